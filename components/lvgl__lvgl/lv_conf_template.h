@@ -73,6 +73,10 @@
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
+/*Count the allocations and bytes per tag (object class, style, timer, etc). See `lv_mem_get_tag_stat()`.
+ *Adds a pointer sized header to every allocation*/
+#define LV_MEM_ACCOUNTING 0
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -121,6 +125,12 @@
     * radius * 4 bytes are used per circle (the most often used radiuses are saved)
     * 0: to disable caching */
     #define LV_CIRCLE_CACHE_SIZE 4
+
+    /* Set number of maximally cached rounded corners.
+    * The corners of rectangles and borders with small radius (max. 12 px) are saved per radius and border width
+    * to draw them without radius masks. 576 bytes are used per corner.
+    * 0: to disable caching */
+    #define LV_CORNER_CACHE_SIZE 0
 #endif /*LV_DRAW_COMPLEX*/
 
 /**
@@ -146,6 +156,13 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Number of cached resolved style properties.
+ *`lv_obj_get_style_prop()` walks the object's styles (and the parents for inherited properties) on every call.
+ *The cache remembers the result per object, part, property and state and is dropped on any style change.
+ *Must be a power of 2. It adds 16 bytes per entry on 32 bit systems.
+ *0: to disable caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
@@ -172,6 +189,11 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Fill, copy and mix RGB565 pixels in 32 bit words (2 color channels at once).
+ *Faster on 32 bit CPUs without SIMD instructions (e.g. RISC-V RV32IMAC).
+ *Used with LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 0*/
+#define LV_DRAW_SW_RGB565_SWAR 0
+
 /*-------------
  * GPU
  *-----------*/
@@ -420,6 +442,10 @@
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
+/*Size of the cache of the expanded (A8) glyph masks in bytes. 0 to disable caching.
+ *Frequently drawn glyphs (e.g. numbers) don't need to be expanded from 1, 2, 4 bpp on every frame.*/
+#define LV_GLYPH_CACHE_SIZE 0
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -450,6 +476,10 @@
 /*The control character to use for signalling text recoloring.*/
 #define LV_TXT_COLOR_CMD "#"
 
+/*Number of cached `lv_txt_get_size()` results (keyed on font, text, max. width and flags). 0 to disable caching.
+ *Every entry stores a copy of the text, texts longer than 32 bytes are not cached.*/
+#define LV_TXT_SIZE_CACHE_SIZE 0
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -166,8 +166,10 @@ struct _lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event
     lv_obj_allocate_spec_attr(obj);
 
     obj->spec_attr->event_dsc_cnt++;
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
     obj->spec_attr->event_dsc = lv_mem_realloc(obj->spec_attr->event_dsc,
                                                obj->spec_attr->event_dsc_cnt * sizeof(lv_event_dsc_t));
+    LV_MEM_TAG_END();
     LV_ASSERT_MALLOC(obj->spec_attr->event_dsc);
 
     obj->spec_attr->event_dsc[obj->spec_attr->event_dsc_cnt - 1].cb = event_cb;
@@ -71,6 +71,7 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state);
  **********************/
 static bool lv_initialized = false;
 const lv_obj_class_t lv_obj_class = {
+    .name = "obj",
     .constructor_cb = lv_obj_constructor,
     .destructor_cb = lv_obj_destructor,
     .event_cb = lv_obj_event,
@@ -362,7 +363,9 @@ void lv_obj_allocate_spec_attr(lv_obj_t * obj)
     if(obj->spec_attr == NULL) {
         static uint32_t x = 0;
         x++;
+        LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
         obj->spec_attr = lv_mem_alloc(sizeof(_lv_obj_spec_attr_t));
+        LV_MEM_TAG_END();
         LV_ASSERT_MALLOC(obj->spec_attr);
         if(obj->spec_attr == NULL) return;
 
@@ -859,7 +862,10 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_coord_t align = lv_obj_get_style_align(obj, LV_PART_MAIN);
         uint16_t layout = lv_obj_get_style_layout(obj, LV_PART_MAIN);
         if(layout || align || w == LV_SIZE_CONTENT || h == LV_SIZE_CONTENT) {
-            lv_obj_mark_layout_as_dirty(obj);
+            lv_obj_t * child = lv_event_get_param(e);
+            /*The child might be moved to an other parent already*/
+            if(child && lv_obj_get_parent(child) == obj) _lv_obj_mark_parent_layout_as_dirty(child);
+            else lv_obj_mark_layout_as_dirty(obj);
         }
     }
     else if(code == LV_EVENT_CHILD_DELETED) {
@@ -894,6 +900,9 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
 
+    /*The cached values of the object are keyed by its state but the children might inherit from this state*/
+    if(lv_obj_get_child_cnt(obj)) _lv_obj_style_cache_invalidate();
+
     _lv_obj_style_transition_dsc_t * ts = lv_mem_buf_get(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     lv_memset_00(ts, sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
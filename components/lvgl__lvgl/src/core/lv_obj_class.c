@@ -43,9 +43,13 @@ static uint32_t get_instance_size(const lv_obj_class_t * class_p);
 lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * parent)
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(class_p));
     uint32_t s = get_instance_size(class_p);
     lv_obj_t * obj = lv_mem_alloc(s);
-    if(obj == NULL) return NULL;
+    if(obj == NULL) {
+        LV_MEM_TAG_END();
+        return NULL;
+    }
     lv_memset_00(obj, s);
     obj->class_p = class_p;
     obj->parent = parent;
@@ -57,6 +61,7 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         if(!disp) {
             LV_LOG_WARN("No display created yet. No place to assign the new screen");
             lv_mem_free(obj);
+            LV_MEM_TAG_END();
             return NULL;
         }
 
@@ -98,11 +103,13 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
         }
     }
 
+    LV_MEM_TAG_END();
     return obj;
 }
 
 void lv_obj_class_init_obj(lv_obj_t * obj)
 {
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
     lv_obj_mark_layout_as_dirty(obj);
     lv_obj_enable_style_refresh(false);
 
@@ -129,6 +136,7 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
         /*Invalidate the area if not screen created*/
         lv_obj_invalidate(obj);
     }
+    LV_MEM_TAG_END();
 }
 
 void _lv_obj_destruct(lv_obj_t * obj)
@@ -168,6 +176,16 @@ bool lv_obj_is_group_def(lv_obj_t * obj)
     return class_p->group_def == LV_OBJ_CLASS_GROUP_DEF_TRUE ? true : false;
 }
 
+const char * lv_obj_class_get_name(const lv_obj_class_t * class_p)
+{
+    /*Find a base in which the name is set*/
+    while(class_p && class_p->name == NULL) class_p = class_p->base_class;
+
+    if(class_p == NULL) return NULL;
+
+    return class_p->name;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -48,6 +48,7 @@ typedef void (*lv_obj_class_event_cb_t)(struct _lv_obj_class_t * class_p, struct
  */
 typedef struct _lv_obj_class_t {
     const struct _lv_obj_class_t * base_class;
+    const char * name;                 /**< Name of the class, e.g. for memory statistics*/
     void (*constructor_cb)(const struct _lv_obj_class_t * class_p, struct _lv_obj_t * obj);
     void (*destructor_cb)(const struct _lv_obj_class_t * class_p, struct _lv_obj_t * obj);
 #if LV_USE_USER_DATA
@@ -82,6 +83,13 @@ bool lv_obj_is_editable(struct _lv_obj_t * obj);
 
 bool lv_obj_is_group_def(struct _lv_obj_t * obj);
 
+/**
+ * Get the name of a class. If it's not set the name of the closest base class is used.
+ * @param class_p   pointer to a class
+ * @return          the name of the class or NULL if none of the classes has a name
+ */
+const char * lv_obj_class_get_name(const struct _lv_obj_class_t * class_p);
+
 /**********************
  *      MACROS
  **********************/
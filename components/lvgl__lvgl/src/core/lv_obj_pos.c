@@ -32,6 +32,7 @@ static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
  *  STATIC VARIABLES
  **********************/
 static uint32_t layout_cnt;
+static lv_obj_layout_stat_t layout_stat;
 
 /**********************
  *      MACROS
@@ -287,6 +288,7 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
+    layout_stat.mark_cnt++;
     obj->layout_inv = 1;
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
@@ -298,6 +300,24 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
+void _lv_obj_mark_parent_layout_as_dirty(lv_obj_t * obj)
+{
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    if(parent == NULL) return;
+
+    /*A child positioned by a layout or a parent sized to its content always needs re-layout.
+     *Otherwise the child can't change anything on the parent: its own size and position are
+     *recalculated when it's marked and the parent's size doesn't depend on them.*/
+    if(!lv_obj_is_layout_positioned(obj) &&
+       lv_obj_get_style_width(parent, LV_PART_MAIN) != LV_SIZE_CONTENT &&
+       lv_obj_get_style_height(parent, LV_PART_MAIN) != LV_SIZE_CONTENT) {
+        layout_stat.skip_cnt++;
+        return;
+    }
+
+    lv_obj_mark_layout_as_dirty(parent);
+}
+
 void lv_obj_update_layout(const lv_obj_t * obj)
 {
     static bool mutex = false;
@@ -313,6 +333,7 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     while(scr->scr_layout_inv) {
         LV_LOG_INFO("Layout update begin");
         scr->scr_layout_inv = 0;
+        layout_stat.pass_cnt++;
         layout_update_core(scr);
         LV_LOG_TRACE("Layout update end");
     }
@@ -320,6 +341,16 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     mutex = false;
 }
 
+void lv_obj_get_layout_stat(lv_obj_layout_stat_t * stat)
+{
+    *stat = layout_stat;
+}
+
+void lv_obj_reset_layout_stat(void)
+{
+    lv_memset_00(&layout_stat, sizeof(layout_stat));
+}
+
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
 {
     layout_cnt++;
@@ -1139,6 +1170,7 @@ static void layout_update_core(lv_obj_t * obj)
 
     if(obj->layout_inv) {
         obj->layout_inv = 0;
+        layout_stat.obj_cnt++;
         lv_obj_refr_size(obj);
         lv_obj_refr_pos(obj);
 
@@ -30,6 +30,13 @@ typedef struct {
     void * user_data;
 } lv_layout_dsc_t;
 
+typedef struct {
+    uint32_t mark_cnt;      /*Number of objects marked for layout update*/
+    uint32_t skip_cnt;      /*Number of parents not marked because the child's size is fixed*/
+    uint32_t pass_cnt;      /*Number of walks of a screen's object tree in `lv_obj_update_layout()`*/
+    uint32_t obj_cnt;       /*Number of objects whose size, position and layout were recalculated*/
+} lv_obj_layout_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -146,12 +153,31 @@ bool lv_obj_is_layout_positioned(const struct _lv_obj_t * obj);
  */
 void lv_obj_mark_layout_as_dirty(struct _lv_obj_t * obj);
 
+/**
+ * Mark the parent of an object for layout update because the object has changed.
+ * Skipped if the object is not positioned by the parent's layout and the parent is not sized
+ * to its content, as the object can't affect the parent then.
+ * @param obj      pointer to an object whose parent might need update
+ */
+void _lv_obj_mark_parent_layout_as_dirty(struct _lv_obj_t * obj);
+
 /**
  * Update the layout of an object.
  * @param obj      pointer to an object whose children needs to be updated
  */
 void lv_obj_update_layout(const struct _lv_obj_t * obj);
 
+/**
+ * Get the layout statistics collected since the last `lv_obj_reset_layout_stat()`
+ * @param stat      store the statistics here
+ */
+void lv_obj_get_layout_stat(lv_obj_layout_stat_t * stat);
+
+/**
+ * Clear the layout statistics
+ */
+void lv_obj_reset_layout_stat(void);
+
 /**
  * Register a new layout
  * @param cb        the layout update callback
@@ -15,6 +15,12 @@
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+    #if LV_OBJ_STYLE_CACHE_SIZE < 2 || (LV_OBJ_STYLE_CACHE_SIZE & (LV_OBJ_STYLE_CACHE_SIZE - 1)) != 0
+        #error "LV_OBJ_STYLE_CACHE_SIZE must be a power of 2"
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +41,17 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+typedef struct {
+    const lv_obj_t * obj;
+    lv_style_value_t value;
+    uint16_t prop;
+    lv_state_t state;
+    uint8_t part;       /*`part >> 16`*/
+    uint8_t gen;        /*Valid only if equal to `style_cache_gen`*/
+} style_cache_entry_t;
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -54,11 +71,21 @@ static void trans_anim_ready_cb(lv_anim_t * a);
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
+#if LV_OBJ_STYLE_CACHE_SIZE
+    static inline style_cache_entry_t * style_cache_get_set(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+    static inline bool style_cache_match(const style_cache_entry_t * entry, const lv_obj_t * obj, lv_part_t part,
+                                         lv_style_prop_t prop);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_OBJ_STYLE_CACHE_SIZE
+    static style_cache_entry_t style_cache[LV_OBJ_STYLE_CACHE_SIZE];
+    static uint8_t style_cache_gen = 1;
+    static lv_obj_style_cache_stat_t style_cache_stat;
+#endif
 
 /**********************
  *      MACROS
@@ -89,7 +116,9 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
 
     /*Allocate space for the new style and shift the rest of the style to the end*/
     obj->style_cnt++;
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
     obj->styles = lv_mem_realloc(obj->styles, obj->style_cnt * sizeof(_lv_obj_style_t));
+    LV_MEM_TAG_END();
 
     uint32_t j;
     for(j = obj->style_cnt - 1; j > i ; j--) {
@@ -100,6 +129,7 @@ void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t se
     obj->styles[i].style = style;
     obj->styles[i].selector = selector;
 
+    _lv_obj_style_cache_invalidate();
     lv_obj_refresh_style(obj, selector, LV_STYLE_PROP_ANY);
 }
 
@@ -145,6 +175,10 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         /*The style from the current `i` index is removed, so `i` points to the next style.
          *Therefore it doesn't needs to be incremented*/
     }
+
+    /*Also called from the destructor: a new object can be allocated at the same address*/
+    _lv_obj_style_cache_invalidate();
+
     if(deleted && prop != LV_STYLE_PROP_INV) {
         lv_obj_refresh_style(obj, part, prop);
     }
@@ -152,6 +186,8 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    _lv_obj_style_cache_invalidate();
+
     if(!style_refr) return;
     lv_disp_t * d = lv_disp_get_next(NULL);
 
@@ -168,6 +204,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Drop the cached values even if refreshing is disabled, the styles have changed anyway*/
+    _lv_obj_style_cache_invalidate();
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -189,8 +228,7 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
         }
     }
     if((part == LV_PART_ANY || part == LV_PART_MAIN) && (prop == LV_STYLE_PROP_ANY || is_layout_refr)) {
-        lv_obj_t * parent = lv_obj_get_parent(obj);
-        if(parent) lv_obj_mark_layout_as_dirty(parent);
+        _lv_obj_mark_parent_layout_as_dirty(obj);
     }
 
     /*Cache the layer type*/
@@ -220,8 +258,52 @@ void lv_obj_enable_style_refresh(bool en)
     style_refr = en;
 }
 
+void _lv_obj_style_cache_invalidate(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    style_cache_stat.invalidate_cnt++;
+    style_cache_gen++;
+    /*On wrap around old entries could become valid again so really clear them*/
+    if(style_cache_gen == 0) {
+        lv_memset_00(style_cache, sizeof(style_cache));
+        style_cache_gen = 1;
+    }
+#endif
+}
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+void lv_obj_style_cache_get_stat(lv_obj_style_cache_stat_t * stat)
+{
+    *stat = style_cache_stat;
+}
+
+void lv_obj_style_cache_reset_stat(void)
+{
+    lv_memset_00(&style_cache_stat, sizeof(style_cache_stat));
+}
+#endif
+
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*`skip_trans` is used to read the values of an other state temporarily, don't cache them*/
+    style_cache_entry_t * set = NULL;
+    if(!obj->skip_trans) {
+        style_cache_stat.lookup_cnt++;
+        set = style_cache_get_set(obj, part, prop);
+        if(style_cache_match(&set[0], obj, part, prop)) {
+            style_cache_stat.hit_cnt++;
+            return set[0].value;
+        }
+        if(style_cache_match(&set[1], obj, part, prop)) {
+            style_cache_stat.hit_cnt++;
+            return set[1].value;
+        }
+    }
+    const lv_obj_t * obj_ori = obj;
+    lv_part_t part_ori = part;
+#endif
+
     lv_style_value_t value_act;
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
@@ -264,22 +346,39 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
             value_act = lv_style_prop_get_default(prop);
         }
     }
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+    if(set) {
+        /*The first way holds the newest entry, the older one is moved to the second way*/
+        if(set[0].gen == style_cache_gen) set[1] = set[0];
+        set[0].obj = obj_ori;
+        set[0].value = value_act;
+        set[0].prop = prop;
+        set[0].state = obj_ori->state;
+        set[0].part = part_ori >> 16;
+        set[0].gen = style_cache_gen;
+    }
+#endif
     return value_act;
 }
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
                                  lv_style_selector_t selector)
 {
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
     lv_style_t * style = get_local_style(obj, selector);
     lv_style_set_prop(style, prop, value);
+    LV_MEM_TAG_END();
     lv_obj_refresh_style(obj, selector, prop);
 }
 
 void lv_obj_set_local_style_prop_meta(lv_obj_t * obj, lv_style_prop_t prop, uint16_t meta,
                                       lv_style_selector_t selector)
 {
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
     lv_style_t * style = get_local_style(obj, selector);
     lv_style_set_prop_meta(style, prop, meta);
+    LV_MEM_TAG_END();
     lv_obj_refresh_style(obj, selector, prop);
 }
 
@@ -342,6 +441,7 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_cache_invalidate();
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -750,6 +850,8 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
         }
         tr = tr_prev;
     }
+
+    if(removed) _lv_obj_style_cache_invalidate();
     return removed;
 }
 
@@ -835,6 +937,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_cache_invalidate();
 
 }
 
@@ -865,6 +968,7 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+                _lv_obj_style_cache_invalidate();
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
@@ -876,6 +980,33 @@ static void trans_anim_ready_cb(lv_anim_t * a)
     }
 }
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+/**
+ * Get the set of the style cache where an object's part's property in the current state can be stored.
+ * The cache is 2 way set associative so a set is 2 consecutive entries.
+ * @param obj       pointer to an object
+ * @param part      the part
+ * @param prop      the property
+ * @return          pointer to the first entry of the set
+ */
+static inline style_cache_entry_t * style_cache_get_set(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)obj >> 2) * 0x9E3779B1;
+    h ^= (uint32_t)prop * 0x85EBCA6B;
+    h ^= (uint32_t)(part >> 16) * 0xC2B2AE35;
+    h ^= (uint32_t)obj->state * 0x27D4EB2F;
+    h ^= h >> 15;
+    return &style_cache[h & (LV_OBJ_STYLE_CACHE_SIZE - 2)];
+}
+
+static inline bool style_cache_match(const style_cache_entry_t * entry, const lv_obj_t * obj, lv_part_t part,
+                                     lv_style_prop_t prop)
+{
+    return entry->gen == style_cache_gen && entry->obj == obj && entry->prop == prop &&
+           entry->state == obj->state && entry->part == (part >> 16);
+}
+#endif
+
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj)
 {
     if(lv_obj_get_style_transform_angle(obj, 0) != 0) return LV_LAYER_TYPE_TRANSFORM;
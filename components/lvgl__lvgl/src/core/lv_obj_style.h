@@ -54,6 +54,14 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+typedef struct {
+    uint32_t lookup_cnt;        /*Number of `lv_obj_get_style_prop()` calls which could use the cache*/
+    uint32_t hit_cnt;           /*Number of lookups served from the cache*/
+    uint32_t invalidate_cnt;    /*Number of times the cache was dropped due to a style change*/
+} lv_obj_style_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -130,6 +138,25 @@ void lv_obj_enable_style_refresh(bool en);
  */
 lv_style_value_t lv_obj_get_style_prop(const struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+/**
+ * Drop all the values cached by `lv_obj_get_style_prop()`.
+ * Used internally when a style, the styles of an object or the parent of an object change.
+ */
+void _lv_obj_style_cache_invalidate(void);
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+/**
+ * Get the statistics of the resolved style property cache
+ * @param stat      store the statistics here
+ */
+void lv_obj_style_cache_get_stat(lv_obj_style_cache_stat_t * stat);
+
+/**
+ * Clear the statistics of the resolved style property cache
+ */
+void lv_obj_style_cache_reset_stat(void);
+#endif
+
 /**
  * Set local style property on an object's part and state.
  * @param obj       pointer to an object
@@ -36,6 +36,9 @@ typedef struct {
     uint32_t    frame_cnt;
     uint32_t    fps_sum_cnt;
     uint32_t    fps_sum_all;
+    uint32_t    refr_cnt;           /*Frames with any redrawn pixel in the current period*/
+    uint32_t    layout_pass_last;   /*Layout passes at the beginning of the current period*/
+    uint32_t    layout_obj_last;    /*Objects re-laid out at the beginning of the current period*/
 #if LV_USE_LABEL
     lv_obj_t  * perf_label;
 #endif
@@ -62,6 +65,7 @@ static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void refr_stat_add_frame(void);
 
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
@@ -75,6 +79,8 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+static lv_refr_frame_stat_t frame_stat; /*Statistics of the frame being refreshed*/
+static lv_refr_stat_t refr_stat;
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -320,6 +326,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         return;
     }
 
+    lv_memset_00(&frame_stat, sizeof(frame_stat));
+    frame_stat.inv_cnt = disp_refr->inv_p;
+
     lv_refr_join_area();
     refr_sync_areas();
     refr_invalid_areas();
@@ -345,6 +354,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
+        frame_stat.px_cnt = px_num;
+        refr_stat_add_frame();
+
         elaps = lv_tick_elaps(start);
 
         /*Call monitor cb if present*/
@@ -377,6 +389,8 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.perf_label = perf_label;
     }
 
+    if(px_num > 0) perf_monitor.refr_cnt++;
+
     if(lv_tick_elaps(perf_monitor.perf_last_time) < 300) {
         if(px_num > 5000) {
             perf_monitor.elaps_sum += elaps;
@@ -413,7 +427,19 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.fps_sum_all += fps;
         perf_monitor.fps_sum_cnt ++;
         uint32_t cpu = 100 - lv_timer_get_idle();
-        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU", fps, cpu);
+
+        /*Layout passes and re-laid out objects per redrawn frame*/
+        lv_obj_layout_stat_t layout_stat;
+        lv_obj_get_layout_stat(&layout_stat);
+        uint32_t refr_cnt = LV_MAX(perf_monitor.refr_cnt, 1);
+        uint32_t pass_x10 = ((layout_stat.pass_cnt - perf_monitor.layout_pass_last) * 10) / refr_cnt;
+        uint32_t obj_per_frame = (layout_stat.obj_cnt - perf_monitor.layout_obj_last) / refr_cnt;
+        perf_monitor.layout_pass_last = layout_stat.pass_cnt;
+        perf_monitor.layout_obj_last = layout_stat.obj_cnt;
+        perf_monitor.refr_cnt = 0;
+
+        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU\n%"LV_PRIu32".%"LV_PRIu32" layout, %"LV_PRIu32" obj",
+                              fps, cpu, pass_x10 / 10, pass_x10 % 10, obj_per_frame);
     }
 #endif
 
@@ -451,6 +477,43 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     REFR_TRACE("finished");
 }
 
+bool lv_refr_join_by_cost(lv_disp_drv_t * disp_drv, const lv_area_t * area1, const lv_area_t * area2,
+                          const lv_area_t * joined)
+{
+    if(disp_drv->flush_cost == 0) {
+        if(_lv_area_is_on(area1, area2) == false) return false;
+        return lv_area_get_size(joined) < lv_area_get_size(area1) + lv_area_get_size(area2);
+    }
+
+    return lv_refr_get_area_cost(disp_drv, joined) <
+           lv_refr_get_area_cost(disp_drv, area1) + lv_refr_get_area_cost(disp_drv, area2);
+}
+
+uint64_t lv_refr_get_area_cost(lv_disp_drv_t * disp_drv, const lv_area_t * area)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t h = lv_area_get_height(area);
+
+    /*Without parts every area is flushed at once*/
+    uint32_t flush_cnt = 1;
+    if(!disp_drv->full_refresh && !disp_drv->direct_mode && disp_drv->draw_buf) {
+        uint32_t max_row = (uint32_t)disp_drv->draw_buf->size / w;
+        if(max_row > 0 && (uint32_t)h > max_row) flush_cnt = (h + max_row - 1) / max_row;
+    }
+
+    return (uint64_t)disp_drv->flush_cost * flush_cnt + (uint64_t)disp_drv->px_cost * lv_area_get_size(area);
+}
+
+void lv_refr_get_stat(lv_refr_stat_t * stat)
+{
+    *stat = refr_stat;
+}
+
+void lv_refr_reset_stat(void)
+{
+    lv_memset_00(&refr_stat, sizeof(refr_stat));
+}
+
 #if LV_USE_PERF_MONITOR
 void lv_refr_reset_fps_counter(void)
 {
@@ -473,40 +536,44 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas where the display driver's `join_cb` finds it cheaper to refresh them together
  */
 static void lv_refr_join_area(void)
 {
+    lv_disp_drv_t * drv = disp_refr->driver;
+    bool (*join_cb)(lv_disp_drv_t *, const lv_area_t *, const lv_area_t *, const lv_area_t *);
+    join_cb = drv->join_cb ? drv->join_cb : lv_refr_join_by_cost;
+
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
-
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
+    bool joined;
+
+    /*A grown area might be worth joining with an area checked earlier so repeat until nothing changes*/
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+                _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+                if(join_cb(drv, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from], &joined_area)) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
         }
-    }
+    } while(joined);
 }
 
 /**
@@ -618,6 +685,7 @@ static void refr_invalid_areas(void)
             refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            frame_stat.area_cnt++;
         }
     }
 
@@ -1325,6 +1393,26 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
     };
 
     drv->flush_cb(drv, &offset_area, color_p);
+    frame_stat.flush_cnt++;
+}
+
+/**
+ * Add the statistics of the refreshed frame to the collected statistics
+ */
+static void refr_stat_add_frame(void)
+{
+    refr_stat.frame_cnt++;
+    refr_stat.last = frame_stat;
+
+    refr_stat.sum.inv_cnt += frame_stat.inv_cnt;
+    refr_stat.sum.area_cnt += frame_stat.area_cnt;
+    refr_stat.sum.px_cnt += frame_stat.px_cnt;
+    refr_stat.sum.flush_cnt += frame_stat.flush_cnt;
+
+    refr_stat.max.inv_cnt = LV_MAX(refr_stat.max.inv_cnt, frame_stat.inv_cnt);
+    refr_stat.max.area_cnt = LV_MAX(refr_stat.max.area_cnt, frame_stat.area_cnt);
+    refr_stat.max.px_cnt = LV_MAX(refr_stat.max.px_cnt, frame_stat.px_cnt);
+    refr_stat.max.flush_cnt = LV_MAX(refr_stat.max.flush_cnt, frame_stat.flush_cnt);
 }
 
 #if LV_USE_PERF_MONITOR
@@ -1336,6 +1424,9 @@ static void perf_monitor_init(perf_monitor_t * _perf_monitor)
     _perf_monitor->fps_sum_cnt = 0;
     _perf_monitor->frame_cnt = 0;
     _perf_monitor->perf_last_time = 0;
+    _perf_monitor->refr_cnt = 0;
+    _perf_monitor->layout_pass_last = 0;
+    _perf_monitor->layout_obj_last = 0;
     _perf_monitor->perf_label = NULL;
 }
 #endif
@@ -26,6 +26,22 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** Refresh statistics of a frame*/
+typedef struct {
+    uint32_t inv_cnt;       /**< Number of invalidated areas before joining*/
+    uint32_t area_cnt;      /**< Number of areas refreshed after joining*/
+    uint32_t px_cnt;        /**< Number of rendered pixels*/
+    uint32_t flush_cnt;     /**< Number of `flush_cb` calls*/
+} lv_refr_frame_stat_t;
+
+/** Refresh statistics collected since the last `lv_refr_reset_stat()`*/
+typedef struct {
+    uint32_t frame_cnt;             /**< Number of frames with anything to refresh*/
+    lv_refr_frame_stat_t last;      /**< The last refreshed frame*/
+    lv_refr_frame_stat_t max;       /**< The largest value of each field in a frame*/
+    lv_refr_frame_stat_t sum;       /**< The sum of each field for all frames*/
+} lv_refr_stat_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -85,6 +101,42 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+/**
+ * The default area joining policy of `lv_disp_drv_t`'s `join_cb`.
+ * If `flush_cost` of the driver is 0 the areas are joined only if they overlap and
+ * the joined area is smaller than `area1` and `area2` together.
+ * Else they are joined (even if they don't overlap) if refreshing `joined` costs less than
+ * refreshing `area1` and `area2`. See `lv_refr_get_area_cost()`.
+ * @param disp_drv  pointer to the display driver being refreshed
+ * @param area1     pointer to an invalidated area
+ * @param area2     pointer to an other invalidated area
+ * @param joined    pointer to the smallest area containing `area1` and `area2`
+ * @return          true: refresh `joined` instead of `area1` and `area2`
+ */
+bool lv_refr_join_by_cost(lv_disp_drv_t * disp_drv, const lv_area_t * area1, const lv_area_t * area2,
+                          const lv_area_t * joined);
+
+/**
+ * Estimate the cost of refreshing an area with the `flush_cost` and `px_cost` of the display driver.
+ * The area is rendered and flushed in as many parts as the draw buffer requires and
+ * each part costs `flush_cost`.
+ * @param disp_drv  pointer to a display driver
+ * @param area      pointer to an area on the display
+ * @return          `flush_cost * flush count + px_cost * pixel count`
+ */
+uint64_t lv_refr_get_area_cost(lv_disp_drv_t * disp_drv, const lv_area_t * area);
+
+/**
+ * Get the refresh statistics collected since the last `lv_refr_reset_stat()`
+ * @param stat      store the statistics here
+ */
+void lv_refr_get_stat(lv_refr_stat_t * stat);
+
+/**
+ * Clear the refresh statistics
+ */
+void lv_refr_reset_stat(void);
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
@@ -14,6 +14,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_rgb565.h"
 #include "../lv_draw.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_color.h"
@@ -43,6 +44,14 @@ typedef struct {
     uint32_t has_alpha : 1;
 } lv_draw_sw_layer_ctx_t;
 
+/** Statistics of the glyph mask cache*/
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs drawn from the cache*/
+    uint32_t miss_cnt;      /**< Number of glyphs expanded and added to the cache*/
+    uint32_t size;          /**< Current size of the cached masks in bytes*/
+    uint32_t lut_cnt;       /**< Number of glyphs drawn on a solid background with a lookup table (no mask needed)*/
+} lv_draw_sw_glyph_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -61,6 +70,24 @@ void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, con
 void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
                        uint32_t letter);
 
+/**
+ * Drop every cached glyph mask. Needs to be called if the glyphs of a font change
+ * or a font is freed (its address might be reused by an other font).
+ * Does nothing if `LV_GLYPH_CACHE_SIZE` is 0.
+ */
+void lv_draw_sw_glyph_cache_clear(void);
+
+/**
+ * Get the statistics of the glyph mask cache
+ * @param stat pointer to a variable to store the result
+ */
+void lv_draw_sw_glyph_cache_get_stat(lv_draw_sw_glyph_cache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters of the glyph mask cache
+ */
+void lv_draw_sw_glyph_cache_reset_stat(void);
+
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_img_dsc_t * draw_dsc,
                                                         const lv_area_t * coords, const uint8_t * src_buf,
@@ -8,6 +8,7 @@ CSRCS += lv_draw_sw_letter.c
 CSRCS += lv_draw_sw_line.c
 CSRCS += lv_draw_sw_polygon.c
 CSRCS += lv_draw_sw_rect.c
+CSRCS += lv_draw_sw_rgb565.c
 CSRCS += lv_draw_sw_transform.c
 CSRCS += lv_draw_sw_layer.c
 
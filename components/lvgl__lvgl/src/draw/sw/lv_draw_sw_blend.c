@@ -14,6 +14,11 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_DRAW_SW_RGB565_SWAR && LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+    #define RGB565_SWAR     1
+#else
+    #define RGB565_SWAR     0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -258,7 +263,11 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
             for(y = 0; y < h; y++) {
+#if RGB565_SWAR
+                _lv_draw_sw_rgb565_fill(&dest_buf->full, color.full, w);
+#else
                 lv_color_fill(dest_buf, color, w);
+#endif
                 dest_buf += dest_stride;
             }
         }
@@ -659,16 +668,25 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     if(mask == NULL) {
         if(opa >= LV_OPA_MAX) {
             for(y = 0; y < h; y++) {
+#if RGB565_SWAR
+                /*lv_memcpy copies byte by byte if the rows are aligned differently*/
+                _lv_draw_sw_rgb565_copy(&dest_buf->full, &src_buf->full, w);
+#else
                 lv_memcpy(dest_buf, src_buf, w * sizeof(lv_color_t));
+#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
         }
         else {
             for(y = 0; y < h; y++) {
+#if RGB565_SWAR
+                _lv_draw_sw_rgb565_mix(&dest_buf->full, &src_buf->full, w, opa);
+#else
                 for(x = 0; x < w; x++) {
                     dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
                 }
+#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
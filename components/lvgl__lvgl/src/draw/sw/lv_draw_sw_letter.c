@@ -13,22 +13,44 @@
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
+#include "../../font/lv_font_fmt_txt.h"
 #include "../../core/lv_refr.h"
+#include "../../misc/lv_lru.h"
+#include "../../misc/lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/*Expected average mask size used to size the hash table of the glyph cache (~7x9 px glyphs)*/
+#define GLYPH_CACHE_AVG_SIZE 64
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_GLYPH_CACHE_SIZE
+typedef struct {
+    const lv_font_t * font;
+    uint32_t letter;
+} glyph_cache_key_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static void /* LV_ATTRIBUTE_FAST_MEM */ draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
-                                                           const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
+                                                           const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p,
+                                                           uint32_t letter);
+
+static bool draw_letter_solid_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
+                                 const lv_font_glyph_dsc_t * g, const uint8_t * map_p);
+
+#if LV_GLYPH_CACHE_SIZE
+static const uint8_t * glyph_cache_get(const lv_font_glyph_dsc_t * g, uint32_t letter, const uint8_t * map_p,
+                                       const uint8_t * bpp_opa_table_p, uint32_t bitmask_init, uint32_t bpp);
+#endif
 
 
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
@@ -39,6 +61,7 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_draw_sw_glyph_cache_stat_t glyph_cache_stat;
 
 /**********************
  *  GLOBAL VARIABLES
@@ -154,16 +177,44 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
 #endif
     }
     else {
-        draw_letter_normal(draw_ctx, dsc, &gpos, &g, map_p);
+        draw_letter_normal(draw_ctx, dsc, &gpos, &g, map_p, letter);
     }
 }
 
+void lv_draw_sw_glyph_cache_clear(void)
+{
+#if LV_GLYPH_CACHE_SIZE
+    if(LV_GC_ROOT(_lv_glyph_cache) == NULL) return;
+
+    lv_lru_del(LV_GC_ROOT(_lv_glyph_cache));
+    LV_GC_ROOT(_lv_glyph_cache) = NULL;
+#endif
+}
+
+void lv_draw_sw_glyph_cache_get_stat(lv_draw_sw_glyph_cache_stat_t * stat)
+{
+    *stat = glyph_cache_stat;
+    stat->size = 0;
+#if LV_GLYPH_CACHE_SIZE
+    lv_lru_t * cache = LV_GC_ROOT(_lv_glyph_cache);
+    if(cache) stat->size = cache->total_memory - cache->free_memory;
+#endif
+}
+
+void lv_draw_sw_glyph_cache_reset_stat(void)
+{
+    glyph_cache_stat.hit_cnt = 0;
+    glyph_cache_stat.miss_cnt = 0;
+    glyph_cache_stat.lut_cnt = 0;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
-                                                     const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p)
+                                                     const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p,
+                                                     uint32_t letter)
 {
 
     const uint8_t * bpp_opa_table_p;
@@ -213,11 +264,35 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             bitmask_init  = 0xFF;
             shades = 256;
             break;       /*No opa table, pixel value will be used directly*/
+        case LV_FONT_RLE_BPP:
+            bpp_opa_table_p = _lv_bpp8_opa_table;
+            bitmask_init  = 0;
+            shades = 0;
+            break;      /*Decoded directly to opacity values*/
         default:
             LV_LOG_WARN("lv_draw_letter: invalid bpp");
             return; /*Invalid bpp. Can't render the letter*/
     }
 
+    /*Most texts are drawn on a plain background where a lookup table can replace the masking and blending*/
+    if((bpp == 4 || bpp == LV_FONT_RLE_BPP) && draw_letter_solid_bg(draw_ctx, dsc, pos, g, map_p)) {
+        glyph_cache_stat.lut_cnt++;
+        return;
+    }
+
+    /*8 bpp bitmaps are already A8 masks. Others might be found in the cache already expanded*/
+    const uint8_t * a8_map = NULL;
+    if(bpp == 8) a8_map = map_p;
+#if LV_GLYPH_CACHE_SIZE
+    else if(bpp != LV_FONT_RLE_BPP) a8_map = glyph_cache_get(g, letter, map_p, bpp_opa_table_p, bitmask_init, bpp);
+#else
+    LV_UNUSED(letter);
+#endif
+
+    /*Run-length encoded glyphs are decoded row by row into the mask, cheaper than expanding them*/
+    lv_font_fmt_txt_rle_t rle;
+    if(bpp == LV_FONT_RLE_BPP) _lv_font_fmt_txt_rle_init(&rle, map_p);
+
     static lv_opa_t opa_table[256];
     static lv_opa_t prev_opa = LV_OPA_TRANSP;
     static uint32_t prev_bpp = 0;
@@ -247,6 +322,7 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     /*Move on the map too*/
     uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
     map_p += bit_ofs >> 3;
+    if(bpp == LV_FONT_RLE_BPP) _lv_font_fmt_txt_rle_skip(&rle, row_start * box_w + col_start);
 
     uint8_t letter_px;
     uint32_t col_bit;
@@ -286,30 +362,59 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
 #if LV_DRAW_COMPLEX
         int32_t mask_p_start = mask_p;
 #endif
-        bitmask = bitmask_init >> col_bit;
-        for(col = col_start; col < col_end; col++) {
-            /*Load the pixel's opacity into the mask*/
-            letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
-            if(letter_px) {
-                mask_buf[mask_p] = bpp_opa_table_p[letter_px];
+        if(a8_map) {
+            /*Copy the already expanded row and apply the opacity the same way as the opa table does*/
+            const uint8_t * a8_row = &a8_map[row * box_w + col_start];
+            if(opa >= LV_OPA_MAX) {
+                lv_memcpy(&mask_buf[mask_p], a8_row, col_end - col_start);
+                mask_p += col_end - col_start;
             }
             else {
-                mask_buf[mask_p] = 0;
+                for(col = col_start; col < col_end; col++) {
+                    lv_opa_t a = *a8_row++;
+                    mask_buf[mask_p++] = a == LV_OPA_COVER ? opa : ((a * opa) >> 8);
+                }
             }
-
-            /*Go to the next column*/
-            if(col_bit < col_bit_max) {
-                col_bit += bpp;
-                bitmask = bitmask >> bpp;
+        }
+        else if(bpp == LV_FONT_RLE_BPP) {
+            _lv_font_fmt_txt_rle_read(&rle, &mask_buf[mask_p], col_end - col_start);
+            if(opa < LV_OPA_MAX) {
+                for(col = col_start; col < col_end; col++) {
+                    lv_opa_t a = mask_buf[mask_p];
+                    mask_buf[mask_p++] = a == LV_OPA_COVER ? opa : ((a * opa) >> 8);
+                }
             }
             else {
-                col_bit = 0;
-                bitmask = bitmask_init;
-                map_p++;
+                mask_p += col_end - col_start;
             }
+            _lv_font_fmt_txt_rle_skip(&rle, box_w - (col_end - col_start));
+        }
+        else {
+            bitmask = bitmask_init >> col_bit;
+            for(col = col_start; col < col_end; col++) {
+                /*Load the pixel's opacity into the mask*/
+                letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
+                if(letter_px) {
+                    mask_buf[mask_p] = bpp_opa_table_p[letter_px];
+                }
+                else {
+                    mask_buf[mask_p] = 0;
+                }
 
-            /*Next mask byte*/
-            mask_p++;
+                /*Go to the next column*/
+                if(col_bit < col_bit_max) {
+                    col_bit += bpp;
+                    bitmask = bitmask >> bpp;
+                }
+                else {
+                    col_bit = 0;
+                    bitmask = bitmask_init;
+                    map_p++;
+                }
+
+                /*Next mask byte*/
+                mask_p++;
+            }
         }
 
 #if LV_DRAW_COMPLEX
@@ -351,6 +456,207 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     lv_mem_buf_release(mask_buf);
 }
 
+/**
+ * Draw a 4 bpp or run-length encoded glyph directly into the draw buffer if every pixel under it has
+ * the same color. The 16 (or 8) possible results of the (letter color, background color, pixel value)
+ * triples are calculated once, exactly as the masked blending would do, and the glyph's pixels are just
+ * looked up. The runs of run-length encoded glyphs are filled at once.
+ * @param draw_ctx      pointer to the draw context
+ * @param dsc           the label draw descriptor
+ * @param pos           top left corner of the glyph's box
+ * @param g             the glyph's descriptor
+ * @param map_p         the glyph's bitmap
+ * @return              true: the glyph is drawn; false: the generic path needs to be used
+ */
+static bool LV_ATTRIBUTE_FAST_MEM draw_letter_solid_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                       const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const uint8_t * map_p)
+{
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(((lv_draw_sw_ctx_t *)draw_ctx)->blend != lv_draw_sw_blend_basic) return false;
+
+    /*Pixel callbacks, ARGB layers and rounded masks are handled by the generic blending*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb || disp->driver->screen_transp || disp->driver->antialiasing == 0) return false;
+
+    lv_area_t glyph_area;
+    glyph_area.x1 = pos->x;
+    glyph_area.y1 = pos->y;
+    glyph_area.x2 = pos->x + g->box_w - 1;
+    glyph_area.y2 = pos->y + g->box_h - 1;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, &glyph_area, draw_ctx->clip_area)) return true;
+    if(dsc->opa <= LV_OPA_MIN) return true;
+#if LV_DRAW_COMPLEX
+    if(lv_draw_mask_is_any(&draw_area)) return false;
+#endif
+
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    int32_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    int32_t w = lv_area_get_width(&draw_area);
+    int32_t h = lv_area_get_height(&draw_area);
+    lv_color_t * dest_buf = draw_ctx->buf;
+    dest_buf += dest_stride * (draw_area.y1 - draw_ctx->buf_area->y1) + (draw_area.x1 - draw_ctx->buf_area->x1);
+
+    /*Check if the background is a single color*/
+    lv_color_t bg_color = dest_buf[0];
+    int32_t x;
+    int32_t y;
+    lv_color_t * dest_row = dest_buf;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            if(dest_row[x].full != bg_color.full) return false;
+        }
+        dest_row += dest_stride;
+    }
+
+    /*The table is valid for the color pair, opacity and bpp until they change*/
+    static lv_color_t lut[16];
+    static lv_color_t lut_fg_color;
+    static lv_color_t lut_bg_color;
+    static lv_opa_t lut_opa = LV_OPA_TRANSP;
+    static uint8_t lut_bpp;
+    lv_opa_t opa = dsc->opa;
+    bool rle = g->bpp == LV_FONT_RLE_BPP;
+    if(lut_opa != opa || lut_fg_color.full != dsc->color.full || lut_bg_color.full != bg_color.full ||
+       lut_bpp != g->bpp) {
+        const uint8_t * opa_table = rle ? _lv_bpp3_opa_table : _lv_bpp4_opa_table;
+        uint32_t shades = rle ? 8 : 16;
+        uint32_t i;
+        lut[0] = bg_color;
+        for(i = 1; i < shades; i++) {
+            lv_opa_t mask = opa_table[i];
+            if(opa < LV_OPA_MAX) {
+                /*Opa table of draw_letter_normal() then the opacity of the blending*/
+                mask = mask == LV_OPA_COVER ? opa : (mask * opa) >> 8;
+                if(mask) mask = (mask * opa) >> 8;
+            }
+
+            if(mask == LV_OPA_TRANSP) lut[i] = bg_color;
+            else if(mask == LV_OPA_COVER) lut[i] = dsc->color;
+            else lut[i] = lv_color_mix(dsc->color, bg_color, mask);
+        }
+        lut_opa = opa;
+        lut_fg_color = dsc->color;
+        lut_bg_color = bg_color;
+        lut_bpp = g->bpp;
+    }
+
+    uint32_t col_start = draw_area.x1 - glyph_area.x1;
+    uint32_t row_start = draw_area.y1 - glyph_area.y1;
+    if(rle) {
+        lv_font_fmt_txt_rle_t rle_dec;
+        _lv_font_fmt_txt_rle_init(&rle_dec, map_p);
+        _lv_font_fmt_txt_rle_skip(&rle_dec, row_start * g->box_w + col_start);
+        for(y = 0; y < h; y++) {
+            x = 0;
+            while(x < w) {
+                uint8_t level;
+                int32_t n = _lv_font_fmt_txt_rle_get_run(&rle_dec, w - x, &level);
+                if(level == 7) lv_color_fill(&dest_buf[x], lut[7], n);
+                else if(level) {
+                    int32_t i;
+                    for(i = 0; i < n; i++) dest_buf[x + i] = lut[level];
+                }
+                x += n;
+            }
+            _lv_font_fmt_txt_rle_skip(&rle_dec, g->box_w - w);
+            dest_buf += dest_stride;
+        }
+        return true;
+    }
+
+    /*The rows are not byte aligned in the bitmap*/
+    uint32_t bit_ofs = (row_start * g->box_w + col_start) * 4;
+    uint32_t row_bit_ofs = (g->box_w - w) * 4;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            uint32_t letter_px = (map_p[bit_ofs >> 3] >> (4 - (bit_ofs & 0x4))) & 0xF;
+            if(letter_px) dest_buf[x] = lut[letter_px];
+            bit_ofs += 4;
+        }
+        bit_ofs += row_bit_ofs;
+        dest_buf += dest_stride;
+    }
+
+    return true;
+}
+
+#if LV_GLYPH_CACHE_SIZE
+/**
+ * Get the expanded A8 mask of a glyph from the cache or expand and add it.
+ * @param g             the glyph's descriptor
+ * @param letter        the letter to identify the glyph in its font
+ * @param map_p         the glyph's bitmap
+ * @param bpp_opa_table_p opacity of the pixel values (without the opacity of the text)
+ * @param bitmask_init  mask of the first pixel in a byte
+ * @param bpp           bit per pixel of the bitmap
+ * @return              `box_w * box_h` bytes mask or NULL if it couldn't be cached
+ */
+static const uint8_t * glyph_cache_get(const lv_font_glyph_dsc_t * g, uint32_t letter, const uint8_t * map_p,
+                                       const uint8_t * bpp_opa_table_p, uint32_t bitmask_init, uint32_t bpp)
+{
+    if(LV_GC_ROOT(_lv_glyph_cache) == NULL) {
+        LV_MEM_TAG_BEGIN("glyph_cache");
+        LV_GC_ROOT(_lv_glyph_cache) = lv_lru_create(LV_GLYPH_CACHE_SIZE, GLYPH_CACHE_AVG_SIZE, NULL, NULL);
+        LV_MEM_TAG_END();
+        LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_glyph_cache));
+        if(LV_GC_ROOT(_lv_glyph_cache) == NULL) return NULL;
+    }
+    lv_lru_t * cache = LV_GC_ROOT(_lv_glyph_cache);
+
+    /*Clear the padding too as the keys are compared with memcmp*/
+    glyph_cache_key_t key;
+    lv_memset_00(&key, sizeof(key));
+    key.font = g->resolved_font;
+    key.letter = letter;
+
+    uint8_t * a8_map = NULL;
+    lv_lru_get(cache, &key, sizeof(key), (void **)&a8_map);
+    if(a8_map) {
+        glyph_cache_stat.hit_cnt++;
+        return a8_map;
+    }
+
+    /*Too large glyphs would only flush the cache*/
+    uint32_t px_cnt = (uint32_t)g->box_w * g->box_h;
+    if(px_cnt > LV_GLYPH_CACHE_SIZE / 4) return NULL;
+
+    LV_MEM_TAG_BEGIN("glyph_cache");
+    a8_map = lv_mem_alloc(px_cnt);
+    if(a8_map == NULL) {
+        LV_MEM_TAG_END();
+        return NULL;
+    }
+
+    /*The rows are not byte aligned in the bitmap so simply process the whole glyph as one stream*/
+    uint32_t col_bit_max = 8 - bpp;
+    uint32_t col_bit = 0;
+    uint32_t bitmask = bitmask_init;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
+        a8_map[i] = letter_px ? bpp_opa_table_p[letter_px] : 0;
+
+        if(col_bit < col_bit_max) {
+            col_bit += bpp;
+            bitmask = bitmask >> bpp;
+        }
+        else {
+            col_bit = 0;
+            bitmask = bitmask_init;
+            map_p++;
+        }
+    }
+
+    lv_lru_set(cache, &key, sizeof(key), a8_map, px_cnt);
+    LV_MEM_TAG_END();
+    glyph_cache_stat.miss_cnt++;
+    return a8_map;
+}
+#endif /*LV_GLYPH_CACHE_SIZE*/
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p)
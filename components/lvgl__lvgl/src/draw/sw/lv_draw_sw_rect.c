@@ -19,11 +19,28 @@
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
+#define CORNER_CACHE_MAX_SIZE   12
 
+#if LV_DRAW_COMPLEX && defined(LV_CORNER_CACHE_SIZE) && LV_CORNER_CACHE_SIZE > 0
+    #define CORNER_CACHE        1
+#else
+    #define CORNER_CACHE        0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if CORNER_CACHE
+/*The 4 corners of a rounded rectangle or border, i.e. the corners of a (2*size)x(2*size) rectangle*/
+typedef struct {
+    lv_coord_t rout;
+    lv_coord_t rin;
+    lv_coord_t border_width;    /*0: filled rectangle*/
+    lv_coord_t size;            /*Width and height of a corner*/
+    uint32_t last_used;
+    lv_opa_t mask[(2 * CORNER_CACHE_MAX_SIZE) * (2 * CORNER_CACHE_MAX_SIZE)];
+} corner_cache_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -48,6 +65,11 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
 static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
                                lv_color_t color, lv_opa_t opa);
 
+#if CORNER_CACHE
+static bool draw_small_radius(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, lv_coord_t rout, lv_coord_t rin,
+                              lv_coord_t border_width, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
+static const lv_opa_t * corner_cache_get(lv_coord_t rout, lv_coord_t rin, lv_coord_t border_width, lv_coord_t size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -58,6 +80,11 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
     static int32_t sh_cache_r = -1;
 #endif
 
+#if CORNER_CACHE
+    static corner_cache_entry_t corner_cache[LV_CORNER_CACHE_SIZE];
+    static uint32_t corner_cache_use_cnt;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -144,6 +171,14 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     int32_t short_side = LV_MIN(coords_bg_w, coords_bg_h);
     int32_t rout = LV_MIN(dsc->radius, short_side >> 1);
 
+#if CORNER_CACHE
+    /*Small radius without gradient: cached corners and plain fills, no masks needed*/
+    if(!mask_any && grad_dir == LV_GRAD_DIR_NONE &&
+       draw_small_radius(draw_ctx, &bg_coords, rout, 0, 0, bg_color, opa, dsc->blend_mode)) {
+        return;
+    }
+#endif
+
     /*Add a radius mask if there is radius*/
     int32_t clipped_w = lv_area_get_width(&clipped_coords);
     int16_t mask_rout_id = LV_MASK_ID_INV;
@@ -1166,6 +1201,18 @@ void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area,
         return;
     }
 
+#if CORNER_CACHE
+    /*Thin borders with small radius can be drawn from cached corners if the width is the same on each side*/
+    lv_coord_t border_width = inner_area->x1 - outer_area->x1;
+    if(!mask_any && border_width > 0 &&
+       inner_area->y1 - outer_area->y1 == border_width &&
+       outer_area->x2 - inner_area->x2 == border_width &&
+       outer_area->y2 - inner_area->y2 == border_width &&
+       draw_small_radius(draw_ctx, outer_area, rout, rin, border_width, color, opa, blend_mode)) {
+        return;
+    }
+#endif
+
     /*Get clipped draw area which is the real draw area.
      *It is always the same or inside `coords`*/
     lv_area_t draw_area;
@@ -1434,3 +1481,214 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
     }
 }
 
+#if CORNER_CACHE
+/**
+ * Draw a rectangle or border with small radius from the cached corners and plain fills.
+ * The result is the same as with the radius masks.
+ * @param draw_ctx      pointer to the draw context
+ * @param outer_area    the outer area of the rectangle or border
+ * @param rout          the radius of the outer area
+ * @param rin           the radius of the inner area. Not used if `border_width == 0`
+ * @param border_width  width of the border on each side or 0 for a filled rectangle
+ * @param color         the color
+ * @param opa           the opacity
+ * @param blend_mode    the blend mode
+ * @return              true: the rectangle is drawn; false: the corners are too large or overlap
+ */
+static bool draw_small_radius(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, lv_coord_t rout, lv_coord_t rin,
+                              lv_coord_t border_width, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode)
+{
+    lv_coord_t size = LV_MAX(rout, border_width);
+    if(rout <= 0 || size > CORNER_CACHE_MAX_SIZE) return false;
+    if(border_width && border_width + rin > size) return false;
+
+    lv_coord_t w = lv_area_get_width(outer_area);
+    lv_coord_t h = lv_area_get_height(outer_area);
+    if(w <= 2 * size || h <= 2 * size) return false;
+
+    /*The blending would modify the mask to remove anti-aliasing*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->antialiasing == 0) return false;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, outer_area, draw_ctx->clip_area)) return true;
+
+    const lv_opa_t * corner_mask = corner_cache_get(rout, rin, border_width, size);
+    if(corner_mask == NULL) return false;
+
+    lv_area_t blend_area;
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = &blend_area;
+    blend_dsc.color = color;
+    blend_dsc.opa = opa;
+    blend_dsc.blend_mode = blend_mode;
+
+    /*Straight parts*/
+    if(border_width == 0) {
+        blend_area.x1 = outer_area->x1 + size;
+        blend_area.x2 = outer_area->x2 - size;
+        blend_area.y1 = outer_area->y1;
+        blend_area.y2 = outer_area->y2;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+        blend_area.x1 = outer_area->x1;
+        blend_area.x2 = outer_area->x1 + size - 1;
+        blend_area.y1 = outer_area->y1 + size;
+        blend_area.y2 = outer_area->y2 - size;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+        blend_area.x1 = outer_area->x2 - size + 1;
+        blend_area.x2 = outer_area->x2;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+    else {
+        blend_area.x1 = outer_area->x1 + size;
+        blend_area.x2 = outer_area->x2 - size;
+        blend_area.y1 = outer_area->y1;
+        blend_area.y2 = outer_area->y1 + border_width - 1;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+        blend_area.y1 = outer_area->y2 - border_width + 1;
+        blend_area.y2 = outer_area->y2;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+        blend_area.x1 = outer_area->x1;
+        blend_area.x2 = outer_area->x1 + border_width - 1;
+        blend_area.y1 = outer_area->y1 + size;
+        blend_area.y2 = outer_area->y2 - size;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+        blend_area.x1 = outer_area->x2 - border_width + 1;
+        blend_area.x2 = outer_area->x2;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+
+    /*The background's opacity is applied on the mask as the radius mask does it*/
+    lv_coord_t mask_size = 4 * size * size;
+    lv_opa_t * opa_mask = NULL;
+    if(border_width == 0 && opa < LV_OPA_COVER) {
+        opa_mask = lv_mem_buf_get(mask_size);
+        lv_coord_t i;
+        for(i = 0; i < mask_size; i++) {
+            opa_mask[i] = LV_UDIV255(corner_mask[i] * opa);
+        }
+        corner_mask = opa_mask;
+        blend_dsc.opa = LV_OPA_COVER;
+    }
+
+    /*Corners. The mask is a (2*size)x(2*size) rectangle aligned to the corner to draw*/
+    lv_area_t mask_area;
+    blend_dsc.mask_buf = (lv_opa_t *)corner_mask;
+    blend_dsc.mask_area = &mask_area;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        if(i & 1) {
+            blend_area.x1 = outer_area->x2 - size + 1;
+            mask_area.x1 = outer_area->x2 - 2 * size + 1;
+        }
+        else {
+            blend_area.x1 = outer_area->x1;
+            mask_area.x1 = outer_area->x1;
+        }
+        if(i & 2) {
+            blend_area.y1 = outer_area->y2 - size + 1;
+            mask_area.y1 = outer_area->y2 - 2 * size + 1;
+        }
+        else {
+            blend_area.y1 = outer_area->y1;
+            mask_area.y1 = outer_area->y1;
+        }
+        blend_area.x2 = blend_area.x1 + size - 1;
+        blend_area.y2 = blend_area.y1 + size - 1;
+        mask_area.x2 = mask_area.x1 + 2 * size - 1;
+        mask_area.y2 = mask_area.y1 + 2 * size - 1;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+
+    if(opa_mask) lv_mem_buf_release(opa_mask);
+
+    return true;
+}
+
+/**
+ * Get the corners of a rectangle or border from the cache or calculate them with the radius masks.
+ * @param rout          the outer radius
+ * @param rin           the inner radius. Not used if `border_width == 0`
+ * @param border_width  width of the border or 0 for a filled rectangle
+ * @param size          width and height of a corner
+ * @return              the corners as a (2*size)x(2*size) mask
+ */
+static const lv_opa_t * corner_cache_get(lv_coord_t rout, lv_coord_t rin, lv_coord_t border_width, lv_coord_t size)
+{
+    if(border_width == 0) rin = 0;
+
+    corner_cache_use_cnt++;
+
+    /*Find the corners or the least recently used entry*/
+    corner_cache_entry_t * entry = &corner_cache[0];
+    uint32_t i;
+    for(i = 0; i < LV_CORNER_CACHE_SIZE; i++) {
+        corner_cache_entry_t * e = &corner_cache[i];
+        if(e->size == size && e->rout == rout && e->rin == rin && e->border_width == border_width) {
+            e->last_used = corner_cache_use_cnt;
+            return e->mask;
+        }
+        if(e->last_used < entry->last_used) entry = e;
+    }
+
+    /*Apply the masks on a rectangle where the corners don't overlap and keep only the corners*/
+    lv_coord_t full_size = 2 * size + 2;
+    lv_area_t outer_area;
+    outer_area.x1 = 0;
+    outer_area.y1 = 0;
+    outer_area.x2 = full_size - 1;
+    outer_area.y2 = full_size - 1;
+
+    lv_draw_mask_radius_param_t mask_rout_param;
+    lv_draw_mask_radius_param_t mask_rin_param;
+    lv_draw_mask_radius_init(&mask_rout_param, &outer_area, rout, false);
+    if(border_width) {
+        lv_area_t inner_area;
+        inner_area.x1 = border_width;
+        inner_area.y1 = border_width;
+        inner_area.x2 = full_size - 1 - border_width;
+        inner_area.y2 = full_size - 1 - border_width;
+        lv_draw_mask_radius_init(&mask_rin_param, &inner_area, rin, true);
+    }
+
+    lv_opa_t * line_buf = lv_mem_buf_get(full_size);
+    lv_opa_t * mask = entry->mask;
+    lv_coord_t y;
+    for(y = 0; y < full_size; y++) {
+        if(y >= size && y < full_size - size) continue;
+
+        /*Apply the masks in the same order as the generic drawing would do*/
+        lv_memset_ff(line_buf, full_size);
+        lv_draw_mask_res_t res;
+        res = mask_rout_param.dsc.cb(line_buf, 0, y, full_size, &mask_rout_param);
+        if(res != LV_DRAW_MASK_RES_TRANSP && border_width) {
+            res = mask_rin_param.dsc.cb(line_buf, 0, y, full_size, &mask_rin_param);
+        }
+        if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(line_buf, full_size);
+
+        lv_memcpy(mask, line_buf, size);
+        lv_memcpy(mask + size, line_buf + full_size - size, size);
+        mask += 2 * size;
+    }
+    lv_mem_buf_release(line_buf);
+
+    lv_draw_mask_free_param(&mask_rout_param);
+    if(border_width) lv_draw_mask_free_param(&mask_rin_param);
+
+    entry->rout = rout;
+    entry->rin = rin;
+    entry->border_width = border_width;
+    entry->size = size;
+    entry->last_used = corner_cache_use_cnt;
+
+    return entry->mask;
+}
+#endif /*CORNER_CACHE*/
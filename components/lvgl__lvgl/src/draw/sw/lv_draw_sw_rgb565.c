@@ -0,0 +1,236 @@
+/**
+ * @file lv_draw_sw_rgb565.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_rgb565.h"
+#include "../../misc/lv_math.h"
+
+#if LV_DRAW_SW_RGB565_SWAR
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_BIG_ENDIAN_SYSTEM
+    #define FIRST_PX_SHIFT      16
+    #define SECOND_PX_SHIFT     0
+#else
+    #define FIRST_PX_SHIFT      0
+    #define SECOND_PX_SHIFT     16
+#endif
+
+/*Get the pixels of a 32 bit word which starts at a 2 byte offset from two aligned words*/
+#define FUNNEL(prev, next)  (((prev) >> SECOND_PX_SHIFT << FIRST_PX_SHIFT) | ((next) >> FIRST_PX_SHIFT << SECOND_PX_SHIFT))
+
+/*Two 16 bit lanes of a word divided by 255. The same as LV_UDIV255 for the values which can occur here*/
+#define UDIV255_X2(x)       ((((x) + 0x00010001 + (((x) >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF)
+
+/*The red and blue channels of a pixel in the low and high lanes*/
+#define RB_X2(c)            (((uint32_t)(c) >> 11) | (((uint32_t)(c) & 0x1F) << 16))
+
+/*The green channels of two pixels in the low and high lanes*/
+#define G_X2(c0, c1)        ((((uint32_t)(c0) >> 5) & 0x3F) | ((((uint32_t)(c1) >> 5) & 0x3F) << 16))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static inline uint16_t mix_px(uint16_t fg, uint16_t bg, lv_opa_t mix);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void LV_ATTRIBUTE_FAST_MEM _lv_draw_sw_rgb565_fill(uint16_t * dest, uint16_t color, int32_t px_cnt)
+{
+    if(px_cnt <= 0) return;
+
+    if((lv_uintptr_t)dest & 0x2) {
+        *dest = color;
+        dest++;
+        px_cnt--;
+    }
+
+    uint32_t c32 = (uint32_t)color | ((uint32_t)color << 16);
+    uint32_t * d32 = (uint32_t *)dest;
+    while(px_cnt >= 16) {
+        d32[0] = c32;
+        d32[1] = c32;
+        d32[2] = c32;
+        d32[3] = c32;
+        d32[4] = c32;
+        d32[5] = c32;
+        d32[6] = c32;
+        d32[7] = c32;
+        d32 += 8;
+        px_cnt -= 16;
+    }
+
+    while(px_cnt >= 2) {
+        *d32 = c32;
+        d32++;
+        px_cnt -= 2;
+    }
+
+    if(px_cnt) *((uint16_t *)d32) = color;
+}
+
+void LV_ATTRIBUTE_FAST_MEM _lv_draw_sw_rgb565_copy(uint16_t * dest, const uint16_t * src, int32_t px_cnt)
+{
+    if(px_cnt <= 0) return;
+
+    /*Make the destination aligned*/
+    if((lv_uintptr_t)dest & 0x2) {
+        *dest = *src;
+        dest++;
+        src++;
+        px_cnt--;
+    }
+
+    uint32_t * d32 = (uint32_t *)dest;
+
+    /*Both aligned: just copy words*/
+    if(((lv_uintptr_t)src & 0x2) == 0) {
+        const uint32_t * s32 = (const uint32_t *)src;
+        while(px_cnt >= 8) {
+            d32[0] = s32[0];
+            d32[1] = s32[1];
+            d32[2] = s32[2];
+            d32[3] = s32[3];
+            d32 += 4;
+            s32 += 4;
+            px_cnt -= 8;
+        }
+
+        while(px_cnt >= 2) {
+            *d32 = *s32;
+            d32++;
+            s32++;
+            px_cnt -= 2;
+        }
+        src = (const uint16_t *)s32;
+    }
+    /*The source is at a 2 byte offset: combine the halves of two aligned words.
+     *Don't read outside of `src` even if it were in the same word*/
+    else if(px_cnt >= 3) {
+        uint32_t prev = (uint32_t)src[0] << SECOND_PX_SHIFT;
+        const uint32_t * s32 = (const uint32_t *)(src + 1);
+        while(px_cnt >= 9) {
+            uint32_t next0 = s32[0];
+            uint32_t next1 = s32[1];
+            uint32_t next2 = s32[2];
+            uint32_t next3 = s32[3];
+            d32[0] = FUNNEL(prev, next0);
+            d32[1] = FUNNEL(next0, next1);
+            d32[2] = FUNNEL(next1, next2);
+            d32[3] = FUNNEL(next2, next3);
+            prev = next3;
+            d32 += 4;
+            s32 += 4;
+            px_cnt -= 8;
+        }
+
+        while(px_cnt >= 3) {
+            uint32_t next = *s32;
+            *d32 = FUNNEL(prev, next);
+            prev = next;
+            d32++;
+            s32++;
+            px_cnt -= 2;
+        }
+        src = (const uint16_t *)s32 - 1;
+    }
+
+    dest = (uint16_t *)d32;
+    while(px_cnt) {
+        *dest = *src;
+        dest++;
+        src++;
+        px_cnt--;
+    }
+}
+
+void LV_ATTRIBUTE_FAST_MEM _lv_draw_sw_rgb565_mix(uint16_t * dest, const uint16_t * src, int32_t px_cnt,
+                                                  lv_opa_t opa)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    /*The optimized mixing of lv_color_mix already handles the 3 channels in one word*/
+    int32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        dest[i] = mix_px(src[i], dest[i], opa);
+    }
+#else
+    /* Each channel is `(fg * opa + bg * (255 - opa) + LV_COLOR_MIX_ROUND_OFS) / 255` as in lv_color_mix.
+     * The values fit into 16 bit (max. 63 * 255 + 255) so 2 channels are calculated in one 32 bit word:
+     * red and blue of a pixel in one word and the green of 2 pixels in an other word.*/
+    uint32_t opa_inv = 255 - opa;
+    uint32_t round_ofs = LV_COLOR_MIX_ROUND_OFS | ((uint32_t)LV_COLOR_MIX_ROUND_OFS << 16);
+
+    while(px_cnt >= 2) {
+        uint32_t fg0 = src[0];
+        uint32_t fg1 = src[1];
+        uint32_t bg0 = dest[0];
+        uint32_t bg1 = dest[1];
+
+        uint32_t rb0 = RB_X2(fg0) * opa + RB_X2(bg0) * opa_inv + round_ofs;
+        uint32_t rb1 = RB_X2(fg1) * opa + RB_X2(bg1) * opa_inv + round_ofs;
+        uint32_t g = G_X2(fg0, fg1) * opa + G_X2(bg0, bg1) * opa_inv + round_ofs;
+        rb0 = UDIV255_X2(rb0);
+        rb1 = UDIV255_X2(rb1);
+        g = UDIV255_X2(g);
+
+        dest[0] = (uint16_t)((rb0 << 11) | ((g & 0x3F) << 5) | (rb0 >> 16));
+        dest[1] = (uint16_t)((rb1 << 11) | ((g >> 16) << 5) | (rb1 >> 16));
+
+        dest += 2;
+        src += 2;
+        px_cnt -= 2;
+    }
+
+    if(px_cnt) *dest = mix_px(*src, *dest, opa);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix two RGB565 colors exactly as `lv_color_mix` does with 16 bit color depth.
+ * @param fg        the foreground color
+ * @param bg        the background color
+ * @param mix       the ratio of the colors. 0: full `bg`, 255: full `fg`
+ * @return          the mixed color
+ */
+static inline uint16_t mix_px(uint16_t fg, uint16_t bg, lv_opa_t mix)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    mix = (uint32_t)((uint32_t)mix + 4) >> 3;
+    uint32_t bg32 = ((uint32_t)bg | ((uint32_t)bg << 16)) & 0x7E0F81F;
+    uint32_t fg32 = ((uint32_t)fg | ((uint32_t)fg << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg32 - bg32) * mix) >> 5) + bg32) & 0x7E0F81F;
+    return (uint16_t)((result >> 16) | result);
+#else
+    uint32_t mix_inv = 255 - mix;
+    uint32_t r = LV_UDIV255((fg >> 11) * mix + (bg >> 11) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    uint32_t g = LV_UDIV255(((fg >> 5) & 0x3F) * mix + ((bg >> 5) & 0x3F) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    uint32_t b = LV_UDIV255((fg & 0x1F) * mix + (bg & 0x1F) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+#endif
+}
+
+#endif /*LV_DRAW_SW_RGB565_SWAR*/
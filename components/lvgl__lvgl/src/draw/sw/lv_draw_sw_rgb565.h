@@ -0,0 +1,69 @@
+/**
+ * @file lv_draw_sw_rgb565.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_RGB565_H
+#define LV_DRAW_SW_RGB565_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+
+#if LV_DRAW_SW_RGB565_SWAR
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill RGB565 pixels with a color using 32 bit stores.
+ * @param dest      pointer to the first pixel (needs to be 2 byte aligned)
+ * @param color     the color in RGB565 format
+ * @param px_cnt    number of pixels to fill
+ */
+void /* LV_ATTRIBUTE_FAST_MEM */ _lv_draw_sw_rgb565_fill(uint16_t * dest, uint16_t color, int32_t px_cnt);
+
+/**
+ * Copy RGB565 pixels using 32 bit loads and stores, even if `dest` and `src` are not aligned the same way.
+ * @param dest      pointer to the first destination pixel (needs to be 2 byte aligned)
+ * @param src       pointer to the first source pixel (needs to be 2 byte aligned)
+ * @param px_cnt    number of pixels to copy
+ */
+void /* LV_ATTRIBUTE_FAST_MEM */ _lv_draw_sw_rgb565_copy(uint16_t * dest, const uint16_t * src, int32_t px_cnt);
+
+/**
+ * Mix RGB565 pixels onto others with an opacity. The result is the same as `lv_color_mix(src, dest, opa)`
+ * with 16 bit color depth, but 2 color channels are calculated at once in a 32 bit word.
+ * @param dest      pointer to the first destination pixel (needs to be 2 byte aligned)
+ * @param src       pointer to the first source pixel (needs to be 2 byte aligned)
+ * @param px_cnt    number of pixels to mix
+ * @param opa       the opacity of `src`
+ */
+void /* LV_ATTRIBUTE_FAST_MEM */ _lv_draw_sw_rgb565_mix(uint16_t * dest, const uint16_t * src, int32_t px_cnt,
+                                                        lv_opa_t opa);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_DRAW_SW_RGB565_SWAR*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_RGB565_H*/
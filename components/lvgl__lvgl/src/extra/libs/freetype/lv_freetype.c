@@ -9,6 +9,8 @@
 #include "lv_freetype.h"
 #if LV_USE_FREETYPE
 
+#include "../../../draw/sw/lv_draw_sw.h"
+
 #include "ft2build.h"
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
@@ -169,6 +171,9 @@ bool lv_ft_font_init(lv_ft_info_t * info)
 
 void lv_ft_font_destroy(lv_font_t * font)
 {
+    lv_txt_size_cache_clear();
+    lv_draw_sw_glyph_cache_clear();
+
 #if LV_FREETYPE_CACHE_SIZE >= 0
     lv_ft_font_destroy_cache(font);
 #else
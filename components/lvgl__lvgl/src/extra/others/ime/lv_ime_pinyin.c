@@ -47,6 +47,7 @@ static void pinyin_ime_clear_data(lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_ime_pinyin_class = {
+    .name = "ime_pinyin",
     .constructor_cb = lv_ime_pinyin_constructor,
     .destructor_cb  = lv_ime_pinyin_destructor,
     .width_def      = LV_SIZE_CONTENT,
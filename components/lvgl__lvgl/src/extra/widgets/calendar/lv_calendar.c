@@ -39,6 +39,7 @@ static void highlight_update(lv_obj_t * calendar);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_calendar_class = {
+    .name = "calendar",
     .constructor_cb = lv_calendar_constructor,
     .width_def = (LV_DPI_DEF * 3) / 2,
     .height_def = (LV_DPI_DEF * 3) / 2,
@@ -47,6 +47,7 @@ lv_chart_tick_dsc_t * get_tick_gsc(lv_obj_t * obj, lv_chart_axis_t axis);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_chart_class = {
+    .name = "chart",
     .constructor_cb = lv_chart_constructor,
     .destructor_cb = lv_chart_destructor,
     .event_cb = lv_chart_event,
@@ -38,6 +38,7 @@ static void lv_keyboard_update_ctrl_map(lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_keyboard_class = {
+    .name = "keyboard",
     .constructor_cb = lv_keyboard_constructor,
     .width_def = LV_PCT(100),
     .height_def = LV_PCT(50),
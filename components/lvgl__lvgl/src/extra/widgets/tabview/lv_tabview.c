@@ -33,6 +33,7 @@ static void cont_scroll_end_event_cb(lv_event_t * e);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_tabview_class = {
+    .name = "tabview",
     .constructor_cb = lv_tabview_constructor,
     .destructor_cb = lv_tabview_destructor,
     .event_cb = lv_tabview_event,
@@ -28,6 +28,9 @@ extern "C" {
 /* imgfont identifier */
 #define LV_IMGFONT_BPP 9
 
+/* Run-length encoded glyph of an `lv_font_fmt_txt` font (`LV_FONT_FMT_TXT_RLE`) */
+#define LV_FONT_RLE_BPP 10
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -14,6 +14,8 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
+#include "../misc/lv_math.h"
+#include "../misc/lv_color.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +38,7 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
+static inline void rle_fetch(lv_font_fmt_txt_rle_t * rle);
 
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
@@ -49,6 +52,9 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Opacity of the 3 bit levels of LV_FONT_FMT_TXT_RLE*/
+static const uint8_t rle_opa_table[8] = {0, 36, 73, 109, 146, 182, 219, 255};
+
 #if LV_USE_FONT_COMPRESSED
     static uint32_t rle_rdp;
     static const uint8_t * rle_in;
@@ -86,7 +92,8 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
 
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
-    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+    /*Run-length encoded glyphs are decoded while drawing*/
+    if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN || fdsc->bitmap_format == LV_FONT_FMT_TXT_RLE) {
         return &fdsc->glyph_bitmap[gdsc->bitmap_index];
     }
     /*Handle compressed bitmap*/
@@ -181,7 +188,7 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->box_w = gdsc->box_w;
     dsc_out->ofs_x = gdsc->ofs_x;
     dsc_out->ofs_y = gdsc->ofs_y;
-    dsc_out->bpp   = (uint8_t)fdsc->bpp;
+    dsc_out->bpp   = fdsc->bitmap_format == LV_FONT_FMT_TXT_RLE ? LV_FONT_RLE_BPP : (uint8_t)fdsc->bpp;
     dsc_out->is_placeholder = false;
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
@@ -202,10 +209,92 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+void _lv_font_fmt_txt_rle_init(lv_font_fmt_txt_rle_t * rle, const uint8_t * bitmap)
+{
+    rle->data = bitmap;
+    rle->cnt = 0;
+    rle->level = 0;
+    rle->pair = 0;
+}
+
+void LV_ATTRIBUTE_FAST_MEM _lv_font_fmt_txt_rle_skip(lv_font_fmt_txt_rle_t * rle, uint32_t px_cnt)
+{
+    uint8_t level;
+    while(px_cnt) {
+        px_cnt -= _lv_font_fmt_txt_rle_get_run(rle, px_cnt, &level);
+    }
+}
+
+uint32_t LV_ATTRIBUTE_FAST_MEM _lv_font_fmt_txt_rle_get_run(lv_font_fmt_txt_rle_t * rle, uint32_t max_cnt,
+                                                             uint8_t * level)
+{
+    if(rle->cnt == 0) rle_fetch(rle);
+    uint32_t n = LV_MIN(max_cnt, rle->cnt);
+    rle->cnt -= n;
+    *level = rle->level;
+    return n;
+}
+
+void LV_ATTRIBUTE_FAST_MEM _lv_font_fmt_txt_rle_read(lv_font_fmt_txt_rle_t * rle, uint8_t * buf, uint32_t px_cnt)
+{
+    uint8_t level;
+    while(px_cnt) {
+        uint32_t n = _lv_font_fmt_txt_rle_get_run(rle, px_cnt, &level);
+        lv_opa_t opa = rle_opa_table[level];
+        /*Most runs are short edges, don't call memset for them*/
+        if(n < 8) {
+            uint32_t i;
+            for(i = 0; i < n; i++) buf[i] = opa;
+        }
+        else {
+            lv_memset(buf, opa, n);
+        }
+        buf += n;
+        px_cnt -= n;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Decode the next run of an `LV_FONT_FMT_TXT_RLE` stream
+ * @param rle       decoder state
+ */
+static inline void rle_fetch(lv_font_fmt_txt_rle_t * rle)
+{
+    /*The second pixel of a pair*/
+    if(rle->pair) {
+        rle->level = rle->pair - 1;
+        rle->cnt = 1;
+        rle->pair = 0;
+        return;
+    }
+
+    uint8_t v = *rle->data;
+    rle->data++;
+    switch(v >> 6) {
+        case 0:
+            rle->level = 0;
+            rle->cnt = (v & 0x3F) + 1;
+            break;
+        case 1:
+            rle->level = 7;
+            rle->cnt = (v & 0x3F) + 1;
+            break;
+        case 2:
+            rle->level = (v >> 3) & 0x7;
+            rle->cnt = 1;
+            rle->pair = (v & 0x7) + 1;
+            break;
+        default:
+            rle->level = (v >> 3) & 0x7;
+            rle->cnt = (v & 0x7) + 1;
+            break;
+    }
+}
+
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
@@ -220,7 +309,7 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -149,6 +149,16 @@ typedef enum {
     LV_FONT_FMT_TXT_PLAIN      = 0,
     LV_FONT_FMT_TXT_COMPRESSED = 1,
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
+    /**
+     * Byte oriented run-length encoding of 3 bpp glyphs, decoded while drawing.
+     * The pixels of a glyph are one stream (the rows are not byte aligned):
+     * - `00nnnnnn`: n + 1 transparent pixels
+     * - `01nnnnnn`: n + 1 fully opaque pixels
+     * - `10aaabbb`: a pixel of level `a` and a pixel of level `b`
+     * - `11aaannn`: n + 1 pixels of level `a`
+     * The glyph descriptors get `LV_FONT_RLE_BPP` as bpp.
+     */
+    LV_FONT_FMT_TXT_RLE = 3,
 } lv_font_fmt_txt_bitmap_format_t;
 
 typedef struct {
@@ -156,6 +166,14 @@ typedef struct {
     uint32_t last_glyph_id;
 } lv_font_fmt_txt_glyph_cache_t;
 
+/** State of reading an `LV_FONT_FMT_TXT_RLE` glyph bitmap*/
+typedef struct {
+    const uint8_t * data;   /**< The next byte to decode*/
+    uint8_t cnt;            /**< Remaining pixels of the current run*/
+    uint8_t level;          /**< Level (0..7) of the current run*/
+    uint8_t pair;           /**< 1 + level of the 2nd pixel of a `10aaabbb` byte if not read yet*/
+} lv_font_fmt_txt_rle_t;
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -225,6 +243,37 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Start reading an `LV_FONT_FMT_TXT_RLE` glyph bitmap
+ * @param rle       decoder state to initialize
+ * @param bitmap    the glyph's bitmap returned by `lv_font_get_glyph_bitmap()`
+ */
+void _lv_font_fmt_txt_rle_init(lv_font_fmt_txt_rle_t * rle, const uint8_t * bitmap);
+
+/**
+ * Step over pixels of an `LV_FONT_FMT_TXT_RLE` glyph
+ * @param rle       decoder state
+ * @param px_cnt    number of pixels to skip
+ */
+void _lv_font_fmt_txt_rle_skip(lv_font_fmt_txt_rle_t * rle, uint32_t px_cnt);
+
+/**
+ * Get the next pixels of an `LV_FONT_FMT_TXT_RLE` glyph which have the same level
+ * @param rle       decoder state
+ * @param max_cnt   return at most this many pixels (> 0)
+ * @param level     store the level of the pixels here: 0 (transparent) .. 7 (opaque)
+ * @return          number of pixels in the run, 1..`max_cnt`
+ */
+uint32_t _lv_font_fmt_txt_rle_get_run(lv_font_fmt_txt_rle_t * rle, uint32_t max_cnt, uint8_t * level);
+
+/**
+ * Read the opacity of the next pixels of an `LV_FONT_FMT_TXT_RLE` glyph
+ * @param rle       decoder state
+ * @param buf       store `px_cnt` opacity values here
+ * @param px_cnt    number of pixels to read
+ */
+void _lv_font_fmt_txt_rle_read(lv_font_fmt_txt_rle_t * rle, uint8_t * buf, uint32_t px_cnt);
+
 /**********************
  *      MACROS
  **********************/
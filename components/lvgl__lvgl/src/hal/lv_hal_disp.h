@@ -137,6 +137,19 @@ typedef struct _lv_disp_drv_t {
     /** OPTIONAL: called when start rendering */
     void (*render_start_cb)(struct _lv_disp_drv_t * disp_drv);
 
+    /** OPTIONAL: Decide whether two invalidated areas should be refreshed as one area.
+     * `joined` is the smallest area containing `area1` and `area2`. Return `true` to refresh `joined` instead.
+     * If not set `lv_refr_join_by_cost()` is used.*/
+    bool (*join_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area1, const lv_area_t * area2,
+                    const lv_area_t * joined);
+
+    /** Cost of a `flush_cb` call (e.g. sending the window commands on SPI) in the unit of `px_cost`.
+     * 0: join only overlapping areas and only if the joined area is smaller than the two areas together*/
+    uint32_t flush_cost;
+
+    /** Cost of rendering and flushing one pixel*/
+    uint32_t px_cost;
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_CHROMA_KEY` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
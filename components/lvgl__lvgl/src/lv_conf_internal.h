@@ -207,6 +207,16 @@
     #endif
 #endif
 
+/*Count the allocations and bytes per tag (object class, style, timer, etc). See `lv_mem_get_tag_stat()`.
+ *Adds a pointer sized header to every allocation*/
+#ifndef LV_MEM_ACCOUNTING
+    #ifdef CONFIG_LV_MEM_ACCOUNTING
+        #define LV_MEM_ACCOUNTING CONFIG_LV_MEM_ACCOUNTING
+    #else
+        #define LV_MEM_ACCOUNTING 0
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -313,6 +323,18 @@
             #define LV_CIRCLE_CACHE_SIZE 4
         #endif
     #endif
+
+    /* Set number of maximally cached rounded corners.
+    * The corners of rectangles and borders with small radius (max. 12 px) are saved per radius and border width
+    * to draw them without radius masks. 576 bytes are used per corner.
+    * 0: to disable caching */
+    #ifndef LV_CORNER_CACHE_SIZE
+        #ifdef CONFIG_LV_CORNER_CACHE_SIZE
+            #define LV_CORNER_CACHE_SIZE CONFIG_LV_CORNER_CACHE_SIZE
+        #else
+            #define LV_CORNER_CACHE_SIZE 0
+        #endif
+    #endif
 #endif /*LV_DRAW_COMPLEX*/
 
 /**
@@ -356,6 +378,19 @@
     #endif
 #endif
 
+/*Number of cached resolved style properties.
+ *`lv_obj_get_style_prop()` walks the object's styles (and the parents for inherited properties) on every call.
+ *The cache remembers the result per object, part, property and state and is dropped on any style change.
+ *Must be a power of 2. It adds 16 bytes per entry on 32 bit systems.
+ *0: to disable caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -412,6 +447,17 @@
     #endif
 #endif
 
+/*Fill, copy and mix RGB565 pixels in 32 bit words (2 color channels at once).
+ *Faster on 32 bit CPUs without SIMD instructions (e.g. RISC-V RV32IMAC).
+ *Used with LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 0*/
+#ifndef LV_DRAW_SW_RGB565_SWAR
+    #ifdef CONFIG_LV_DRAW_SW_RGB565_SWAR
+        #define LV_DRAW_SW_RGB565_SWAR CONFIG_LV_DRAW_SW_RGB565_SWAR
+    #else
+        #define LV_DRAW_SW_RGB565_SWAR 0
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -1261,6 +1307,16 @@
     #endif
 #endif
 
+/*Size of the cache of the expanded (A8) glyph masks in bytes. 0 to disable caching.
+ *Frequently drawn glyphs (e.g. numbers) don't need to be expanded from 1, 2, 4 bpp on every frame.*/
+#ifndef LV_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_GLYPH_CACHE_SIZE
+        #define LV_GLYPH_CACHE_SIZE CONFIG_LV_GLYPH_CACHE_SIZE
+    #else
+        #define LV_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -1327,6 +1383,16 @@
     #endif
 #endif
 
+/*Number of cached `lv_txt_get_size()` results (keyed on font, text, max. width and flags). 0 to disable caching.
+ *Every entry stores a copy of the text, texts longer than 32 bytes are not cached.*/
+#ifndef LV_TXT_SIZE_CACHE_SIZE
+    #ifdef CONFIG_LV_TXT_SIZE_CACHE_SIZE
+        #define LV_TXT_SIZE_CACHE_SIZE CONFIG_LV_TXT_SIZE_CACHE_SIZE
+    #else
+        #define LV_TXT_SIZE_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -41,6 +41,15 @@ extern "C" {
 #  define CONFIG_LV_MEM_SIZE (CONFIG_LV_MEM_SIZE_KILOBYTES * 1024U)
 #endif
 
+/*******************
+ * LV_TICK_CUSTOM
+ *******************/
+
+/*Kconfig only provides the header; on ESP-IDF read the tick from esp_timer*/
+#if defined(ESP_PLATFORM) && defined(CONFIG_LV_TICK_CUSTOM) && !defined(CONFIG_LV_TICK_CUSTOM_SYS_TIME_EXPR)
+#  define CONFIG_LV_TICK_CUSTOM_SYS_TIME_EXPR ((uint32_t)(esp_timer_get_time() / 1000LL))
+#endif
+
 /*------------------
  * MONITOR POSITION
  *-----------------*/
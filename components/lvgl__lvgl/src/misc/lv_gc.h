@@ -21,6 +21,7 @@ extern "C" {
 #include "lv_types.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
+#include "lv_txt.h"
 #include "../core/lv_obj_pos.h"
 
 /*********************
@@ -32,6 +33,12 @@ extern "C" {
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_TXT_SIZE_CACHE_SIZE
+#    define LV_TXT_SIZE_CACHE_DEF       1
+#else
+#    define LV_TXT_SIZE_CACHE_DEF       0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -60,6 +67,8 @@ extern "C" {
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
     LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
     LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
+    LV_DISPATCH_COND(f, _lv_txt_size_cache_arr_t, _lv_txt_size_cache, LV_TXT_SIZE_CACHE_DEF, 1)         \
+    LV_DISPATCH(f, void * , _lv_glyph_cache)                                                           \
     LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
@@ -39,6 +39,16 @@
 
 #define ZERO_MEM_SENTINEL  0xa1b2c3d4
 
+#if LV_MEM_ACCOUNTING
+    /*Every allocation starts with a header storing the tag index in the lower bits and the requested size above it.
+     *It's pointer sized to keep the alignment of the allocator*/
+    #define ACC_HDR_SIZE    sizeof(void *)
+    #define ACC_TAG_BITS    8
+    #define ACC_TAG_MASK    ((1 << ACC_TAG_BITS) - 1)
+    #define ACC_SIZE_MAX    (UINT32_MAX >> ACC_TAG_BITS)
+    #define ACC_TAG_MAX     32
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -49,6 +59,13 @@
 #if LV_MEM_CUSTOM == 0
     static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
 #endif
+#if LV_MEM_ACCOUNTING
+    static void * acc_hdr_set(void * p, uint32_t tag, size_t size);
+    static void * acc_hdr_get(void * data, uint32_t * tag, size_t * size);
+    static void acc_add(uint32_t tag, size_t size);
+    static void acc_remove(uint32_t tag, size_t size);
+    static uint32_t acc_tag_find(const char * tag);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -61,6 +78,14 @@
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_MEM_ACCOUNTING
+    static lv_mem_tag_stat_t acc_tags[ACC_TAG_MAX] = {{.name = "other"}};
+    static uint32_t acc_tag_cnt = 1;
+    static uint32_t acc_tag_act;     /*Index of the tag of the next allocations*/
+    static uint32_t acc_size;        /*Bytes requested by the live allocations*/
+    static uint32_t acc_peak_size;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -114,6 +139,16 @@ void lv_mem_deinit(void)
 #if LV_MEM_CUSTOM == 0
     lv_tlsf_destroy(tlsf);
     lv_mem_init();
+
+#if LV_MEM_ACCOUNTING
+    /*Everything is freed*/
+    uint32_t i;
+    for(i = 0; i < acc_tag_cnt; i++) {
+        acc_tags[i].cnt = 0;
+        acc_tags[i].size = 0;
+    }
+    acc_size = 0;
+#endif
 #endif
 }
 
@@ -130,10 +165,23 @@ void * lv_mem_alloc(size_t size)
         return &zero_mem;
     }
 
+#if LV_MEM_ACCOUNTING
+    size_t alloc_size = size + ACC_HDR_SIZE;
+#else
+    size_t alloc_size = size;
+#endif
+
 #if LV_MEM_CUSTOM == 0
-    void * alloc = lv_tlsf_malloc(tlsf, size);
+    void * alloc = lv_tlsf_malloc(tlsf, alloc_size);
 #else
-    void * alloc = LV_MEM_CUSTOM_ALLOC(size);
+    void * alloc = LV_MEM_CUSTOM_ALLOC(alloc_size);
+#endif
+
+#if LV_MEM_ACCOUNTING
+    if(alloc) {
+        alloc = acc_hdr_set(alloc, acc_tag_act, size);
+        acc_add(acc_tag_act, size);
+    }
 #endif
 
     if(alloc == NULL) {
@@ -172,6 +220,13 @@ void lv_mem_free(void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+#if LV_MEM_ACCOUNTING
+    uint32_t tag;
+    size_t acc_data_size;
+    data = acc_hdr_get(data, &tag, &acc_data_size);
+    acc_remove(tag, acc_data_size);
+#endif
+
 #if LV_MEM_CUSTOM == 0
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
@@ -200,18 +255,35 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
         return &zero_mem;
     }
 
-    if(data_p == &zero_mem) return lv_mem_alloc(new_size);
+    if(data_p == &zero_mem || data_p == NULL) return lv_mem_alloc(new_size);
+
+#if LV_MEM_ACCOUNTING
+    /*Keep the tag of the original allocation*/
+    uint32_t tag;
+    size_t old_size;
+    data_p = acc_hdr_get(data_p, &tag, &old_size);
+    size_t alloc_size = new_size + ACC_HDR_SIZE;
+#else
+    size_t alloc_size = new_size;
+#endif
 
 #if LV_MEM_CUSTOM == 0
-    void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    void * new_p = lv_tlsf_realloc(tlsf, data_p, alloc_size);
 #else
-    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
+    void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, alloc_size);
 #endif
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't allocate memory");
         return NULL;
     }
 
+#if LV_MEM_ACCOUNTING
+    new_p = acc_hdr_set(new_p, tag, new_size);
+    acc_remove(tag, old_size);
+    acc_add(tag, new_size);
+    acc_tags[tag].alloc_cnt--;  /*It's not a new allocation*/
+#endif
+
     MEM_TRACE("allocated at %p", new_p);
     return new_p;
 }
@@ -268,6 +340,52 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #endif
 }
 
+#if LV_MEM_ACCOUNTING
+const char * lv_mem_set_tag(const char * tag)
+{
+    const char * prev = acc_tag_act == 0 ? NULL : acc_tags[acc_tag_act].name;
+    acc_tag_act = acc_tag_find(tag);
+    return prev;
+}
+
+uint32_t lv_mem_get_tag_stat(lv_mem_tag_stat_t * stat, uint32_t max_cnt)
+{
+    uint32_t cnt = LV_MIN(max_cnt, acc_tag_cnt);
+    lv_memcpy(stat, acc_tags, cnt * sizeof(lv_mem_tag_stat_t));
+    return cnt;
+}
+
+bool lv_mem_get_tag_stat_by_name(const char * tag, lv_mem_tag_stat_t * stat)
+{
+    uint32_t i;
+    for(i = 0; i < acc_tag_cnt; i++) {
+        if(tag == NULL ? i == 0 : strcmp(acc_tags[i].name, tag) == 0) {
+            *stat = acc_tags[i];
+            return true;
+        }
+    }
+
+    lv_memset_00(stat, sizeof(lv_mem_tag_stat_t));
+    return false;
+}
+
+void lv_mem_get_used_size(uint32_t * size, uint32_t * peak_size)
+{
+    if(size) *size = acc_size;
+    if(peak_size) *peak_size = acc_peak_size;
+}
+
+void lv_mem_reset_tag_stat(void)
+{
+    uint32_t i;
+    for(i = 0; i < acc_tag_cnt; i++) {
+        acc_tags[i].alloc_cnt = 0;
+        acc_tags[i].peak_size = acc_tags[i].size;
+    }
+    acc_peak_size = acc_size;
+}
+#endif
+
 
 /**
  * Get a temporal buffer with the given size.
@@ -308,7 +426,9 @@ void * lv_mem_buf_get(uint32_t size)
     for(uint8_t i = 0; i < LV_MEM_BUF_MAX_NUM; i++) {
         if(LV_GC_ROOT(lv_mem_buf[i]).used == 0) {
             /*if this fails you probably need to increase your LV_MEM_SIZE/heap size*/
+            LV_MEM_TAG_BEGIN("mem_buf");
             void * buf = lv_mem_realloc(LV_GC_ROOT(lv_mem_buf[i]).p, size);
+            LV_MEM_TAG_END();
             LV_ASSERT_MSG(buf != NULL, "Out of memory, can't allocate a new buffer (increase your LV_MEM_SIZE/heap size)");
             if(buf == NULL) return NULL;
 
@@ -564,3 +684,69 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
     }
 }
 #endif
+
+#if LV_MEM_ACCOUNTING
+static void * acc_hdr_set(void * p, uint32_t tag, size_t size)
+{
+    LV_ASSERT_MSG(size <= ACC_SIZE_MAX, "Too large allocation for LV_MEM_ACCOUNTING");
+    *((uint32_t *)p) = ((uint32_t)size << ACC_TAG_BITS) | tag;
+    return (uint8_t *)p + ACC_HDR_SIZE;
+}
+
+static void * acc_hdr_get(void * data, uint32_t * tag, size_t * size)
+{
+    void * p = (uint8_t *)data - ACC_HDR_SIZE;
+    uint32_t hdr = *((uint32_t *)p);
+    *tag = hdr & ACC_TAG_MASK;
+    *size = hdr >> ACC_TAG_BITS;
+    return p;
+}
+
+static void acc_add(uint32_t tag, size_t size)
+{
+    lv_mem_tag_stat_t * stat = &acc_tags[tag];
+    stat->alloc_cnt++;
+    stat->cnt++;
+    stat->size += size;
+    stat->peak_size = LV_MAX(stat->peak_size, stat->size);
+
+    acc_size += size;
+    acc_peak_size = LV_MAX(acc_peak_size, acc_size);
+}
+
+static void acc_remove(uint32_t tag, size_t size)
+{
+    acc_tags[tag].cnt--;
+    acc_tags[tag].size -= size;
+    acc_size -= size;
+}
+
+/**
+ * Get the index of a tag and add it if it's new
+ * @param tag   name of the tag. NULL: untagged
+ * @return      index of the tag in `acc_tags`. If there is no more space, the untagged index (0)
+ */
+static uint32_t acc_tag_find(const char * tag)
+{
+    if(tag == NULL) return 0;
+
+    /*The tags are mostly string literals so compare the pointers first*/
+    uint32_t i;
+    for(i = 0; i < acc_tag_cnt; i++) {
+        if(acc_tags[i].name == tag) return i;
+    }
+
+    for(i = 0; i < acc_tag_cnt; i++) {
+        if(strcmp(acc_tags[i].name, tag) == 0) return i;
+    }
+
+    if(acc_tag_cnt >= ACC_TAG_MAX) {
+        LV_LOG_WARN("no more space for the \"%s\" memory tag", tag);
+        return 0;
+    }
+
+    acc_tags[acc_tag_cnt].name = tag;
+    acc_tag_cnt++;
+    return acc_tag_cnt - 1;
+}
+#endif
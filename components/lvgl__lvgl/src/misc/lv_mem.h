@@ -18,6 +18,7 @@ extern "C" {
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#include <stdbool.h>
 
 #include "lv_types.h"
 
@@ -51,6 +52,19 @@ typedef struct {
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
 
+#if LV_MEM_ACCOUNTING
+/**
+ * Allocation statistics of a tag.
+ */
+typedef struct {
+    const char * name;      /**< Name of the tag. "other" for the untagged allocations*/
+    uint32_t alloc_cnt;     /**< Number of allocations since the last `lv_mem_reset_tag_stat()`*/
+    uint32_t cnt;           /**< Number of live allocations*/
+    uint32_t size;          /**< Bytes requested by the live allocations*/
+    uint32_t peak_size;     /**< The largest `size` since the last `lv_mem_reset_tag_stat()`*/
+} lv_mem_tag_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -101,6 +115,45 @@ lv_res_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_MEM_ACCOUNTING
+/**
+ * Set the tag of the next allocations. Reallocations keep the tag of the original allocation.
+ * @param tag       name of the tag (e.g. an object class or "timer"), NULL: untagged.
+ *                  Only the pointer is saved so it needs to be static.
+ * @return          the previous tag to restore later
+ */
+const char * lv_mem_set_tag(const char * tag);
+
+/**
+ * Get the statistics of the tags. The first one is always the untagged allocations.
+ * @param stat      array to store the statistics
+ * @param max_cnt   size of the `stat` array
+ * @return          number of tags written into `stat`
+ */
+uint32_t lv_mem_get_tag_stat(lv_mem_tag_stat_t * stat, uint32_t max_cnt);
+
+/**
+ * Get the statistics of a tag
+ * @param tag       name of the tag. NULL or "other": untagged allocations
+ * @param stat      store the statistics here
+ * @return          false if there was no allocation with this tag (`stat` is zeroed)
+ */
+bool lv_mem_get_tag_stat_by_name(const char * tag, lv_mem_tag_stat_t * stat);
+
+/**
+ * Get the bytes requested by all the live allocations and their peak
+ * @param size      store the current size here (can be NULL)
+ * @param peak_size store the largest size since the last `lv_mem_reset_tag_stat()` here (can be NULL)
+ */
+void lv_mem_get_used_size(uint32_t * size, uint32_t * peak_size);
+
+/**
+ * Clear the allocation counters and set the peaks to the current sizes.
+ * The live allocation counts and sizes are kept.
+ */
+void lv_mem_reset_tag_stat(void);
+#endif
+
 
 /**
  * Get a temporal buffer with the given size.
@@ -236,6 +289,15 @@ void /* LV_ATTRIBUTE_FAST_MEM */ lv_memset_ff(void * dst, size_t len);
  *      MACROS
  **********************/
 
+/*Tag the allocations until `LV_MEM_TAG_END()` in the same scope. Use it only once in a function.*/
+#if LV_MEM_ACCOUNTING
+    #define LV_MEM_TAG_BEGIN(tag)   const char * _lv_mem_tag_prev = lv_mem_set_tag(tag)
+    #define LV_MEM_TAG_END()        lv_mem_set_tag(_lv_mem_tag_prev)
+#else
+    #define LV_MEM_TAG_BEGIN(tag)
+    #define LV_MEM_TAG_END()
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -168,7 +168,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    LV_MEM_TAG_BEGIN("timer");
     new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
+    LV_MEM_TAG_END();
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
 
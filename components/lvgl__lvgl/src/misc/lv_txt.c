@@ -13,6 +13,7 @@
 #include "lv_log.h"
 #include "lv_mem.h"
 #include "lv_assert.h"
+#include "lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -46,9 +47,21 @@
     static uint32_t lv_txt_iso8859_1_get_char_id(const char * txt, uint32_t byte_id);
     static uint32_t lv_txt_iso8859_1_get_length(const char * txt);
 #endif
+static inline uint32_t txt_next_letter(const char * txt, uint32_t * i);
+static inline uint32_t txt_peek_letter(const char * txt);
+static void txt_get_size_core(lv_point_t * size_res, const char * text, const lv_font_t * font,
+                              lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
+#if LV_TXT_SIZE_CACHE_SIZE
+    static bool txt_size_cache_hash(const char * text, uint32_t * hash_res, uint32_t * len_res);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_txt_size_cache_stat_t size_cache_stat;
+#if LV_TXT_SIZE_CACHE_SIZE
+    static uint32_t size_cache_life;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -99,43 +112,69 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
-    uint32_t line_start     = 0;
-    uint32_t new_line_start = 0;
-    uint16_t letter_height = lv_font_get_line_height(font);
+#if LV_TXT_SIZE_CACHE_SIZE
+    uint32_t txt_hash;
+    uint32_t txt_len;
+    if(!txt_size_cache_hash(text, &txt_hash, &txt_len)) {
+        txt_get_size_core(size_res, text, font, letter_space, line_space, max_width, flag);
+        return;
+    }
 
-    /*Calc. the height and longest line*/
-    while(text[line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+    size_cache_stat.lookup_cnt++;
+    size_cache_life++;
 
-        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
-            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
+    /*Look for the same text and parameters and find the least recently used entry on the way*/
+    _lv_txt_size_cache_entry_t * cache = LV_GC_ROOT(_lv_txt_size_cache);
+    _lv_txt_size_cache_entry_t * entry = &cache[0];
+    uint32_t i;
+    for(i = 0; i < LV_TXT_SIZE_CACHE_SIZE; i++) {
+        _lv_txt_size_cache_entry_t * e = &cache[i];
+        if(e->txt_hash == txt_hash && e->font == font && e->txt_len == txt_len &&
+           e->letter_space == letter_space && e->line_space == line_space && e->max_width == max_width &&
+           e->flag == flag && memcmp(e->txt, text, txt_len) == 0) {
+            size_cache_stat.hit_cnt++;
+            e->life = size_cache_life;
+            *size_res = e->size;
             return;
         }
-        else {
-            size_res->y += letter_height;
-            size_res->y += line_space;
-        }
+        if(size_cache_life - e->life > size_cache_life - entry->life) entry = e;
+    }
 
-        /*Calculate the longest line*/
-        lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
-                                                      flag);
+    txt_get_size_core(size_res, text, font, letter_space, line_space, max_width, flag);
+
+    entry->font = font;
+    entry->txt_hash = txt_hash;
+    entry->life = size_cache_life;
+    entry->size = *size_res;
+    entry->letter_space = letter_space;
+    entry->line_space = line_space;
+    entry->max_width = max_width;
+    entry->flag = flag;
+    entry->txt_len = txt_len;
+    lv_memcpy(entry->txt, text, txt_len);
+#else
+    txt_get_size_core(size_res, text, font, letter_space, line_space, max_width, flag);
+#endif
+}
 
-        size_res->x = LV_MAX(act_line_length, size_res->x);
-        line_start  = new_line_start;
-    }
+void lv_txt_size_cache_clear(void)
+{
+#if LV_TXT_SIZE_CACHE_SIZE
+    lv_memset_00(LV_GC_ROOT(_lv_txt_size_cache), sizeof(_lv_txt_size_cache_arr_t));
+#endif
+}
 
-    /*Make the text one line taller if the last character is '\n' or '\r'*/
-    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
-        size_res->y += letter_height + line_space;
-    }
+void lv_txt_size_cache_get_stat(lv_txt_size_cache_stat_t * stat)
+{
+    *stat = size_cache_stat;
+}
 
-    /*Correction with the last line space or set the height manually if the text is empty*/
-    if(size_res->y == 0)
-        size_res->y = letter_height;
-    else
-        size_res->y -= line_space;
+void lv_txt_size_cache_reset_stat(void)
+{
+    lv_memset_00(&size_cache_stat, sizeof(size_cache_stat));
 }
 
+
 /**
  * Get the next word of text. A word is delimited by break characters.
  *
@@ -186,12 +225,12 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
     uint32_t break_index = NO_BREAK_FOUND; /*only used for "long" words*/
     uint32_t break_letter_count = 0; /*Number of characters up to the long word break point*/
 
-    letter = _lv_txt_encoded_next(txt, &i_next);
+    letter = txt_next_letter(txt, &i_next);
     i_next_next = i_next;
 
     /*Obtain the full word, regardless if it fits or not in max_width*/
     while(txt[i] != '\0') {
-        letter_next = _lv_txt_encoded_next(txt, &i_next_next);
+        letter_next = txt_next_letter(txt, &i_next_next);
         word_len++;
 
         /*Handle the recolor command*/
@@ -327,7 +366,7 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
 
     /*Always step at least one to avoid infinite loops*/
     if(i == 0) {
-        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        uint32_t letter = txt_next_letter(txt, &i);
         if(used_width != NULL) {
             line_w = lv_font_get_glyph_width(font, letter, '\0');
         }
@@ -353,9 +392,8 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
 
     if(length != 0) {
         while(i < length) {
-            uint32_t letter;
-            uint32_t letter_next;
-            _lv_txt_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+            uint32_t letter = txt_next_letter(txt, &i);
+            uint32_t letter_next = letter != '\0' ? txt_peek_letter(&txt[i]) : 0;
 
             if((flag & LV_TEXT_FLAG_RECOLOR) != 0) {
                 if(_lv_txt_is_cmd(&cmd_state, letter) != false) {
@@ -862,3 +900,98 @@ static uint32_t lv_txt_iso8859_1_get_length(const char * txt)
 #error "Invalid character encoding. See `LV_TXT_ENC` in `lv_conf.h`"
 
 #endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the next letter without calling the decoder for ASCII characters.
+ * Works with any supported encoding as they all store ASCII characters on 1 byte.
+ * @param txt a '\0' terminated string
+ * @param i start byte index in 'txt'. After the call it will point to the next encoded char.
+ * @return the decoded letter
+ */
+static inline uint32_t txt_next_letter(const char * txt, uint32_t * i)
+{
+    uint8_t c = (uint8_t)txt[*i];
+    if(LV_IS_ASCII(c)) {
+        (*i)++;
+        return c;
+    }
+    return _lv_txt_encoded_next(txt, i);
+}
+
+/**
+ * Decode the first letter of a string without stepping. Skips the decoder for ASCII characters.
+ * @param txt a '\0' terminated string
+ * @return the decoded letter
+ */
+static inline uint32_t txt_peek_letter(const char * txt)
+{
+    uint8_t c = (uint8_t)txt[0];
+    if(LV_IS_ASCII(c)) return c;
+    return _lv_txt_encoded_next(txt, NULL);
+}
+
+static void txt_get_size_core(lv_point_t * size_res, const char * text, const lv_font_t * font,
+                              lv_coord_t letter_space, lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+    uint32_t line_start     = 0;
+    uint32_t new_line_start = 0;
+    uint16_t letter_height = lv_font_get_line_height(font);
+
+    /*Calc. the height and longest line*/
+    while(text[line_start] != '\0') {
+        new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
+
+        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(lv_coord_t)) {
+            LV_LOG_WARN("lv_txt_get_size: integer overflow while calculating text height");
+            return;
+        }
+        else {
+            size_res->y += letter_height;
+            size_res->y += line_space;
+        }
+
+        /*Calculate the longest line*/
+        lv_coord_t act_line_length = lv_txt_get_width(&text[line_start], new_line_start - line_start, font, letter_space,
+                                                      flag);
+
+        size_res->x = LV_MAX(act_line_length, size_res->x);
+        line_start  = new_line_start;
+    }
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0)
+        size_res->y = letter_height;
+    else
+        size_res->y -= line_space;
+}
+
+#if LV_TXT_SIZE_CACHE_SIZE
+/**
+ * Hash (FNV-1a) and measure the length of a text for the size cache in one pass.
+ * @return false if the text is too long to be cached
+ */
+static bool txt_size_cache_hash(const char * text, uint32_t * hash_res, uint32_t * len_res)
+{
+    uint32_t hash = 2166136261U;
+    uint32_t len = 0;
+    while(text[len] != '\0') {
+        if(len >= _LV_TXT_SIZE_CACHE_TXT_MAX_LEN) return false;
+        hash ^= (uint8_t)text[len];
+        hash *= 16777619U;
+        len++;
+    }
+
+    *hash_res = hash;
+    *len_res = len;
+    return true;
+}
+#endif
@@ -32,6 +32,9 @@ extern "C" {
 #define LV_TXT_ENC_UTF8 1
 #define LV_TXT_ENC_ASCII 2
 
+/*Longer texts are measured but not cached as the cache entries store a copy of the text*/
+#define _LV_TXT_SIZE_CACHE_TXT_MAX_LEN 32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -65,6 +68,31 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/** Statistics of the `lv_txt_get_size()` cache*/
+typedef struct {
+    uint32_t lookup_cnt;    /**< Number of cacheable `lv_txt_get_size()` calls*/
+    uint32_t hit_cnt;       /**< Number of calls served from the cache*/
+} lv_txt_size_cache_stat_t;
+
+#if LV_TXT_SIZE_CACHE_SIZE
+/** An entry of the `lv_txt_get_size()` cache*/
+typedef struct {
+    const lv_font_t * font;     /**< NULL if the entry is not used yet*/
+    uint32_t txt_hash;
+    uint32_t life;              /**< The lookup counter at the last use. The least recently used entry is replaced.*/
+    lv_point_t size;
+    lv_coord_t letter_space;
+    lv_coord_t line_space;
+    lv_coord_t max_width;
+    lv_text_flag_t flag;
+    uint8_t txt_len;
+    char txt[_LV_TXT_SIZE_CACHE_TXT_MAX_LEN];    /**< Copy of the text to tell apart the texts with the same hash*/
+} _lv_txt_size_cache_entry_t;
+
+/*The entries are in a fixed array to not fragment the heap by replacing them*/
+typedef _lv_txt_size_cache_entry_t _lv_txt_size_cache_arr_t[LV_TXT_SIZE_CACHE_SIZE];
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -83,6 +111,24 @@ typedef uint8_t lv_text_align_t;
 void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
                      lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
 
+/**
+ * Drop every cached text size. Needs to be called if the metrics of a font change
+ * or a font is freed (its address might be reused by an other font).
+ * Does nothing if `LV_TXT_SIZE_CACHE_SIZE` is 0.
+ */
+void lv_txt_size_cache_clear(void);
+
+/**
+ * Get the statistics of the text size cache
+ * @param stat pointer to a variable to store the result
+ */
+void lv_txt_size_cache_get_stat(lv_txt_size_cache_stat_t * stat);
+
+/**
+ * Reset the statistics of the text size cache
+ */
+void lv_txt_size_cache_reset_stat(void);
+
 /**
  * Get the next line of text. Check line length and break chars too.
  * @param txt a '\0' terminated string
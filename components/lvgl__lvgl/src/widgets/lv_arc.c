@@ -50,6 +50,7 @@ static bool lv_arc_angle_within_bg_bounds(lv_obj_t * obj, const uint32_t angle,
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_arc_class  = {
+    .name = "arc",
     .constructor_cb = lv_arc_constructor,
     .event_cb = lv_arc_event,
     .instance_size = sizeof(lv_arc_t),
@@ -53,6 +53,7 @@ static void set_ofs_y_anim(void * obj, int32_t v);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_label_class = {
+    .name = "label",
     .constructor_cb = lv_label_constructor,
     .destructor_cb = lv_label_destructor,
     .event_cb = lv_label_event,
@@ -121,7 +122,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         /*Get the size of the text and process it*/
         size_t len = _lv_txt_ap_calc_bytes_cnt(text);
 
+        LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
         label->text = lv_mem_alloc(len);
+        LV_MEM_TAG_END();
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
 
@@ -131,7 +134,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         size_t len = strlen(text) + 1;
 
         /*Allocate space for the new text*/
+        LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
         label->text = lv_mem_alloc(len);
+        LV_MEM_TAG_END();
         LV_ASSERT_MALLOC(label->text);
         if(label->text == NULL) return;
         strcpy(label->text, text);
@@ -165,7 +170,9 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
 
     va_list args;
     va_start(args, fmt);
+    LV_MEM_TAG_BEGIN(lv_obj_class_get_name(obj->class_p));
     label->text = _lv_txt_set_text_vfmt(fmt, args);
+    LV_MEM_TAG_END();
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
@@ -39,6 +39,7 @@ static void lv_templ_event(const lv_obj_class_t * class_p, lv_event_t * e);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_templ_class = {
+    .name = "templ",
     .constructor_cb = lv_templ_constructor,
     .destructor_cb = lv_templ_destructor,
     .event_cb = lv_templ_event,
@@ -41,6 +41,7 @@ static bool is_slider_horizontal(lv_obj_t * obj);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_slider_class = {
+    .name = "slider",
     .constructor_cb = lv_slider_constructor,
     .event_cb = lv_slider_event,
     .editable = LV_OBJ_CLASS_EDITABLE_TRUE,
@@ -52,6 +52,7 @@ static void lv_switch_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 const lv_obj_class_t lv_switch_class = {
+    .name = "switch",
     .constructor_cb = lv_switch_constructor,
     .destructor_cb = lv_switch_destructor,
     .event_cb = lv_switch_event,
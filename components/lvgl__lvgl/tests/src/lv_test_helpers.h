@@ -1,6 +1,9 @@
 #ifndef LV_TEST_HELPERS_H
 #define LV_TEST_HELPERS_H
 
+#include "../src/draw/sw/lv_draw_sw.h"
+#include <time.h>
+
 #ifdef LVGL_CI_USING_SYS_HEAP
 /* Skip checking heap as we don't have the info available */
 #define LV_HEAP_CHECK(x) do {} while(0)
@@ -11,12 +14,23 @@
 
 static inline uint32_t lv_test_get_free_mem(void)
 {
+    /*The caches keep copies of the texts and glyphs, it's not a leak*/
+    lv_txt_size_cache_clear();
+    lv_draw_sw_glyph_cache_clear();
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
     return m1.free_size;
 }
 #endif /* LVGL_CI_USING_SYS_HEAP */
 
+/*Monotonic time in microseconds, for the timings the benchmarks print*/
+static inline uint32_t lv_test_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
 
 #endif /*LV_TEST_HELPERS_H*/
 
@@ -0,0 +1,106 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define BENCH_FRAMES    20
+
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[800 * 480];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_draw_sw_glyph_cache_clear();
+    lv_draw_sw_glyph_cache_reset_stat();
+
+    /*On a solid background the glyphs are drawn with a lookup table without using the cache*/
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0xffffff), 0);
+    lv_obj_set_style_bg_grad_color(lv_scr_act(), lv_color_hex(0x808080), 0);
+    lv_obj_set_style_bg_grad_dir(lv_scr_act(), LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_obj_remove_style_all(lv_scr_act());
+}
+
+static void refr_full(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void test_draw_sw_glyph_cache_hits_per_frame(void)
+{
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * label = lv_label_create(lv_scr_act());
+        lv_label_set_text_fmt(label, "%d.%03d -0123456789", (int)i, (int)(i * 125));
+        lv_obj_set_pos(label, 10, i * 30);
+    }
+    refr_full();
+
+    lv_draw_sw_glyph_cache_stat_t stat;
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_NOT_EQUAL(0, stat.miss_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, stat.size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_GLYPH_CACHE_SIZE, stat.size);
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_glyph_cache_reset_stat();
+    uint32_t t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_FRAMES; i++) {
+        refr_full();
+    }
+    uint32_t t_elaps = lv_test_time_us() - t_start;
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+
+    TEST_PRINTF("glyph cache: %u hits/frame, %u misses, %u bytes, %u us/frame",
+                stat.hit_cnt / BENCH_FRAMES, stat.miss_cnt, stat.size, t_elaps / BENCH_FRAMES);
+
+    /*Every glyph is cached after the first frame*/
+    TEST_ASSERT_EQUAL_UINT32(0, stat.miss_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, stat.hit_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+}
+
+void test_draw_sw_glyph_cache_eviction(void)
+{
+#if LV_FONT_MONTSERRAT_24
+    /*More glyphs than what fits into the cache*/
+    char txt[96];
+    uint32_t i;
+    for(i = 0; i < sizeof(txt) - 1; i++) txt[i] = (char)(' ' + i);
+    txt[sizeof(txt) - 1] = '\0';
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 780);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+    lv_obj_set_style_text_opa(label, LV_OPA_70, 0);
+    lv_label_set_text(label, txt);
+    refr_full();
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_glyph_cache_stat_t stat;
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_GLYPH_CACHE_SIZE, stat.size);
+
+    /*Some glyphs come from the cache, others are expanded again but the result is the same*/
+    refr_full();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_draw_sw_glyph_cache_clear();
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.size);
+#endif
+}
+
+#endif
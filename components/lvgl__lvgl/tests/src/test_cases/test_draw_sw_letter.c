@@ -0,0 +1,135 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define BENCH_FRAMES    20
+
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[800 * 480];
+#if LV_DRAW_COMPLEX
+static lv_draw_mask_line_param_t mask_param;
+static int16_t mask_id = LV_MASK_ID_INV;
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_draw_sw_glyph_cache_reset_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_obj_remove_style_all(lv_scr_act());
+    lv_obj_remove_event_cb(lv_scr_act(), NULL);
+}
+
+#if LV_DRAW_COMPLEX
+/*A line mask above the screen doesn't change anything but forces the generic masked blending*/
+static void full_mask_event_cb(lv_event_t * e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        lv_draw_mask_line_points_init(&mask_param, -100, -10, 1000, -10, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
+        mask_id = lv_draw_mask_add(&mask_param, NULL);
+    }
+    else if(code == LV_EVENT_DRAW_POST_END) {
+        lv_draw_mask_free_param(&mask_param);
+        lv_draw_mask_remove_id(mask_id);
+        mask_id = LV_MASK_ID_INV;
+    }
+}
+#endif
+
+static uint32_t refr_frames(uint32_t frame_cnt)
+{
+    uint32_t t_start = lv_test_time_us();
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    return (lv_test_time_us() - t_start) / frame_cnt;
+}
+
+static void create_labels(void)
+{
+    static const lv_font_t * fonts[] = {
+        &lv_font_montserrat_14,
+#if LV_FONT_MONTSERRAT_24
+        &lv_font_montserrat_24,
+#endif
+    };
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_MAX, LV_OPA_70, LV_OPA_10};
+    static const uint32_t colors[] = {0x000000, 0xFF6B35, 0x4CAF50};
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0xF9F9F9), 0);
+    lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0);
+
+    uint32_t f, o, c;
+    lv_coord_t y = 0;
+    for(f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++) {
+        for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+            for(c = 0; c < sizeof(colors) / sizeof(colors[0]); c++) {
+                lv_obj_t * label = lv_label_create(lv_scr_act());
+                lv_label_set_text(label, "-1234.567 0.000 XYZ Branch Center");
+                lv_obj_set_style_text_font(label, fonts[f], 0);
+                lv_obj_set_style_text_opa(label, opas[o], 0);
+                lv_obj_set_style_text_color(label, lv_color_hex(colors[c]), 0);
+                lv_obj_set_pos(label, (c * 7) % 5, y);
+                y += lv_font_get_line_height(fonts[f]) - 4;  /*Overlap a little to have glyphs on non-solid background*/
+            }
+        }
+    }
+}
+
+void test_draw_sw_letter_lut_same_as_generic(void)
+{
+    create_labels();
+
+    lv_draw_sw_glyph_cache_stat_t stat;
+    lv_draw_sw_glyph_cache_reset_stat();
+    refr_frames(1);
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_NOT_EQUAL(0, stat.lut_cnt);
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+#if LV_DRAW_COMPLEX
+    lv_obj_add_event_cb(lv_scr_act(), full_mask_event_cb, LV_EVENT_ALL, NULL);
+    lv_draw_sw_glyph_cache_reset_stat();
+    refr_frames(1);
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.lut_cnt);
+
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+#endif
+}
+
+void test_draw_sw_letter_lut_throughput(void)
+{
+    create_labels();
+
+    lv_draw_sw_glyph_cache_stat_t stat;
+    lv_draw_sw_glyph_cache_reset_stat();
+    uint32_t t_lut = refr_frames(BENCH_FRAMES);
+    lv_draw_sw_glyph_cache_get_stat(&stat);
+    uint32_t lut_cnt = stat.lut_cnt / BENCH_FRAMES;
+
+#if LV_DRAW_COMPLEX
+    lv_obj_add_event_cb(lv_scr_act(), full_mask_event_cb, LV_EVENT_ALL, NULL);
+    uint32_t t_generic = refr_frames(BENCH_FRAMES);
+
+    TEST_PRINTF("%u glyphs/frame with LUT: %u us/frame, masked blending: %u us/frame", lut_cnt, t_lut, t_generic);
+#else
+    TEST_PRINTF("%u glyphs/frame with LUT: %u us/frame", lut_cnt, t_lut);
+#endif
+    TEST_ASSERT_NOT_EQUAL(0, lut_cnt);
+}
+
+#endif
@@ -0,0 +1,145 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define BENCH_RECTS     2000
+
+extern lv_color_t test_fb[];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_obj_remove_event_cb(lv_scr_act(), NULL);
+}
+
+/*The rounded corners are drawn with masks only with complex drawing*/
+#if LV_DRAW_COMPLEX
+
+static lv_color_t fb_ref[800 * 480];
+static lv_draw_mask_line_param_t mask_param;
+static int16_t mask_id = LV_MASK_ID_INV;
+static uint32_t bench_time;
+
+/*A line mask above the screen doesn't change anything but forces drawing with the radius masks*/
+static void full_mask_event_cb(lv_event_t * e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_DRAW_MAIN_BEGIN) {
+        lv_draw_mask_line_points_init(&mask_param, -100, -10, 1000, -10, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
+        mask_id = lv_draw_mask_add(&mask_param, NULL);
+    }
+    else if(code == LV_EVENT_DRAW_POST_END) {
+        lv_draw_mask_free_param(&mask_param);
+        lv_draw_mask_remove_id(mask_id);
+        mask_id = LV_MASK_ID_INV;
+    }
+}
+
+static void refr_full(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*A value box of the DRO: radius 6 with 2 px border*/
+static void bench_event_cb(lv_event_t * e)
+{
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = 6;
+    dsc.bg_color = lv_color_hex(0x202020);
+    dsc.border_width = 2;
+    dsc.border_color = lv_color_hex(0x4CAF50);
+
+    lv_area_t area;
+    lv_obj_get_coords(lv_event_get_target(e), &area);
+    uint32_t t_start = lv_test_time_us();
+    uint32_t i;
+    for(i = 0; i < BENCH_RECTS; i++) {
+        lv_draw_rect(draw_ctx, &dsc, &area);
+    }
+    bench_time = lv_test_time_us() - t_start;
+}
+
+#endif /*LV_DRAW_COMPLEX*/
+
+void test_draw_sw_rect_small_radius_same_as_masks(void)
+{
+#if LV_DRAW_COMPLEX
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_50};
+    lv_coord_t x = 0;
+    lv_coord_t y = 0;
+    lv_coord_t r;
+    lv_coord_t bw;
+    uint32_t o;
+    for(r = 1; r <= 14; r++) {
+        for(bw = 0; bw <= 3; bw++) {
+            for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+                lv_obj_t * obj = lv_obj_create(lv_scr_act());
+                lv_obj_remove_style_all(obj);
+                /*Odd and even sizes and sizes where the corners almost touch*/
+                lv_coord_t corner_size = LV_MAX(r, bw);
+                lv_obj_set_size(obj, 2 * corner_size + 1 + (bw + o) % 3, 2 * corner_size + 1 + o);
+                lv_obj_set_pos(obj, x, y);
+                lv_obj_set_style_radius(obj, r, 0);
+                lv_obj_set_style_bg_color(obj, lv_color_hex(0xFF6B35), 0);
+                lv_obj_set_style_bg_opa(obj, opas[o], 0);
+                lv_obj_set_style_border_width(obj, bw, 0);
+                lv_obj_set_style_border_color(obj, lv_color_hex(0x2060C0), 0);
+                lv_obj_set_style_border_opa(obj, opas[o], 0);
+                lv_obj_set_style_outline_width(obj, o + 1, 0);
+                lv_obj_set_style_outline_pad(obj, bw, 0);
+                lv_obj_set_style_outline_color(obj, lv_color_hex(0x000000), 0);
+
+                x += 2 * corner_size + 16;
+                if(x > 740) {
+                    x = 0;
+                    y += 2 * corner_size + 16;
+                }
+            }
+        }
+    }
+
+    refr_full();
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_add_event_cb(lv_scr_act(), full_mask_event_cb, LV_EVENT_ALL, NULL);
+    refr_full();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+#endif
+}
+
+void test_draw_sw_rect_small_radius_value_box_benchmark(void)
+{
+#if LV_DRAW_COMPLEX
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, 120, 36);
+    lv_obj_add_event_cb(obj, bench_event_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    refr_full();
+    uint32_t t_cached = bench_time;
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_add_event_cb(lv_scr_act(), full_mask_event_cb, LV_EVENT_ALL, NULL);
+    refr_full();
+    uint32_t t_masks = bench_time;
+
+    /*The timings depend on the machine and the build, only the result is checked*/
+    TEST_PRINTF("value box: %u ns with cached corners, %u ns with radius masks",
+                t_cached * 1000 / BENCH_RECTS, t_masks * 1000 / BENCH_RECTS);
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+#endif
+}
+
+#endif
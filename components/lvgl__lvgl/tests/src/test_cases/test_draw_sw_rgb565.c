@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+#if LV_DRAW_SW_RGB565_SWAR
+
+#define GUARD       0xDEAD
+#define MAX_LEN     40
+#define BENCH_W     320
+#define BENCH_H     240
+#define BENCH_CNT   20
+
+static uint16_t dest_buf[MAX_LEN + 8];
+static uint16_t dest_ref[MAX_LEN + 8];
+static uint16_t src_buf[MAX_LEN + 8];
+
+static uint16_t bench_dest[BENCH_W * BENCH_H + 2];
+static uint16_t bench_src[BENCH_W * BENCH_H + 2];
+
+/*lv_color_mix() with 16 bit color depth*/
+static uint16_t ref_mix(uint16_t fg, uint16_t bg, lv_opa_t mix)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    mix = (uint32_t)((uint32_t)mix + 4) >> 3;
+    uint32_t bg32 = ((uint32_t)bg | ((uint32_t)bg << 16)) & 0x7E0F81F;
+    uint32_t fg32 = ((uint32_t)fg | ((uint32_t)fg << 16)) & 0x7E0F81F;
+    uint32_t result = ((((fg32 - bg32) * mix) >> 5) + bg32) & 0x7E0F81F;
+    return (uint16_t)((result >> 16) | result);
+#else
+    uint32_t r = LV_UDIV255((fg >> 11) * mix + (bg >> 11) * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    uint32_t g = LV_UDIV255(((fg >> 5) & 0x3F) * mix + ((bg >> 5) & 0x3F) * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    uint32_t b = LV_UDIV255((fg & 0x1F) * mix + (bg & 0x1F) * (255 - mix) + LV_COLOR_MIX_ROUND_OFS);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+#endif
+}
+
+static uint16_t rnd(void)
+{
+    static uint32_t seed = 0x1234567;
+    seed = seed * 1103515245 + 12345;
+    return (uint16_t)(seed >> 8);
+}
+
+static void init_bufs(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(dest_buf) / sizeof(dest_buf[0]); i++) {
+        dest_buf[i] = GUARD;
+        src_buf[i] = rnd();
+    }
+    lv_memcpy(dest_ref, dest_buf, sizeof(dest_ref));
+}
+
+#endif /*LV_DRAW_SW_RGB565_SWAR*/
+
+void test_draw_sw_rgb565_fill(void)
+{
+#if LV_DRAW_SW_RGB565_SWAR
+    uint32_t ofs;
+    int32_t len;
+    for(ofs = 0; ofs < 4; ofs++) {
+        for(len = 0; len <= MAX_LEN; len++) {
+            init_bufs();
+            uint16_t color = rnd();
+            int32_t i;
+            for(i = 0; i < len; i++) dest_ref[ofs + i] = color;
+
+            _lv_draw_sw_rgb565_fill(&dest_buf[ofs], color, len);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_buf, MAX_LEN + 8);
+        }
+    }
+#endif
+}
+
+void test_draw_sw_rgb565_copy(void)
+{
+#if LV_DRAW_SW_RGB565_SWAR
+    uint32_t dest_ofs;
+    uint32_t src_ofs;
+    int32_t len;
+    for(dest_ofs = 0; dest_ofs < 4; dest_ofs++) {
+        for(src_ofs = 0; src_ofs < 4; src_ofs++) {
+            for(len = 0; len <= MAX_LEN; len++) {
+                init_bufs();
+                int32_t i;
+                for(i = 0; i < len; i++) dest_ref[dest_ofs + i] = src_buf[src_ofs + i];
+
+                _lv_draw_sw_rgb565_copy(&dest_buf[dest_ofs], &src_buf[src_ofs], len);
+                TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_buf, MAX_LEN + 8);
+            }
+        }
+    }
+#endif
+}
+
+void test_draw_sw_rgb565_mix(void)
+{
+#if LV_DRAW_SW_RGB565_SWAR
+    uint32_t opa;
+    for(opa = 0; opa <= 255; opa++) {
+        uint32_t ofs = opa & 0x3;
+        int32_t len = opa % MAX_LEN;
+        init_bufs();
+        int32_t i;
+        for(i = 0; i < len; i++) {
+            dest_buf[ofs + i] = rnd();
+            dest_ref[ofs + i] = ref_mix(src_buf[ofs + i], dest_buf[ofs + i], opa);
+        }
+
+        _lv_draw_sw_rgb565_mix(&dest_buf[ofs], &src_buf[ofs], len, opa);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(dest_ref, dest_buf, MAX_LEN + 8);
+    }
+
+    /*The extreme values of each channel*/
+    static const uint16_t colors[] = {0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0x0821, 0xF7DE};
+    uint32_t fg;
+    uint32_t bg;
+    for(fg = 0; fg < sizeof(colors) / sizeof(colors[0]); fg++) {
+        for(bg = 0; bg < sizeof(colors) / sizeof(colors[0]); bg++) {
+            for(opa = 0; opa <= 255; opa++) {
+                dest_buf[0] = colors[bg];
+                dest_buf[1] = colors[bg];
+                src_buf[0] = colors[fg];
+                src_buf[1] = colors[fg];
+                _lv_draw_sw_rgb565_mix(dest_buf, src_buf, 2, opa);
+                TEST_ASSERT_EQUAL_HEX16(ref_mix(colors[fg], colors[bg], opa), dest_buf[0]);
+                TEST_ASSERT_EQUAL_HEX16(dest_buf[0], dest_buf[1]);
+            }
+        }
+    }
+#endif
+}
+
+void test_draw_sw_rgb565_benchmark(void)
+{
+#if LV_DRAW_SW_RGB565_SWAR
+    uint32_t i;
+    int32_t x;
+    for(i = 0; i < BENCH_W * BENCH_H + 2; i++) bench_src[i] = rnd();
+
+    /*The source is at a 2 byte offset compared to the destination as it often happens with images*/
+    uint32_t t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) _lv_draw_sw_rgb565_fill(bench_dest, (uint16_t)i, BENCH_W * BENCH_H);
+    uint32_t t_fill = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) {
+        for(x = 0; x < BENCH_W * BENCH_H; x++) bench_dest[x] = (uint16_t)i;
+    }
+    uint32_t t_fill_ref = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) _lv_draw_sw_rgb565_copy(bench_dest, bench_src + 1, BENCH_W * BENCH_H);
+    uint32_t t_copy = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) lv_memcpy(bench_dest, bench_src + 1, BENCH_W * BENCH_H * sizeof(uint16_t));
+    uint32_t t_copy_ref = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) _lv_draw_sw_rgb565_mix(bench_dest, bench_src, BENCH_W * BENCH_H, 128);
+    uint32_t t_mix = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) {
+        for(x = 0; x < BENCH_W * BENCH_H; x++) bench_dest[x] = ref_mix(bench_src[x], bench_dest[x], 128);
+    }
+    uint32_t t_mix_ref = lv_test_time_us() - t_start;
+
+    TEST_PRINTF("%dx%d RGB565 [us]: fill %u (per pixel %u), copy %u (lv_memcpy %u), mix %u (per pixel %u)",
+                BENCH_W, BENCH_H, t_fill / BENCH_CNT, t_fill_ref / BENCH_CNT, t_copy / BENCH_CNT, t_copy_ref / BENCH_CNT,
+                t_mix / BENCH_CNT, t_mix_ref / BENCH_CNT);
+
+    /*The results are still correct*/
+    _lv_draw_sw_rgb565_copy(bench_dest, bench_src + 1, BENCH_W * BENCH_H);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(bench_src + 1, bench_dest, BENCH_W * BENCH_H);
+#endif
+}
+
+#endif
@@ -1,5 +1,6 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
 
 #include "unity/unity.h"
 #include "lv_test_indev.h"
@@ -50,6 +51,8 @@ void test_dropdown_create_delete(void)
 void test_dropdown_set_options(void)
 {
 
+    lv_txt_size_cache_clear();
+    lv_draw_sw_glyph_cache_clear();
     lv_mem_monitor_t m1;
     lv_mem_monitor(&m1);
 
@@ -108,6 +111,8 @@ void test_dropdown_set_options(void)
 
     lv_obj_del(dd1);
 
+    lv_txt_size_cache_clear();
+    lv_draw_sw_glyph_cache_clear();
     lv_mem_monitor_t m2;
     lv_mem_monitor(&m2);
     TEST_ASSERT_UINT32_WITHIN(48, m1.free_size, m2.free_size);
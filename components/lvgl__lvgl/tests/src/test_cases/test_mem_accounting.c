@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_MEM_ACCOUNTING
+    lv_mem_reset_tag_stat();
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+#if LV_MEM_ACCOUNTING
+
+static lv_mem_tag_stat_t get_stat(const char * tag)
+{
+    lv_mem_tag_stat_t stat;
+    lv_mem_get_tag_stat_by_name(tag, &stat);
+    return stat;
+}
+
+static void alloc_inner(void)
+{
+    LV_MEM_TAG_BEGIN("test_inner");
+    void * p = lv_mem_alloc(16);
+    LV_MEM_TAG_END();
+    lv_mem_free(p);
+}
+
+#endif
+
+void test_mem_accounting_tag(void)
+{
+#if LV_MEM_ACCOUNTING
+    LV_MEM_TAG_BEGIN("test_tag");
+    void * p1 = lv_mem_alloc(100);
+    void * p2 = lv_mem_alloc(50);
+    LV_MEM_TAG_END();
+
+    lv_mem_tag_stat_t stat = get_stat("test_tag");
+    TEST_ASSERT_EQUAL_STRING("test_tag", stat.name);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.cnt);
+    TEST_ASSERT_EQUAL_UINT32(150, stat.size);
+
+    lv_mem_free(p2);
+    stat = get_stat("test_tag");
+    TEST_ASSERT_EQUAL_UINT32(1, stat.cnt);
+    TEST_ASSERT_EQUAL_UINT32(100, stat.size);
+    TEST_ASSERT_EQUAL_UINT32(150, stat.peak_size);
+
+    lv_mem_free(p1);
+    stat = get_stat("test_tag");
+    TEST_ASSERT_EQUAL_UINT32(0, stat.cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.size);
+
+    lv_mem_reset_tag_stat();
+    stat = get_stat("test_tag");
+    TEST_ASSERT_EQUAL_UINT32(0, stat.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.peak_size);
+#endif
+}
+
+void test_mem_accounting_realloc_keeps_tag(void)
+{
+#if LV_MEM_ACCOUNTING
+    LV_MEM_TAG_BEGIN("test_realloc");
+    uint8_t * p = lv_mem_alloc(10);
+    LV_MEM_TAG_END();
+    lv_memset(p, 0x55, 10);
+
+    p = lv_mem_realloc(p, 1000);
+    TEST_ASSERT_EACH_EQUAL_HEX8(0x55, p, 10);
+
+    lv_mem_tag_stat_t stat = get_stat("test_realloc");
+    TEST_ASSERT_EQUAL_UINT32(1, stat.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.cnt);
+    TEST_ASSERT_EQUAL_UINT32(1000, stat.size);
+
+    lv_mem_free(p);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stat("test_realloc").size);
+#endif
+}
+
+void test_mem_accounting_nested_tags(void)
+{
+#if LV_MEM_ACCOUNTING
+    uint32_t other_cnt = get_stat(NULL).cnt;
+
+    LV_MEM_TAG_BEGIN("test_outer");
+    void * p1 = lv_mem_alloc(8);
+    alloc_inner();
+    void * p3 = lv_mem_alloc(8);
+    LV_MEM_TAG_END();
+    void * p4 = lv_mem_alloc(4);
+
+    TEST_ASSERT_EQUAL_UINT32(2, get_stat("test_outer").cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, get_stat("test_inner").alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(other_cnt + 1, get_stat("other").cnt);
+
+    lv_mem_free(p1);
+    lv_mem_free(p3);
+    lv_mem_free(p4);
+#endif
+}
+
+void test_mem_accounting_objects_by_class(void)
+{
+#if LV_MEM_ACCOUNTING
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Hello accounting");
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+
+    lv_mem_tag_stat_t label_stat = get_stat("label");
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3, label_stat.cnt);     /*Instance, text, local style*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(sizeof(lv_label_t) + sizeof("Hello accounting"), label_stat.size);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(sizeof(lv_btn_t), get_stat("btn").size);
+
+    /*The sum of the tags is the total*/
+    lv_mem_tag_stat_t stats[32];
+    uint32_t cnt = lv_mem_get_tag_stat(stats, 32);
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) sum += stats[i].size;
+    uint32_t size;
+    lv_mem_get_used_size(&size, NULL);
+    TEST_ASSERT_EQUAL_UINT32(size, sum);
+    TEST_ASSERT_EQUAL_STRING("other", stats[0].name);
+
+    lv_obj_del(label);
+    lv_obj_del(btn);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stat("label").size);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stat("btn").size);
+#endif
+}
+
+void test_mem_accounting_unknown_tag(void)
+{
+#if LV_MEM_ACCOUNTING
+    lv_mem_tag_stat_t stat;
+    TEST_ASSERT_FALSE(lv_mem_get_tag_stat_by_name("test_never_used", &stat));
+    TEST_ASSERT_EQUAL_UINT32(0, stat.size);
+#endif
+}
+
+#endif
@@ -0,0 +1,84 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_obj_pos_fixed_child_does_not_dirty_parent(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(parent, 300, 200);
+    lv_obj_center(parent);
+
+    lv_obj_t * box = lv_obj_create(parent);
+    lv_obj_set_size(box, 60, 20);
+    lv_obj_set_pos(box, 10, 10);
+    lv_obj_update_layout(lv_scr_act());
+
+    lv_obj_layout_stat_t stat;
+    lv_obj_reset_layout_stat();
+    lv_obj_set_style_border_width(box, 4, 0);
+    lv_obj_update_layout(lv_scr_act());
+    lv_obj_get_layout_stat(&stat);
+
+    /*Only the box itself needs to be updated*/
+    TEST_ASSERT_EQUAL_UINT32(1, stat.obj_cnt);
+    TEST_ASSERT_NOT_EQUAL(0, stat.skip_cnt);
+
+    /*The box still can be moved and resized*/
+    lv_obj_set_style_width(box, 80, 0);
+    lv_obj_set_style_x(box, 30, 0);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(80, lv_obj_get_width(box));
+    TEST_ASSERT_EQUAL(30, lv_obj_get_x(box));
+}
+
+void test_obj_pos_content_sized_parent_follows_child(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(parent, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_style_pad_all(parent, 0, 0);
+    lv_obj_set_style_border_width(parent, 0, 0);
+
+    lv_obj_t * box = lv_obj_create(parent);
+    lv_obj_set_size(box, 60, 20);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(60, lv_obj_get_width(parent));
+
+    lv_obj_set_style_width(box, 90, 0);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(90, lv_obj_get_width(parent));
+}
+
+void test_obj_pos_flex_child_dirties_parent(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(parent, 300, 100);
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_ROW);
+    lv_obj_set_style_pad_all(parent, 0, 0);
+    lv_obj_set_style_pad_column(parent, 0, 0);
+
+    lv_obj_t * box1 = lv_obj_create(parent);
+    lv_obj_set_size(box1, 60, 20);
+    lv_obj_t * box2 = lv_obj_create(parent);
+    lv_obj_set_size(box2, 60, 20);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(60, lv_obj_get_x(box2));
+
+    /*The size is fixed but positioned by the layout, so the siblings need to move*/
+    lv_obj_set_style_width(box1, 100, 0);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(100, lv_obj_get_x(box2));
+}
+
+#endif
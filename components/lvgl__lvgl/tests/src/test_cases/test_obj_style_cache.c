@@ -0,0 +1,135 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define BENCH_ROWS      8
+#define BENCH_COLS      4
+#define BENCH_FRAMES    20
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_obj_style_cache_state_change(void)
+{
+    static lv_style_t style_checked;
+    lv_style_init(&style_checked);
+    lv_style_set_bg_color(&style_checked, lv_color_hex(0x0000ff));
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), 0);
+    lv_obj_add_style(obj, &style_checked, LV_STATE_CHECKED);
+
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_add_state(obj, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_clear_state(obj, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Modify the shared style and report it*/
+    lv_obj_add_state(obj, LV_STATE_CHECKED);
+    lv_style_set_bg_color(&style_checked, lv_color_hex(0x00ff00));
+    lv_obj_report_style_change(&style_checked);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    lv_obj_remove_style(obj, &style_checked, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+}
+
+void test_obj_style_cache_inherited(void)
+{
+    lv_obj_t * parent1 = lv_obj_create(lv_scr_act());
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x0000ff), LV_STATE_CHECKED);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x00ff00), 0);
+
+    lv_obj_t * label = lv_label_create(parent1);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    /*The state of the parent is not part of the child's key*/
+    lv_obj_add_state(parent1, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_set_parent(label, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    /*Local style of the parent changes*/
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x123456), 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    /*Styles changed while refreshing is disabled*/
+    lv_obj_enable_style_refresh(false);
+    lv_obj_set_style_text_color(label, lv_color_hex(0x654321), 0);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x654321), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+}
+
+void test_obj_style_cache_lookups_per_frame(void)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    static lv_style_t style_row;
+    lv_style_init(&style_row);
+    lv_style_set_flex_flow(&style_row, LV_FLEX_FLOW_ROW);
+    lv_style_set_layout(&style_row, LV_LAYOUT_FLEX);
+    lv_style_set_pad_all(&style_row, 2);
+    lv_style_set_width(&style_row, LV_PCT(100));
+    lv_style_set_height(&style_row, LV_SIZE_CONTENT);
+
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t r, c;
+    for(r = 0; r < BENCH_ROWS; r++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_add_style(row, &style_row, 0);
+        for(c = 0; c < BENCH_COLS; c++) {
+            lv_obj_t * label = lv_label_create(row);
+            lv_label_set_text_fmt(label, "%d.%03d", (int)r, (int)c);
+        }
+        lv_obj_t * btn = lv_btn_create(row);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text(label, "OK");
+    }
+    lv_refr_now(NULL);
+
+    lv_obj_style_cache_stat_t stat;
+    lv_obj_style_cache_reset_stat();
+    uint32_t t_start = lv_test_time_us();
+    uint32_t i;
+    for(i = 0; i < BENCH_FRAMES; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    uint32_t t_elaps = lv_test_time_us() - t_start;
+    lv_obj_style_cache_get_stat(&stat);
+
+    uint32_t walk_cnt = stat.lookup_cnt - stat.hit_cnt;
+    TEST_PRINTF("style lookups/frame: %u, style walks/frame: %u (%u without cache), %u us/frame",
+                stat.lookup_cnt / BENCH_FRAMES, walk_cnt / BENCH_FRAMES, stat.lookup_cnt / BENCH_FRAMES,
+                t_elaps / BENCH_FRAMES);
+
+    /*Nothing changes between the frames so most of the lookups should be served from the cache*/
+    TEST_ASSERT_EQUAL_UINT32(0, stat.invalidate_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(stat.lookup_cnt / 2, stat.hit_cnt);
+
+    /*The label of the button might inherit from the new state so the cache needs to be dropped*/
+    lv_obj_t * btn = lv_obj_get_child(lv_obj_get_child(cont, 0), BENCH_COLS);
+    lv_obj_add_state(btn, LV_STATE_CHECKED);
+    lv_obj_style_cache_get_stat(&stat);
+    TEST_ASSERT_NOT_EQUAL(0, stat.invalidate_cnt);
+#endif
+}
+
+#endif
@@ -0,0 +1,186 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BOX_CNT     6
+#define BOX_W       120
+#define BOX_H       24
+#define BOX_GAP     12
+#define BUF_ROWS    20
+
+/*lv_obj_get_transformed_area() increases the invalidated areas by 5 px*/
+#define INV_PAD     5
+#define INV_W       (BOX_W + 2 * INV_PAD)
+#define INV_H       (BOX_H + 2 * INV_PAD)
+
+static lv_obj_t * boxes[BOX_CNT];
+static lv_disp_drv_t drv_saved;
+static uint32_t buf_size_saved;
+static uint32_t join_cb_cnt;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv_saved = *drv;
+    buf_size_saved = drv->draw_buf->size;
+
+    /*A column of DRO value boxes*/
+    uint32_t i;
+    for(i = 0; i < BOX_CNT; i++) {
+        boxes[i] = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(boxes[i]);
+        lv_obj_set_size(boxes[i], BOX_W, BOX_H);
+        lv_obj_set_pos(boxes[i], 10, 10 + i * (BOX_H + BOX_GAP));
+    }
+
+    lv_refr_now(NULL);
+    lv_refr_reset_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->draw_buf->size = buf_size_saved;
+    drv->join_cb = drv_saved.join_cb;
+    drv->flush_cost = drv_saved.flush_cost;
+    drv->px_cost = drv_saved.px_cost;
+    lv_obj_clean(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void invalidate_boxes(void)
+{
+    uint32_t i;
+    for(i = 0; i < BOX_CNT; i++) lv_obj_invalidate(boxes[i]);
+    lv_refr_now(NULL);
+}
+
+static bool never_join_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area1, const lv_area_t * area2,
+                          const lv_area_t * joined)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(area1);
+    LV_UNUSED(area2);
+    LV_UNUSED(joined);
+    join_cb_cnt++;
+    return false;
+}
+
+void test_refr_join_without_cost_keeps_separate_areas(void)
+{
+    invalidate_boxes();
+
+    lv_refr_stat_t stat;
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT, stat.last.inv_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT, stat.last.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT, stat.last.flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT * INV_W * INV_H, stat.last.px_cnt);
+}
+
+void test_refr_join_by_cost_joins_close_areas(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cost = 1000;
+    drv->px_cost = 1;
+
+    invalidate_boxes();
+
+    /*The gaps cost less than the saved flushes so the boxes are refreshed as one area*/
+    uint32_t h = BOX_CNT * BOX_H + (BOX_CNT - 1) * BOX_GAP + 2 * INV_PAD;
+    lv_refr_stat_t stat;
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT, stat.last.inv_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.last.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.last.flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(INV_W * h, stat.last.px_cnt);
+}
+
+void test_refr_join_by_cost_keeps_far_areas(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cost = 1000;
+    drv->px_cost = 1;
+
+    /*Two boxes far from each other: the pixels in between cost more than a flush*/
+    lv_obj_set_y(boxes[BOX_CNT - 1], 400);
+    lv_refr_now(NULL);
+    lv_refr_reset_stat();
+
+    lv_obj_invalidate(boxes[0]);
+    lv_obj_invalidate(boxes[BOX_CNT - 1]);
+    lv_refr_now(NULL);
+
+    lv_refr_stat_t stat;
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.last.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * INV_W * INV_H, stat.last.px_cnt);
+}
+
+void test_refr_join_area_cost(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->draw_buf->size = BUF_ROWS * BOX_W;
+    drv->flush_cost = 300;
+    drv->px_cost = 2;
+
+    lv_area_t a = {0, 0, BOX_W - 1, BUF_ROWS - 1};
+    TEST_ASSERT_EQUAL_UINT64(300 + 2 * BOX_W * BUF_ROWS, lv_refr_get_area_cost(drv, &a));
+
+    /*One more row needs an other flush*/
+    a.y2++;
+    TEST_ASSERT_EQUAL_UINT64(2 * 300 + 2 * BOX_W * (BUF_ROWS + 1), lv_refr_get_area_cost(drv, &a));
+
+    /*Narrower areas fit more rows into the buffer*/
+    a.x2 = BOX_W / 2 - 1;
+    TEST_ASSERT_EQUAL_UINT64(300 + 2 * (BOX_W / 2) * (BUF_ROWS + 1), lv_refr_get_area_cost(drv, &a));
+}
+
+void test_refr_join_custom_cb(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->join_cb = never_join_cb;
+
+    /*Overlapping areas are not joined either*/
+    lv_obj_set_y(boxes[1], 10 + BOX_H / 2);
+    lv_refr_now(NULL);
+    lv_refr_reset_stat();
+
+    join_cb_cnt = 0;
+    invalidate_boxes();
+
+    lv_refr_stat_t stat;
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT, stat.last.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT * (BOX_CNT - 1), join_cb_cnt);
+}
+
+void test_refr_join_stat_sum_and_max(void)
+{
+    invalidate_boxes();
+    lv_obj_invalidate(boxes[0]);
+    lv_refr_now(NULL);
+
+    /*Nothing to refresh: not a frame*/
+    lv_refr_now(NULL);
+
+    lv_refr_stat_t stat;
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(2, stat.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.last.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT, stat.max.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT + 1, stat.sum.area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(BOX_CNT + 1, stat.sum.flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32((BOX_CNT + 1) * INV_W * INV_H, stat.sum.px_cnt);
+
+    lv_refr_reset_stat();
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.sum.px_cnt);
+}
+
+#endif
@@ -0,0 +1,152 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#define BENCH_LABELS    10
+#define BENCH_UPDATES   200
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_txt_size_cache_clear();
+    lv_txt_size_cache_reset_stat();
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_txt_size_cache_same_result(void)
+{
+    static const char * texts[] = {
+        "0.000",
+        "-1234.567",
+        "Branch Center",
+        "A longer text which needs to be wrapped into more lines",
+        "Line 1\nLine 2\r\nLine 3\n",
+        "A" LV_SYMBOL_OK "B" LV_SYMBOL_CLOSE,
+        "#ff0000 re#color",
+        "",
+    };
+    static const lv_coord_t widths[] = {LV_COORD_MAX, 100, 30};
+    const lv_font_t * font = &lv_font_montserrat_14;
+
+    uint32_t t, w, f;
+    for(t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+        for(w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            for(f = 0; f < 2; f++) {
+                lv_text_flag_t flag = f ? LV_TEXT_FLAG_RECOLOR : LV_TEXT_FLAG_NONE;
+                lv_point_t size_ref;
+                lv_point_t size_cached;
+                lv_txt_size_cache_clear();
+                lv_txt_get_size(&size_ref, texts[t], font, 2, 3, widths[w], flag);
+                lv_txt_get_size(&size_cached, texts[t], font, 2, 3, widths[w], flag);
+                TEST_ASSERT_EQUAL(size_ref.x, size_cached.x);
+                TEST_ASSERT_EQUAL(size_ref.y, size_cached.y);
+            }
+        }
+    }
+
+    lv_txt_size_cache_stat_t stat;
+    lv_txt_size_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(stat.lookup_cnt / 2, stat.hit_cnt);
+}
+
+void test_txt_size_cache_key(void)
+{
+    const lv_font_t * font = &lv_font_montserrat_14;
+    const char * txt = "Workpiece coordinates";
+    lv_point_t size_wide;
+    lv_point_t size_narrow;
+    lv_point_t size;
+
+    lv_txt_get_size(&size_wide, txt, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&size_narrow, txt, font, 0, 0, 60, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_GREATER_THAN(size_wide.y, size_narrow.y);
+
+    /*Every parameter is part of the key*/
+    lv_txt_get_size(&size, txt, font, 0, 0, 60, LV_TEXT_FLAG_EXPAND);
+    TEST_ASSERT_EQUAL(size_wide.x, size.x);
+    TEST_ASSERT_EQUAL(size_wide.y, size.y);
+    lv_txt_get_size(&size, txt, font, 4, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_GREATER_THAN(size_wide.x, size.x);
+#if LV_FONT_MONTSERRAT_24
+    lv_txt_get_size(&size, txt, &lv_font_montserrat_24, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_GREATER_THAN(size_wide.y, size.y);
+#endif
+
+    /*Same length, different text*/
+    lv_txt_get_size(&size, "1.111", font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_point_t size2;
+    lv_txt_get_size(&size2, "8.888", font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_NOT_EQUAL(size.x, size2.x);
+
+    lv_txt_size_cache_stat_t stat;
+    lv_txt_size_cache_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(0, stat.hit_cnt);
+
+    /*Too long texts are not cached but still measured*/
+    char long_txt[400];
+    lv_memset(long_txt, 'x', sizeof(long_txt) - 1);
+    long_txt[sizeof(long_txt) - 1] = '\0';
+    lv_txt_get_size(&size, long_txt, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&size2, long_txt, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(size.x, size2.x);
+    lv_txt_size_cache_stat_t stat2;
+    lv_txt_size_cache_get_stat(&stat2);
+    TEST_ASSERT_EQUAL_UINT32(stat.lookup_cnt, stat2.lookup_cnt);
+}
+
+void test_txt_size_cache_mixed_ascii_width(void)
+{
+    const lv_font_t * font = &lv_font_montserrat_14;
+    lv_coord_t w = lv_txt_get_width("A" LV_SYMBOL_OK "B", strlen("A" LV_SYMBOL_OK "B"), font, 1, LV_TEXT_FLAG_NONE);
+
+    lv_coord_t expected = lv_font_get_glyph_width(font, 'A', 0xF00C) +
+                          lv_font_get_glyph_width(font, 0xF00C, 'B') +
+                          lv_font_get_glyph_width(font, 'B', 0) + 2;
+    TEST_ASSERT_EQUAL(expected, w);
+
+    /*The symbol is a single letter when the lines are broken*/
+    lv_coord_t used_width;
+    uint32_t next = _lv_txt_get_next_line(LV_SYMBOL_OK "\nB", font, 0, LV_COORD_MAX, &used_width, LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL_UINT32(strlen(LV_SYMBOL_OK "\n"), next);
+    TEST_ASSERT_EQUAL(lv_font_get_glyph_width(font, 0xF00C, '\n'), used_width);
+}
+
+void test_txt_size_cache_label_updates(void)
+{
+    lv_obj_t * labels[BENCH_LABELS];
+    uint32_t i;
+    for(i = 0; i < BENCH_LABELS; i++) {
+        labels[i] = lv_label_create(lv_scr_act());
+        lv_obj_set_pos(labels[i], 10, i * 20);
+    }
+
+    lv_txt_size_cache_reset_stat();
+    uint32_t t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_UPDATES; i++) {
+        /*A DRO like update: only a few values change on every update*/
+        uint32_t l;
+        for(l = 0; l < BENCH_LABELS; l++) {
+            int32_t v = (l < 3) ? (int32_t)(i % 8) : (int32_t)l;
+            lv_label_set_text_fmt(labels[l], "%d.%03d", (int)v, (int)(v * 125));
+        }
+        lv_obj_update_layout(lv_scr_act());
+    }
+    uint32_t t_elaps = lv_test_time_us() - t_start;
+
+    lv_txt_size_cache_stat_t stat;
+    lv_txt_size_cache_get_stat(&stat);
+    TEST_PRINTF("text size lookups: %u, hits: %u, %u us/update", stat.lookup_cnt, stat.hit_cnt,
+                t_elaps / BENCH_UPDATES);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(stat.lookup_cnt * 9 / 10, stat.hit_cnt);
+}
+
+#endif
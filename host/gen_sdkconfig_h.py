@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Generate sdkconfig.h for the host simulation from sdkconfig files.
+
+The first file is the project's sdkconfig; the following ones are fragments
+applied on top of it in order (host/sdkconfig.host, host/sdkconfig.replay):
+
+    CONFIG_FOO=y          -> #define CONFIG_FOO 1
+    CONFIG_BAR=42         -> #define CONFIG_BAR 42
+    CONFIG_BAZ="text"     -> #define CONFIG_BAZ "text"
+    # CONFIG_FOO is not set  removes CONFIG_FOO
+
+Options that depend on a disabled one are not removed (there is no Kconfig
+here to evaluate the dependencies), which is harmless as the code only looks
+at them behind the parent option.
+
+    python host/gen_sdkconfig_h.py build/sdkconfig.h sdkconfig host/sdkconfig.host
+
+The output is only rewritten when it changes.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SET_RE = re.compile(r'^(CONFIG_[A-Za-z0-9_]+)=(.*)$')
+UNSET_RE = re.compile(r'^#\s*(CONFIG_[A-Za-z0-9_]+) is not set')
+
+
+def parse(path, options):
+    with open(path, encoding='utf-8') as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            m = SET_RE.match(line)
+            if m:
+                name, value = m.groups()
+                if value == 'y':
+                    value = '1'
+                elif value == 'n':
+                    options.pop(name, None)
+                    continue
+                elif not value:
+                    sys.exit('%s:%d: %s has no value' % (path, lineno, name))
+                options[name] = value
+                continue
+            m = UNSET_RE.match(line)
+            if m:
+                options.pop(m.group(1), None)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('output', help='sdkconfig.h to write')
+    parser.add_argument('sdkconfig', nargs='+', help='sdkconfig, then fragments')
+    args = parser.parse_args()
+
+    options = {}
+    for path in args.sdkconfig:
+        parse(path, options)
+
+    lines = ['/* Generated by host/gen_sdkconfig_h.py from %s. */' % ', '.join(
+                 os.path.basename(p) for p in args.sdkconfig),
+             '#pragma once', '']
+    lines += ['#define %s %s' % (name, value) for name, value in options.items()]
+    text = '\n'.join(lines) + '\n'
+
+    try:
+        with open(args.output, encoding='utf-8') as f:
+            if f.read() == text:
+                return
+    except FileNotFoundError:
+        pass
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
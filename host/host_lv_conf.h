@@ -0,0 +1,8 @@
+#pragma once
+// LVGL在主机上的Kconfig配置：与固件一样取自sdkconfig.h（LV_CONF_SKIP），
+// lv_conf_kconfig.h只在ESP_PLATFORM下定义的tick表达式在这里补上
+#include "sdkconfig.h"
+
+#if defined(CONFIG_LV_TICK_CUSTOM) && !defined(CONFIG_LV_TICK_CUSTOM_SYS_TIME_EXPR)
+#define CONFIG_LV_TICK_CUSTOM_SYS_TIME_EXPR ((uint32_t)(esp_timer_get_time() / 1000LL))
+#endif
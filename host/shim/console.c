@@ -0,0 +1,98 @@
+#include <pthread.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "driver/usb_serial_jtag.h"
+#include "sim.h"
+
+// USB-Serial-JTAG控制台：输出写到标准输出，输入是标准输入与脚本console命令送入的字符
+
+#define CONSOLE_RX_LEN  256
+
+static pthread_mutex_t console_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t console_cond;
+static uint8_t console_rx[CONSOLE_RX_LEN];
+static size_t console_head, console_count;
+static bool console_installed = false;
+static pthread_t stdin_thread;
+static pthread_once_t console_once = PTHREAD_ONCE_INIT;
+
+static void console_init(void)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&console_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+void sim_console_input(const char *text)
+{
+    pthread_once(&console_once, console_init);
+    pthread_mutex_lock(&console_lock);
+    for (; *text && console_count < CONSOLE_RX_LEN; text++) {
+        console_rx[(console_head + console_count++) % CONSOLE_RX_LEN] = (uint8_t)*text;
+    }
+    pthread_cond_broadcast(&console_cond);
+    pthread_mutex_unlock(&console_lock);
+}
+
+static void *stdin_thread_fn(void *arg)
+{
+    char buf[64];
+    ssize_t n;
+    while ((n = read(STDIN_FILENO, buf, sizeof(buf) - 1)) > 0) {
+        buf[n] = '\0';
+        sim_console_input(buf);
+    }
+    return NULL;
+}
+
+esp_err_t usb_serial_jtag_driver_install(usb_serial_jtag_driver_config_t *config)
+{
+    if (console_installed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    console_installed = true;
+    pthread_once(&console_once, console_init);
+    if (isatty(STDIN_FILENO)) {
+        sim_thread_start(&stdin_thread, SIM_RT_PRIO_PERIPH, stdin_thread_fn, NULL, "console_in");
+    }
+    return ESP_OK;
+}
+
+int usb_serial_jtag_read_bytes(void *buf, uint32_t length, TickType_t ticks_to_wait)
+{
+    uint8_t *dst = buf;
+    uint32_t n = 0;
+    struct timespec deadline;
+    bool timed = ticks_to_wait != portMAX_DELAY;
+    if (timed) {
+        int64_t tick_us = 1000000 / configTICK_RATE_HZ;
+        sim_abs_timespec((sim_time_us() / tick_us + ticks_to_wait) * tick_us, &deadline);
+    }
+    pthread_mutex_lock(&console_lock);
+    // 与驱动相同：有数据就返回已有的部分
+    while (console_count == 0) {
+        int err = timed ? pthread_cond_timedwait(&console_cond, &console_lock, &deadline)
+                        : pthread_cond_wait(&console_cond, &console_lock);
+        if (err == ETIMEDOUT) {
+            break;
+        }
+    }
+    while (console_count && n < length) {
+        dst[n++] = console_rx[console_head];
+        console_head = (console_head + 1) % CONSOLE_RX_LEN;
+        console_count--;
+    }
+    pthread_mutex_unlock(&console_lock);
+    return (int)n;
+}
+
+int usb_serial_jtag_write_bytes(const void *src, size_t size, TickType_t ticks_to_wait)
+{
+    size_t n = fwrite(src, 1, size, stdout);
+    fflush(stdout);
+    return (int)n;
+}
@@ -0,0 +1,175 @@
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_pm.h"
+#include "esp_cpu.h"
+#include "esp_rom_crc.h"
+#include "esp_app_desc.h"
+#include "esp_private/esp_clk.h"
+#include "sim_compat.h"
+#include "sim.h"
+
+// 其余ESP-IDF接口：日志、错误名、CRC、应用描述、时钟、复位原因、堆与PM锁
+
+static pthread_mutex_t log_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// ==================== 日志 ====================
+uint32_t esp_log_timestamp(void)
+{
+    return (uint32_t)(sim_time_us() / 1000);
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    pthread_mutex_lock(&log_lock);
+    vprintf(format, args);
+    fflush(stdout);
+    pthread_mutex_unlock(&log_lock);
+    va_end(args);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+        case ESP_OK: return "ESP_OK";
+        case ESP_FAIL: return "ESP_FAIL";
+        case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE: return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_CRC: return "ESP_ERR_INVALID_CRC";
+        case ESP_ERR_INVALID_VERSION: return "ESP_ERR_INVALID_VERSION";
+        default: return "UNKNOWN ERROR";
+    }
+}
+
+__attribute__((weak)) size_t strlcpy(char *dst, const char *src, size_t size)
+{
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+// ==================== CRC ====================
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// ==================== 应用描述 ====================
+static esp_app_desc_t app_desc;
+static pthread_once_t app_desc_once = PTHREAD_ONCE_INIT;
+
+static void app_desc_init(void)
+{
+    app_desc.magic_word = 0xABCD5432;
+    strlcpy(app_desc.version, "host-sim", sizeof(app_desc.version));
+    strlcpy(app_desc.project_name, "pendant", sizeof(app_desc.project_name));
+    strlcpy(app_desc.time, __TIME__, sizeof(app_desc.time));
+    strlcpy(app_desc.date, __DATE__, sizeof(app_desc.date));
+    strlcpy(app_desc.idf_ver, "host", sizeof(app_desc.idf_ver));
+    // 没有ELF哈希：用编译时间代替（会话记录的build id）
+    uint32_t h = esp_rom_crc32_le(0, (const uint8_t *)__DATE__ __TIME__, sizeof(__DATE__ __TIME__) - 1);
+    memcpy(app_desc.app_elf_sha256, &h, sizeof(h));
+}
+
+const esp_app_desc_t *esp_app_get_description(void)
+{
+    pthread_once(&app_desc_once, app_desc_init);
+    return &app_desc;
+}
+
+// ==================== 时钟 ====================
+int esp_clk_cpu_freq(void)
+{
+    return SIM_CPU_FREQ_HZ;
+}
+
+uint64_t esp_clk_rtc_time(void)
+{
+    return (uint64_t)sim_time_us();
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+    return (uint32_t)(sim_time_us() * (SIM_CPU_FREQ_HZ / 1000000));
+}
+
+// ==================== 系统 ====================
+esp_reset_reason_t esp_reset_reason(void)
+{
+    return ESP_RST_POWERON;
+}
+
+// 目标上的堆在主机上没有对应：按ESP32-C6启动后的典型值报告
+uint32_t esp_get_free_heap_size(void)
+{
+    return 300 * 1024;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    return 300 * 1024;
+}
+
+void esp_restart(void)
+{
+    fflush(stdout);
+    exit(0);
+}
+
+// ==================== PM锁 ====================
+struct esp_pm_lock {
+    esp_pm_lock_type_t type;
+    const char *name;
+    int count;
+};
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t lock_type, int arg, const char *name, esp_pm_lock_handle_t *out_handle)
+{
+    struct esp_pm_lock *lock = calloc(1, sizeof(*lock));
+    if (lock == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    lock->type = lock_type;
+    lock->name = name;
+    *out_handle = lock;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle)
+{
+    __atomic_add_fetch(&handle->count, 1, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle)
+{
+    if (__atomic_sub_fetch(&handle->count, 1, __ATOMIC_RELAXED) < 0) {
+        __atomic_add_fetch(&handle->count, 1, __ATOMIC_RELAXED);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,237 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include "esp_timer.h"
+#include "esp_freertos_hooks.h"
+#include "freertos/FreeRTOS.h"
+#include "sim.h"
+
+// esp_timer：与ESP-IDF相同，一个高优先级的esp_timer任务按到期顺序执行回调，
+// ESP_TIMER_ISR的回调投递到中断上下文。FreeRTOS的tick中断（tick钩子）也由它产生
+
+#define ESP_TIMER_TASK_PRIO     22
+#define TICK_US                 (1000000 / configTICK_RATE_HZ)
+#define MAX_TICK_HOOKS          8
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch;
+    const char *name;
+    int64_t alarm_us;
+    uint64_t period_us;
+    bool active;
+    struct esp_timer *next;
+};
+
+static struct timespec sim_epoch;
+static pthread_mutex_t timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t timer_cond;
+static struct esp_timer *timer_list = NULL;     // 按到期时间排序的活动定时器
+static pthread_t timer_thread;
+
+static esp_freertos_tick_cb_t tick_hooks[MAX_TICK_HOOKS];
+static int tick_hook_count = 0;
+static esp_timer_handle_t tick_timer = NULL;
+
+// ==================== 时间基准 ====================
+int64_t sim_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)(ts.tv_sec - sim_epoch.tv_sec) * 1000000 + (ts.tv_nsec - sim_epoch.tv_nsec) / 1000;
+}
+
+void sim_abs_timespec(int64_t t_us, struct timespec *ts)
+{
+    int64_t ns = sim_epoch.tv_nsec + (t_us % 1000000) * 1000;
+    ts->tv_sec = sim_epoch.tv_sec + t_us / 1000000 + ns / 1000000000;
+    ts->tv_nsec = ns % 1000000000;
+}
+
+void sim_sleep_until_us(int64_t t_us)
+{
+    struct timespec ts;
+    sim_abs_timespec(t_us, &ts);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return sim_time_us();
+}
+
+// ==================== 定时器 ====================
+static void timer_insert(struct esp_timer *timer)
+{
+    struct esp_timer **p = &timer_list;
+    while (*p && (*p)->alarm_us <= timer->alarm_us) {
+        p = &(*p)->next;
+    }
+    timer->next = *p;
+    *p = timer;
+    timer->active = true;
+}
+
+static void timer_remove(struct esp_timer *timer)
+{
+    for (struct esp_timer **p = &timer_list; *p; p = &(*p)->next) {
+        if (*p == timer) {
+            *p = timer->next;
+            break;
+        }
+    }
+    timer->active = false;
+}
+
+static void *timer_thread_fn(void *arg)
+{
+    pthread_mutex_lock(&timer_lock);
+    while (1) {
+        if (timer_list == NULL) {
+            pthread_cond_wait(&timer_cond, &timer_lock);
+            continue;
+        }
+        struct esp_timer *timer = timer_list;
+        int64_t now = sim_time_us();
+        if (timer->alarm_us > now) {
+            struct timespec ts;
+            sim_abs_timespec(timer->alarm_us, &ts);
+            pthread_cond_timedwait(&timer_cond, &timer_lock, &ts);
+            continue;
+        }
+        timer_remove(timer);
+        if (timer->period_us) {
+            timer->alarm_us += timer->period_us;
+            if (timer->alarm_us <= now) {
+                // 跟不上时跳过错过的周期
+                timer->alarm_us = now + timer->period_us;
+            }
+            timer_insert(timer);
+        }
+        esp_timer_cb_t callback = timer->callback;
+        void *cb_arg = timer->arg;
+        esp_timer_dispatch_t dispatch = timer->dispatch;
+        pthread_mutex_unlock(&timer_lock);
+        if (dispatch == ESP_TIMER_ISR) {
+            sim_isr_post(callback, cb_arg);
+        } else {
+            callback(cb_arg);
+        }
+        pthread_mutex_lock(&timer_lock);
+    }
+    return NULL;
+}
+
+void sim_esp_timer_init(void)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&timer_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    clock_gettime(CLOCK_MONOTONIC, &sim_epoch);
+    sim_thread_start(&timer_thread, SIM_RT_PRIO_TASK + ESP_TIMER_TASK_PRIO, timer_thread_fn, NULL, "esp_timer");
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (create_args == NULL || create_args->callback == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct esp_timer *timer = calloc(1, sizeof(*timer));
+    if (timer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    timer->callback = create_args->callback;
+    timer->arg = create_args->arg;
+    timer->dispatch = create_args->dispatch_method;
+    timer->name = create_args->name;
+    *out_handle = timer;
+    return ESP_OK;
+}
+
+static esp_err_t timer_start(esp_timer_handle_t timer, uint64_t timeout_us, uint64_t period_us)
+{
+    pthread_mutex_lock(&timer_lock);
+    if (timer->active) {
+        pthread_mutex_unlock(&timer_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->alarm_us = sim_time_us() + (int64_t)timeout_us;
+    timer->period_us = period_us;
+    timer_insert(timer);
+    pthread_cond_signal(&timer_cond);
+    pthread_mutex_unlock(&timer_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us)
+{
+    return timer_start(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period)
+{
+    return timer_start(timer, period, period);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&timer_lock);
+    if (!timer->active) {
+        pthread_mutex_unlock(&timer_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer_remove(timer);
+    pthread_mutex_unlock(&timer_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer)
+{
+    if (esp_timer_is_active(timer)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    free(timer);
+    return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer)
+{
+    pthread_mutex_lock(&timer_lock);
+    bool active = timer->active;
+    pthread_mutex_unlock(&timer_lock);
+    return active;
+}
+
+// ==================== tick钩子 ====================
+static void tick_isr(void *arg)
+{
+    for (int i = 0; i < tick_hook_count; i++) {
+        tick_hooks[i]();
+    }
+}
+
+esp_err_t esp_register_freertos_tick_hook(esp_freertos_tick_cb_t new_tick_cb)
+{
+    if (tick_hook_count >= MAX_TICK_HOOKS) {
+        return ESP_ERR_NO_MEM;
+    }
+    tick_hooks[tick_hook_count++] = new_tick_cb;
+    if (tick_timer == NULL) {
+        const esp_timer_create_args_t args = {.callback = tick_isr, .dispatch_method = ESP_TIMER_ISR, .name = "tick"};
+        esp_timer_create(&args, &tick_timer);
+        // 第一次在下一个节拍边界触发，之后每个节拍一次
+        pthread_mutex_lock(&timer_lock);
+        tick_timer->alarm_us = (sim_time_us() / TICK_US + 1) * TICK_US;
+        tick_timer->period_us = TICK_US;
+        timer_insert(tick_timer);
+        pthread_cond_signal(&timer_cond);
+        pthread_mutex_unlock(&timer_lock);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,611 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
+#include "sim.h"
+
+// FreeRTOS API在pthread上的实现：任务是线程，阻塞是条件变量上的等待，节拍由单调时钟换算。
+// 实时调度时所有线程在同一个CPU上以SCHED_FIFO运行，高优先级任务就绪时立即抢占低优先级任务，
+// 与单核FreeRTOS的调度一致；临界区是一把带优先级继承的递归锁
+
+#define TICK_US             (1000000 / configTICK_RATE_HZ)
+#define SIM_TASK_STACK      (256 * 1024)    // 主机上printf等占用的栈比目标大得多，不使用任务的栈深度
+#define ISR_QUEUE_LEN       256
+
+struct sim_task {
+    pthread_t thread;
+    char name[configMAX_TASK_NAME_LEN];
+    TaskFunction_t fn;
+    void *arg;
+    UBaseType_t prio;
+    UBaseType_t number;
+    clockid_t cpu_clock;
+    bool started;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+    struct sim_task *next;
+};
+
+struct sim_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint8_t *buf;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t count;
+    UBaseType_t head;
+};
+
+struct sim_stream {
+    pthread_mutex_t lock;
+    pthread_cond_t data;
+    pthread_cond_t space;
+    uint8_t *buf;
+    size_t size;
+    size_t head;
+    size_t count;
+    size_t trigger;
+};
+
+bool sim_rt = false;
+
+static pthread_mutex_t task_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct sim_task *task_list = NULL;
+static UBaseType_t task_number = 0;
+static uint64_t deleted_runtime_us = 0;     // 已删除任务的CPU时间（计入总数，不再单独列出）
+static __thread struct sim_task *current_task = NULL;
+static __thread bool in_isr = false;
+
+static pthread_mutex_t critical_lock;
+
+// ==================== 线程与时间 ====================
+static void cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+void sim_thread_start(pthread_t *thread, int rt_prio, void *(*fn)(void *), void *arg, const char *name)
+{
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, SIM_TASK_STACK);
+    if (sim_rt) {
+        struct sched_param param = {.sched_priority = rt_prio};
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    int err = pthread_create(thread, &attr, fn, arg);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        fprintf(stderr, "sim: cannot create thread %s: %s\n", name, strerror(err));
+        exit(1);
+    }
+    char short_name[16];
+    strlcpy(short_name, name, sizeof(short_name));
+    pthread_setname_np(*thread, short_name);
+}
+
+// FreeRTOS的超时从当前节拍起算：ticks个节拍后的节拍边界
+static bool tick_deadline(TickType_t ticks, struct timespec *ts)
+{
+    if (ticks == portMAX_DELAY) {
+        return false;
+    }
+    int64_t now_tick = sim_time_us() / TICK_US;
+    sim_abs_timespec((now_tick + ticks) * TICK_US, ts);
+    return true;
+}
+
+// 等待条件变量，超时返回false
+static bool cond_wait(pthread_cond_t *cond, pthread_mutex_t *lock, bool timed, const struct timespec *ts)
+{
+    if (!timed) {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, lock, ts) != ETIMEDOUT;
+}
+
+void sim_critical_enter(portMUX_TYPE *mux)
+{
+    pthread_mutex_lock(&critical_lock);
+}
+
+void sim_critical_exit(portMUX_TYPE *mux)
+{
+    pthread_mutex_unlock(&critical_lock);
+}
+
+BaseType_t xPortInIsrContext(void)
+{
+    return in_isr;
+}
+
+void vPortYield(void)
+{
+    sched_yield();
+}
+
+// ==================== 中断上下文 ====================
+static struct {
+    void (*fn)(void *);
+    void *arg;
+} isr_queue[ISR_QUEUE_LEN];
+static unsigned isr_head, isr_count;
+static pthread_mutex_t isr_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t isr_cond;
+static pthread_t isr_thread;
+
+void sim_isr_post(void (*fn)(void *), void *arg)
+{
+    pthread_mutex_lock(&isr_lock);
+    if (isr_count == ISR_QUEUE_LEN) {
+        pthread_mutex_unlock(&isr_lock);
+        fprintf(stderr, "sim: interrupt queue full, interrupt lost\n");
+        return;
+    }
+    unsigned i = (isr_head + isr_count++) % ISR_QUEUE_LEN;
+    isr_queue[i].fn = fn;
+    isr_queue[i].arg = arg;
+    pthread_cond_signal(&isr_cond);
+    pthread_mutex_unlock(&isr_lock);
+}
+
+static void *isr_thread_fn(void *arg)
+{
+    in_isr = true;
+    while (1) {
+        pthread_mutex_lock(&isr_lock);
+        while (isr_count == 0) {
+            pthread_cond_wait(&isr_cond, &isr_lock);
+        }
+        void (*fn)(void *) = isr_queue[isr_head].fn;
+        void *fn_arg = isr_queue[isr_head].arg;
+        isr_head = (isr_head + 1) % ISR_QUEUE_LEN;
+        isr_count--;
+        pthread_mutex_unlock(&isr_lock);
+        fn(fn_arg);
+    }
+    return NULL;
+}
+
+void sim_isr_init(void)
+{
+    cond_init(&isr_cond);
+    sim_thread_start(&isr_thread, SIM_RT_PRIO_ISR, isr_thread_fn, NULL, "isr");
+}
+
+void sim_freertos_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&critical_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+// ==================== 任务 ====================
+static void *task_entry(void *arg)
+{
+    struct sim_task *task = arg;
+    current_task = task;
+    pthread_getcpuclockid(pthread_self(), &task->cpu_clock);
+    pthread_mutex_lock(&task_list_lock);
+    task->started = true;
+    pthread_mutex_unlock(&task_list_lock);
+    task->fn(task->arg);
+    fprintf(stderr, "sim: task %s returned from its function\n", task->name);
+    abort();
+}
+
+static TaskHandle_t task_create(TaskFunction_t fn, const char *name, void *arg, UBaseType_t prio)
+{
+    struct sim_task *task = calloc(1, sizeof(*task));
+    if (task == NULL) {
+        return NULL;
+    }
+    strlcpy(task->name, name, sizeof(task->name));
+    task->fn = fn;
+    task->arg = arg;
+    task->prio = prio < configMAX_PRIORITIES ? prio : configMAX_PRIORITIES - 1;
+    pthread_mutex_init(&task->lock, NULL);
+    cond_init(&task->cond);
+
+    pthread_mutex_lock(&task_list_lock);
+    task->number = ++task_number;
+    task->next = task_list;
+    task_list = task;
+    pthread_mutex_unlock(&task_list_lock);
+
+    sim_thread_start(&task->thread, SIM_RT_PRIO_TASK + (int)task->prio, task_entry, task, task->name);
+    return task;
+}
+
+void sim_freertos_start_main(void (*fn)(void *), int prio)
+{
+    task_create(fn, "main", NULL, prio);
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                               UBaseType_t prio, StackType_t *stack, StaticTask_t *tcb)
+{
+    return task_create(fn, name, arg, prio);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t prio, TaskHandle_t *out)
+{
+    TaskHandle_t task = task_create(fn, name, arg, prio);
+    if (out) {
+        *out = task;
+    }
+    return task ? pdPASS : pdFAIL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *out, BaseType_t core)
+{
+    return xTaskCreate(fn, name, stack_depth, arg, prio, out);
+}
+
+static uint64_t task_runtime_us(const struct sim_task *task)
+{
+    struct timespec ts;
+    if (!task->started || clock_gettime(task->cpu_clock, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task != NULL && task != current_task) {
+        fprintf(stderr, "sim: vTaskDelete of another task is not supported\n");
+        abort();
+    }
+    task = current_task;
+    pthread_mutex_lock(&task_list_lock);
+    for (struct sim_task **p = &task_list; *p; p = &(*p)->next) {
+        if (*p == task) {
+            *p = task->next;
+            break;
+        }
+    }
+    deleted_runtime_us += task_runtime_us(task);
+    pthread_mutex_unlock(&task_list_lock);
+    // 任务结构不释放：句柄可能还留在别处
+    pthread_exit(NULL);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(sim_time_us() / TICK_US);
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return current_task;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    if (ticks == 0) {
+        sched_yield();
+        return;
+    }
+    sim_sleep_until_us(((int64_t)xTaskGetTickCount() + ticks) * TICK_US);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *prev_wake, TickType_t increment)
+{
+    TickType_t now = xTaskGetTickCount();
+    TickType_t wake = *prev_wake + increment;
+    // 与FreeRTOS相同：唤醒时间已过去时不延时
+    bool should_delay = (TickType_t)(wake - *prev_wake) > (TickType_t)(now - *prev_wake);
+    *prev_wake = wake;
+    if (should_delay) {
+        sim_sleep_until_us(((int64_t)now + (TickType_t)(wake - now)) * TICK_US);
+    } else {
+        sched_yield();
+    }
+    return should_delay ? pdTRUE : pdFALSE;
+}
+
+// ==================== 任务通知 ====================
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait)
+{
+    struct sim_task *task = current_task;
+    struct timespec ts;
+    bool timed = tick_deadline(ticks_to_wait, &ts);
+    pthread_mutex_lock(&task->lock);
+    while (task->notify == 0 && cond_wait(&task->cond, &task->lock, timed, &ts)) {
+    }
+    uint32_t value = task->notify;
+    if (value) {
+        task->notify = clear_on_exit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->lock);
+    task->notify++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_prio_woken)
+{
+    xTaskNotifyGive(task);
+    if (higher_prio_woken) {
+        *higher_prio_woken = pdFALSE;   // 线程被唤醒时由Linux调度器立即抢占
+    }
+}
+
+// ==================== 运行时间统计 ====================
+// ulRunTimeCounter为线程CPU时间；"IDLE"为总时间中没有任务运行的部分（中断线程的时间也算在内）
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t max, configRUN_TIME_COUNTER_TYPE *total_runtime)
+{
+    uint64_t total = (uint64_t)sim_time_us();
+    uint64_t busy = deleted_runtime_us;
+    UBaseType_t n = 0;
+    pthread_mutex_lock(&task_list_lock);
+    for (struct sim_task *task = task_list; task; task = task->next) {
+        uint64_t runtime = task_runtime_us(task);
+        busy += runtime;
+        if (n + 1 >= max) {
+            continue;
+        }
+        status[n++] = (TaskStatus_t){
+            .xHandle = task,
+            .pcTaskName = task->name,
+            .xTaskNumber = task->number,
+            .eCurrentState = (task == current_task) ? eRunning : eBlocked,
+            .uxCurrentPriority = task->prio,
+            .uxBasePriority = task->prio,
+            .ulRunTimeCounter = (configRUN_TIME_COUNTER_TYPE)runtime,
+        };
+    }
+    pthread_mutex_unlock(&task_list_lock);
+    if (n < max) {
+        status[n++] = (TaskStatus_t){
+            .pcTaskName = "IDLE",
+            .xTaskNumber = 0,
+            .eCurrentState = eReady,
+            .ulRunTimeCounter = (configRUN_TIME_COUNTER_TYPE)(total > busy ? total - busy : 0),
+        };
+    }
+    if (total_runtime) {
+        *total_runtime = (configRUN_TIME_COUNTER_TYPE)total;
+    }
+    return n;
+}
+
+void sim_print_task_stats(void)
+{
+    int64_t total = sim_time_us();
+    printf("%-16s %4s %10s %6s\n", "task", "prio", "cpu_ms", "cpu%");
+    pthread_mutex_lock(&task_list_lock);
+    for (struct sim_task *task = task_list; task; task = task->next) {
+        uint64_t runtime = task_runtime_us(task);
+        printf("%-16s %4u %10.1f %6.2f\n", task->name, task->prio, runtime / 1000.0,
+               total ? runtime * 100.0 / total : 0.0);
+    }
+    pthread_mutex_unlock(&task_list_lock);
+}
+
+// ==================== 队列与信号量 ====================
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct sim_queue *queue = calloc(1, sizeof(*queue));
+    if (queue == NULL) {
+        return NULL;
+    }
+    if (item_size) {
+        queue->buf = malloc((size_t)length * item_size);
+        if (queue->buf == NULL) {
+            free(queue);
+            return NULL;
+        }
+    }
+    queue->length = length;
+    queue->item_size = item_size;
+    pthread_mutex_init(&queue->lock, NULL);
+    cond_init(&queue->not_empty);
+    cond_init(&queue->not_full);
+    return queue;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t *storage, StaticQueue_t *buf)
+{
+    return xQueueCreate(length, item_size);
+}
+
+SemaphoreHandle_t sim_semaphore_create(UBaseType_t max, UBaseType_t initial)
+{
+    QueueHandle_t sem = xQueueCreate(max, 0);
+    if (sem) {
+        sem->count = initial;
+    }
+    return sem;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+    free(queue->buf);
+    free(queue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait)
+{
+    struct timespec ts;
+    bool timed = tick_deadline(ticks_to_wait, &ts);
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->length) {
+        if (!cond_wait(&queue->not_full, &queue->lock, timed, &ts)) {
+            pthread_mutex_unlock(&queue->lock);
+            return pdFALSE;
+        }
+    }
+    if (queue->item_size) {
+        UBaseType_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(queue->buf + (size_t)tail * queue->item_size, item, queue->item_size);
+    }
+    queue->count++;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+    return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_prio_woken)
+{
+    if (higher_prio_woken) {
+        *higher_prio_woken = pdFALSE;
+    }
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks_to_wait)
+{
+    struct timespec ts;
+    bool timed = tick_deadline(ticks_to_wait, &ts);
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0) {
+        if (!cond_wait(&queue->not_empty, &queue->lock, timed, &ts)) {
+            pthread_mutex_unlock(&queue->lock);
+            return pdFALSE;
+        }
+    }
+    if (queue->item_size) {
+        memcpy(item, queue->buf + (size_t)queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1) % queue->length;
+    }
+    queue->count--;
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    queue->count = 0;
+    queue->head = 0;
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+// ==================== 流缓冲区 ====================
+StreamBufferHandle_t xStreamBufferCreate(size_t size, size_t trigger_level)
+{
+    struct sim_stream *stream = calloc(1, sizeof(*stream));
+    if (stream == NULL) {
+        return NULL;
+    }
+    stream->buf = malloc(size);
+    if (stream->buf == NULL) {
+        free(stream);
+        return NULL;
+    }
+    stream->size = size;
+    stream->trigger = trigger_level ? trigger_level : 1;
+    pthread_mutex_init(&stream->lock, NULL);
+    cond_init(&stream->data);
+    cond_init(&stream->space);
+    return stream;
+}
+
+size_t xStreamBufferSend(StreamBufferHandle_t stream, const void *data, size_t len, TickType_t ticks_to_wait)
+{
+    const uint8_t *src = data;
+    size_t sent = 0;
+    struct timespec ts;
+    bool timed = tick_deadline(ticks_to_wait, &ts);
+    pthread_mutex_lock(&stream->lock);
+    while (sent < len) {
+        while (stream->count < stream->size && sent < len) {
+            stream->buf[(stream->head + stream->count++) % stream->size] = src[sent++];
+        }
+        pthread_cond_signal(&stream->data);
+        if (sent < len && !cond_wait(&stream->space, &stream->lock, timed, &ts)) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stream->lock);
+    return sent;
+}
+
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t stream, const void *data, size_t len, BaseType_t *woken)
+{
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    return xStreamBufferSend(stream, data, len, 0);
+}
+
+size_t xStreamBufferReceive(StreamBufferHandle_t stream, void *data, size_t len, TickType_t ticks_to_wait)
+{
+    uint8_t *dst = data;
+    struct timespec ts;
+    bool timed = tick_deadline(ticks_to_wait, &ts);
+    size_t want = len < stream->trigger ? len : stream->trigger;
+    pthread_mutex_lock(&stream->lock);
+    while (stream->count < want && cond_wait(&stream->data, &stream->lock, timed, &ts)) {
+    }
+    size_t n = 0;
+    while (n < len && stream->count > 0) {
+        dst[n++] = stream->buf[stream->head];
+        stream->head = (stream->head + 1) % stream->size;
+        stream->count--;
+    }
+    if (n) {
+        pthread_cond_signal(&stream->space);
+    }
+    pthread_mutex_unlock(&stream->lock);
+    return n;
+}
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t stream)
+{
+    pthread_mutex_lock(&stream->lock);
+    size_t count = stream->count;
+    pthread_mutex_unlock(&stream->lock);
+    return count;
+}
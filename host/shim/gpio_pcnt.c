@@ -0,0 +1,254 @@
+#include <pthread.h>
+#include <stdio.h>
+#include "driver/gpio.h"
+#include "driver/pcnt.h"
+#include "soc/gpio_struct.h"
+#include "sim.h"
+
+// GPIO与PCNT：引脚电平由脚本驱动，边沿按配置的中断类型投递到中断上下文；
+// PCNT计数直接由脚本注入（不模拟A/B相波形），行为与旧版驱动相同：到达上下限时清零
+
+gpio_dev_t GPIO;
+
+typedef struct {
+    int driven;             // 外部驱动的电平，-1为未驱动
+    int out_level;          // 输出模式下写入的电平
+    gpio_mode_t mode;
+    bool pull_up;
+    bool pull_down;
+    gpio_int_type_t intr_type;
+    gpio_isr_t isr;
+    void *isr_arg;
+} sim_pin_t;
+
+typedef struct {
+    int16_t count;
+    int16_t h_lim;
+    int16_t l_lim;
+    bool paused;
+    bool configured;
+} sim_pcnt_t;
+
+static pthread_mutex_t gpio_lock = PTHREAD_MUTEX_INITIALIZER;
+static sim_pin_t pins[GPIO_NUM_MAX] = {
+    [0 ... GPIO_NUM_MAX - 1] = {.driven = -1},
+};
+static bool isr_service = false;
+static sim_pcnt_t pcnt_units[PCNT_UNIT_MAX];
+
+static int pin_level(const sim_pin_t *pin)
+{
+    if (pin->mode & GPIO_MODE_OUTPUT) {
+        return pin->out_level;
+    }
+    if (pin->driven >= 0) {
+        return pin->driven;
+    }
+    return pin->pull_up ? 1 : 0;
+}
+
+// ==================== GPIO ====================
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+    pthread_mutex_lock(&gpio_lock);
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        if (config->pin_bit_mask & (1ULL << i)) {
+            pins[i].mode = config->mode;
+            pins[i].pull_up = config->pull_up_en;
+            pins[i].pull_down = config->pull_down_en;
+            pins[i].intr_type = config->intr_type;
+        }
+    }
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return 0;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    int level = pin_level(&pins[gpio_num]);
+    pthread_mutex_unlock(&gpio_lock);
+    return level;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    pins[gpio_num].out_level = level ? 1 : 0;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    pins[gpio_num].intr_type = intr_type;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    if (isr_service) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    isr_service = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    if (!isr_service) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (gpio_num < 0 || gpio_num >= GPIO_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    pins[gpio_num].isr = isr_handler;
+    pins[gpio_num].isr_arg = args;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+// 主机仿真不睡眠：唤醒配置不改变中断行为
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio_num)
+{
+    return ESP_OK;
+}
+
+void sim_gpio_drive(int num, int level)
+{
+    if (num < 0 || num >= GPIO_NUM_MAX) {
+        fprintf(stderr, "sim: no GPIO %d\n", num);
+        return;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    sim_pin_t *pin = &pins[num];
+    int old_level = pin_level(pin);
+    pin->driven = level < 0 ? -1 : (level ? 1 : 0);
+    int new_level = pin_level(pin);
+    bool fire = false;
+    if (new_level != old_level && pin->isr) {
+        switch (pin->intr_type) {
+            case GPIO_INTR_POSEDGE: fire = new_level; break;
+            case GPIO_INTR_NEGEDGE: fire = !new_level; break;
+            case GPIO_INTR_ANYEDGE: fire = true; break;
+            case GPIO_INTR_HIGH_LEVEL: fire = new_level; break;
+            case GPIO_INTR_LOW_LEVEL: fire = !new_level; break;
+            default: break;
+        }
+    }
+    gpio_isr_t isr = pin->isr;
+    void *isr_arg = pin->isr_arg;
+    pthread_mutex_unlock(&gpio_lock);
+    if (fire) {
+        sim_isr_post(isr, isr_arg);
+    }
+}
+
+// ==================== PCNT ====================
+esp_err_t pcnt_unit_config(const pcnt_config_t *config)
+{
+    if (config->unit >= PCNT_UNIT_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    sim_pcnt_t *unit = &pcnt_units[config->unit];
+    unit->h_lim = config->counter_h_lim;
+    unit->l_lim = config->counter_l_lim;
+    unit->count = 0;
+    unit->configured = true;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+esp_err_t pcnt_get_counter_value(pcnt_unit_t unit, int16_t *count)
+{
+    if (unit >= PCNT_UNIT_MAX || count == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    *count = pcnt_units[unit].count;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+static esp_err_t pcnt_set_paused(pcnt_unit_t unit, bool paused)
+{
+    if (unit >= PCNT_UNIT_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    pcnt_units[unit].paused = paused;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_pause(pcnt_unit_t unit)
+{
+    return pcnt_set_paused(unit, true);
+}
+
+esp_err_t pcnt_counter_resume(pcnt_unit_t unit)
+{
+    return pcnt_set_paused(unit, false);
+}
+
+esp_err_t pcnt_counter_clear(pcnt_unit_t unit)
+{
+    if (unit >= PCNT_UNIT_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    pcnt_units[unit].count = 0;
+    pthread_mutex_unlock(&gpio_lock);
+    sim_jog_cleared();
+    return ESP_OK;
+}
+
+esp_err_t pcnt_set_filter_value(pcnt_unit_t unit, uint16_t filter_val)
+{
+    return unit < PCNT_UNIT_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_filter_enable(pcnt_unit_t unit)
+{
+    return unit < PCNT_UNIT_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+void sim_pcnt_add(int num, int delta)
+{
+    if (num < 0 || num >= PCNT_UNIT_MAX) {
+        fprintf(stderr, "sim: no PCNT unit %d\n", num);
+        return;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    sim_pcnt_t *unit = &pcnt_units[num];
+    bool counted = unit->configured && !unit->paused;
+    if (counted) {
+        int count = unit->count + delta;
+        if (count >= unit->h_lim || count <= unit->l_lim) {
+            count = 0;
+        }
+        unit->count = (int16_t)count;
+    }
+    pthread_mutex_unlock(&gpio_lock);
+    if (counted && delta) {
+        sim_jog_injected();
+    }
+}
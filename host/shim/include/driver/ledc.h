@@ -0,0 +1,19 @@
+#pragma once
+#include "esp_err.h"
+
+// 主机仿真：只有类型，背光亮度由host/shim/lcd.c记录
+typedef enum {
+    LEDC_LOW_SPEED_MODE,
+} ledc_mode_t;
+
+typedef enum {
+    LEDC_TIMER_0,
+} ledc_timer_t;
+
+typedef enum {
+    LEDC_CHANNEL_0,
+} ledc_channel_t;
+
+typedef enum {
+    LEDC_TIMER_13_BIT = 13,
+} ledc_timer_bit_t;
@@ -0,0 +1,8 @@
+#pragma once
+#include "esp_err.h"
+
+// 主机仿真：只有类型，面板由host/shim/lcd.c直接模拟
+typedef enum {
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+} spi_host_device_t;
@@ -0,0 +1,4 @@
+#pragma once
+
+// 主机仿真：控制台本来就是标准输出
+static inline void usb_serial_jtag_vfs_use_driver(void) {}
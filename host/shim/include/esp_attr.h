@@ -0,0 +1,8 @@
+#pragma once
+
+// 主机仿真：没有IRAM/DRAM之分
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define NOINIT_ATTR
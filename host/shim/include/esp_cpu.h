@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+
+// 主机仿真：周期计数器按CPU频率（esp_clk_cpu_freq）由单调时钟换算
+uint32_t esp_cpu_get_cycle_count(void);
@@ -0,0 +1,6 @@
+#pragma once
+#include "esp_err.h"
+
+// 主机仿真：tick钩子在仿真的tick中断中调用
+typedef void (*esp_freertos_tick_cb_t)(void);
+esp_err_t esp_register_freertos_tick_hook(esp_freertos_tick_cb_t new_tick_cb);
@@ -0,0 +1,4 @@
+#pragma once
+
+// 主机仿真：中断分配标志只用于驱动的安装参数，仿真中不区分
+#define ESP_INTR_FLAG_IRAM      (1 << 10)
@@ -0,0 +1,11 @@
+#pragma once
+
+// 主机仿真：面板写入host/shim/lcd.c的帧缓冲
+typedef struct esp_lcd_panel_io_t *esp_lcd_panel_io_handle_t;
+typedef struct esp_lcd_panel_t *esp_lcd_panel_handle_t;
+typedef void *esp_lcd_spi_bus_handle_t;
+
+typedef enum {
+    LCD_RGB_ENDIAN_RGB = 0,
+    LCD_RGB_ENDIAN_BGR,
+} lcd_color_rgb_endian_t;
@@ -0,0 +1,7 @@
+#pragma once
+#include <stdint.h>
+
+#define SIM_CPU_FREQ_HZ     160000000   // ESP32-C6最高频率
+
+int esp_clk_cpu_freq(void);
+uint64_t esp_clk_rtc_time(void);
@@ -0,0 +1,6 @@
+#pragma once
+#include "esp_err.h"
+
+// 主机仿真：不睡眠，唤醒源配置为空操作
+static inline esp_err_t esp_sleep_enable_gpio_wakeup(void) { return ESP_OK; }
+static inline esp_err_t esp_sleep_enable_uart_wakeup(int uart_num) { return ESP_OK; }
@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "esp_attr.h"
+#include "esp_err.h"
+#include "sim_compat.h"
+
+// 主机仿真：FreeRTOS API在pthread上的实现（host/shim/freertos.c）。每个任务一个线程，
+// 实时调度时全部固件线程绑定在同一个CPU上按FreeRTOS优先级以SCHED_FIFO运行，模拟单核ESP32-C6
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t StackType_t;    // 与ESP-IDF相同，栈深度以字节为单位
+
+#define pdFALSE             ((BaseType_t)0)
+#define pdTRUE              ((BaseType_t)1)
+#define pdPASS              pdTRUE
+#define pdFAIL              pdFALSE
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+
+#define configTICK_RATE_HZ          CONFIG_FREERTOS_HZ
+#define configMAX_PRIORITIES        25
+#define configMAX_TASK_NAME_LEN     16
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)           ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))
+#define pdTICKS_TO_MS(ticks)        ((TickType_t)(((uint64_t)(ticks) * 1000U) / configTICK_RATE_HZ))
+
+// 静态分配的控制块：仿真在堆上另建对象，这里只需要有类型
+typedef struct {
+    void *impl;
+} StaticTask_t, StaticQueue_t, StaticSemaphore_t, StaticStreamBuffer_t;
+
+// 临界区：单核上等于关中断，仿真中所有portMUX共用一把递归锁（中断线程也要先拿锁）
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    {0}
+
+void sim_critical_enter(portMUX_TYPE *mux);
+void sim_critical_exit(portMUX_TYPE *mux);
+#define portENTER_CRITICAL(mux)         sim_critical_enter(mux)
+#define portEXIT_CRITICAL(mux)          sim_critical_exit(mux)
+#define portENTER_CRITICAL_ISR(mux)     sim_critical_enter(mux)
+#define portEXIT_CRITICAL_ISR(mux)      sim_critical_exit(mux)
+#define portENTER_CRITICAL_SAFE(mux)    sim_critical_enter(mux)
+#define portEXIT_CRITICAL_SAFE(mux)     sim_critical_exit(mux)
+#define taskENTER_CRITICAL(mux)         sim_critical_enter(mux)
+#define taskEXIT_CRITICAL(mux)          sim_critical_exit(mux)
+
+BaseType_t xPortInIsrContext(void);
+void vPortYield(void);
+#define portYIELD()                     vPortYield()
+#define portYIELD_FROM_ISR(...)         do { } while (0)
@@ -0,0 +1,15 @@
+#pragma once
+#include "freertos/queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t sim_semaphore_create(UBaseType_t max, UBaseType_t initial);
+#define xSemaphoreCreateBinary()                    sim_semaphore_create(1, 0)
+#define xSemaphoreCreateBinaryStatic(buf)           ((void)(buf), sim_semaphore_create(1, 0))
+#define xSemaphoreCreateCounting(max, initial)      sim_semaphore_create((max), (initial))
+#define xSemaphoreCreateMutex()                     sim_semaphore_create(1, 1)
+#define xSemaphoreCreateMutexStatic(buf)            ((void)(buf), sim_semaphore_create(1, 1))
+#define xSemaphoreTake(sem, ticks)                  xQueueReceive((sem), NULL, (ticks))
+#define xSemaphoreGive(sem)                         xQueueSend((sem), NULL, 0)
+#define xSemaphoreGiveFromISR(sem, woken)           xQueueSendFromISR((sem), NULL, (woken))
+#define vSemaphoreDelete(sem)                       vQueueDelete(sem)
@@ -0,0 +1,10 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct sim_stream *StreamBufferHandle_t;
+
+StreamBufferHandle_t xStreamBufferCreate(size_t size, size_t trigger_level);
+size_t xStreamBufferSend(StreamBufferHandle_t stream, const void *data, size_t len, TickType_t ticks_to_wait);
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t stream, const void *data, size_t len, BaseType_t *woken);
+size_t xStreamBufferReceive(StreamBufferHandle_t stream, void *data, size_t len, TickType_t ticks_to_wait);
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t stream);
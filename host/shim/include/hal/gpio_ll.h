@@ -0,0 +1,19 @@
+#pragma once
+#include "soc/gpio_struct.h"
+#include "driver/gpio.h"
+
+// 主机仿真：寄存器级操作转到仿真的GPIO驱动
+static inline void gpio_ll_wakeup_disable(gpio_dev_t *hw, uint32_t gpio_num)
+{
+    gpio_wakeup_disable((gpio_num_t)gpio_num);
+}
+
+static inline void gpio_ll_set_intr_type(gpio_dev_t *hw, uint32_t gpio_num, gpio_int_type_t intr_type)
+{
+    gpio_set_intr_type((gpio_num_t)gpio_num, intr_type);
+}
+
+static inline int gpio_ll_get_level(gpio_dev_t *hw, uint32_t gpio_num)
+{
+    return gpio_get_level((gpio_num_t)gpio_num);
+}
@@ -0,0 +1,5 @@
+#pragma once
+#include <stddef.h>
+
+// ESP-IDF的newlib提供strlcpy，glibc 2.38之前没有
+size_t strlcpy(char *dst, const char *src, size_t size);
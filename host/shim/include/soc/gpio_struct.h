@@ -0,0 +1,8 @@
+#pragma once
+
+// 主机仿真：GPIO寄存器组只作为gpio_ll函数的参数
+typedef struct {
+    int unused;
+} gpio_dev_t;
+
+extern gpio_dev_t GPIO;
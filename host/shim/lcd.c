@@ -0,0 +1,178 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include "ST7789.h"
+#include "sim.h"
+
+// 面板：代替ST7789.c。draw_bitmap把像素复制到内存中的面板显存（240x320，与ST7789相同），
+// 按SPI时钟与每次刷屏的固定开销计算传输时间，传输完毕时在中断上下文中调用刷屏完成回调
+
+#define PANEL_RAM_W     240
+#define PANEL_RAM_H     320
+#define MAX_PENDING     16
+
+static const char *TAG_LCD = "WS_LCD";
+
+struct esp_lcd_panel_t {
+    uint16_t ram[PANEL_RAM_H][PANEL_RAM_W];
+    bool on;
+    bool mirror_x;
+    bool mirror_y;
+    bool swap_xy;
+};
+
+static struct esp_lcd_panel_t panel;
+esp_lcd_panel_handle_t panel_handle = NULL;
+
+static pthread_mutex_t lcd_lock = PTHREAD_MUTEX_INITIALIZER;
+static int64_t pending_done_us[MAX_PENDING];    // 排队中的传输完成时间
+static int pending_head, pending_count;
+static int64_t lcd_busy_until_us = 0;
+static esp_timer_handle_t lcd_done_timer = NULL;
+static uint8_t lcd_backlight = 0;
+static uint64_t lcd_flushes = 0;
+static uint64_t lcd_pixels = 0;
+static uint64_t lcd_busy_us = 0;
+
+// 传输完成中断
+static void lcd_trans_done_isr(void *arg)
+{
+    pthread_mutex_lock(&lcd_lock);
+    pending_head = (pending_head + 1) % MAX_PENDING;
+    pending_count--;
+    int64_t next = pending_count ? pending_done_us[pending_head] : -1;
+    pthread_mutex_unlock(&lcd_lock);
+    if (next >= 0) {
+        int64_t wait = next - esp_timer_get_time();
+        esp_timer_start_once(lcd_done_timer, wait > 0 ? wait : 0);
+    }
+    esp_lcd_panel_io_event_data_t edata;
+    example_notify_lvgl_flush_ready(NULL, &edata, &disp_drv);
+}
+
+esp_err_t esp_lcd_panel_draw_bitmap(esp_lcd_panel_handle_t handle, int x_start, int y_start, int x_end, int y_end,
+                                    const void *color_data)
+{
+    if (handle == NULL || x_start < 0 || y_start < 0 || x_end > PANEL_RAM_W || y_end > PANEL_RAM_H ||
+        x_start >= x_end || y_start >= y_end) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint16_t *src = color_data;
+    int w = x_end - x_start;
+    for (int y = y_start; y < y_end; y++) {
+        memcpy(&handle->ram[y][x_start], src, (size_t)w * sizeof(uint16_t));
+        src += w;
+    }
+
+    uint64_t px = (uint64_t)w * (uint64_t)(y_end - y_start);
+    int64_t cost_us = (int64_t)((LVGL_FLUSH_COST_NS + px * LVGL_PX_COST_NS) / 1000);
+    pthread_mutex_lock(&lcd_lock);
+    if (pending_count == MAX_PENDING) {
+        pthread_mutex_unlock(&lcd_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    int64_t now = esp_timer_get_time();
+    int64_t start = lcd_busy_until_us > now ? lcd_busy_until_us : now;
+    lcd_busy_until_us = start + cost_us;
+    pending_done_us[(pending_head + pending_count) % MAX_PENDING] = lcd_busy_until_us;
+    bool idle = pending_count++ == 0;
+    lcd_flushes++;
+    lcd_pixels += px;
+    lcd_busy_us += cost_us;
+    pthread_mutex_unlock(&lcd_lock);
+    if (idle) {
+        esp_timer_start_once(lcd_done_timer, cost_us);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_mirror(esp_lcd_panel_handle_t handle, bool mirror_x, bool mirror_y)
+{
+    handle->mirror_x = mirror_x;
+    handle->mirror_y = mirror_y;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_swap_xy(esp_lcd_panel_handle_t handle, bool swap_axes)
+{
+    handle->swap_xy = swap_axes;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_disp_on_off(esp_lcd_panel_handle_t handle, bool on_off)
+{
+    handle->on = on_off;
+    return ESP_OK;
+}
+
+void LCD_Init_Start(void)
+{
+    ESP_LOGI(TAG_LCD, "Install simulated ST7789T panel");
+    const esp_timer_create_args_t args = {
+        .callback = lcd_trans_done_isr,
+        .dispatch_method = ESP_TIMER_ISR,
+        .name = "lcd_trans_done",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&args, &lcd_done_timer));
+    panel_handle = &panel;
+    BK_Init();
+}
+
+void LCD_Init_Finish(void)
+{
+    ESP_ERROR_CHECK(esp_lcd_panel_mirror(panel_handle, true, false));
+    ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
+}
+
+void LCD_Init(void)
+{
+    LCD_Init_Start();
+    LCD_Init_Finish();
+    BK_Light(75);
+}
+
+void BK_Init(void)
+{
+    lcd_backlight = 0;
+}
+
+void BK_Light(uint8_t Light)
+{
+    lcd_backlight = Light > 100 ? 100 : Light;
+}
+
+void BK_Fade(uint8_t Light, int Time_ms)
+{
+    lcd_backlight = Light > 100 ? 100 : Light;
+}
+
+// ==================== 仿真接口 ====================
+int sim_lcd_save_ppm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", EXAMPLE_LCD_H_RES, EXAMPLE_LCD_V_RES);
+    for (int y = 0; y < EXAMPLE_LCD_V_RES; y++) {
+        for (int x = 0; x < EXAMPLE_LCD_H_RES; x++) {
+            uint16_t c = panel.ram[y + Offset_Y][x + Offset_X];
+            uint8_t rgb[3] = {
+                (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+                (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+                (uint8_t)((c & 0x1F) * 255 / 31),
+            };
+            fwrite(rgb, 1, sizeof(rgb), f);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+void sim_lcd_print_stats(void)
+{
+    int64_t total = sim_time_us();
+    printf("LCD: %llu flushes, %llu px, SPI busy %.1f%%, backlight %u%%\n", (unsigned long long)lcd_flushes,
+           (unsigned long long)lcd_pixels, total ? lcd_busy_us * 100.0 / total : 0.0, lcd_backlight);
+}
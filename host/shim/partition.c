@@ -0,0 +1,229 @@
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "esp_partition.h"
+#include "sim.h"
+
+// 分区：分区表取自partitions.csv。每个分区在内存中是一块擦除后（0xFF）的flash，
+// --flash label=文件 时改用文件：文件与分区一样大时直接映射，写入会保存到文件（例如会话记录）；
+// 文件更小时（例如资源包ui_assets.bin）复制进内存，写入不保存。写入与NOR flash一样只能把1写成0
+
+#define MAX_PARTITIONS  16
+#define FLASH_SECTOR    4096
+
+typedef struct {
+    esp_partition_t part;
+    uint8_t *mem;
+} sim_partition_t;
+
+static sim_partition_t partitions[MAX_PARTITIONS];
+static int partition_count = 0;
+
+static uint32_t parse_size(const char *s)
+{
+    char *end;
+    unsigned long v = strtoul(s, &end, 0);
+    while (isspace((unsigned char)*end)) {
+        end++;
+    }
+    if (*end == 'K' || *end == 'k') {
+        v *= 1024;
+    } else if (*end == 'M' || *end == 'm') {
+        v *= 1024 * 1024;
+    }
+    return (uint32_t)v;
+}
+
+static char *trim(char *s)
+{
+    while (isspace((unsigned char)*s)) {
+        s++;
+    }
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) {
+        *--end = '\0';
+    }
+    return s;
+}
+
+void sim_partitions_load(const char *csv)
+{
+    FILE *f = fopen(csv, "r");
+    if (f == NULL) {
+        perror(csv);
+        exit(1);
+    }
+    char line[256];
+    uint32_t next_offset = 0x9000;
+    while (fgets(line, sizeof(line), f) && partition_count < MAX_PARTITIONS) {
+        char *p = trim(line);
+        if (*p == '#' || *p == '\0') {
+            continue;
+        }
+        char *fields[6] = {0};
+        for (int i = 0; i < 6 && p; i++) {
+            fields[i] = trim(strsep(&p, ","));
+        }
+        if (fields[4] == NULL || *fields[4] == '\0') {
+            continue;
+        }
+        sim_partition_t *sp = &partitions[partition_count++];
+        strncpy(sp->part.label, fields[0], sizeof(sp->part.label) - 1);
+        bool app = strcasecmp(fields[1], "app") == 0 || strcmp(fields[1], "0") == 0;
+        sp->part.type = app ? ESP_PARTITION_TYPE_APP : ESP_PARTITION_TYPE_DATA;
+        sp->part.subtype = (int)strtol(fields[2], NULL, 0);
+        uint32_t align = app ? 0x10000 : FLASH_SECTOR;
+        uint32_t offset = *fields[3] ? parse_size(fields[3]) : (next_offset + align - 1) & ~(align - 1);
+        sp->part.address = offset;
+        sp->part.size = parse_size(fields[4]);
+        sp->part.erase_size = FLASH_SECTOR;
+        next_offset = offset + sp->part.size;
+        sp->mem = mmap(NULL, sp->part.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (sp->mem == MAP_FAILED) {
+            perror("sim: partition memory");
+            exit(1);
+        }
+        memset(sp->mem, 0xFF, sp->part.size);
+    }
+    fclose(f);
+}
+
+int sim_flash_attach(const char *label, const char *path)
+{
+    sim_partition_t *sp = NULL;
+    for (int i = 0; i < partition_count; i++) {
+        if (strcmp(partitions[i].part.label, label) == 0) {
+            sp = &partitions[i];
+        }
+    }
+    if (sp == NULL) {
+        fprintf(stderr, "sim: no partition '%s'\n", label);
+        return -1;
+    }
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        // 新文件：整个分区都是擦除状态
+        for (uint32_t off = 0; off < sp->part.size; off += FLASH_SECTOR) {
+            uint8_t sector[FLASH_SECTOR];
+            memset(sector, 0xFF, sizeof(sector));
+            if (write(fd, sector, sizeof(sector)) != sizeof(sector)) {
+                perror(path);
+                close(fd);
+                return -1;
+            }
+        }
+        st.st_size = sp->part.size;
+    }
+    if ((uint64_t)st.st_size > sp->part.size) {
+        fprintf(stderr, "sim: %s is larger than partition '%s' (%u bytes)\n", path, label, (unsigned)sp->part.size);
+        close(fd);
+        return -1;
+    }
+    if ((uint64_t)st.st_size == sp->part.size) {
+        void *mem = mmap(NULL, sp->part.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) {
+            perror(path);
+            close(fd);
+            return -1;
+        }
+        munmap(sp->mem, sp->part.size);
+        sp->mem = mem;
+    } else if (read(fd, sp->mem, st.st_size) != st.st_size) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+// ==================== esp_partition ====================
+static sim_partition_t *find_sim(const esp_partition_t *partition)
+{
+    return (sim_partition_t *)partition;    // part是sim_partition_t的第一个成员
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    for (int i = 0; i < partition_count; i++) {
+        const esp_partition_t *part = &partitions[i].part;
+        if ((type == ESP_PARTITION_TYPE_ANY || part->type == type) &&
+            (subtype == ESP_PARTITION_SUBTYPE_ANY || part->subtype == (int)subtype) &&
+            (label == NULL || strcmp(part->label, label) == 0)) {
+            return part;
+        }
+    }
+    return NULL;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size)
+{
+    if (partition == NULL || dst == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (src_offset > partition->size || size > partition->size - src_offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(dst, find_sim(partition)->mem + src_offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t dst_offset, const void *src, size_t size)
+{
+    if (partition == NULL || src == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dst_offset > partition->size || size > partition->size - dst_offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint8_t *mem = find_sim(partition)->mem + dst_offset;
+    const uint8_t *data = src;
+    for (size_t i = 0; i < size; i++) {
+        mem[i] &= data[i];
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size)
+{
+    if (partition == NULL || offset % FLASH_SECTOR || size % FLASH_SECTOR) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset > partition->size || size > partition->size - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memset(find_sim(partition)->mem + offset, 0xFF, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void **out_ptr,
+                             esp_partition_mmap_handle_t *out_handle)
+{
+    if (partition == NULL || out_ptr == NULL || out_handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (offset > partition->size || size > partition->size - offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    *out_ptr = find_sim(partition)->mem + offset;
+    *out_handle = 0;
+    return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle)
+{
+}
@@ -0,0 +1,404 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "sim.h"
+
+// UART：每个端口接一个伪终端（PTY），对端（GRBL模拟器或终端程序）打开打印出的/dev/pts路径。
+// 线路按波特率计时：RX字节依次到达硬件FIFO，FIFO达到120字节或线路空闲10个字符时间后
+// 中断把数据搬进驱动的环形缓冲区（ESP-IDF的默认阈值）；TX字节进入128字节的FIFO，
+// 发送完毕时才写到PTY，FIFO满时uart_write_bytes阻塞
+
+#define UART_FIFO_LEN           128
+#define UART_FULL_THRESH        120     // UART_FULL_THRESH_DEFAULT
+#define UART_TOUT_THRESH        10      // UART_TOUT_THRESH_DEFAULT（字符时间）
+#define UART_PENDING_LEN        4096
+
+static const char *TAG_UART = "uart";
+
+typedef struct tx_chunk {
+    struct tx_chunk *next;
+    int64_t done_ns;        // 最后一个字节离开线路的时间
+    int64_t jog_src_us;     // $J指令对应的手轮注入时间
+    size_t len;
+    uint8_t data[];
+} tx_chunk_t;
+
+typedef struct {
+    bool opened;
+    bool installed;
+    int master;
+    int slave;              // 保持一个slave端打开，对端关闭时master不会读到EIO
+    char path[64];
+    int baud;               // 0：不计时
+    bool baud_fixed;        // --baud指定，忽略uart_param_config的波特率
+
+    // 线路上尚未进入FIFO的字节，第i个在pend_t0_ns + (i+1)个字符时间到达
+    uint8_t pending[UART_PENDING_LEN];
+    size_t pend_len;
+    int64_t pend_t0_ns;
+    uint8_t fifo[UART_FIFO_LEN];
+    size_t fifo_len;
+    int64_t last_rx_ns;
+
+    pthread_mutex_t lock;
+    pthread_cond_t rx_cond;
+    pthread_cond_t tx_cond;
+    uint8_t *ring;
+    size_t ring_size;
+    size_t ring_head;
+    size_t ring_count;
+    QueueHandle_t event_queue;
+
+    tx_chunk_t *tx_head;
+    tx_chunk_t *tx_tail;
+    int64_t tx_busy_ns;     // 线路发送完已排队字节的时间
+
+    uint64_t rx_bytes;
+    uint64_t rx_dropped;
+    uint64_t tx_bytes;
+    uint64_t tx_dropped;
+    pthread_t rx_thread;
+    pthread_t tx_thread;
+} sim_uart_t;
+
+static sim_uart_t uarts[UART_NUM_MAX];
+
+static int64_t now_ns(void)
+{
+    return sim_time_us() * 1000;
+}
+
+static int64_t char_ns(const sim_uart_t *u)
+{
+    return u->baud > 0 ? 10000000000LL / u->baud : 0;     // 8N1：10位
+}
+
+// ==================== RX ====================
+// 中断：把FIFO里的数据搬进环形缓冲区并发送事件
+static void rx_fifo_flush(sim_uart_t *u)
+{
+    if (u->fifo_len == 0) {
+        return;
+    }
+    uart_event_t event = {.type = UART_DATA, .size = u->fifo_len};
+    pthread_mutex_lock(&u->lock);
+    if (u->ring == NULL || u->ring_size - u->ring_count < u->fifo_len) {
+        event.type = UART_BUFFER_FULL;
+        u->rx_dropped += u->fifo_len;
+    } else {
+        for (size_t i = 0; i < u->fifo_len; i++) {
+            u->ring[(u->ring_head + u->ring_count++) % u->ring_size] = u->fifo[i];
+        }
+        u->rx_bytes += u->fifo_len;
+        pthread_cond_broadcast(&u->rx_cond);
+    }
+    QueueHandle_t queue = u->event_queue;
+    pthread_mutex_unlock(&u->lock);
+    if (queue) {
+        xQueueSendFromISR(queue, &event, NULL);
+    }
+    u->fifo_len = 0;
+}
+
+// 把已经到达的字节从线路移进FIFO，FIFO达到阈值时产生中断
+static void rx_advance(sim_uart_t *u, int64_t now)
+{
+    int64_t cns = char_ns(u);
+    size_t arrived = u->pend_len;
+    if (cns > 0) {
+        int64_t n = (now - u->pend_t0_ns) / cns;
+        arrived = n < 0 ? 0 : (n < (int64_t)u->pend_len ? (size_t)n : u->pend_len);
+    }
+    for (size_t i = 0; i < arrived; i++) {
+        u->fifo[u->fifo_len++] = u->pending[i];
+        if (u->fifo_len >= UART_FULL_THRESH) {
+            rx_fifo_flush(u);
+        }
+    }
+    if (arrived) {
+        u->last_rx_ns = u->pend_t0_ns + (int64_t)arrived * cns;
+        u->pend_t0_ns = u->last_rx_ns;
+        u->pend_len -= arrived;
+        memmove(u->pending, u->pending + arrived, u->pend_len);
+    }
+    if (u->pend_len == 0 && u->fifo_len && now >= u->last_rx_ns + UART_TOUT_THRESH * cns) {
+        rx_fifo_flush(u);
+    }
+}
+
+static void *uart_rx_thread(void *arg)
+{
+    sim_uart_t *u = arg;
+    while (1) {
+        int64_t cns = char_ns(u);
+        int64_t now = now_ns();
+        rx_advance(u, now);
+
+        // 下一个事件：FIFO达到阈值的那个字节到达，或者线路空闲超时
+        int64_t next = -1;
+        if (u->pend_len && u->fifo_len + u->pend_len >= UART_FULL_THRESH) {
+            next = u->pend_t0_ns + (int64_t)(UART_FULL_THRESH - u->fifo_len) * cns;
+        } else if (u->pend_len) {
+            next = u->pend_t0_ns + (int64_t)u->pend_len * cns + UART_TOUT_THRESH * cns;
+        } else if (u->fifo_len) {
+            next = u->last_rx_ns + UART_TOUT_THRESH * cns;
+        }
+        struct pollfd pfd = {.fd = u->master, .events = POLLIN};
+        struct timespec timeout;
+        if (next >= 0) {
+            int64_t wait = next > now ? next - now : 0;
+            timeout.tv_sec = wait / 1000000000;
+            timeout.tv_nsec = wait % 1000000000;
+        }
+        // 线路上的字节太多（对端发送得比波特率快）时先不读，PTY本身会缓冲
+        if (u->pend_len == UART_PENDING_LEN) {
+            pfd.events = 0;
+        }
+        if (ppoll(&pfd, 1, next >= 0 ? &timeout : NULL, NULL) <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+        ssize_t n = read(u->master, u->pending + u->pend_len, UART_PENDING_LEN - u->pend_len);
+        if (n <= 0) {
+            continue;
+        }
+        if (u->pend_len == 0) {
+            now = now_ns();
+            u->pend_t0_ns = now > u->last_rx_ns ? now : u->last_rx_ns;
+        }
+        u->pend_len += (size_t)n;
+    }
+    return NULL;
+}
+
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait)
+{
+    if (uart_num >= UART_NUM_MAX || !uarts[uart_num].installed) {
+        return -1;
+    }
+    sim_uart_t *u = &uarts[uart_num];
+    uint8_t *dst = buf;
+    uint32_t n = 0;
+    // 与ESP-IDF相同：读满length字节或到达超时才返回
+    struct timespec deadline;
+    bool timed = ticks_to_wait != portMAX_DELAY;
+    if (timed) {
+        int64_t tick_us = 1000000 / configTICK_RATE_HZ;
+        sim_abs_timespec((sim_time_us() / tick_us + ticks_to_wait) * tick_us, &deadline);
+    }
+    pthread_mutex_lock(&u->lock);
+    while (n < length) {
+        while (u->ring_count && n < length) {
+            dst[n++] = u->ring[u->ring_head];
+            u->ring_head = (u->ring_head + 1) % u->ring_size;
+            u->ring_count--;
+        }
+        if (n == length) {
+            break;
+        }
+        int err = timed ? pthread_cond_timedwait(&u->rx_cond, &u->lock, &deadline)
+                        : pthread_cond_wait(&u->rx_cond, &u->lock);
+        if (err == ETIMEDOUT) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&u->lock);
+    return (int)n;
+}
+
+// ==================== TX ====================
+static void *uart_tx_thread(void *arg)
+{
+    sim_uart_t *u = arg;
+    pthread_mutex_lock(&u->lock);
+    while (1) {
+        while (u->tx_head == NULL) {
+            pthread_cond_wait(&u->tx_cond, &u->lock);
+        }
+        tx_chunk_t *chunk = u->tx_head;
+        pthread_mutex_unlock(&u->lock);
+        sim_sleep_until_us(chunk->done_ns / 1000);
+        if (u->opened && write(u->master, chunk->data, chunk->len) != (ssize_t)chunk->len) {
+            u->tx_dropped += chunk->len;    // 没有对端读取，PTY缓冲区已满
+        }
+        if (chunk->jog_src_us) {
+            sim_jog_record(chunk->done_ns / 1000 - chunk->jog_src_us);
+        }
+        pthread_mutex_lock(&u->lock);
+        u->tx_head = chunk->next;
+        if (u->tx_head == NULL) {
+            u->tx_tail = NULL;
+        }
+        free(chunk);
+    }
+    return NULL;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size)
+{
+    if (uart_num >= UART_NUM_MAX || !uarts[uart_num].installed) {
+        return -1;
+    }
+    sim_uart_t *u = &uarts[uart_num];
+    if (!u->opened) {
+        return (int)size;   // 没有PTY：丢弃
+    }
+    const uint8_t *data = src;
+    int64_t jog_src_us = (size >= 3 && memcmp(data, "$J=", 3) == 0) ? sim_jog_take_source() : 0;
+    size_t off = 0;
+    while (off < size) {
+        size_t len = size - off < UART_FIFO_LEN ? size - off : UART_FIFO_LEN;
+        int64_t cns = char_ns(u);
+        // 等到TX FIFO里放得下这一段
+        pthread_mutex_lock(&u->lock);
+        int64_t now = now_ns();
+        int64_t busy = u->tx_busy_ns > now ? u->tx_busy_ns : now;
+        int64_t room_at = busy - (int64_t)(UART_FIFO_LEN - len) * cns;
+        pthread_mutex_unlock(&u->lock);
+        if (room_at > now) {
+            sim_sleep_until_us(room_at / 1000);
+        }
+
+        tx_chunk_t *chunk = malloc(sizeof(*chunk) + len);
+        if (chunk == NULL) {
+            return (int)off;
+        }
+        memcpy(chunk->data, data + off, len);
+        chunk->len = len;
+        chunk->next = NULL;
+        chunk->jog_src_us = (off + len == size) ? jog_src_us : 0;
+        pthread_mutex_lock(&u->lock);
+        now = now_ns();
+        busy = u->tx_busy_ns > now ? u->tx_busy_ns : now;
+        u->tx_busy_ns = busy + (int64_t)len * cns;
+        chunk->done_ns = u->tx_busy_ns;
+        if (u->tx_tail) {
+            u->tx_tail->next = chunk;
+        } else {
+            u->tx_head = chunk;
+        }
+        u->tx_tail = chunk;
+        u->tx_bytes += len;
+        pthread_cond_signal(&u->tx_cond);
+        pthread_mutex_unlock(&u->lock);
+        off += len;
+    }
+    return (int)size;
+}
+
+// ==================== 驱动 ====================
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags)
+{
+    if (uart_num >= UART_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    sim_uart_t *u = &uarts[uart_num];
+    if (u->installed) {
+        ESP_LOGE(TAG_UART, "%s(%d): UART driver already installed", __func__, __LINE__);
+        return ESP_FAIL;
+    }
+    pthread_mutex_lock(&u->lock);
+    u->ring = malloc(rx_buffer_size);
+    u->ring_size = rx_buffer_size;
+    if (uart_queue) {
+        u->event_queue = xQueueCreate(queue_size, sizeof(uart_event_t));
+        *uart_queue = u->event_queue;
+    }
+    u->installed = true;
+    pthread_mutex_unlock(&u->lock);
+    return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config)
+{
+    if (uart_num >= UART_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!uarts[uart_num].baud_fixed) {
+        uarts[uart_num].baud = uart_config->baud_rate;
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num)
+{
+    return uart_num < UART_NUM_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t uart_num, int wakeup_threshold)
+{
+    return uart_num < UART_NUM_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+// ==================== 仿真接口 ====================
+int sim_uart_open(int uart_num, int baud, const char *link)
+{
+    sim_uart_t *u = &uarts[uart_num];
+    pthread_mutex_init(&u->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&u->rx_cond, &attr);
+    pthread_cond_init(&u->tx_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    u->baud = baud > 0 ? baud : 0;
+    u->baud_fixed = baud >= 0;
+
+    u->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (u->master < 0 || grantpt(u->master) != 0 || unlockpt(u->master) != 0 ||
+        ptsname_r(u->master, u->path, sizeof(u->path)) != 0) {
+        perror("sim: cannot open a pseudo-terminal");
+        return -1;
+    }
+    u->slave = open(u->path, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if (u->slave < 0 || tcgetattr(u->slave, &tio) != 0) {
+        perror("sim: cannot open the pseudo-terminal slave");
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(u->slave, TCSANOW, &tio);
+    fcntl(u->master, F_SETFL, fcntl(u->master, F_GETFL) | O_NONBLOCK);
+    if (link) {
+        unlink(link);
+        if (symlink(u->path, link) != 0) {
+            perror("sim: cannot create the UART link");
+        }
+    }
+    u->opened = true;
+    printf("sim: UART%d on %s%s%s\n", uart_num, u->path, link ? " -> " : "", link ? link : "");
+    fflush(stdout);
+    sim_thread_start(&u->rx_thread, SIM_RT_PRIO_PERIPH, uart_rx_thread, u, "uart_line_rx");
+    sim_thread_start(&u->tx_thread, SIM_RT_PRIO_PERIPH, uart_tx_thread, u, "uart_line_tx");
+    return 0;
+}
+
+void sim_uart_inject(int uart_num, const void *data, size_t len)
+{
+    sim_uart_t *u = &uarts[uart_num];
+    // 从slave端写入，和对端发送的数据一样经过线路计时
+    if (!u->opened || write(u->slave, data, len) != (ssize_t)len) {
+        fprintf(stderr, "sim: UART%d inject failed\n", uart_num);
+    }
+}
+
+void sim_uart_print_stats(void)
+{
+    for (int i = 0; i < UART_NUM_MAX; i++) {
+        sim_uart_t *u = &uarts[i];
+        if (u->opened) {
+            printf("UART%d: rx %llu B (dropped %llu), tx %llu B (dropped %llu), %d baud\n", i,
+                   (unsigned long long)u->rx_bytes, (unsigned long long)u->rx_dropped,
+                   (unsigned long long)u->tx_bytes, (unsigned long long)u->tx_dropped, u->baud);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+// 主机仿真的内部接口：shim驱动（host/shim）与仿真主程序（host/sim/sim_main.c）之间使用
+
+// ==================== 时间 ====================
+int64_t sim_time_us(void);                          // 仿真启动后的微秒数（CLOCK_MONOTONIC）
+void sim_sleep_until_us(int64_t t_us);              // 睡眠到绝对时间
+void sim_abs_timespec(int64_t t_us, struct timespec *ts);   // 绝对时间转为CLOCK_MONOTONIC的timespec
+
+// ==================== 线程与调度 ====================
+// 实时调度时全部线程绑定在一个CPU上以SCHED_FIFO运行：FreeRTOS任务优先级p对应SIM_RT_PRIO_TASK+p，
+// 中断上下文与外设模型（UART线路、PTY）高于全部任务，脚本线程最高
+#define SIM_RT_PRIO_TASK        10
+#define SIM_RT_PRIO_ISR         60
+#define SIM_RT_PRIO_PERIPH      61
+#define SIM_RT_PRIO_WORLD       70
+
+extern bool sim_rt;                                 // 实时调度是否生效
+// 创建线程（rt_prio为SCHED_FIFO优先级，实时调度未生效时忽略），失败时退出仿真
+void sim_thread_start(pthread_t *thread, int rt_prio, void *(*fn)(void *), void *arg, const char *name);
+void sim_freertos_init(void);
+void sim_freertos_start_main(void (*fn)(void *), int prio);  // 创建运行app_main的"main"任务
+void sim_print_task_stats(void);                    // 打印各任务的CPU时间
+
+// 中断上下文：fn在仿真的中断线程中执行（xPortInIsrContext为真），按投递顺序
+void sim_isr_post(void (*fn)(void *), void *arg);
+void sim_isr_init(void);
+void sim_esp_timer_init(void);
+
+// ==================== 外设 ====================
+void sim_gpio_drive(int pin, int level);            // 外部驱动引脚电平，level为-1时释放（按上下拉取值）
+void sim_pcnt_add(int unit, int delta);             // 注入手轮脉冲计数
+int sim_uart_open(int uart_num, int baud, const char *link);   // 打开UART的PTY（link非空时建立符号链接）
+void sim_uart_inject(int uart_num, const void *data, size_t len);  // 像对端发送一样送入RX
+void sim_uart_print_stats(void);
+void sim_console_input(const char *text);           // 送入USB-Serial-JTAG控制台
+int sim_flash_attach(const char *label, const char *path);     // 分区使用的镜像文件
+void sim_partitions_load(const char *csv);
+int sim_lcd_save_ppm(const char *path);             // 保存面板可见区域的截图
+void sim_lcd_print_stats(void);
+
+// ==================== 点动延迟 ====================
+// 从手轮脉冲注入到对应的$J指令最后一个字节发送完毕
+int64_t sim_jog_take_source(void);                  // 写入$J时取出最早一次未发送的注入时间（0为无）
+void sim_jog_injected(void);                        // 注入脉冲时调用
+void sim_jog_cleared(void);                         // 计数器清零时调用（未选轴时不会发出$J）
+void sim_jog_record(int64_t latency_us);            // $J发送完毕
@@ -0,0 +1,394 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "sim.h"
+
+// 主机仿真的入口：在Linux上运行固件的app_main与全部任务，外设由脚本驱动。
+//
+//   pendant_sim [--script jog.sim] [--flash session=session.bin] [--baud 0] [--uart-link /tmp/grbl] [--no-rt]
+//
+// UART1（GRBL）接在打印出的PTY上；脚本结束或Ctrl-C时打印点动延迟、各任务CPU时间、刷屏与串口统计。
+//
+// 脚本每行一个命令，#后为注释（例子见host/scripts/）：
+//   wait 毫秒                  等待
+//   axis X|Y|Z|A|OFF           左拨档
+//   mult 0.1|1|5               右拨档（上电为x1）
+//   wheel 格数 [毫秒]          转动手轮（每格2个计数，负数反转），给出时间时逐格均匀转完
+//   func [毫秒]                按下功能键（默认100ms）
+//   estop down|up              急停按下/松开
+//   gpio 引脚 0|1|z            驱动或释放任意引脚
+//   uart 文本                  GRBL发给吊坠的数据（支持\r \n \t \xHH）
+//   console 文本               调试控制台输入
+//   shot 文件.ppm              保存面板截图（LVGL画出的像素，未应用面板的镜像）
+//   echo 文本 / report / quit  打印标记 / 打印统计 / 结束
+// 点动延迟取决于手轮脉冲落在编码器任务20ms轮询周期中的位置，脚本的转动间隔不宜是10ms的整数倍
+
+// 引脚与main.c相同
+#define SIM_LEFT_SW1        4
+#define SIM_LEFT_SW2        5
+#define SIM_LEFT_SW3        3
+#define SIM_LEFT_SW4        2
+#define SIM_RIGHT_SW1       9
+#define SIM_RIGHT_SW2       18
+#define SIM_RIGHT_SW3       19
+#define SIM_ESTOP_PIN       23
+#define SIM_FUNC_BTN_PIN    20
+#define SIM_PCNT_UNIT       0
+#define SIM_GRBL_UART       UART_NUM_1
+#define SIM_COUNTS_PER_CLICK 2      // 手轮每格2个计数（main.c除以2.0f）
+#define SIM_MAIN_TASK_PRIO  1       // ESP-IDF的main任务优先级
+#define JOG_SAMPLES_MAX     100000
+
+extern void app_main(void);
+
+static volatile sig_atomic_t sim_quit = 0;
+static int64_t sim_start_us = 0;
+
+static pthread_mutex_t jog_lock = PTHREAD_MUTEX_INITIALIZER;
+static int64_t jog_first_inject_us = 0;
+static uint32_t jog_samples[JOG_SAMPLES_MAX];
+static size_t jog_sample_count = 0;
+
+// ==================== 点动延迟 ====================
+void sim_jog_injected(void)
+{
+    pthread_mutex_lock(&jog_lock);
+    if (jog_first_inject_us == 0) {
+        jog_first_inject_us = sim_time_us();
+    }
+    pthread_mutex_unlock(&jog_lock);
+}
+
+void sim_jog_cleared(void)
+{
+    pthread_mutex_lock(&jog_lock);
+    jog_first_inject_us = 0;
+    pthread_mutex_unlock(&jog_lock);
+}
+
+int64_t sim_jog_take_source(void)
+{
+    pthread_mutex_lock(&jog_lock);
+    int64_t t = jog_first_inject_us;
+    jog_first_inject_us = 0;
+    pthread_mutex_unlock(&jog_lock);
+    return t;
+}
+
+void sim_jog_record(int64_t latency_us)
+{
+    pthread_mutex_lock(&jog_lock);
+    if (jog_sample_count < JOG_SAMPLES_MAX && latency_us >= 0) {
+        jog_samples[jog_sample_count++] = (uint32_t)latency_us;
+    }
+    pthread_mutex_unlock(&jog_lock);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_jog_latency(void)
+{
+    pthread_mutex_lock(&jog_lock);
+    size_t n = jog_sample_count;
+    static uint32_t sorted[JOG_SAMPLES_MAX];
+    memcpy(sorted, jog_samples, n * sizeof(sorted[0]));
+    pthread_mutex_unlock(&jog_lock);
+    if (n == 0) {
+        printf("jog latency: no $J sent\n");
+        return;
+    }
+    qsort(sorted, n, sizeof(sorted[0]), cmp_u32);
+    printf("jog latency (count -> $J on the wire), %zu samples: p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+           n, sorted[n / 2] / 1000.0, sorted[n * 9 / 10] / 1000.0, sorted[n * 99 / 100] / 1000.0,
+           sorted[n - 1] / 1000.0);
+}
+
+static void print_report(void)
+{
+    printf("\n==== sim report: %.2f s ====\n", (sim_time_us() - sim_start_us) / 1e6);
+    print_jog_latency();
+    sim_lcd_print_stats();
+    sim_uart_print_stats();
+    sim_print_task_stats();
+    fflush(stdout);
+}
+
+// ==================== 脚本 ====================
+static void script_wait_ms(double ms)
+{
+    int64_t until = sim_time_us() + (int64_t)(ms * 1000);
+    while (!sim_quit && sim_time_us() < until) {
+        int64_t t = sim_time_us() + 10000;
+        sim_sleep_until_us(t < until ? t : until);
+    }
+}
+
+// 解析\r \n \t \xHH转义
+static size_t unescape(const char *in, char *out, size_t size)
+{
+    size_t n = 0;
+    while (*in && n + 1 < size) {
+        if (in[0] == '\\' && in[1]) {
+            in++;
+            switch (*in) {
+                case 'r': out[n++] = '\r'; in++; break;
+                case 'n': out[n++] = '\n'; in++; break;
+                case 't': out[n++] = '\t'; in++; break;
+                case 'x': {
+                    char hex[3] = {0};
+                    strncpy(hex, in + 1, 2);
+                    out[n++] = (char)strtol(hex, NULL, 16);
+                    in += 1 + strlen(hex);
+                    break;
+                }
+                default: out[n++] = *in++; break;
+            }
+        } else {
+            out[n++] = *in++;
+        }
+    }
+    out[n] = '\0';
+    return n;
+}
+
+static void select_one(const int *pins, int count, int selected)
+{
+    for (int i = 0; i < count; i++) {
+        sim_gpio_drive(pins[i], pins[i] == selected ? 0 : -1);
+    }
+}
+
+static int run_command(char *line, const char *file, int lineno)
+{
+    char *cmd = strtok(line, " \t\r\n");
+    char *arg = strtok(NULL, "\r\n");
+    while (arg && (*arg == ' ' || *arg == '\t')) {
+        arg++;
+    }
+    static const int left_pins[] = {SIM_LEFT_SW1, SIM_LEFT_SW2, SIM_LEFT_SW3, SIM_LEFT_SW4};
+    static const int right_pins[] = {SIM_RIGHT_SW1, SIM_RIGHT_SW2, SIM_RIGHT_SW3};
+
+    if (cmd == NULL || cmd[0] == '#') {
+        return 0;
+    } else if (strcmp(cmd, "wait") == 0 && arg) {
+        script_wait_ms(atof(arg));
+    } else if (strcmp(cmd, "axis") == 0 && arg) {
+        const char *axes = "XYZA";
+        const char *p = strchr(axes, arg[0]);
+        select_one(left_pins, 4, (p && arg[0]) ? left_pins[p - axes] : -1);
+    } else if (strcmp(cmd, "mult") == 0 && arg) {
+        double m = atof(arg);
+        select_one(right_pins, 3, m < 0.5 ? SIM_RIGHT_SW1 : m < 2 ? SIM_RIGHT_SW2 : SIM_RIGHT_SW3);
+    } else if (strcmp(cmd, "wheel") == 0 && arg) {
+        // wheel 格数 [毫秒]：给出时间时逐格均匀转动
+        char *end;
+        long clicks = strtol(arg, &end, 10);
+        double ms = strtod(end, NULL);
+        long steps = labs(clicks);
+        int dir = clicks < 0 ? -1 : 1;
+        if (ms <= 0 || steps <= 1) {
+            sim_pcnt_add(SIM_PCNT_UNIT, (int)clicks * SIM_COUNTS_PER_CLICK);
+        } else {
+            int64_t t0 = sim_time_us();
+            for (long i = 0; i < steps && !sim_quit; i++) {
+                sim_sleep_until_us(t0 + (int64_t)(ms * 1000 * i / steps));
+                sim_pcnt_add(SIM_PCNT_UNIT, dir * SIM_COUNTS_PER_CLICK);
+            }
+            sim_sleep_until_us(t0 + (int64_t)(ms * 1000));
+        }
+    } else if (strcmp(cmd, "func") == 0) {
+        sim_gpio_drive(SIM_FUNC_BTN_PIN, 0);
+        script_wait_ms(arg ? atof(arg) : 100);
+        sim_gpio_drive(SIM_FUNC_BTN_PIN, -1);
+    } else if (strcmp(cmd, "estop") == 0 && arg) {
+        sim_gpio_drive(SIM_ESTOP_PIN, strncmp(arg, "down", 4) == 0 ? 0 : -1);
+    } else if (strcmp(cmd, "gpio") == 0 && arg) {
+        int pin, level;
+        char z;
+        if (sscanf(arg, "%d %d", &pin, &level) == 2) {
+            sim_gpio_drive(pin, level);
+        } else if (sscanf(arg, "%d %c", &pin, &z) == 2 && z == 'z') {
+            sim_gpio_drive(pin, -1);
+        } else {
+            goto bad;
+        }
+    } else if (strcmp(cmd, "uart") == 0 && arg) {
+        char buf[512];
+        size_t n = unescape(arg, buf, sizeof(buf));
+        sim_uart_inject(SIM_GRBL_UART, buf, n);
+    } else if (strcmp(cmd, "console") == 0 && arg) {
+        char buf[256];
+        unescape(arg, buf, sizeof(buf));
+        sim_console_input(buf);
+    } else if (strcmp(cmd, "shot") == 0 && arg) {
+        if (sim_lcd_save_ppm(arg) == 0) {
+            printf("sim: screenshot %s\n", arg);
+        }
+    } else if (strcmp(cmd, "echo") == 0) {
+        printf("sim: %s\n", arg ? arg : "");
+    } else if (strcmp(cmd, "report") == 0) {
+        print_report();
+    } else if (strcmp(cmd, "quit") == 0) {
+        return 1;
+    } else {
+        goto bad;
+    }
+    fflush(stdout);
+    return 0;
+bad:
+    fprintf(stderr, "%s:%d: bad command '%s'\n", file, lineno, cmd);
+    return -1;
+}
+
+static int run_script(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    char line[600];
+    int lineno = 0;
+    int rc = 0;
+    while (!sim_quit && rc == 0 && fgets(line, sizeof(line), f)) {
+        rc = run_command(line, path, ++lineno);
+    }
+    fclose(f);
+    return rc < 0 ? -1 : 0;
+}
+
+// ==================== 启动 ====================
+static void on_signal(int sig)
+{
+    sim_quit = 1;
+}
+
+// 全部线程绑定在当前CPU上，以SCHED_FIFO运行（需要root或CAP_SYS_NICE）
+static void setup_realtime(void)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(sched_getcpu(), &set);
+    struct sched_param param = {.sched_priority = SIM_RT_PRIO_WORLD};
+    if (sched_setaffinity(0, sizeof(set), &set) != 0 || sched_setscheduler(0, SCHED_FIFO, &param) != 0) {
+        fprintf(stderr, "sim: real-time scheduling unavailable (%s), task priorities are not enforced\n",
+                strerror(errno));
+        return;
+    }
+    sim_rt = true;
+}
+
+static void main_task(void *arg)
+{
+    app_main();
+    vTaskDelete(NULL);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--script FILE] [--flash LABEL=FILE]... [--baud N] [--uart-link PATH]\n"
+            "          [--partitions CSV] [--no-rt]\n", prog);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *script = NULL;
+    const char *uart_link = NULL;
+    const char *partitions = SIM_PARTITIONS_CSV;
+    const char *flash[8];
+    int flash_count = 0;
+    int baud = -1;
+    bool rt = true;
+    bool assets_given = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(a, "--no-rt") == 0) {
+            rt = false;
+        } else if (v == NULL) {
+            usage(argv[0]);
+        } else if (strcmp(a, "--script") == 0) {
+            script = v;
+            i++;
+        } else if (strcmp(a, "--flash") == 0 && flash_count < 8 && strchr(v, '=')) {
+            flash[flash_count++] = v;
+            assets_given |= strncmp(v, "assets=", 7) == 0;
+            i++;
+        } else if (strcmp(a, "--baud") == 0) {
+            baud = atoi(v);
+            i++;
+        } else if (strcmp(a, "--uart-link") == 0) {
+            uart_link = v;
+            i++;
+        } else if (strcmp(a, "--partitions") == 0) {
+            partitions = v;
+            i++;
+        } else {
+            usage(argv[0]);
+        }
+    }
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (rt) {
+        setup_realtime();
+    }
+    sim_freertos_init();
+    sim_esp_timer_init();
+    sim_isr_init();
+
+    sim_partitions_load(partitions);
+    if (!assets_given && sim_flash_attach("assets", SIM_ASSETS_BIN) != 0) {
+        return 1;
+    }
+    for (int i = 0; i < flash_count; i++) {
+        char label[32];
+        const char *eq = strchr(flash[i], '=');
+        snprintf(label, sizeof(label), "%.*s", (int)(eq - flash[i]), flash[i]);
+        if (sim_flash_attach(label, eq + 1) != 0) {
+            return 1;
+        }
+    }
+    if (sim_uart_open(SIM_GRBL_UART, baud, uart_link) != 0) {
+        return 1;
+    }
+
+    // 上电状态：急停松开、功能键松开（上拉），左拨档OFF，右拨档x1
+    sim_gpio_drive(SIM_RIGHT_SW2, 0);
+
+    sim_start_us = sim_time_us();
+    sim_freertos_start_main(main_task, SIM_MAIN_TASK_PRIO);
+
+    int rc = 0;
+    if (script) {
+        rc = run_script(script);
+    } else {
+        while (!sim_quit) {
+            pause();
+        }
+    }
+    print_report();
+    if (uart_link) {
+        unlink(uart_link);
+    }
+    fflush(stdout);
+    _exit(rc ? 1 : 0);
+}
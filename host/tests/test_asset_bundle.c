@@ -0,0 +1,156 @@
+#include "lvgl.h"
+
+#include "unity/unity.h"
+#include <stdio.h>
+
+#include "ui_fonts.h"
+#include "Asset_Bundle_Format.h"
+
+#define CANVAS_W    240
+#define CANVAS_H    64
+
+static const char dro_chars[] = "0123456789.-+XYZABC";
+
+/*The firmware maps the partition, here the file is read to a buffer with the same alignment*/
+static uint32_t bundle_buf[16 * 1024];
+static const uint8_t * bundle = (const uint8_t *)bundle_buf;
+static size_t bundle_size;
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    FILE * f = fopen(TEST_ASSET_BUNDLE, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    bundle_size = fread(bundle_buf, 1, sizeof(bundle_buf), f);
+    fclose(f);
+    TEST_ASSERT_LESS_THAN(sizeof(bundle_buf), bundle_size);
+
+    canvas = lv_canvas_create(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+static const lv_font_t * font_create(const char * name)
+{
+    const asset_bundle_entry_t * e = asset_bundle_find(bundle, name, ASSET_TYPE_FONT);
+    TEST_ASSERT_NOT_NULL(e);
+    lv_font_t * font = asset_bundle_font_create(bundle + e->offset, e->size);
+    TEST_ASSERT_NOT_NULL(font);
+    return font;
+}
+
+static bool in_bundle(const void * p)
+{
+    return (const uint8_t *)p >= bundle && (const uint8_t *)p < bundle + bundle_size;
+}
+
+static void draw_text(lv_color_t * buf, const lv_font_t * font, const char * txt)
+{
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = font;
+    dsc.color = lv_color_black();
+    lv_canvas_draw_text(canvas, 4, 0, CANVAS_W - 8, &dsc, txt);
+}
+
+void test_asset_bundle_check(void)
+{
+    TEST_ASSERT_TRUE(asset_bundle_check(bundle, bundle_size));
+
+    /*Truncated, e.g. a partition that is too small*/
+    TEST_ASSERT_FALSE(asset_bundle_check(bundle, bundle_size - 1));
+
+    /*An erased partition*/
+    static uint32_t erased[64];
+    lv_memset_ff(erased, sizeof(erased));
+    TEST_ASSERT_FALSE(asset_bundle_check((const uint8_t *)erased, sizeof(erased)));
+
+    TEST_ASSERT_NULL(asset_bundle_find(bundle, "lv_font_montserrat_12", ASSET_TYPE_FONT));
+    TEST_ASSERT_NULL(asset_bundle_find(bundle, "dro_font_48", ASSET_TYPE_IMAGE));
+    TEST_ASSERT_NOT_NULL(asset_bundle_find(bundle, "dro_font_48", ASSET_TYPE_FONT));
+}
+
+void test_asset_bundle_font_in_place(void)
+{
+    const lv_font_t * font = font_create("dro_font_48");
+    const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
+    TEST_ASSERT_EQUAL(lv_font_get_line_height(&dro_font_48), lv_font_get_line_height(font));
+    TEST_ASSERT_EQUAL(dro_font_48.base_line, font->base_line);
+    TEST_ASSERT_EQUAL(LV_FONT_FMT_TXT_RLE, dsc->bitmap_format);
+
+    /*Zero-copy: the glyph data is read from the bundle. Only LV_FONT_FMT_TXT_LARGE needs
+     *the glyph descriptors in another layout*/
+    TEST_ASSERT_TRUE(in_bundle(dsc->glyph_bitmap));
+    TEST_ASSERT_TRUE(in_bundle(dsc->cmaps[0].unicode_list) || dsc->cmaps[0].unicode_list == NULL);
+#if LV_FONT_FMT_TXT_LARGE == 0
+    TEST_ASSERT_TRUE(in_bundle(dsc->glyph_dsc));
+#endif
+
+    const char * c;
+    for(c = dro_chars; *c; c++) {
+        lv_font_glyph_dsc_t g;
+        lv_font_glyph_dsc_t ref;
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, *c, '1'));
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&dro_font_48, &ref, *c, '1'));
+        TEST_ASSERT_EQUAL_UINT16(ref.adv_w, g.adv_w);
+        TEST_ASSERT_EQUAL_UINT16(ref.box_w, g.box_w);
+        TEST_ASSERT_EQUAL_UINT16(ref.box_h, g.box_h);
+        TEST_ASSERT_EQUAL_INT16(ref.ofs_x, g.ofs_x);
+        TEST_ASSERT_EQUAL_INT16(ref.ofs_y, g.ofs_y);
+        TEST_ASSERT_EQUAL_UINT8(ref.bpp, g.bpp);
+        TEST_ASSERT_TRUE(in_bundle(lv_font_get_glyph_bitmap(font, *c)));
+    }
+
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &g, 'Q', 0));
+
+    lv_mem_free((void *)font);
+}
+
+void test_asset_bundle_fonts_render_like_compiled(void)
+{
+    static const char * names[] = {"pendant_font_12", "dro_font_24", "dro_font_32", "dro_font_48"};
+    static const char * texts[] = {"Workpiece X-12.7 Branch Center", "X-12.7A+0.35", "X-12.7A+0.35", "X-12.7A+0.35"};
+    const lv_font_t * refs[] = {&pendant_font_12, &dro_font_24, &dro_font_32, &dro_font_48};
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        const lv_font_t * font = font_create(names[i]);
+        draw_text(canvas_buf, font, texts[i]);
+        draw_text(ref_buf, refs[i], texts[i]);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, canvas_buf, sizeof(canvas_buf));
+        lv_mem_free((void *)font);
+    }
+}
+
+void test_asset_bundle_image(void)
+{
+    const asset_bundle_entry_t * e = asset_bundle_find(bundle, "test_img_a8", ASSET_TYPE_IMAGE);
+    TEST_ASSERT_NOT_NULL(e);
+
+    lv_img_dsc_t img;
+    TEST_ASSERT_TRUE(asset_bundle_img_init(&img, bundle + e->offset, e->size));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_ALPHA_8BIT, img.header.cf);
+    TEST_ASSERT_EQUAL(8, img.header.w);
+    TEST_ASSERT_EQUAL(4, img.header.h);
+    TEST_ASSERT_EQUAL_UINT32(8 * 4, img.data_size);
+    TEST_ASSERT_TRUE(in_bundle(img.data));
+    TEST_ASSERT_EQUAL_HEX8(0x28, img.data[9]);
+
+    /*LVGL draws it straight from the bundle*/
+    lv_obj_t * obj = lv_img_create(lv_scr_act());
+    lv_img_set_src(obj, &img);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL(8, lv_obj_get_width(obj));
+    lv_refr_now(NULL);
+}
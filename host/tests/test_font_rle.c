@@ -0,0 +1,173 @@
+#include "lvgl.h"
+#include "src/font/lv_font_fmt_txt.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#include "ui_fonts.h"
+
+#define CANVAS_W    240
+#define CANVAS_H    64
+#define GLYPH_MAX   (64 * 64)
+#define BENCH_CNT   50
+
+/*4 bpp and 3 bpp opacity steps differ by at most 17*/
+#define COLOR_TOLERANCE 20
+
+static const char dro_chars[] = "0123456789.-+XYZABC";
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_H];
+static lv_color_t ref_buf[CANVAS_W * CANVAS_H];
+static uint8_t a8_buf[GLYPH_MAX];
+static uint8_t a8_part_buf[GLYPH_MAX];
+static lv_obj_t * canvas;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    canvas = lv_canvas_create(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+/*The opacity of a 4 bpp pixel after rounding it to the 8 levels of LV_FONT_FMT_TXT_RLE*/
+static lv_opa_t rle_opa(uint32_t v4)
+{
+    static const lv_opa_t opa3[8] = {0, 36, 73, 109, 146, 182, 219, 255};
+    return opa3[(v4 * 14 + 15) / 30];
+}
+
+static void draw_text(lv_color_t * buf, const lv_font_t * font, lv_coord_t y, lv_opa_t opa, const char * txt)
+{
+    lv_canvas_set_buffer(canvas, buf, CANVAS_W, CANVAS_H, LV_IMG_CF_TRUE_COLOR);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = font;
+    dsc.color = lv_color_black();
+    dsc.opa = opa;
+    lv_canvas_draw_text(canvas, 4, y, CANVAS_W - 8, &dsc, txt);
+}
+
+static void assert_same_render(lv_coord_t y, lv_opa_t opa, const char * txt)
+{
+    draw_text(canvas_buf, &dro_font_48, y, opa, txt);
+    draw_text(ref_buf, &lv_font_montserrat_48, y, opa, txt);
+
+    uint32_t drawn_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < CANVAS_W * CANVAS_H; i++) {
+        uint32_t c = lv_color_to32(canvas_buf[i]);
+        uint32_t ref = lv_color_to32(ref_buf[i]);
+        uint32_t sh;
+        for(sh = 0; sh < 24; sh += 8) {
+            int32_t diff = (int32_t)((c >> sh) & 0xFF) - (int32_t)((ref >> sh) & 0xFF);
+            TEST_ASSERT_INT32_WITHIN(COLOR_TOLERANCE, 0, diff);
+        }
+        if((c & 0xFFFFFF) != 0xFFFFFF) drawn_cnt++;
+    }
+
+    TEST_ASSERT_GREATER_THAN_UINT32(CANVAS_W * CANVAS_H / 20, drawn_cnt);
+}
+
+void test_font_rle_glyphs_match_source(void)
+{
+    const char * c;
+    for(c = dro_chars; *c; c++) {
+        lv_font_glyph_dsc_t dsc;
+        lv_font_glyph_dsc_t ref;
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&dro_font_48, &dsc, *c, 0));
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_48, &ref, *c, 0));
+        TEST_ASSERT_EQUAL_UINT8(LV_FONT_RLE_BPP, dsc.bpp);
+        TEST_ASSERT_EQUAL_UINT16(ref.adv_w, dsc.adv_w);
+        TEST_ASSERT_EQUAL_UINT16(ref.box_w, dsc.box_w);
+        TEST_ASSERT_EQUAL_UINT16(ref.box_h, dsc.box_h);
+        TEST_ASSERT_EQUAL_INT16(ref.ofs_x, dsc.ofs_x);
+        TEST_ASSERT_EQUAL_INT16(ref.ofs_y, dsc.ofs_y);
+
+        uint32_t px_cnt = dsc.box_w * dsc.box_h;
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(GLYPH_MAX, px_cnt);
+
+        lv_font_fmt_txt_rle_t rle;
+        _lv_font_fmt_txt_rle_init(&rle, lv_font_get_glyph_bitmap(&dro_font_48, *c));
+        _lv_font_fmt_txt_rle_read(&rle, a8_buf, px_cnt);
+
+        const uint8_t * ref_map = lv_font_get_glyph_bitmap(&lv_font_montserrat_48, *c);
+        uint32_t i;
+        for(i = 0; i < px_cnt; i++) {
+            uint32_t v4 = (ref_map[i >> 1] >> ((i & 1) ? 0 : 4)) & 0xF;
+            TEST_ASSERT_EQUAL_UINT8(rle_opa(v4), a8_buf[i]);
+        }
+    }
+}
+
+void test_font_rle_skip_and_read_in_parts(void)
+{
+    lv_font_glyph_dsc_t dsc;
+    lv_font_get_glyph_dsc(&dro_font_48, &dsc, '8', 0);
+    const uint8_t * map = lv_font_get_glyph_bitmap(&dro_font_48, '8');
+    uint32_t px_cnt = dsc.box_w * dsc.box_h;
+
+    lv_font_fmt_txt_rle_t rle;
+    _lv_font_fmt_txt_rle_init(&rle, map);
+    _lv_font_fmt_txt_rle_read(&rle, a8_buf, px_cnt);
+
+    /*Read and skip pieces of any length as the draw functions do with clipped rows*/
+    uint32_t step;
+    for(step = 1; step < 80; step += 3) {
+        lv_memset_00(a8_part_buf, sizeof(a8_part_buf));
+        _lv_font_fmt_txt_rle_init(&rle, map);
+        uint32_t i = 0;
+        while(i < px_cnt) {
+            uint32_t n = LV_MIN(step, px_cnt - i);
+            _lv_font_fmt_txt_rle_read(&rle, &a8_part_buf[i], n);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(&a8_buf[i], &a8_part_buf[i], n);
+            i += n;
+
+            n = LV_MIN(step / 2, px_cnt - i);
+            _lv_font_fmt_txt_rle_skip(&rle, n);
+            i += n;
+        }
+    }
+}
+
+void test_font_rle_draw(void)
+{
+    assert_same_render(0, LV_OPA_COVER, "-123.456");
+    assert_same_render(4, LV_OPA_COVER, "X+7890.5");
+
+    /*The top rows are clipped*/
+    assert_same_render(-20, LV_OPA_COVER, "-123.456");
+
+    assert_same_render(0, LV_OPA_50, "-123.456");
+}
+
+void test_font_rle_benchmark(void)
+{
+    uint32_t i;
+    uint32_t t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) draw_text(canvas_buf, &dro_font_48, 0, LV_OPA_COVER, "-888.888");
+    uint32_t t_rle = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) draw_text(ref_buf, &lv_font_montserrat_48, 0, LV_OPA_COVER, "-888.888");
+    uint32_t t_plain = lv_test_time_us() - t_start;
+
+    /*With opacity the letter color is mixed into the lookup tables too*/
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) draw_text(canvas_buf, &dro_font_48, 0, LV_OPA_90, "-888.888");
+    uint32_t t_rle_opa = lv_test_time_us() - t_start;
+
+    t_start = lv_test_time_us();
+    for(i = 0; i < BENCH_CNT; i++) draw_text(ref_buf, &lv_font_montserrat_48, 0, LV_OPA_90, "-888.888");
+    uint32_t t_plain_opa = lv_test_time_us() - t_start;
+
+    TEST_PRINTF("48 px \"-888.888\" on a canvas [us]: RLE %u (4 bpp %u), with opacity RLE %u (4 bpp %u)",
+                t_rle / BENCH_CNT, t_plain / BENCH_CNT, t_rle_opa / BENCH_CNT, t_plain_opa / BENCH_CNT);
+}
@@ -0,0 +1,84 @@
+#include "lvgl.h"
+
+#include "unity/unity.h"
+
+#include "ui_fonts.h"
+
+/*Characters of the firmware's screen and its printed numbers*/
+static const char ui_chars[] = "Meth Workpiece XYZ BrCe Branch Center 0123456789.-";
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void assert_same_glyph(uint32_t letter, uint32_t letter_next)
+{
+    lv_font_glyph_dsc_t ref;
+    lv_font_glyph_dsc_t dsc;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_12, &ref, letter, letter_next));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&pendant_font_12, &dsc, letter, letter_next));
+
+    /*adv_w includes the kerning with the next letter*/
+    TEST_ASSERT_EQUAL_UINT16(ref.adv_w, dsc.adv_w);
+    TEST_ASSERT_EQUAL_UINT16(ref.box_w, dsc.box_w);
+    TEST_ASSERT_EQUAL_UINT16(ref.box_h, dsc.box_h);
+    TEST_ASSERT_EQUAL_INT16(ref.ofs_x, dsc.ofs_x);
+    TEST_ASSERT_EQUAL_INT16(ref.ofs_y, dsc.ofs_y);
+    TEST_ASSERT_EQUAL_UINT8(ref.bpp, dsc.bpp);
+}
+
+void test_font_subset_same_glyphs(void)
+{
+    const char * c;
+    for(c = ui_chars; *c; c++) {
+        assert_same_glyph((uint8_t)*c, 0);
+
+        lv_font_glyph_dsc_t dsc;
+        lv_font_get_glyph_dsc(&pendant_font_12, &dsc, (uint8_t)*c, 0);
+        uint32_t size = (dsc.box_w * dsc.box_h * dsc.bpp + 7) / 8;
+        if(size == 0) continue;
+
+        const uint8_t * ref_bitmap = lv_font_get_glyph_bitmap(&lv_font_montserrat_12, (uint8_t)*c);
+        const uint8_t * bitmap = lv_font_get_glyph_bitmap(&pendant_font_12, (uint8_t)*c);
+        TEST_ASSERT_NOT_NULL(bitmap);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref_bitmap, bitmap, size);
+    }
+}
+
+void test_font_subset_same_kerning(void)
+{
+    const char * c1;
+    const char * c2;
+    for(c1 = ui_chars; *c1; c1++) {
+        for(c2 = ui_chars; *c2; c2++) {
+            assert_same_glyph((uint8_t)*c1, (uint8_t)*c2);
+        }
+    }
+
+    /*Make sure kerning is really tested*/
+    lv_font_glyph_dsc_t dsc;
+    lv_font_glyph_dsc_t dsc_kern;
+    lv_font_get_glyph_dsc(&pendant_font_12, &dsc, 'W', 0);
+    lv_font_get_glyph_dsc(&pendant_font_12, &dsc_kern, 'W', 'a');
+    TEST_ASSERT_LESS_THAN_UINT16(dsc.adv_w, dsc_kern.adv_w);
+}
+
+void test_font_subset_no_other_glyphs(void)
+{
+    lv_font_glyph_dsc_t dsc;
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&pendant_font_12, &dsc, 'Q', 0));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&pendant_font_12, &dsc, 0xB0, 0));
+
+    /*Right after the last code point of a range (digits) and of a sparse list (letters)*/
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&pendant_font_12, &dsc, ':', 0));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&pendant_font_12, &dsc, 'u', 0));
+
+    /*The same check in the built-in fonts: 0x7F is not in the 0x20..0x7E range*/
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&lv_font_montserrat_12, &dsc, 0x7F, 0));
+}
@@ -0,0 +1,126 @@
+#include "lvgl.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#include "coordinate_screen.h"
+#include "ui_fonts.h"
+
+/*The longest line main/Perf_HUD/Perf_HUD.c is expected to print*/
+#define HUD_LONGEST     "120fps 12.5ms J50/s 12 S10/s 9999ms E99/99 9999K"
+#define HUD_SHORT       "0fps 0.0ms J0/s 0 S0/s >9s E0/0 1K"
+
+static lv_obj_t * objs[COORDINATE_SCREEN_OBJ_MAX];
+
+/*The firmware loads the fonts from the asset bundle, the test uses the compiled copies*/
+static const lv_font_t * load_font(const char * name)
+{
+    if(strcmp(name, "pendant_font_12") == 0) return &pendant_font_12;
+    if(strcmp(name, "dro_font_24") == 0) return &dro_font_24;
+    return NULL;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    coordinate_screen_create(lv_scr_act(), objs, load_font);
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void test_perf_hud_strip_is_reserved(void)
+{
+    lv_obj_t * root = objs[COORDINATE_SCREEN_ROOT];
+    lv_obj_t * hud = objs[COORDINATE_SCREEN_PERF_HUD];
+    TEST_ASSERT_TRUE(lv_obj_has_flag(hud, LV_OBJ_FLAG_HIDDEN));
+
+    lv_label_set_text(hud, HUD_LONGEST);
+    lv_obj_clear_flag(hud, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(root);
+
+    /*Inside the root, so the root's clip area doesn't cut it*/
+    lv_area_t hud_area;
+    lv_obj_get_coords(hud, &hud_area);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&hud_area, &root->coords, 0));
+    TEST_ASSERT_EQUAL_INT(lv_font_get_line_height(&pendant_font_12), lv_area_get_height(&hud_area));
+
+    /*No other object draws into the strip (shadows included)*/
+    uint32_t i;
+    for(i = COORDINATE_SCREEN_ROOT + 1; i < COORDINATE_SCREEN_OBJ_MAX; i++) {
+        if(i == COORDINATE_SCREEN_PERF_HUD) continue;
+        lv_area_t a;
+        lv_obj_get_coords(objs[i], &a);
+        lv_area_increase(&a, _lv_obj_get_ext_draw_size(objs[i]), _lv_obj_get_ext_draw_size(objs[i]));
+        lv_area_t common;
+        if(_lv_area_intersect(&common, &a, &hud_area)) {
+            TEST_PRINTF("object %u overlaps the HUD strip", i);
+            TEST_FAIL();
+        }
+    }
+}
+
+void test_perf_hud_text_fits_the_font_and_strip(void)
+{
+    lv_obj_t * hud = objs[COORDINATE_SCREEN_PERF_HUD];
+
+    /*Every character has a glyph in the subset font*/
+    const char * txt = HUD_LONGEST HUD_SHORT;
+    for(; *txt; txt++) {
+        lv_font_glyph_dsc_t dsc;
+        if(!lv_font_get_glyph_dsc(&pendant_font_12, &dsc, *txt, 0)) {
+            TEST_PRINTF("'%c' is missing from pendant_font_12", *txt);
+            TEST_FAIL();
+        }
+    }
+
+    lv_point_t size;
+    lv_txt_get_size(&size, HUD_LONGEST, &pendant_font_12, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    TEST_PRINTF("longest HUD line: %d px of %d px", size.x, lv_obj_get_content_width(hud));
+    TEST_ASSERT_LESS_OR_EQUAL_INT(lv_obj_get_content_width(hud), size.x);
+}
+
+void test_perf_hud_update_redraws_the_strip_only(void)
+{
+    lv_obj_t * hud = objs[COORDINATE_SCREEN_PERF_HUD];
+    lv_area_t coords[COORDINATE_SCREEN_OBJ_MAX];
+    uint32_t i;
+    for(i = 0; i < COORDINATE_SCREEN_OBJ_MAX; i++) lv_obj_get_coords(objs[i], &coords[i]);
+
+    lv_obj_clear_flag(hud, LV_OBJ_FLAG_HIDDEN);
+    lv_label_set_text(hud, HUD_SHORT);
+    lv_refr_now(NULL);
+
+    lv_area_t strip;
+    lv_obj_get_coords(hud, &strip);
+    lv_obj_get_transformed_area(hud, &strip, false, false);
+    lv_area_increase(&strip, 5, 5);     /*As lv_obj_invalidate() does for transformed objects*/
+
+    lv_refr_reset_stat();
+    lv_label_set_text(hud, HUD_LONGEST);
+    lv_refr_now(NULL);
+    lv_refr_stat_t stat;
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stat.last.inv_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(lv_area_get_size(&strip), stat.last.px_cnt);
+
+    /*Nothing moved: the label's height is one line whatever the text*/
+    for(i = 0; i < COORDINATE_SCREEN_OBJ_MAX; i++) {
+        lv_area_t a;
+        lv_obj_get_coords(objs[i], &a);
+        TEST_ASSERT_EQUAL_MEMORY(&coords[i], &a, sizeof(a));
+    }
+
+    /*Hiding it again redraws the same strip*/
+    lv_refr_reset_stat();
+    lv_obj_add_flag(hud, LV_OBJ_FLAG_HIDDEN);
+    lv_refr_now(NULL);
+    lv_refr_get_stat(&stat);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(lv_area_get_size(&strip), stat.last.px_cnt);
+}
@@ -0,0 +1,132 @@
+#include "lvgl.h"
+
+#include "unity/unity.h"
+
+#include "Session_Log.h"
+
+static uint8_t buf[16 * SESSION_REC_MAX_SIZE];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static const uint8_t rx_data[] = "<Idle|MPos:1.000,2.000,3.000,0.000|WPos:0.000,0.000,0.000,0.000>\r\nok\r\n";
+
+/*One record of every type, with the gaps the firmware sees*/
+static uint32_t fill_records(session_rec_t * recs)
+{
+    uint32_t n = 0;
+    recs[n++] = (session_rec_t) {
+        .type = SESSION_REC_ENCODER, .time_us = 0, .encoder = 4
+    };
+    recs[n++] = (session_rec_t) {
+        .type = SESSION_REC_ENCODER, .time_us = 20000, .encoder = -1000
+    };
+    recs[n++] = (session_rec_t) {
+        .type = SESSION_REC_SWITCH, .time_us = 20150, .sw = {'Z', 50}
+    };
+    recs[n++] = (session_rec_t) {
+        .type = SESSION_REC_SWITCH, .time_us = 20150, .sw = {0, 1}
+    };
+    recs[n++] = (session_rec_t) {
+        .type = SESSION_REC_BUTTON, .time_us = 3600000000ULL, .button = {SESSION_BTN_ESTOP, 0}
+    };
+    recs[n] = (session_rec_t) {
+        .type = SESSION_REC_UART_RX, .time_us = 3600000001ULL
+    };
+    recs[n].rx.data = rx_data;
+    recs[n++].rx.len = sizeof(rx_data) - 1;
+    recs[n++] = (session_rec_t) {
+        .type = SESSION_REC_GAP, .time_us = 3600000001ULL, .gap = 70000
+    };
+    return n;
+}
+
+void test_session_log_round_trip(void)
+{
+    session_rec_t recs[8];
+    uint32_t cnt = fill_records(recs);
+    uint32_t i;
+
+    size_t len = 0;
+    uint64_t prev_us = 0;
+    for(i = 0; i < cnt; i++) {
+        size_t n = session_rec_encode(&recs[i], prev_us, &buf[len]);
+        TEST_ASSERT_GREATER_THAN(0, n);
+        TEST_ASSERT_LESS_OR_EQUAL(SESSION_REC_MAX_SIZE, n);
+        len += n;
+        prev_us = recs[i].time_us;
+    }
+    /*Handwheel records stay small: type, 20 ms gap and a two byte count*/
+    TEST_ASSERT_EQUAL(1 + 3 + 2, session_rec_encode(&recs[1], recs[0].time_us, &buf[len]));
+
+    const uint8_t * in = buf;
+    prev_us = 0;
+    for(i = 0; i < cnt; i++) {
+        session_rec_t rec;
+        TEST_ASSERT_TRUE(session_rec_decode(&in, buf + len, prev_us, &rec));
+        TEST_ASSERT_EQUAL(recs[i].type, rec.type);
+        TEST_ASSERT_EQUAL_UINT64(recs[i].time_us, rec.time_us);
+        switch(rec.type) {
+            case SESSION_REC_ENCODER:
+                TEST_ASSERT_EQUAL_INT32(recs[i].encoder, rec.encoder);
+                break;
+            case SESSION_REC_SWITCH:
+                TEST_ASSERT_EQUAL_CHAR(recs[i].sw.left, rec.sw.left);
+                TEST_ASSERT_EQUAL_UINT8(recs[i].sw.right_x10, rec.sw.right_x10);
+                break;
+            case SESSION_REC_BUTTON:
+                TEST_ASSERT_EQUAL_UINT8(recs[i].button.id, rec.button.id);
+                TEST_ASSERT_EQUAL_UINT8(recs[i].button.level, rec.button.level);
+                break;
+            case SESSION_REC_UART_RX:
+                TEST_ASSERT_EQUAL_UINT16(recs[i].rx.len, rec.rx.len);
+                TEST_ASSERT_EQUAL_MEMORY(recs[i].rx.data, rec.rx.data, rec.rx.len);
+                break;
+            case SESSION_REC_GAP:
+                TEST_ASSERT_EQUAL_UINT32(recs[i].gap, rec.gap);
+                break;
+        }
+        prev_us = rec.time_us;
+    }
+    TEST_ASSERT_EQUAL_PTR(buf + len, in);
+}
+
+void test_session_log_rejects_invalid(void)
+{
+    session_rec_t recs[8];
+    uint32_t cnt = fill_records(recs);
+    uint32_t i;
+
+    /*Time going backwards, an empty or too long UART chunk and unknown types are not encoded*/
+    TEST_ASSERT_EQUAL(0, session_rec_encode(&recs[1], recs[1].time_us + 1, buf));
+    session_rec_t rec = recs[5];
+    rec.rx.len = 0;
+    TEST_ASSERT_EQUAL(0, session_rec_encode(&rec, 0, buf));
+    rec.rx.len = SESSION_RX_MAX + 1;
+    TEST_ASSERT_EQUAL(0, session_rec_encode(&rec, 0, buf));
+    rec.type = (session_rec_type_t)0;
+    TEST_ASSERT_EQUAL(0, session_rec_encode(&rec, 0, buf));
+
+    /*A record cut anywhere (a chunk torn by a power cut) does not decode and does not move the input*/
+    for(i = 0; i < cnt; i++) {
+        size_t n = session_rec_encode(&recs[i], 0, buf);
+        size_t cut;
+        for(cut = 0; cut < n; cut++) {
+            const uint8_t * in = buf;
+            TEST_ASSERT_FALSE(session_rec_decode(&in, buf + cut, 0, &rec));
+            TEST_ASSERT_EQUAL_PTR(buf, in);
+        }
+    }
+
+    /*Erased flash is not a record*/
+    lv_memset_ff(buf, 16);
+    const uint8_t * in = buf;
+    TEST_ASSERT_FALSE(session_rec_decode(&in, buf + 16, 0, &rec));
+}
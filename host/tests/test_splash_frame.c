@@ -0,0 +1,164 @@
+#include "lvgl.h"
+
+#include "unity/unity.h"
+#include <stdlib.h>
+
+#include "coordinate_screen.h"
+#include "Splash_Frame.h"
+
+/*The firmware's panel and the size of its splash partition*/
+#define PANEL_W         172
+#define PANEL_H         320
+#define PARTITION_SIZE  (64 * 1024)
+
+#define TEST_PX_CNT     40000   /*Longer than a token can describe*/
+
+static uint16_t px[TEST_PX_CNT];
+static uint16_t decoded[TEST_PX_CNT];
+static uint16_t encoded[SPLASH_RLE_MAX_WORDS(TEST_PX_CNT)];
+
+static lv_color_t frame[PANEL_W * PANEL_H];
+static lv_color_t strips[PANEL_W * PANEL_H];
+static lv_obj_t * objs[COORDINATE_SCREEN_OBJ_MAX];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+static uint32_t round_trip(uint32_t px_cnt)
+{
+    uint32_t words = splash_rle_encode(px, px_cnt, encoded);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(SPLASH_RLE_MAX_WORDS(px_cnt), words);
+
+    const uint16_t * in = encoded;
+    lv_memset_00(decoded, sizeof(decoded));
+    TEST_ASSERT_TRUE(splash_rle_decode(&in, encoded + words, decoded, px_cnt));
+    TEST_ASSERT_EQUAL_PTR(encoded + words, in);
+    TEST_ASSERT_EQUAL_MEMORY(px, decoded, px_cnt * sizeof(uint16_t));
+    return words;
+}
+
+void test_splash_rle_round_trip(void)
+{
+    uint32_t i;
+
+    /*One colour: a run per SPLASH_RLE_CNT_MAX pixels*/
+    for(i = 0; i < TEST_PX_CNT; i++) px[i] = 0xF800;
+    TEST_ASSERT_EQUAL_UINT32(4, round_trip(TEST_PX_CNT));
+
+    /*No two neighbours are equal: literals only*/
+    for(i = 0; i < TEST_PX_CNT; i++) px[i] = i;
+    TEST_ASSERT_EQUAL_UINT32(TEST_PX_CNT + 2, round_trip(TEST_PX_CNT));
+
+    /*Pairs are not worth a run, triples are*/
+    for(i = 0; i < TEST_PX_CNT; i++) px[i] = i / 2;
+    TEST_ASSERT_EQUAL_UINT32(TEST_PX_CNT + 2, round_trip(TEST_PX_CNT));
+    for(i = 0; i < TEST_PX_CNT; i++) px[i] = i / 3;
+    TEST_ASSERT_EQUAL_UINT32((TEST_PX_CNT - 1) / 3 * 2, round_trip(TEST_PX_CNT - 1));
+
+    /*Worst case and short tails*/
+    for(i = 0; i < TEST_PX_CNT; i++) px[i] = (i % 4) == 3 ? 1 : 0;
+    round_trip(TEST_PX_CNT);
+    for(i = 1; i < 5; i++) round_trip(i);
+
+    srand(1);
+    for(i = 0; i < TEST_PX_CNT; i++) px[i] = (rand() % 8) ? px[i > 0 ? i - 1 : 0] : rand();
+    round_trip(TEST_PX_CNT);
+}
+
+void test_splash_rle_decode_rejects_bad_data(void)
+{
+    uint32_t i;
+    for(i = 0; i < 100; i++) px[i] = i < 50 ? 0x1234 : i;
+    uint32_t words = splash_rle_encode(px, 100, encoded);
+
+    /*Truncated*/
+    const uint16_t * in = encoded;
+    TEST_ASSERT_FALSE(splash_rle_decode(&in, encoded + words - 1, decoded, 100));
+
+    /*A token crossing the end of the strip*/
+    in = encoded;
+    TEST_ASSERT_FALSE(splash_rle_decode(&in, encoded + words, decoded, 40));
+
+    /*An erased partition*/
+    lv_memset_ff(encoded, 64);
+    in = encoded;
+    TEST_ASSERT_FALSE(splash_rle_decode(&in, encoded + 32, decoded, 100));
+}
+
+static void create_screen(void)
+{
+    /*The test display is larger than the panel, a parent of the panel's size gives the same layout*/
+    lv_obj_t * panel = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(panel);
+    lv_obj_set_size(panel, PANEL_W, PANEL_H);
+    coordinate_screen_create(panel, objs, NULL);
+    lv_label_set_text(objs[COORDINATE_SCREEN_MECHANICAL_X], "-1234.567");
+    lv_label_set_text(objs[COORDINATE_SCREEN_WORKPIECE_Y], "12.700");
+    lv_label_set_text(objs[COORDINATE_SCREEN_CENTERING_VALUE], "X");
+    lv_obj_update_layout(lv_scr_act());
+}
+
+void test_splash_frame_strips_match_full_frame(void)
+{
+    create_screen();
+
+    lv_area_t full = {0, 0, PANEL_W - 1, PANEL_H - 1};
+    TEST_ASSERT_TRUE(splash_frame_render(lv_scr_act(), &full, frame));
+
+    /*Rendered strip by strip as the firmware saves it. The transformed root is drawn through a layer
+     *clipped to every strip*/
+    lv_coord_t y;
+    for(y = 0; y < PANEL_H; y += SPLASH_STRIP_LINES) {
+        lv_area_t area = {0, y, PANEL_W - 1, LV_MIN(y + SPLASH_STRIP_LINES, PANEL_H) - 1};
+        TEST_ASSERT_TRUE(splash_frame_render(lv_scr_act(), &area, &strips[y * PANEL_W]));
+    }
+    TEST_ASSERT_EQUAL_MEMORY(frame, strips, sizeof(frame));
+
+    /*Not a blank frame: the white root and black text*/
+    uint32_t i;
+    uint32_t dark = 0;
+    for(i = 0; i < PANEL_W * PANEL_H; i++) {
+        if(lv_color_brightness(frame[i]) < 64) dark++;
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(100, dark);
+}
+
+void test_splash_frame_fits_partition(void)
+{
+    create_screen();
+
+    /*Encode the RGB565 strips like the firmware saves them*/
+    static uint16_t frame565[PANEL_W * PANEL_H];
+    static uint16_t stream[(PARTITION_SIZE - sizeof(splash_header_t)) / 2];
+    uint32_t words = 0;
+    lv_coord_t y;
+    for(y = 0; y < PANEL_H; y += SPLASH_STRIP_LINES) {
+        lv_area_t area = {0, y, PANEL_W - 1, LV_MIN(y + SPLASH_STRIP_LINES, PANEL_H) - 1};
+        uint32_t cnt = lv_area_get_size(&area);
+        TEST_ASSERT_TRUE(splash_frame_render(lv_scr_act(), &area, strips));
+        uint32_t i;
+        for(i = 0; i < cnt; i++) frame565[y * PANEL_W + i] = lv_color_to16(strips[i]);
+        uint32_t n = splash_rle_encode(&frame565[y * PANEL_W], cnt, encoded);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(stream) / 2, words + n);
+        lv_memcpy(&stream[words], encoded, n * sizeof(uint16_t));
+        words += n;
+    }
+    TEST_PRINTF("splash frame: %u B (raw %u B)", words * 2, (unsigned)sizeof(frame565));
+
+    /*Decode it like the boot code: strip by strip into one buffer*/
+    const uint16_t * in = stream;
+    for(y = 0; y < PANEL_H; y += SPLASH_STRIP_LINES) {
+        uint32_t cnt = PANEL_W * (LV_MIN(y + SPLASH_STRIP_LINES, PANEL_H) - y);
+        TEST_ASSERT_TRUE(splash_rle_decode(&in, stream + words, decoded, cnt));
+        TEST_ASSERT_EQUAL_MEMORY(&frame565[y * PANEL_W], decoded, cnt * sizeof(uint16_t));
+    }
+    TEST_ASSERT_EQUAL_PTR(stream + words, in);
+}
@@ -0,0 +1,99 @@
+#include "lvgl.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#include "coordinate_screen.h"
+#include "ui_fonts.h"
+
+typedef struct {
+    const char * tag;
+    uint32_t size;      /*Bytes*/
+    uint32_t cnt;       /*Number of allocations*/
+} budget_t;
+
+/* The LVGL heap budget of the firmware's coordinate screen per object class.
+ * Measured on the 64 bit host so the sizes are larger than on the target (pointers are 8 bytes)
+ * but they grow together. If a change exceeds the budget, check whether it's intended and
+ * update the numbers here. The caches (e.g. "txt_cache") are not part of the budget.*/
+static const budget_t coord_screen_budget[] = {
+    {"obj",         352,    7},
+    {"label",       6240,   136},
+    {"textarea",    1000,   10},
+    {"btn",         320,    5},
+    {"anim",        480,    4},     /*Cursor blinking of the text areas*/
+};
+
+#define BUDGET_CNT  (sizeof(coord_screen_budget) / sizeof(coord_screen_budget[0]))
+
+static lv_obj_t * objs[COORDINATE_SCREEN_OBJ_MAX];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_scr_act());
+}
+
+/*The firmware loads the fonts from the asset bundle, the test uses the compiled copies*/
+static const lv_font_t * load_font(const char * name)
+{
+    if(strcmp(name, "pendant_font_12") == 0) return &pendant_font_12;
+    if(strcmp(name, "dro_font_24") == 0) return &dro_font_24;
+    return NULL;
+}
+
+static lv_mem_tag_stat_t get_stat(const char * tag)
+{
+    lv_mem_tag_stat_t stat;
+    lv_mem_get_tag_stat_by_name(tag, &stat);
+    return stat;
+}
+
+void test_ui_mem_budget_coordinate_screen(void)
+{
+    lv_mem_tag_stat_t start[BUDGET_CNT];
+    uint32_t i;
+    for(i = 0; i < BUDGET_CNT; i++) start[i] = get_stat(coord_screen_budget[i].tag);
+
+    coordinate_screen_create(lv_scr_act(), objs, load_font);
+
+    /*Set the values as the firmware does*/
+    static const coordinate_screen_obj_t values[] = {
+        COORDINATE_SCREEN_MECHANICAL_X, COORDINATE_SCREEN_MECHANICAL_Y, COORDINATE_SCREEN_MECHANICAL_Z,
+        COORDINATE_SCREEN_WORKPIECE_X, COORDINATE_SCREEN_WORKPIECE_Y, COORDINATE_SCREEN_WORKPIECE_Z,
+    };
+    for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        lv_label_set_text(objs[values[i]], "-1234.567");
+    }
+    lv_label_set_text(objs[COORDINATE_SCREEN_CENTERING_VALUE], "X");
+    lv_textarea_set_text(objs[COORDINATE_SCREEN_CENTERING1_VALUE], "-1234.567");
+    lv_textarea_set_text(objs[COORDINATE_SCREEN_CENTERING2_VALUE], "-1234.567");
+    lv_refr_now(NULL);
+
+    uint32_t size_sum = 0;
+    uint32_t budget_sum = 0;
+    for(i = 0; i < BUDGET_CNT; i++) {
+        lv_mem_tag_stat_t stat = get_stat(coord_screen_budget[i].tag);
+        uint32_t size = stat.size - start[i].size;
+        uint32_t cnt = stat.cnt - start[i].cnt;
+        TEST_PRINTF("%s: %u B in %u allocations (budget %u B in %u)", coord_screen_budget[i].tag, size, cnt,
+                    coord_screen_budget[i].size, coord_screen_budget[i].cnt);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(coord_screen_budget[i].size, size);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(coord_screen_budget[i].cnt, cnt);
+        size_sum += size;
+        budget_sum += coord_screen_budget[i].size;
+    }
+    TEST_PRINTF("coordinate screen: %u B (budget %u B)", size_sum, budget_sum);
+
+    /*Everything is freed with the screen. Only the `spec_attr` of the active screen (an "obj") remains.*/
+    lv_obj_clean(lv_scr_act());
+    for(i = 0; i < BUDGET_CNT; i++) {
+        if(strcmp(coord_screen_budget[i].tag, "obj") == 0) continue;
+        TEST_ASSERT_EQUAL_UINT32(start[i].size, get_stat(coord_screen_budget[i].tag).size);
+    }
+}
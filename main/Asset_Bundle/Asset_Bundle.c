@@ -0,0 +1,115 @@
+#include "Asset_Bundle.h"
+#include <inttypes.h>
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "Asset_Bundle_Format.h"
+
+static const char *TAG_ASSET = "ASSET";
+
+static const uint8_t *asset_bundle = NULL;      // 映射后的资源包，无效时为NULL
+static esp_partition_mmap_handle_t asset_mmap_handle;
+static void **asset_objs = NULL;                // 按条目序号缓存已创建的lv_font_t / lv_img_dsc_t
+
+esp_err_t Asset_Bundle_Init(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                           CONFIG_PENDANT_ASSET_PARTITION_LABEL);
+    if (part == NULL) {
+        ESP_LOGW(TAG_ASSET, "没有资源分区 %s", CONFIG_PENDANT_ASSET_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // 先读头，只映射资源包实际占用的部分（少占MMU页）
+    asset_bundle_header_t hdr;
+    esp_err_t err = esp_partition_read(part, 0, &hdr, sizeof(hdr));
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (hdr.magic != ASSET_BUNDLE_MAGIC || hdr.version != ASSET_BUNDLE_VERSION ||
+        hdr.size < sizeof(hdr) || hdr.size > part->size) {
+        ESP_LOGW(TAG_ASSET, "资源分区未烧录或版本不符（magic %08" PRIx32 ", version %u）", hdr.magic, hdr.version);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    const void *ptr;
+    err = esp_partition_mmap(part, 0, hdr.size, ESP_PARTITION_MMAP_DATA, &ptr, &asset_mmap_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG_ASSET, "映射资源分区失败: %s", esp_err_to_name(err));
+        return err;
+    }
+    const uint8_t *bundle = ptr;
+
+#if CONFIG_PENDANT_ASSET_VERIFY_CRC
+    uint32_t crc = esp_rom_crc32_le(0, bundle + sizeof(hdr), hdr.size - sizeof(hdr));
+    if (crc != hdr.crc32) {
+        ESP_LOGE(TAG_ASSET, "资源包CRC错误（%08" PRIx32 "，应为%08" PRIx32 "）", crc, hdr.crc32);
+        esp_partition_munmap(asset_mmap_handle);
+        return ESP_ERR_INVALID_CRC;
+    }
+#endif
+    if (!asset_bundle_check(bundle, hdr.size)) {
+        ESP_LOGE(TAG_ASSET, "资源包条目表损坏");
+        esp_partition_munmap(asset_mmap_handle);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    asset_objs = lv_mem_alloc(hdr.entry_cnt * sizeof(void *));
+    if (asset_objs == NULL && hdr.entry_cnt > 0) {
+        esp_partition_munmap(asset_mmap_handle);
+        return ESP_ERR_NO_MEM;
+    }
+    lv_memset_00(asset_objs, hdr.entry_cnt * sizeof(void *));
+    asset_bundle = bundle;
+    ESP_LOGI(TAG_ASSET, "资源分区 %s：%u个资源，%" PRIu32 "字节", part->label, hdr.entry_cnt, hdr.size);
+    return ESP_OK;
+}
+
+// 查找条目，idx返回其序号（asset_objs的下标）
+static const asset_bundle_entry_t *asset_find(const char *name, asset_type_t type, int *idx)
+{
+    if (asset_bundle == NULL) {
+        return NULL;
+    }
+    const asset_bundle_entry_t *e = asset_bundle_find(asset_bundle, name, type);
+    if (e == NULL) {
+        ESP_LOGW(TAG_ASSET, "资源包中没有 %s", name);
+        return NULL;
+    }
+    *idx = e - (const asset_bundle_entry_t *)(asset_bundle + sizeof(asset_bundle_header_t));
+    return e;
+}
+
+const lv_font_t *asset_bundle_get_font(const char *name)
+{
+    int idx;
+    const asset_bundle_entry_t *e = asset_find(name, ASSET_TYPE_FONT, &idx);
+    if (e == NULL) {
+        return NULL;
+    }
+    if (asset_objs[idx] == NULL) {
+        asset_objs[idx] = asset_bundle_font_create(asset_bundle + e->offset, e->size);
+        if (asset_objs[idx] == NULL) {
+            ESP_LOGE(TAG_ASSET, "字体 %s 数据无效", name);
+        }
+    }
+    return asset_objs[idx];
+}
+
+const lv_img_dsc_t *asset_bundle_get_img(const char *name)
+{
+    int idx;
+    const asset_bundle_entry_t *e = asset_find(name, ASSET_TYPE_IMAGE, &idx);
+    if (e == NULL) {
+        return NULL;
+    }
+    if (asset_objs[idx] == NULL) {
+        lv_img_dsc_t *dsc = lv_mem_alloc(sizeof(lv_img_dsc_t));
+        if (dsc != NULL && !asset_bundle_img_init(dsc, asset_bundle + e->offset, e->size)) {
+            ESP_LOGE(TAG_ASSET, "图片 %s 数据无效", name);
+            lv_mem_free(dsc);
+            dsc = NULL;
+        }
+        asset_objs[idx] = dsc;
+    }
+    return asset_objs[idx];
+}
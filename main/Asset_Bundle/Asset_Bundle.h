@@ -0,0 +1,19 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "lvgl.h"
+#include "sdkconfig.h"
+
+// 资源分区：tools/gen_asset_bundle.py把界面字体与图片（ui_assets.json的images）打包写入assets分区
+// （idf.py flash时一起烧录），运行时用esp_partition_mmap映射，LVGL直接从flash读取字形位图与像素，
+// 不经过lv_fs也不复制到RAM
+esp_err_t Asset_Bundle_Init(void);  // 映射并校验资源分区，需在LVGL_Init之后调用
+
+// 按名称获取字体（第一次获取时创建lv_font_t，之后返回同一个对象）；
+// 资源分区无效或没有该字体时返回NULL，调用者应退回LV_FONT_DEFAULT
+const lv_font_t *asset_bundle_get_font(const char *name);
+// 按名称获取图片（第一次获取时创建lv_img_dsc_t，像素指向flash）；资源分区无效或没有该图片时返回NULL
+const lv_img_dsc_t *asset_bundle_get_img(const char *name);
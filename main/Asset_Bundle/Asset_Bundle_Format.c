@@ -0,0 +1,203 @@
+#include "Asset_Bundle_Format.h"
+#include <string.h>
+
+#if LV_FONT_FMT_TXT_LARGE == 0
+_Static_assert(sizeof(lv_font_fmt_txt_glyph_dsc_t) == ASSET_GLYPH_DSC_SIZE, "lv_font_fmt_txt_glyph_dsc_t layout");
+#endif
+
+// 一个字体在内存中的全部描述，一次分配
+typedef struct {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_glyph_cache_t cache;
+    union {
+        lv_font_fmt_txt_kern_classes_t classes;
+        lv_font_fmt_txt_kern_pair_t pairs;
+    } kern;
+    lv_font_fmt_txt_cmap_t cmaps[];     // LV_FONT_FMT_TXT_LARGE时其后是展开的字形描述
+} asset_font_t;
+
+// [ofs, ofs + len)在数据块内且ofs按align对齐
+static bool asset_range_ok(uint32_t ofs, uint32_t len, uint32_t size, uint32_t align)
+{
+    return ofs % align == 0 && ofs <= size && len <= size - ofs;
+}
+
+bool asset_bundle_check(const uint8_t *bundle, size_t size)
+{
+    const asset_bundle_header_t *hdr = (const asset_bundle_header_t *)bundle;
+    if (((uintptr_t)bundle & 3) != 0 || size < sizeof(asset_bundle_header_t) ||
+        hdr->magic != ASSET_BUNDLE_MAGIC || hdr->version != ASSET_BUNDLE_VERSION || hdr->size > size) {
+        return false;
+    }
+    if (!asset_range_ok(sizeof(asset_bundle_header_t), hdr->entry_cnt * sizeof(asset_bundle_entry_t), hdr->size, 4)) {
+        return false;
+    }
+
+    const asset_bundle_entry_t *entries = (const asset_bundle_entry_t *)(bundle + sizeof(asset_bundle_header_t));
+    for (uint32_t i = 0; i < hdr->entry_cnt; i++) {
+        if (memchr(entries[i].name, '\0', ASSET_NAME_LEN) == NULL ||
+            !asset_range_ok(entries[i].offset, entries[i].size, hdr->size, 4)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const asset_bundle_entry_t *asset_bundle_find(const uint8_t *bundle, const char *name, asset_type_t type)
+{
+    const asset_bundle_header_t *hdr = (const asset_bundle_header_t *)bundle;
+    const asset_bundle_entry_t *entries = (const asset_bundle_entry_t *)(bundle + sizeof(asset_bundle_header_t));
+    for (uint32_t i = 0; i < hdr->entry_cnt; i++) {
+        if (entries[i].type == type && strncmp(entries[i].name, name, ASSET_NAME_LEN) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+// 检查一个cmap引用的数组
+static bool asset_cmap_ok(const asset_font_cmap_t *c, uint32_t size)
+{
+    switch (c->type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+            return true;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            return asset_range_ok(c->glyph_id_ofs_list, c->range_length, size, 1);
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+            return asset_range_ok(c->unicode_list, c->list_length * 2U, size, 2);
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            return asset_range_ok(c->unicode_list, c->list_length * 2U, size, 2) &&
+                   asset_range_ok(c->glyph_id_ofs_list, c->list_length * 2U, size, 2);
+        default:
+            return false;
+    }
+}
+
+lv_font_t *asset_bundle_font_create(const uint8_t *blob, uint32_t size)
+{
+    const asset_font_header_t *hdr = (const asset_font_header_t *)blob;
+    if (((uintptr_t)blob & 3) != 0 || size < sizeof(asset_font_header_t)) {
+        return NULL;
+    }
+    if ((hdr->bpp != 1 && hdr->bpp != 2 && hdr->bpp != 3 && hdr->bpp != 4 && hdr->bpp != 8) ||
+        hdr->bitmap_format > LV_FONT_FMT_TXT_RLE || hdr->cmap_num == 0 || hdr->cmap_num > 511 ||
+        !asset_range_ok(hdr->glyph_dsc, hdr->glyph_cnt * ASSET_GLYPH_DSC_SIZE, size, 4) ||
+        !asset_range_ok(hdr->cmaps, hdr->cmap_num * sizeof(asset_font_cmap_t), size, 4) ||
+        hdr->glyph_bitmap >= size) {
+        return NULL;
+    }
+    const asset_font_cmap_t *cmaps = (const asset_font_cmap_t *)(blob + hdr->cmaps);
+    for (uint32_t i = 0; i < hdr->cmap_num; i++) {
+        if (!asset_cmap_ok(&cmaps[i], size)) {
+            return NULL;
+        }
+    }
+
+    uint32_t alloc_size = sizeof(asset_font_t) + hdr->cmap_num * sizeof(lv_font_fmt_txt_cmap_t);
+#if LV_FONT_FMT_TXT_LARGE
+    alloc_size += hdr->glyph_cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t);
+#endif
+    LV_MEM_TAG_BEGIN("asset_font");
+    asset_font_t *f = lv_mem_alloc(alloc_size);
+    LV_MEM_TAG_END();
+    if (f == NULL) {
+        return NULL;
+    }
+    lv_memset_00(f, sizeof(asset_font_t));
+
+    // 字距：描述结构在内存中，数组指向数据块
+    const void *kern_dsc = NULL;
+    if (hdr->kern != 0 && hdr->kern_classes) {
+        const asset_font_kern_classes_t *k = (const asset_font_kern_classes_t *)(blob + hdr->kern);
+        if (!asset_range_ok(hdr->kern, sizeof(*k), size, 4) ||
+            !asset_range_ok(k->class_pair_values, k->left_class_cnt * k->right_class_cnt, size, 1) ||
+            !asset_range_ok(k->left_class_mapping, hdr->glyph_cnt, size, 1) ||
+            !asset_range_ok(k->right_class_mapping, hdr->glyph_cnt, size, 1)) {
+            lv_mem_free(f);
+            return NULL;
+        }
+        f->kern.classes.class_pair_values = (const int8_t *)(blob + k->class_pair_values);
+        f->kern.classes.left_class_mapping = blob + k->left_class_mapping;
+        f->kern.classes.right_class_mapping = blob + k->right_class_mapping;
+        f->kern.classes.left_class_cnt = k->left_class_cnt;
+        f->kern.classes.right_class_cnt = k->right_class_cnt;
+        kern_dsc = &f->kern.classes;
+    } else if (hdr->kern != 0) {
+        const asset_font_kern_pairs_t *k = (const asset_font_kern_pairs_t *)(blob + hdr->kern);
+        if (!asset_range_ok(hdr->kern, sizeof(*k), size, 4) || k->glyph_ids_size > 1 || k->pair_cnt >= (1U << 30) ||
+            !asset_range_ok(k->glyph_ids, k->pair_cnt * 2 << k->glyph_ids_size, size, 1U << k->glyph_ids_size) ||
+            !asset_range_ok(k->values, k->pair_cnt, size, 1)) {
+            lv_mem_free(f);
+            return NULL;
+        }
+        f->kern.pairs.glyph_ids = blob + k->glyph_ids;
+        f->kern.pairs.values = (const int8_t *)(blob + k->values);
+        f->kern.pairs.pair_cnt = k->pair_cnt;
+        f->kern.pairs.glyph_ids_size = k->glyph_ids_size;
+        kern_dsc = &f->kern.pairs;
+    }
+
+    for (uint32_t i = 0; i < hdr->cmap_num; i++) {
+        lv_font_fmt_txt_cmap_t *c = &f->cmaps[i];
+        c->range_start = cmaps[i].range_start;
+        c->range_length = cmaps[i].range_length;
+        c->glyph_id_start = cmaps[i].glyph_id_start;
+        c->unicode_list = cmaps[i].unicode_list ? (const uint16_t *)(blob + cmaps[i].unicode_list) : NULL;
+        c->glyph_id_ofs_list = cmaps[i].glyph_id_ofs_list ? blob + cmaps[i].glyph_id_ofs_list : NULL;
+        c->list_length = cmaps[i].list_length;
+        c->type = cmaps[i].type;
+    }
+
+#if LV_FONT_FMT_TXT_LARGE
+    lv_font_fmt_txt_glyph_dsc_t *glyph_dsc = (lv_font_fmt_txt_glyph_dsc_t *)&f->cmaps[hdr->cmap_num];
+    const uint8_t *src = blob + hdr->glyph_dsc;
+    for (uint32_t i = 0; i < hdr->glyph_cnt; i++, src += ASSET_GLYPH_DSC_SIZE) {
+        uint32_t w;
+        memcpy(&w, src, sizeof(w));
+        glyph_dsc[i].bitmap_index = w & 0xFFFFF;
+        glyph_dsc[i].adv_w = w >> 20;
+        glyph_dsc[i].box_w = src[4];
+        glyph_dsc[i].box_h = src[5];
+        glyph_dsc[i].ofs_x = (int8_t)src[6];
+        glyph_dsc[i].ofs_y = (int8_t)src[7];
+    }
+    f->dsc.glyph_dsc = glyph_dsc;
+#else
+    f->dsc.glyph_dsc = (const lv_font_fmt_txt_glyph_dsc_t *)(blob + hdr->glyph_dsc);
+#endif
+    f->dsc.glyph_bitmap = blob + hdr->glyph_bitmap;
+    f->dsc.cmaps = f->cmaps;
+    f->dsc.kern_dsc = kern_dsc;
+    f->dsc.kern_scale = hdr->kern_scale;
+    f->dsc.cmap_num = hdr->cmap_num;
+    f->dsc.bpp = hdr->bpp;
+    f->dsc.kern_classes = hdr->kern_classes;
+    f->dsc.bitmap_format = hdr->bitmap_format;
+    f->dsc.cache = &f->cache;
+
+    f->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    f->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    f->font.line_height = hdr->line_height;
+    f->font.base_line = hdr->base_line;
+    f->font.subpx = hdr->subpx;
+    f->font.underline_position = hdr->underline_position;
+    f->font.underline_thickness = hdr->underline_thickness;
+    f->font.dsc = &f->dsc;
+    return &f->font;
+}
+
+bool asset_bundle_img_init(lv_img_dsc_t *dsc, const uint8_t *blob, uint32_t size)
+{
+    if (size < sizeof(lv_img_header_t)) {
+        return false;
+    }
+    lv_memset_00(dsc, sizeof(*dsc));
+    memcpy(&dsc->header, blob, sizeof(lv_img_header_t));
+    if (dsc->header.cf == LV_IMG_CF_UNKNOWN || dsc->header.w == 0 || dsc->header.h == 0) {
+        return false;
+    }
+    dsc->data = blob + sizeof(lv_img_header_t);
+    dsc->data_size = size - sizeof(lv_img_header_t);
+    return true;
+}
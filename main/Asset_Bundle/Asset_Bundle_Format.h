@@ -0,0 +1,103 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lvgl.h"
+
+// 资源包格式（由tools/gen_asset_bundle.py生成，小端，每个数据块4字节对齐）
+// 字体的位图、字形描述、cmap与字距数组原样存放，LVGL直接读取映射后的flash；
+// 内存中只保留几个小的描述结构（lv_font_t、lv_font_fmt_txt_dsc_t与cmap表）
+
+#define ASSET_BUNDLE_MAGIC      0x31425341  // "ASB1"
+#define ASSET_BUNDLE_VERSION    1
+#define ASSET_NAME_LEN          16
+#define ASSET_GLYPH_DSC_SIZE    8           // LV_FONT_FMT_TXT_LARGE == 0的lv_font_fmt_txt_glyph_dsc_t
+
+typedef enum {
+    ASSET_TYPE_FONT = 1,    // asset_font_header_t + 各数组
+    ASSET_TYPE_IMAGE = 2,   // LVGL二进制图片：lv_img_header_t + 像素数据
+} asset_type_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entry_cnt;
+    uint32_t size;          // 整个资源包的字节数（含本头）
+    uint32_t crc32;         // 本头之后全部字节的CRC32（与zlib相同）
+} asset_bundle_header_t;
+
+typedef struct {
+    char name[ASSET_NAME_LEN];  // 以0结尾
+    uint8_t type;               // asset_type_t
+    uint8_t reserved[3];
+    uint32_t offset;            // 相对资源包开头
+    uint32_t size;
+} asset_bundle_entry_t;
+
+// 字体数据块的头，偏移均相对数据块开头
+typedef struct {
+    uint16_t line_height;
+    int16_t base_line;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    uint8_t subpx;
+    uint8_t bpp;
+    uint8_t bitmap_format;      // lv_font_fmt_txt_bitmap_format_t
+    uint8_t kern_classes;       // 1: kern指向asset_font_kern_classes_t，0: asset_font_kern_pairs_t
+    uint16_t kern_scale;
+    uint16_t cmap_num;
+    uint16_t glyph_cnt;         // 含0号保留字形
+    uint32_t glyph_bitmap;
+    uint32_t glyph_dsc;         // lv_font_fmt_txt_glyph_dsc_t[glyph_cnt]（LV_FONT_FMT_TXT_LARGE == 0的布局）
+    uint32_t cmaps;             // asset_font_cmap_t[cmap_num]
+    uint32_t kern;              // 0: 无字距
+} asset_font_header_t;
+
+typedef struct {
+    uint32_t range_start;
+    uint32_t unicode_list;      // 0: 无
+    uint32_t glyph_id_ofs_list; // 0: 无
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint16_t list_length;
+    uint8_t type;               // lv_font_fmt_txt_cmap_type_t
+    uint8_t reserved;
+} asset_font_cmap_t;
+
+typedef struct {
+    uint32_t class_pair_values;
+    uint32_t left_class_mapping;
+    uint32_t right_class_mapping;
+    uint8_t left_class_cnt;
+    uint8_t right_class_cnt;
+    uint8_t reserved[2];
+} asset_font_kern_classes_t;
+
+typedef struct {
+    uint32_t glyph_ids;
+    uint32_t values;
+    uint32_t pair_cnt;
+    uint8_t glyph_ids_size;     // 0: uint8_t，1: uint16_t
+    uint8_t reserved[3];
+} asset_font_kern_pairs_t;
+
+_Static_assert(sizeof(asset_bundle_header_t) == 16, "asset_bundle_header_t layout");
+_Static_assert(sizeof(asset_bundle_entry_t) == 28, "asset_bundle_entry_t layout");
+_Static_assert(sizeof(asset_font_header_t) == 32, "asset_font_header_t layout");
+_Static_assert(sizeof(asset_font_cmap_t) == 20, "asset_font_cmap_t layout");
+_Static_assert(sizeof(asset_font_kern_classes_t) == 16, "asset_font_kern_classes_t layout");
+_Static_assert(sizeof(asset_font_kern_pairs_t) == 16, "asset_font_kern_pairs_t layout");
+
+// 检查资源包的头与条目表是否完整（不含CRC，CRC由调用者用ROM函数计算）
+bool asset_bundle_check(const uint8_t *bundle, size_t size);
+
+// 按名称与类型查找条目，找不到返回NULL（资源包须已通过asset_bundle_check）
+const asset_bundle_entry_t *asset_bundle_find(const uint8_t *bundle, const char *name, asset_type_t type);
+
+// 用字体数据块创建lv_font_t，位图等数组直接指向数据块（数据块须在字体使用期间保持映射）；
+// LV_FONT_FMT_TXT_LARGE为1时字形描述的布局不同，只有字形描述展开到内存
+// 描述结构用lv_mem_alloc一次分配，用lv_mem_free释放；数据块不合法时返回NULL
+lv_font_t *asset_bundle_font_create(const uint8_t *blob, uint32_t size);
+
+// 用图片数据块填写lv_img_dsc_t，像素数据直接指向数据块
+bool asset_bundle_img_init(lv_img_dsc_t *dsc, const uint8_t *blob, uint32_t size);
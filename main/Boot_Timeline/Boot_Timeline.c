@@ -0,0 +1,70 @@
+#include "Boot_Timeline.h"
+#include <inttypes.h>
+#include "esp_private/esp_clk.h"
+#include "Debug_Log.h"
+
+static const char *TAG_BOOT = "BOOT";
+
+static const char *boot_phase_names[BOOT_PHASE_MAX] = {
+    "app_main", "jog_ready", "panel_awake", "ui_created", "panel_ready", "splash", "first_frame"
+};
+
+// esp_timer从启动代码初始化后才开始计时，加上该偏移换算成复位以来的时间
+static int64_t boot_timer_offset_us = 0;
+static uint32_t boot_phase_us[BOOT_PHASE_MAX];
+
+void Boot_Timeline_Init(void)
+{
+    // RTC时间从芯片复位开始计数，覆盖ROM、二级bootloader与启动代码
+    int64_t since_reset_us = (int64_t)esp_clk_rtc_time();
+    boot_timer_offset_us = since_reset_us - esp_timer_get_time();
+    boot_timeline_mark(BOOT_PHASE_APP_MAIN);
+}
+
+void boot_timeline_mark(boot_phase_t phase)
+{
+    if (phase >= BOOT_PHASE_MAX || boot_phase_us[phase] != 0) {
+        return;
+    }
+    boot_phase_us[phase] = (uint32_t)(esp_timer_get_time() + boot_timer_offset_us);
+    debug_log(DLOG_EVT_BOOT_PHASE, phase, (int32_t)boot_phase_us[phase]);
+}
+
+bool boot_timeline_reached(boot_phase_t phase)
+{
+    return phase < BOOT_PHASE_MAX && boot_phase_us[phase] != 0;
+}
+
+uint32_t boot_timeline_get_us(boot_phase_t phase)
+{
+    return (phase < BOOT_PHASE_MAX) ? boot_phase_us[phase] : 0;
+}
+
+void boot_timeline_report(void)
+{
+    // 按时间先后打印：有启动画面时面板在界面创建之前就绪
+    uint32_t prev = 0;
+    bool printed[BOOT_PHASE_MAX] = {false};
+    ESP_LOGI(TAG_BOOT, "%-12s %10s %10s", "phase", "since_rst", "delta");
+    for (int n = 0; n < BOOT_PHASE_MAX; n++) {
+        int i = -1;
+        for (int j = 0; j < BOOT_PHASE_MAX; j++) {
+            if (!printed[j] && boot_phase_us[j] != 0 && (i < 0 || boot_phase_us[j] < boot_phase_us[i])) {
+                i = j;
+            }
+        }
+        if (i < 0) {
+            break;
+        }
+        printed[i] = true;
+        ESP_LOGI(TAG_BOOT, "%-12s %7" PRIu32 ".%02" PRIu32 " %7" PRIu32 ".%02" PRIu32 " ms", boot_phase_names[i],
+                 boot_phase_us[i] / 1000, (boot_phase_us[i] % 1000) / 10,
+                 (boot_phase_us[i] - prev) / 1000, ((boot_phase_us[i] - prev) % 1000) / 10);
+        prev = boot_phase_us[i];
+    }
+    for (int i = 0; i < BOOT_PHASE_MAX; i++) {
+        if (boot_phase_us[i] == 0) {
+            ESP_LOGI(TAG_BOOT, "%-12s %10s", boot_phase_names[i], "-");
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// 启动阶段（时间均从芯片复位开始计算，包含ROM与二级bootloader）
+typedef enum {
+    BOOT_PHASE_APP_MAIN = 0,    // 进入app_main
+    BOOT_PHASE_JOG_READY,       // 串口、手轮、拨档、急停全部就绪
+    BOOT_PHASE_PANEL_AWAKE,     // 面板已复位并发出SLPOUT
+    BOOT_PHASE_UI_CREATED,      // LVGL与界面对象创建完成
+    BOOT_PHASE_PANEL_READY,     // 面板初始化序列完成、显示打开
+    BOOT_PHASE_SPLASH,          // 启动画面刷到面板并打开背光（有保存的画面时，早于UI_CREATED）
+    BOOT_PHASE_FIRST_FRAME,     // 第一帧刷到面板并打开背光
+    BOOT_PHASE_MAX
+} boot_phase_t;
+
+void Boot_Timeline_Init(void);             // 在app_main开头调用，记录复位到app_main的时间
+
+void boot_timeline_mark(boot_phase_t phase);        // 记录阶段时间（只记录第一次）
+bool boot_timeline_reached(boot_phase_t phase);
+uint32_t boot_timeline_get_us(boot_phase_t phase);  // 复位到该阶段的微秒数，未到达返回0
+void boot_timeline_report(void);                    // 打印启动时间线
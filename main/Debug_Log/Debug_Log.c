@@ -0,0 +1,189 @@
+#include "Debug_Log.h"
+#include <string.h>
+#include <inttypes.h>
+#include "driver/usb_serial_jtag.h"
+#include "driver/usb_serial_jtag_vfs.h"
+
+static const char *TAG_DLOG = "DLOG";
+
+#if !CONFIG_DEBUG_LOG_FORMAT_BINARY
+static const char *dlog_event_names[DLOG_EVT_MAX] = {
+    "dropped", "boot", "jog", "axis", "multiplier", "estop", "func_btn", "midpoint", "coord_frame", "power", "boot_phase",
+    "stall"
+};
+#endif
+
+#define DLOG_QUEUE_LEN  CONFIG_DEBUG_LOG_QUEUE_LEN
+
+// 记录环形队列（静态分配），写入方可以是中断
+static dlog_record_t dlog_queue[DLOG_QUEUE_LEN];
+static volatile uint32_t dlog_head = 0;     // 写指针
+static volatile uint32_t dlog_tail = 0;     // 读指针
+static volatile uint32_t dlog_dropped = 0;
+static uint8_t dlog_seq = 0;
+static portMUX_TYPE dlog_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// 令牌桶限速：每秒 CONFIG_DEBUG_LOG_RATE_LIMIT 条，最多突发 CONFIG_DEBUG_LOG_BURST 条
+#define DLOG_TOKEN_PERIOD_US  (1000000 / CONFIG_DEBUG_LOG_RATE_LIMIT)
+static int64_t dlog_bucket_time_us = 0;
+static int32_t dlog_tokens = CONFIG_DEBUG_LOG_BURST;
+
+static TaskHandle_t dlog_task_handle = NULL;
+#define DLOG_TASK_STACK_SIZE  3072
+static StaticTask_t dlog_task_tcb;
+static StackType_t dlog_task_stack[DLOG_TASK_STACK_SIZE];
+
+// 控制台命令表，控制台任务读USB-Serial-JTAG的输入并分发
+typedef struct {
+    char key;
+    const char *help;
+    debug_console_cmd_t cmd;
+} debug_console_entry_t;
+static debug_console_entry_t console_cmds[DEBUG_CONSOLE_MAX_CMDS];
+static volatile int console_cmd_count = 0;
+static portMUX_TYPE console_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#define CONSOLE_TASK_STACK_SIZE  3072   // 命令在此任务中执行（追踪导出、统计打印都用printf）
+static StaticTask_t console_task_tcb;
+static StackType_t console_task_stack[CONSOLE_TASK_STACK_SIZE];
+
+// ==================== 写入 ====================
+void IRAM_ATTR debug_log(dlog_event_t event, int32_t a0, int32_t a1)
+{
+    int64_t now = esp_timer_get_time();
+    bool queued = false;
+
+    portENTER_CRITICAL_SAFE(&dlog_lock);
+    int64_t elapsed = now - dlog_bucket_time_us;
+    if (elapsed >= DLOG_TOKEN_PERIOD_US * CONFIG_DEBUG_LOG_BURST) {
+        dlog_tokens = CONFIG_DEBUG_LOG_BURST;
+        dlog_bucket_time_us = now;
+    } else if (elapsed >= DLOG_TOKEN_PERIOD_US) {
+        uint32_t refill = (uint32_t)elapsed / DLOG_TOKEN_PERIOD_US;
+        dlog_tokens += refill;
+        if (dlog_tokens > CONFIG_DEBUG_LOG_BURST) {
+            dlog_tokens = CONFIG_DEBUG_LOG_BURST;
+        }
+        dlog_bucket_time_us += (int64_t)refill * DLOG_TOKEN_PERIOD_US;
+    }
+    if (dlog_tokens > 0 && (dlog_head - dlog_tail) < DLOG_QUEUE_LEN) {
+        dlog_tokens--;
+        dlog_record_t *rec = &dlog_queue[dlog_head % DLOG_QUEUE_LEN];
+        rec->sync[0] = DLOG_SYNC0;
+        rec->sync[1] = DLOG_SYNC1;
+        rec->event = (uint8_t)event;
+        rec->seq = dlog_seq++;
+        rec->time_us = (uint32_t)now;
+        rec->a0 = a0;
+        rec->a1 = a1;
+        dlog_head++;
+        queued = true;
+    } else {
+        dlog_dropped++;
+    }
+    portEXIT_CRITICAL_SAFE(&dlog_lock);
+
+    if (queued && dlog_task_handle) {
+        if (xPortInIsrContext()) {
+            BaseType_t higher_prio_woken = pdFALSE;
+            vTaskNotifyGiveFromISR(dlog_task_handle, &higher_prio_woken);
+            portYIELD_FROM_ISR(higher_prio_woken);
+        } else {
+            xTaskNotifyGive(dlog_task_handle);
+        }
+    }
+}
+
+// ==================== 输出 ====================
+static void debug_log_emit(const dlog_record_t *rec)
+{
+#if CONFIG_DEBUG_LOG_FORMAT_BINARY
+    usb_serial_jtag_write_bytes(rec, sizeof(dlog_record_t), pdMS_TO_TICKS(20));
+#else
+    const char *name = (rec->event < DLOG_EVT_MAX) ? dlog_event_names[rec->event] : "?";
+    ESP_LOGI(TAG_DLOG, "%10" PRIu32 " %-11s %" PRId32 " %" PRId32, rec->time_us, name, rec->a0, rec->a1);
+#endif
+}
+
+static void debug_log_task(void *arg)
+{
+    dlog_record_t rec;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+        // 上报丢弃的记录数（不受限速约束）
+        portENTER_CRITICAL(&dlog_lock);
+        uint32_t dropped = dlog_dropped;
+        dlog_dropped = 0;
+        portEXIT_CRITICAL(&dlog_lock);
+        if (dropped) {
+            rec = (dlog_record_t){ .sync = {DLOG_SYNC0, DLOG_SYNC1}, .event = DLOG_EVT_DROPPED,
+                                   .time_us = (uint32_t)esp_timer_get_time(), .a0 = (int32_t)dropped };
+            debug_log_emit(&rec);
+        }
+
+        while (dlog_tail != dlog_head) {
+            portENTER_CRITICAL(&dlog_lock);
+            rec = dlog_queue[dlog_tail % DLOG_QUEUE_LEN];
+            dlog_tail++;
+            portEXIT_CRITICAL(&dlog_lock);
+            debug_log_emit(&rec);
+        }
+    }
+}
+
+// ==================== 控制台命令 ====================
+void debug_console_register(char key, const char *help, debug_console_cmd_t cmd)
+{
+    portENTER_CRITICAL(&console_lock);
+    if (console_cmd_count < DEBUG_CONSOLE_MAX_CMDS) {
+        console_cmds[console_cmd_count] = (debug_console_entry_t){ .key = key, .help = help, .cmd = cmd };
+        console_cmd_count++;
+    }
+    portEXIT_CRITICAL(&console_lock);
+}
+
+static void console_task(void *arg)
+{
+    uint8_t c;
+    while (1) {
+        if (usb_serial_jtag_read_bytes(&c, 1, portMAX_DELAY) != 1) {
+            continue;
+        }
+        debug_console_cmd_t cmd = NULL;
+        portENTER_CRITICAL(&console_lock);
+        int count = console_cmd_count;
+        for (int i = 0; i < count; i++) {
+            if (console_cmds[i].key == (char)c) {
+                cmd = console_cmds[i].cmd;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&console_lock);
+
+        if (cmd) {
+            cmd();
+        } else if (c == '?') {
+            for (int i = 0; i < count; i++) {
+                printf("%c  %s\n", console_cmds[i].key, console_cmds[i].help);
+            }
+            fflush(stdout);
+        }
+    }
+}
+
+void Debug_Log_Init(void)
+{
+    // 安装USB-Serial-JTAG驱动，控制台改走驱动（阻塞写，不丢字符）
+    usb_serial_jtag_driver_config_t usj_config = USB_SERIAL_JTAG_DRIVER_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(usb_serial_jtag_driver_install(&usj_config));
+    usb_serial_jtag_vfs_use_driver();
+
+    dlog_bucket_time_us = esp_timer_get_time();
+    dlog_task_handle = xTaskCreateStatic(debug_log_task, "debug_log", DLOG_TASK_STACK_SIZE, NULL,
+                                         CONFIG_DEBUG_LOG_TASK_PRIORITY, dlog_task_stack, &dlog_task_tcb);
+    xTaskCreateStatic(console_task, "console", CONSOLE_TASK_STACK_SIZE, NULL, 1, console_task_stack, &console_task_tcb);
+#if !CONFIG_DEBUG_LOG_FORMAT_BINARY
+    ESP_LOGI(TAG_DLOG, "Debug log on USB-Serial-JTAG, %d records/s", CONFIG_DEBUG_LOG_RATE_LIMIT);
+#endif
+}
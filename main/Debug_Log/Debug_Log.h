@@ -0,0 +1,48 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// 调试事件编号（二进制日志中的事件ID，新增事件只能追加在末尾）
+typedef enum {
+    DLOG_EVT_DROPPED = 0,   // 因限速/缓冲满丢弃的记录数  a0=丢弃数
+    DLOG_EVT_BOOT,          // 启动                      a0=复位原因
+    DLOG_EVT_JOG,           // 发送点动指令              a0=轴 a1=位移(µm)
+    DLOG_EVT_AXIS,          // 切换轴                    a0=轴字符(0为OFF档)
+    DLOG_EVT_MULTIPLIER,    // 倍率调整                  a0=倍率×10
+    DLOG_EVT_ESTOP,         // 急停                      a0=1触发/0解除
+    DLOG_EVT_FUNC_BTN,      // 功能按键状态切换          a0=状态
+    DLOG_EVT_MIDPOINT,      // 发送分中指令              a0=轴 a1=中点(µm)
+    DLOG_EVT_COORD_FRAME,   // 收到坐标帧                a0=1解析成功/0失败
+    DLOG_EVT_POWER,         // 亮灭屏                    a0=1唤醒/0暗屏 a1=唤醒到首帧延迟(µs)
+    DLOG_EVT_BOOT_PHASE,    // 启动阶段                  a0=阶段 a1=复位以来的时间(µs)
+    DLOG_EVT_STALL,         // 追踪到的停顿              a0=追踪事件编号 a1=时长(µs)
+    DLOG_EVT_MAX
+} dlog_event_t;
+
+// 二进制记录格式（小端），每条记录以两个同步字节开头
+#define DLOG_SYNC0  0xA5
+#define DLOG_SYNC1  0x5A
+typedef struct __attribute__((packed)) {
+    uint8_t sync[2];
+    uint8_t event;
+    uint8_t seq;            // 序号，用于发现丢包
+    uint32_t time_us;       // esp_timer 时间戳（低32位）
+    int32_t a0;
+    int32_t a1;
+} dlog_record_t;
+
+void Debug_Log_Init(void);  // 安装USB-Serial-JTAG驱动并创建日志输出任务
+
+// 记录一条调试事件，可在任务和中断中调用；超过速率限制时丢弃并计数
+void debug_log(dlog_event_t event, int32_t a0, int32_t a1);
+
+// 调试控制台的单字符命令（例如追踪导出t、任务统计m），由控制台任务在收到该字符时执行
+typedef void (*debug_console_cmd_t)(void);
+// 在各模块的Init中注册，最多DEBUG_CONSOLE_MAX_CMDS个；按?列出已注册的命令
+#define DEBUG_CONSOLE_MAX_CMDS  8
+void debug_console_register(char key, const char *help, debug_console_cmd_t cmd);
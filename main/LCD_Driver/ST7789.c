@@ -4,7 +4,7 @@ static const char *TAG_LCD = "WS_LCD";
 
 esp_lcd_panel_handle_t panel_handle = NULL;
 
-void LCD_Init(void)
+void LCD_Init_Start(void)
 {
      ESP_LOGI(TAG_LCD, "Initialize SPI bus");                                            
      spi_bus_config_t buscfg = {                                                         
@@ -43,6 +43,14 @@ void LCD_Init(void)
 
 
     ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
+    ESP_ERROR_CHECK(esp_lcd_panel_st7789t_sleep_out(panel_handle));
+
+    BK_Init();                                                                                          // Initialize the backlight (off)
+}
+
+void LCD_Init_Finish(void)
+{
+    // 只等待SLPOUT之后剩余的时间，然后发送初始化序列
     ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_mirror(panel_handle, true, false));
 
@@ -51,13 +59,16 @@ void LCD_Init(void)
     // 设置横屏显示(未成功)
     //ESP_ERROR_CHECK(esp_lcd_panel_swap_xy(panel_handle, true));
     //ESP_ERROR_CHECK(esp_lcd_panel_mirror(panel_handle, true, true));
+}
+
+void LCD_Init(void)
+{
+    LCD_Init_Start();
+    LCD_Init_Finish();
 
     ESP_LOGI(TAG_LCD, "Turn on LCD backlight");
     // gpio_set_level(EXAMPLE_PIN_NUM_BK_LIGHT, EXAMPLE_LCD_BK_LIGHT_ON_LEVEL);
-    
-    BK_Init();                                                                                          // Initialize the backlight
     BK_Light(75);
-
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -72,21 +83,23 @@ void BK_Init(void)
     };
     ESP_ERROR_CHECK(gpio_config(&bk_gpio_config));
     
-    // 配置LEDC
+    // 配置LEDC：时钟取自RC_FAST（约17.5MHz），light-sleep中不停，背光亮着也可以睡眠；
+    // 13位分辨率下RC_FAST最高约2kHz，取1kHz留出RC_FAST频率偏差的余量
     ledc_timer_config_t ledc_timer = {
         .duty_resolution = LEDC_TIMER_13_BIT,
-        .freq_hz = 5000,
+        .freq_hz = 1000,
         .speed_mode = LEDC_LS_MODE,
         .timer_num = LEDC_HS_TIMER,
-        .clk_cfg = LEDC_AUTO_CLK
+        .clk_cfg = LEDC_USE_RC_FAST_CLK
     };
-    ledc_timer_config(&ledc_timer);
+    ESP_ERROR_CHECK(ledc_timer_config(&ledc_timer));
 
     ledc_channel.channel    = LEDC_HS_CH0_CHANNEL;
     ledc_channel.duty       = 0;
     ledc_channel.gpio_num   = EXAMPLE_PIN_NUM_BK_LIGHT;
     ledc_channel.speed_mode = LEDC_LS_MODE;
     ledc_channel.timer_sel  = LEDC_HS_TIMER;
+    ledc_channel.sleep_mode = LEDC_SLEEP_MODE_KEEP_ALIVE;
     ledc_channel_config(&ledc_channel);
     ledc_fade_func_install(0);
 }
@@ -99,4 +112,14 @@ void BK_Light(uint8_t Light)
     ledc_set_duty(ledc_channel.speed_mode, ledc_channel.channel, Duty);
     ledc_update_duty(ledc_channel.speed_mode, ledc_channel.channel);
 }
+void BK_Fade(uint8_t Light, int Time_ms)
+{
+    if(Light > 100) Light = 100;
+    uint16_t Duty = LEDC_MAX_Duty-(81*(100-Light));
+    if(Light == 0) Duty = 0;
+    // 硬件渐变到目标占空比，不阻塞调用者；先停下正在进行的渐变（例如渐灭中被唤醒）
+    ledc_fade_stop(ledc_channel.speed_mode, ledc_channel.channel);
+    ledc_set_fade_with_time(ledc_channel.speed_mode, ledc_channel.channel, Duty, Time_ms);
+    ledc_fade_start(ledc_channel.speed_mode, ledc_channel.channel, LEDC_FADE_NO_WAIT);
+}
 // end Backlight program
\ No newline at end of file
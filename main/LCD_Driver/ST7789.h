@@ -55,5 +55,8 @@ extern esp_lcd_panel_handle_t panel_handle;
 
 void BK_Init(void);                             // Initialize the LCD backlight, which has been called in the LCD_Init function, ignore it                                                         
 void BK_Light(uint8_t Light);                   // Call this function to adjust the brightness of the backlight. The value of the parameter Light ranges from 0 to 100
+void BK_Fade(uint8_t Light, int Time_ms);       // Fade the backlight to Light (0-100) over Time_ms using the LEDC fade hardware
 
-void LCD_Init(void);                     // Call this function to initialize the screen (must be called in the main function) !!!!!
\ No newline at end of file
+void LCD_Init(void);                     // Call this function to initialize the screen (must be called in the main function) !!!!!
+void LCD_Init_Start(void);               // Bus, panel IO, reset and Sleep Out; backlight stays off. Work done before LCD_Init_Finish overlaps the sleep-out wait
+void LCD_Init_Finish(void);              // Wait for the rest of the sleep-out time, send the init sequence and turn the display on
\ No newline at end of file
@@ -14,6 +14,8 @@
 #endif
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
 #include "esp_lcd_panel_interface.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_vendor.h"
@@ -27,6 +29,10 @@
 
 static const char *TAG = "lcd_panel.st7789t";
 
+#define ST7789T_RESET_PULSE_US   20     // RESX low pulse, spec minimum 10us
+#define ST7789T_RESET_WAIT_MS    10     // spec: wait 5ms after releasing RESX before sending commands
+#define ST7789T_SLPOUT_WAIT_MS   100    // wait after SLPOUT before the init sequence
+
 static esp_err_t panel_st7789t_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_st7789t_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_st7789t_init(esp_lcd_panel_t *panel);
@@ -47,6 +53,7 @@ typedef struct {
     uint8_t fb_bits_per_pixel;
     uint8_t madctl_val; // save current value of LCD_CMD_MADCTL register
     uint8_t colmod_cal; // save surrent value of LCD_CMD_COLMOD register
+    int64_t slpout_time_us; // time LCD_CMD_SLPOUT was sent, 0 while the panel is in sleep mode
 } st7789t_panel_t;
 
 esp_err_t esp_lcd_new_panel_st7789t(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_st7789t_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
@@ -144,14 +151,24 @@ static esp_err_t panel_st7789t_reset(esp_lcd_panel_t *panel)
     // perform hardware reset
     if (st7789t->reset_gpio_num >= 0) {
         gpio_set_level(st7789t->reset_gpio_num, st7789t->reset_level);
-        vTaskDelay(pdMS_TO_TICKS(10));
+        esp_rom_delay_us(ST7789T_RESET_PULSE_US);
         gpio_set_level(st7789t->reset_gpio_num, !st7789t->reset_level);
-        vTaskDelay(pdMS_TO_TICKS(10));
+        vTaskDelay(pdMS_TO_TICKS(ST7789T_RESET_WAIT_MS));
     } else { // perform software reset
         esp_lcd_panel_io_tx_param(io, LCD_CMD_SWRESET, NULL, 0);
         vTaskDelay(pdMS_TO_TICKS(20)); // spec, wait at least 5m before sending new command
     }
+    st7789t->slpout_time_us = 0;
+
+    return ESP_OK;
+}
 
+esp_err_t esp_lcd_panel_st7789t_sleep_out(esp_lcd_panel_handle_t panel)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    st7789t_panel_t *st7789t = __containerof(panel, st7789t_panel_t, base);
+    esp_lcd_panel_io_tx_param(st7789t->io, LCD_CMD_SLPOUT, NULL, 0);
+    st7789t->slpout_time_us = esp_timer_get_time();
     return ESP_OK;
 }
 
@@ -161,8 +178,16 @@ static esp_err_t panel_st7789t_init(esp_lcd_panel_t *panel)
     esp_lcd_panel_io_handle_t io = st7789t->io;
     // LCD goes into sleep mode and display will be turned off after power on reset, exit sleep mode first
     // printf("AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA\r\n");
-    esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0);
-    vTaskDelay(pdMS_TO_TICKS(100));
+    if (st7789t->slpout_time_us == 0) {
+        esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0);
+        st7789t->slpout_time_us = esp_timer_get_time();
+    }
+    // only wait for what is left of the sleep-out time, the caller may have done other work since
+    // esp_lcd_panel_st7789t_sleep_out()
+    int64_t remain_us = st7789t->slpout_time_us + ST7789T_SLPOUT_WAIT_MS * 1000 - esp_timer_get_time();
+    if (remain_us > 0) {
+        vTaskDelay((TickType_t)((remain_us + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000)));
+    }
     // esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {st7789t->madctl_val,}, 1);
     // esp_lcd_panel_io_tx_param(io, LCD_CMD_COLMOD, (uint8_t[]) {st7789t->colmod_cal,}, 1);
     
@@ -42,6 +42,19 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_st7789t(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_st7789t_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+/**
+ * @brief Send Sleep Out to an ST7789T panel ahead of esp_lcd_panel_init()
+ *
+ * esp_lcd_panel_init() then only waits for the remainder of the sleep-out time,
+ * so the caller can overlap that wait with other work.
+ *
+ * @param[in] panel LCD panel handle returned by esp_lcd_new_panel_st7789t(), after esp_lcd_panel_reset()
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_panel_st7789t_sleep_out(esp_lcd_panel_handle_t panel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,75 @@
+#include "LP_Inputs.h"
+
+#if CONFIG_PENDANT_LP_CORE_INPUTS
+#include "driver/rtc_io.h"
+#include "esp_sleep.h"
+#include "ulp_lp_core.h"
+#include "lp_core_main.h"
+
+static const char *TAG_LP = "LP_INPUTS";
+
+extern const uint8_t lp_core_main_bin_start[] asm("_binary_lp_core_main_bin_start");
+extern const uint8_t lp_core_main_bin_end[]   asm("_binary_lp_core_main_bin_end");
+
+// 手轮A/B相与左拨档均位于LP IO（GPIO0~5）
+static const gpio_num_t lp_input_pins[] = {
+    GPIO_NUM_0, GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5
+};
+
+static int32_t last_encoder_count = 0;
+
+void LP_Inputs_Init(void)
+{
+    ESP_LOGI(TAG_LP, "Start LP core input program");
+    for (int i = 0; i < sizeof(lp_input_pins) / sizeof(lp_input_pins[0]); i++) {
+        ESP_ERROR_CHECK(rtc_gpio_init(lp_input_pins[i]));
+        ESP_ERROR_CHECK(rtc_gpio_set_direction(lp_input_pins[i], RTC_GPIO_MODE_INPUT_ONLY));
+        ESP_ERROR_CHECK(rtc_gpio_pulldown_dis(lp_input_pins[i]));
+        ESP_ERROR_CHECK(rtc_gpio_pullup_en(lp_input_pins[i]));
+    }
+
+    ESP_ERROR_CHECK(ulp_lp_core_load_binary(lp_core_main_bin_start, lp_core_main_bin_end - lp_core_main_bin_start));
+    ulp_wake_threshold = CONFIG_PENDANT_LP_CORE_WAKE_COUNTS;
+
+    ulp_lp_core_cfg_t cfg = {
+        .wakeup_source = ULP_LP_CORE_WAKEUP_SOURCE_HP_CPU,  // 由HP核启动一次，之后LP核常驻循环
+    };
+    ESP_ERROR_CHECK(ulp_lp_core_run(&cfg));
+
+    // LP核作为睡眠唤醒源，配合 lp_inputs_arm_wakeup 使用
+    ESP_ERROR_CHECK(esp_sleep_enable_ulp_wakeup());
+    last_encoder_count = (int32_t)ulp_enc_count;
+}
+
+int32_t lp_inputs_take_encoder_count(void)
+{
+    int32_t now = (int32_t)ulp_enc_count;  // 32位对齐读取，LP核只写、HP核只读
+    int32_t delta = now - last_encoder_count;
+    last_encoder_count = now;
+    return delta;
+}
+
+char lp_inputs_get_left_switch(void)
+{
+    return (char)ulp_left_sw;
+}
+
+void lp_inputs_arm_wakeup(void)
+{
+    ulp_wake_base_count = ulp_enc_count;
+    ulp_wake_request = 1;
+}
+
+void lp_inputs_disarm_wakeup(void)
+{
+    ulp_wake_request = 0;
+}
+
+uint32_t lp_inputs_take_wake_events(void)
+{
+    uint32_t events = ulp_wake_events;
+    ulp_wake_events = 0;
+    return events;
+}
+
+#endif  // CONFIG_PENDANT_LP_CORE_INPUTS
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// LP核输入：手轮计数与左拨档（轴选择）由LP核采集，HP核只读取共享内存
+void LP_Inputs_Init(void);  // 配置LP IO、加载并启动LP核程序
+
+// 取出自上次调用以来的手轮计数增量（与PCNT原始计数单位一致）
+int32_t lp_inputs_take_encoder_count(void);
+
+// 读取LP核防抖后的左拨档值：'X'/'Y'/'Z'/'A'，0为OFF
+char lp_inputs_get_left_switch(void);
+
+// HP核进入睡眠前调用：允许LP核在手轮转动或拨档变化时唤醒HP核
+void lp_inputs_arm_wakeup(void);
+// HP核醒来后调用：不再需要LP核唤醒
+void lp_inputs_disarm_wakeup(void);
+
+// 读取并清除唤醒事件（bit0:手轮 bit1:拨档）
+uint32_t lp_inputs_take_wake_events(void);
@@ -11,15 +11,27 @@ static lv_color_t buf2[ LVGL_BUF_LEN];
 lv_disp_draw_buf_t disp_buf;                                                 // contains internal graphic buffer(s) called draw buffer(s)
 lv_disp_drv_t disp_drv;                                                      // contains callback functions
     
+#if !LV_TICK_CUSTOM
 void example_increase_lvgl_tick(void *arg)
 {
     /* Tell LVGL how many milliseconds has elapsed */
     lv_tick_inc(EXAMPLE_LVGL_TICK_PERIOD_MS);
 }
+#endif
 
 bool example_notify_lvgl_flush_ready(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
 {
     lv_disp_drv_t *disp_driver = (lv_disp_drv_t *)user_ctx;
+#if CONFIG_PENDANT_SPLASH
+    // The splash frame is streamed before LVGL is initialised, it is not an LVGL flush
+    bool need_yield;
+    if (splash_flush_done(&need_yield)) {
+        return need_yield;
+    }
+#endif
+    TRACE_END(TRACE_EVT_FLUSH, 0);
+    perf_hud_flush_done();
+    power_manager_flush_done();
     lv_disp_flush_ready(disp_driver);
     return false;
 }
@@ -31,10 +43,35 @@ void example_lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
     int offsetx2 = area->x2;
     int offsety1 = area->y1;
     int offsety2 = area->y2;
+    power_manager_flush_begin(lv_disp_flush_is_last(drv));
+    TRACE_BEGIN(TRACE_EVT_FLUSH, lv_area_get_size(area));
+    perf_hud_flush_begin();
     // copy a buffer's content to a specific area of the display
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1 + Offset_X, offsety1 + Offset_Y, offsetx2 + Offset_X + 1, offsety2 + Offset_Y + 1, color_map);
 }
 
+#if CONFIG_PENDANT_TRACE
+// Rendering of a frame starts; it ends in example_lvgl_monitor_cb after the last flush was started
+void example_lvgl_render_start_cb(lv_disp_drv_t *drv)
+{
+    TRACE_BEGIN(TRACE_EVT_RENDER, 0);
+}
+#endif
+
+#if CONFIG_PENDANT_TRACE || CONFIG_PENDANT_PERF_HUD
+void example_lvgl_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    TRACE_END(TRACE_EVT_RENDER, px);
+    perf_hud_frame();
+}
+#endif
+
+bool lvgl_flush_idle(void)
+{
+    // no invalidated areas waiting and the last flush has finished: the panel shows the current frame
+    return disp && disp->inv_p == 0 && !disp_buf.flushing;
+}
+
 /* Rotate display and touch, when rotated screen in LVGL. Called when driver parameters are updated. */
 void example_lvgl_port_update_callback(lv_disp_drv_t *drv)
 {
@@ -82,9 +119,19 @@ void LVGL_Init(void)
     disp_drv.drv_update_cb = example_lvgl_port_update_callback;                                         // Function : Rotate display and touch, when rotated screen in LVGL. Called when driver parameters are updated. 
     disp_drv.draw_buf = &disp_buf;                                                                      // LVGL will use this buffer(s) to draw the screens contents
     disp_drv.user_data = panel_handle;                
+    disp_drv.flush_cost = LVGL_FLUSH_COST_NS;                                                           // Dirty areas are joined only if it's cheaper than flushing them separately
+    disp_drv.px_cost = LVGL_PX_COST_NS;
+#if CONFIG_PENDANT_TRACE
+    disp_drv.render_start_cb = example_lvgl_render_start_cb;
+#endif
+#if CONFIG_PENDANT_TRACE || CONFIG_PENDANT_PERF_HUD
+    disp_drv.monitor_cb = example_lvgl_monitor_cb;
+#endif
     ESP_LOGI(TAG_LVGL,"Register display indev to LVGL");                                                  // Custom display driver user data
     disp = lv_disp_drv_register(&disp_drv);                                                  // Create screen objects
     
+    // With LV_TICK_CUSTOM the tick is read from esp_timer and no periodic 2 ms wakeup blocks light-sleep
+#if !LV_TICK_CUSTOM
     /********************* LVGL *********************/
     ESP_LOGI(TAG_LVGL, "Install LVGL tick timer");
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
@@ -96,5 +143,6 @@ void LVGL_Init(void)
     esp_timer_handle_t lvgl_tick_timer = NULL;
     ESP_ERROR_CHECK(esp_timer_create(&lvgl_tick_timer_args, &lvgl_tick_timer));
     ESP_ERROR_CHECK(esp_timer_start_periodic(lvgl_tick_timer, EXAMPLE_LVGL_TICK_PERIOD_MS * 1000));
+#endif
 
 }
@@ -9,9 +9,16 @@
 #include "demos/lv_demos.h"
 
 #include "ST7789.h"
+#include "Power_Manager.h"
+#include "Splash.h"
+#include "Trace.h"
+#include "Perf_HUD.h"
 
 #define LVGL_BUF_LEN  (EXAMPLE_LCD_H_RES * 20)
 #define EXAMPLE_LVGL_TICK_PERIOD_MS    2
+// Refresh costs in ns: a pixel is 16 bits on the SPI bus, a flush adds the window commands and the transaction setup
+#define LVGL_PX_COST_NS        (16ULL * 1000 * 1000 * 1000 / EXAMPLE_LCD_PIXEL_CLOCK_HZ)
+#define LVGL_FLUSH_COST_NS     (CONFIG_PENDANT_LCD_FLUSH_COST_US * 1000)
 
 extern lv_disp_draw_buf_t disp_buf;                                                 // contains internal graphic buffer(s) called draw buffer(s)
 extern lv_disp_drv_t disp_drv;                                                      // contains callback functions
@@ -21,6 +28,15 @@ bool example_notify_lvgl_flush_ready(esp_lcd_panel_io_handle_t panel_io, esp_lcd
 void example_lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
 /* Rotate display and touch, when rotated screen in LVGL. Called when driver parameters are updated. */
 void example_lvgl_port_update_callback(lv_disp_drv_t *drv);
+#if !LV_TICK_CUSTOM
 void example_increase_lvgl_tick(void *arg);
+#endif
+#if CONFIG_PENDANT_TRACE
+void example_lvgl_render_start_cb(lv_disp_drv_t *drv);
+#endif
+#if CONFIG_PENDANT_TRACE || CONFIG_PENDANT_PERF_HUD
+void example_lvgl_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+#endif
+bool lvgl_flush_idle(void);               // True when nothing is invalidated and no flush is in progress
 
 void LVGL_Init(void);                     // Call this function to initialize the screen (must be called in the main function) !!!!!
\ No newline at end of file
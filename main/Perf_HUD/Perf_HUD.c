@@ -0,0 +1,197 @@
+#include "Perf_HUD.h"
+
+#if CONFIG_PENDANT_PERF_HUD
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_log.h"
+
+static const char *TAG_HUD = "PERF_HUD";
+
+// 累计计数，显示时与上一次的快照相减得到速率
+typedef struct {
+    uint32_t frames;            // 渲染的帧数
+    uint32_t flush_us;          // DMA刷屏累计耗时
+    uint32_t jogs;              // 发送的点动指令
+    uint32_t lines_sent;        // 发送的指令行（点动、G10、$X）
+    uint32_t replies;           // 收到的ok/error应答
+    uint32_t status_frames;     // 解析成功的状态帧
+    int64_t last_status_us;     // 最近一个状态帧的时间，0表示还没有收到
+    uint32_t uart_overflows;    // RX FIFO溢出、接收缓冲区满（丢失数据）
+    uint32_t uart_errors;       // 帧错误、校验错误、break
+} perf_hud_counters_t;
+
+static perf_hud_counters_t perf_counters;
+static portMUX_TYPE perf_lock = portMUX_INITIALIZER_UNLOCKED;
+static int64_t perf_flush_start_us;
+
+static lv_obj_t *perf_label = NULL;
+static lv_timer_t *perf_timer = NULL;
+static perf_hud_counters_t perf_last;   // 上一次显示时的快照
+static int64_t perf_last_us;
+
+// 状态帧之外的一行应答
+static char perf_reply[8];
+static uint8_t perf_reply_len = 0;
+
+// ==================== 统计 ====================
+void perf_hud_frame(void)
+{
+    portENTER_CRITICAL(&perf_lock);
+    perf_counters.frames++;
+    portEXIT_CRITICAL(&perf_lock);
+}
+
+void perf_hud_flush_begin(void)
+{
+    perf_flush_start_us = esp_timer_get_time();
+}
+
+void perf_hud_flush_done(void)
+{
+    uint32_t us = (uint32_t)(esp_timer_get_time() - perf_flush_start_us);
+    portENTER_CRITICAL_ISR(&perf_lock);
+    perf_counters.flush_us += us;
+    portEXIT_CRITICAL_ISR(&perf_lock);
+}
+
+void perf_hud_tx_line(bool jog)
+{
+    portENTER_CRITICAL(&perf_lock);
+    perf_counters.lines_sent++;
+    if (jog) {
+        perf_counters.jogs++;
+    }
+    portEXIT_CRITICAL(&perf_lock);
+}
+
+void perf_hud_link_reset(void)
+{
+    portENTER_CRITICAL(&perf_lock);
+    perf_counters.replies = perf_counters.lines_sent;
+    portEXIT_CRITICAL(&perf_lock);
+}
+
+void perf_hud_rx_char(char c)
+{
+    if (c != '\n') {
+        if (c != '\r' && perf_reply_len < sizeof(perf_reply)) {
+            perf_reply[perf_reply_len++] = c;
+        }
+        return;
+    }
+    bool ok = perf_reply_len == 2 && memcmp(perf_reply, "ok", 2) == 0;
+    bool error = perf_reply_len >= 5 && memcmp(perf_reply, "error", 5) == 0;
+    perf_reply_len = 0;
+    if (ok || error) {
+        portENTER_CRITICAL(&perf_lock);
+        // 上位机也在同一串口上通信时应答可能多于本机发送的行数
+        if (perf_counters.replies != perf_counters.lines_sent) {
+            perf_counters.replies++;
+        }
+        portEXIT_CRITICAL(&perf_lock);
+    }
+}
+
+void perf_hud_status_frame(void)
+{
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&perf_lock);
+    perf_counters.status_frames++;
+    perf_counters.last_status_us = now;
+    portEXIT_CRITICAL(&perf_lock);
+}
+
+void perf_hud_uart_event(uart_event_type_t type)
+{
+    portENTER_CRITICAL(&perf_lock);
+    switch (type) {
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            perf_counters.uart_overflows++;
+            break;
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+        case UART_BREAK:
+            perf_counters.uart_errors++;
+            break;
+        default:
+            break;
+    }
+    portEXIT_CRITICAL(&perf_lock);
+}
+
+// ==================== 显示 ====================
+static uint32_t perf_rate(uint32_t cnt, uint32_t ms)
+{
+    return (cnt * 1000 + ms / 2) / ms;
+}
+
+// LVGL定时器，只在显示时运行；暗屏时lv_timer_handler不运行，诊断条也不更新
+static void perf_hud_timer_cb(lv_timer_t *timer)
+{
+    perf_hud_counters_t now;
+    portENTER_CRITICAL(&perf_lock);
+    now = perf_counters;
+    portEXIT_CRITICAL(&perf_lock);
+
+    int64_t t = esp_timer_get_time();
+    uint32_t ms = (uint32_t)((t - perf_last_us) / 1000);
+    if (ms == 0) {
+        return;
+    }
+    uint32_t frames = now.frames - perf_last.frames;
+    uint32_t flush_us = frames ? (now.flush_us - perf_last.flush_us) / frames : 0;
+
+    char age[8];
+    if (now.last_status_us == 0) {
+        strcpy(age, "-");
+    } else if (t - now.last_status_us < 10000000) {
+        snprintf(age, sizeof(age), "%ums", (unsigned)((t - now.last_status_us) / 1000));
+    } else {
+        strcpy(age, ">9s");
+    }
+
+    // 诊断条本身每个周期也渲染一帧，帧率不会低于1000/CONFIG_PENDANT_PERF_HUD_PERIOD_MS
+    char text[64];
+    snprintf(text, sizeof(text), "%ufps %u.%ums J%u/s %u S%u/s %s E%u/%u %uK",
+             (unsigned)perf_rate(frames, ms), (unsigned)(flush_us / 1000), (unsigned)(flush_us / 100 % 10),
+             (unsigned)perf_rate(now.jogs - perf_last.jogs, ms), (unsigned)(now.lines_sent - now.replies),
+             (unsigned)perf_rate(now.status_frames - perf_last.status_frames, ms), age,
+             (unsigned)now.uart_overflows, (unsigned)now.uart_errors, (unsigned)(esp_get_free_heap_size() / 1024));
+    lv_label_set_text(perf_label, text);
+
+    perf_last = now;
+    perf_last_us = t;
+}
+
+void perf_hud_toggle(void)
+{
+    if (perf_label == NULL) {
+        return;
+    }
+    if (lv_obj_has_flag(perf_label, LV_OBJ_FLAG_HIDDEN)) {
+        // 从显示时开始计算速率
+        portENTER_CRITICAL(&perf_lock);
+        perf_last = perf_counters;
+        portEXIT_CRITICAL(&perf_lock);
+        perf_last_us = esp_timer_get_time();
+        lv_label_set_text_static(perf_label, "");
+        lv_obj_clear_flag(perf_label, LV_OBJ_FLAG_HIDDEN);
+        lv_timer_resume(perf_timer);
+    } else {
+        lv_timer_pause(perf_timer);
+        lv_obj_add_flag(perf_label, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void Perf_HUD_Init(lv_obj_t *label)
+{
+    perf_label = label;
+    perf_timer = lv_timer_create(perf_hud_timer_cb, CONFIG_PENDANT_PERF_HUD_PERIOD_MS, NULL);
+    lv_timer_pause(perf_timer);
+    ESP_LOGI(TAG_HUD, "performance HUD: long-press the function button with the axis selector at OFF");
+}
+
+#endif  // CONFIG_PENDANT_PERF_HUD
@@ -0,0 +1,38 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+#include "driver/uart.h"
+#include "sdkconfig.h"
+
+// 诊断条：坐标界面底部预留的一行（coordinate_screen.json的perf_hud），显示
+//   渲染帧率与每帧刷屏耗时、点动指令速率与未应答的指令数、状态帧间隔与速率、串口错误、空闲堆
+// 标签固定宽度且只有一行，更新时只重绘这一条，不引起重新布局。轴选择在OFF档时长按功能键切换显示
+// 关闭CONFIG_PENDANT_PERF_HUD时下面的函数都是空函数
+
+#if CONFIG_PENDANT_PERF_HUD
+void Perf_HUD_Init(lv_obj_t *label);   // 创建界面后调用，label为预留的诊断条（初始隐藏）
+void perf_hud_toggle(void);            // 显示/隐藏（UI任务中调用）
+
+// 统计，可在任务中调用；标注“中断”的只在中断中调用
+void perf_hud_frame(void);                          // LVGL渲染完一帧（monitor_cb）
+void perf_hud_flush_begin(void);                    // flush_cb开始一块的DMA传输
+void perf_hud_flush_done(void);                     // 中断：一块传输完成
+void perf_hud_tx_line(bool jog);                    // 向GRBL发送了一行指令（GRBL对每行回复ok或error）
+void perf_hud_link_reset(void);                     // 发送了软复位（0x18），GRBL丢弃未执行的指令
+void perf_hud_rx_char(char c);                      // 状态帧<...>之外收到的字符，用于识别ok/error应答
+void perf_hud_status_frame(void);                   // 解析了一个状态帧
+void perf_hud_uart_event(uart_event_type_t type);   // UART驱动事件（只统计错误）
+#else
+static inline void Perf_HUD_Init(lv_obj_t *label) {}
+static inline void perf_hud_toggle(void) {}
+static inline void perf_hud_frame(void) {}
+static inline void perf_hud_flush_begin(void) {}
+static inline void perf_hud_flush_done(void) {}
+static inline void perf_hud_tx_line(bool jog) {}
+static inline void perf_hud_link_reset(void) {}
+static inline void perf_hud_rx_char(char c) {}
+static inline void perf_hud_status_frame(void) {}
+static inline void perf_hud_uart_event(uart_event_type_t type) {}
+#endif
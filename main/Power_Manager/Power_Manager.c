@@ -0,0 +1,341 @@
+#include "Power_Manager.h"
+#include <inttypes.h>
+#include "freertos/semphr.h"
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
+#include "ST7789.h"
+#include "Debug_Log.h"
+#include "LP_Inputs.h"
+
+static const char *TAG_PM = "POWER";
+
+typedef enum {
+    PM_STATE_LIT = 0,       // 背光亮，正常渲染
+    PM_STATE_FADING,        // 背光渐灭中，仍然渲染
+    PM_STATE_DARK,          // 背光灭，停止渲染，允许light-sleep
+} pm_state_t;
+
+#define PM_MAX_WAKE_GPIOS   12
+#define PM_FADE_IN_MS       150     // 唤醒时背光渐亮时间（比渐灭短，尽快可见）
+
+typedef struct {
+    gpio_num_t pin;
+    gpio_int_type_t intr_type;      // 正常工作时的中断类型
+} pm_wake_gpio_t;
+
+static pm_wake_gpio_t pm_wake_gpios[PM_MAX_WAKE_GPIOS];
+static int pm_wake_gpio_count = 0;
+static volatile bool pm_gpio_armed = false;
+
+static portMUX_TYPE pm_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile pm_state_t pm_state = PM_STATE_LIT;
+static volatile bool pm_wake_pending = false;
+static volatile int64_t pm_last_activity_us = 0;
+static volatile int64_t pm_wake_time_us = 0;
+static int64_t pm_fade_end_us = 0;
+
+// 唤醒到首帧的测量
+static volatile bool pm_wait_first_frame = false;
+static volatile uint32_t pm_flushes_since_wake = 0;
+static volatile uint32_t pm_flush_pending = 0;
+static volatile bool pm_flush_last = false;
+static volatile uint32_t pm_wake_latency_us = 0;
+static volatile uint32_t pm_worst_wake_latency_us = 0;
+
+static SemaphoreHandle_t pm_activity_sem = NULL;
+static StaticSemaphore_t pm_activity_sem_buf;
+
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t pm_render_lock = NULL;      // lv_timer_handler期间
+static esp_pm_lock_handle_t pm_flush_lock = NULL;       // SPI DMA刷屏期间
+static esp_pm_lock_handle_t pm_jog_lock = NULL;         // 手轮转动期间
+static bool pm_jog_locked = false;
+static int64_t pm_last_jog_us = 0;
+#endif
+
+// ==================== 唤醒源 ====================
+void power_manager_add_wake_gpio(gpio_num_t pin, gpio_int_type_t intr_type)
+{
+    if (pm_wake_gpio_count >= PM_MAX_WAKE_GPIOS) {
+        ESP_LOGW(TAG_PM, "Too many wake GPIOs, GPIO%d ignored", pin);
+        return;
+    }
+    pm_wake_gpios[pm_wake_gpio_count].pin = pin;
+    pm_wake_gpios[pm_wake_gpio_count].intr_type = intr_type;
+    pm_wake_gpio_count++;
+}
+
+// GPIO唤醒只支持电平触发：按当前电平取反配置，任何一次变化都能唤醒
+static void power_manager_arm_wakeup(void)
+{
+    for (int i = 0; i < pm_wake_gpio_count; i++) {
+        gpio_num_t pin = pm_wake_gpios[i].pin;
+        gpio_wakeup_enable(pin, gpio_get_level(pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+    pm_gpio_armed = true;
+#if CONFIG_PENDANT_LP_CORE_INPUTS
+    lp_inputs_take_wake_events();
+    lp_inputs_arm_wakeup();
+#endif
+}
+
+static void power_manager_disarm_wakeup(void)
+{
+    pm_gpio_armed = false;
+    for (int i = 0; i < pm_wake_gpio_count; i++) {
+        gpio_wakeup_disable(pm_wake_gpios[i].pin);
+        gpio_set_intr_type(pm_wake_gpios[i].pin, pm_wake_gpios[i].intr_type);
+    }
+#if CONFIG_PENDANT_LP_CORE_INPUTS
+    lp_inputs_disarm_wakeup();
+#endif
+}
+
+void IRAM_ATTR power_manager_gpio_wake_isr(gpio_num_t pin)
+{
+    if (!pm_gpio_armed) {
+        return;
+    }
+    // 电平中断在引脚保持期间会一直触发，先换回原来的边沿中断
+    for (int i = 0; i < pm_wake_gpio_count; i++) {
+        if (pm_wake_gpios[i].pin == pin) {
+            gpio_ll_wakeup_disable(&GPIO, pin);
+            gpio_ll_set_intr_type(&GPIO, pin, pm_wake_gpios[i].intr_type);
+            break;
+        }
+    }
+
+    bool wake = false;
+    portENTER_CRITICAL_ISR(&pm_lock);
+    if (pm_state != PM_STATE_LIT && !pm_wake_pending) {
+        pm_wake_time_us = esp_timer_get_time();
+        pm_wake_pending = true;
+        wake = true;
+    }
+    portEXIT_CRITICAL_ISR(&pm_lock);
+
+    if (wake) {
+        BaseType_t higher_prio_woken = pdFALSE;
+        xSemaphoreGiveFromISR(pm_activity_sem, &higher_prio_woken);
+        portYIELD_FROM_ISR(higher_prio_woken);
+    }
+}
+
+// ==================== 活动与亮灭屏 ====================
+void power_manager_notify_activity(void)
+{
+    int64_t now = esp_timer_get_time();
+    bool wake = false;
+
+    portENTER_CRITICAL(&pm_lock);
+    pm_last_activity_us = now;
+    if (pm_state != PM_STATE_LIT && !pm_wake_pending) {
+        pm_wake_time_us = now;
+        pm_wake_pending = true;
+        wake = true;
+    }
+    portEXIT_CRITICAL(&pm_lock);
+
+    if (wake && pm_activity_sem) {
+        xSemaphoreGive(pm_activity_sem);
+    }
+}
+
+static void power_manager_enter_dark(void)
+{
+    portENTER_CRITICAL(&pm_lock);
+    pm_state = PM_STATE_DARK;
+    portEXIT_CRITICAL(&pm_lock);
+    power_manager_arm_wakeup();
+    debug_log(DLOG_EVT_POWER, 0, 0);
+}
+
+static void power_manager_wake(void)
+{
+    bool was_dark = (pm_state == PM_STATE_DARK);
+    if (was_dark) {
+        power_manager_disarm_wakeup();
+        pm_flushes_since_wake = 0;
+        pm_wait_first_frame = true;
+    }
+    BK_Fade(CONFIG_PENDANT_BACKLIGHT_LEVEL, PM_FADE_IN_MS);
+
+    portENTER_CRITICAL(&pm_lock);
+    pm_state = PM_STATE_LIT;
+    pm_wake_pending = false;
+    portEXIT_CRITICAL(&pm_lock);
+}
+
+void power_manager_update(void)
+{
+    int64_t now = esp_timer_get_time();
+
+    switch (pm_state) {
+    case PM_STATE_LIT:
+#if CONFIG_PENDANT_IDLE_TIMEOUT_S > 0
+        if ((now - pm_last_activity_us) >= (int64_t)CONFIG_PENDANT_IDLE_TIMEOUT_S * 1000000) {
+            BK_Fade(0, CONFIG_PENDANT_BACKLIGHT_FADE_MS);
+            pm_fade_end_us = now + CONFIG_PENDANT_BACKLIGHT_FADE_MS * 1000;
+            portENTER_CRITICAL(&pm_lock);
+            pm_state = PM_STATE_FADING;
+            portEXIT_CRITICAL(&pm_lock);
+        }
+#endif
+        break;
+    case PM_STATE_FADING:
+        if (pm_wake_pending) {
+            power_manager_wake();      // 渐灭过程中有操作，直接恢复亮度
+        } else if (now >= pm_fade_end_us) {
+            power_manager_enter_dark();
+        }
+        break;
+    case PM_STATE_DARK:
+        if (pm_wake_pending) {
+            power_manager_wake();
+        }
+        break;
+    }
+}
+
+bool power_manager_is_dark(void)
+{
+    return pm_state == PM_STATE_DARK;
+}
+
+void power_manager_idle_wait(void)
+{
+    xSemaphoreTake(pm_activity_sem, pdMS_TO_TICKS(CONFIG_PENDANT_IDLE_POLL_MS));
+}
+
+TickType_t power_manager_poll_period(TickType_t active_ticks)
+{
+    return (pm_state == PM_STATE_DARK) ? pdMS_TO_TICKS(CONFIG_PENDANT_IDLE_POLL_MS) : active_ticks;
+}
+
+// ==================== 唤醒到首帧 ====================
+static void power_manager_record_first_frame(void)
+{
+    uint32_t latency = (uint32_t)(esp_timer_get_time() - pm_wake_time_us);
+    pm_wait_first_frame = false;
+    pm_wake_latency_us = latency;
+    if (latency > pm_worst_wake_latency_us) {
+        pm_worst_wake_latency_us = latency;
+    }
+    debug_log(DLOG_EVT_POWER, 1, (int32_t)latency);
+}
+
+uint32_t power_manager_get_wake_latency_us(void)
+{
+    return pm_wake_latency_us;
+}
+
+uint32_t power_manager_get_worst_wake_latency_us(void)
+{
+    return pm_worst_wake_latency_us;
+}
+
+// ==================== PM锁 ====================
+void power_manager_render_begin(void)
+{
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_acquire(pm_render_lock);
+#endif
+}
+
+void power_manager_render_end(void)
+{
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_release(pm_render_lock);
+#endif
+    // 唤醒后没有需要重绘的区域：屏幕内容一直保留在面板中，此时即为首帧
+    if (pm_wait_first_frame && pm_flushes_since_wake == 0 && pm_flush_pending == 0) {
+        lv_disp_t *d = lv_disp_get_default();
+        if (d && d->inv_p == 0) {
+            power_manager_record_first_frame();
+        }
+    }
+}
+
+void power_manager_flush_begin(bool last)
+{
+    portENTER_CRITICAL(&pm_lock);
+    pm_flush_pending++;
+    pm_flush_last = last;
+    portEXIT_CRITICAL(&pm_lock);
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_acquire(pm_flush_lock);
+#endif
+}
+
+void power_manager_flush_done(void)
+{
+    bool last = false;
+    portENTER_CRITICAL_ISR(&pm_lock);
+    if (pm_flush_pending == 0) {
+        portEXIT_CRITICAL_ISR(&pm_lock);
+        return;     // 不是LVGL发起的刷屏
+    }
+    pm_flush_pending--;
+    pm_flushes_since_wake++;
+    last = pm_flush_last;
+    portEXIT_CRITICAL_ISR(&pm_lock);
+#if CONFIG_PM_ENABLE
+    esp_pm_lock_release(pm_flush_lock);
+#endif
+    if (last && pm_wait_first_frame) {
+        power_manager_record_first_frame();
+    }
+}
+
+void power_manager_jog(bool moved)
+{
+#if CONFIG_PM_ENABLE
+    int64_t now = esp_timer_get_time();
+    if (moved) {
+        pm_last_jog_us = now;
+        if (!pm_jog_locked) {
+            esp_pm_lock_acquire(pm_jog_lock);
+            pm_jog_locked = true;
+        }
+    } else if (pm_jog_locked && (now - pm_last_jog_us) >= CONFIG_PENDANT_PM_JOG_HOLD_MS * 1000) {
+        esp_pm_lock_release(pm_jog_lock);
+        pm_jog_locked = false;
+    }
+#endif
+    if (moved) {
+        power_manager_notify_activity();
+    }
+}
+
+// ==================== 初始化 ====================
+void Power_Manager_Init(void)
+{
+    pm_activity_sem = xSemaphoreCreateBinaryStatic(&pm_activity_sem_buf);
+    pm_last_activity_us = esp_timer_get_time();
+
+#if CONFIG_PM_ENABLE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = CONFIG_PENDANT_PM_MIN_FREQ_MHZ,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        .light_sleep_enable = true,
+#endif
+    };
+    ESP_ERROR_CHECK(esp_pm_configure(&pm_config));
+
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "render", &pm_render_lock));
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "lcd_flush", &pm_flush_lock));
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "jog", &pm_jog_lock));
+    // 背光的LEDC由RC_FAST驱动（BK_Init），light-sleep中保持RC_FAST供电，背光亮着也能睡眠
+    ESP_ERROR_CHECK(esp_sleep_pd_config(ESP_PD_DOMAIN_RC_FAST, ESP_PD_OPTION_ON));
+    ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+
+    ESP_LOGI(TAG_PM, "DFS %d-%d MHz, light-sleep %s, idle timeout %d s", CONFIG_PENDANT_PM_MIN_FREQ_MHZ,
+             CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, pm_config.light_sleep_enable ? "on" : "off",
+             CONFIG_PENDANT_IDLE_TIMEOUT_S);
+#else
+    ESP_LOGI(TAG_PM, "Power management disabled, backlight idle timeout %d s", CONFIG_PENDANT_IDLE_TIMEOUT_S);
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// 电源管理：无操作超时后背光渐灭并停止渲染，暗屏期间CPU自动进入light-sleep；
+// 手轮/拨档/按键/串口活动唤醒后背光渐亮，并统计唤醒到首帧的延迟
+void Power_Manager_Init(void);  // 配置DFS与自动light-sleep、创建PM锁，需在BK_Init之后调用
+
+// 注册暗屏时用作唤醒源的GPIO，intr_type为该引脚正常工作时的中断类型（无中断填GPIO_INTR_DISABLE）
+void power_manager_add_wake_gpio(gpio_num_t pin, gpio_int_type_t intr_type);
+// 在带中断的唤醒引脚的ISR开头调用：把唤醒用的电平中断恢复为原来的边沿中断
+void power_manager_gpio_wake_isr(gpio_num_t pin);
+
+// 报告一次用户/串口活动（任务中调用），暗屏时请求唤醒
+void power_manager_notify_activity(void);
+// UI任务每次循环调用：处理超时渐灭与唤醒渐亮
+void power_manager_update(void);
+// 当前是否暗屏（暗屏时不渲染）
+bool power_manager_is_dark(void);
+// 暗屏时UI任务调用：等待活动事件，最长CONFIG_PENDANT_IDLE_POLL_MS
+void power_manager_idle_wait(void);
+// 轮询任务的周期：亮屏时为active_ticks，暗屏时放慢到CONFIG_PENDANT_IDLE_POLL_MS
+TickType_t power_manager_poll_period(TickType_t active_ticks);
+
+// PM锁：渲染（lv_timer_handler）、SPI DMA刷屏、点动期间保持最高频率
+void power_manager_render_begin(void);
+void power_manager_render_end(void);
+void power_manager_flush_begin(bool last);     // flush_cb中调用，last表示本帧最后一块
+void power_manager_flush_done(void);           // 刷屏完成回调（中断）中调用
+void power_manager_jog(bool moved);            // 编码器任务每次轮询调用
+
+// 唤醒到首帧刷新完成的延迟（微秒）
+uint32_t power_manager_get_wake_latency_us(void);
+uint32_t power_manager_get_worst_wake_latency_us(void);
@@ -0,0 +1,353 @@
+#include "Recorder.h"
+
+#if CONFIG_PENDANT_RECORDER
+#include <inttypes.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "esp_app_desc.h"
+
+static const char *TAG_REC = "RECORDER";
+
+#define REC_CHUNK_SIZE      CONFIG_PENDANT_RECORDER_CHUNK_SIZE
+#define REC_TASK_STACK      3072
+#define REC_TASK_PRIO       1       // 写flash，最低优先级
+#define REPLAY_TASK_PRIO    9       // 回放：低于急停任务，高于被注入输入的编码器任务
+
+static const esp_partition_t *rec_part = NULL;
+static uint32_t rec_slot_size;      // 每个槽的大小（擦除扇区的整数倍）
+
+static TaskHandle_t rec_task_handle = NULL;
+static StaticTask_t rec_task_tcb;
+static StackType_t rec_task_stack[REC_TASK_STACK];
+
+// RAM双缓冲：一个接收记录，另一个等待写入flash
+static uint8_t rec_buf[2][REC_CHUNK_SIZE];
+
+static uint32_t rec_chunk_size(uint16_t len)
+{
+    return (sizeof(session_chunk_t) + len + SESSION_CHUNK_ALIGN - 1) & ~(uint32_t)(SESSION_CHUNK_ALIGN - 1);
+}
+
+static bool rec_read_header(int slot, session_header_t *hdr)
+{
+    return esp_partition_read(rec_part, slot * rec_slot_size, hdr, sizeof(*hdr)) == ESP_OK &&
+           hdr->magic == SESSION_MAGIC;
+}
+
+#if CONFIG_PENDANT_RECORDER_RECORD
+// ==================== 记录 ====================
+static uint16_t rec_len[2];
+static int rec_active = 0;
+static int rec_pending = -1;        // 等待写入flash的缓冲区，-1表示没有
+static volatile bool rec_running = false;
+static int64_t rec_start_us;
+static uint64_t rec_last_us = 0;    // 上一条记录的时间（距会话开始）
+static uint32_t rec_dropped = 0;    // 写flash跟不上时丢弃、还没有写GAP记录的条数
+static portMUX_TYPE rec_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static session_header_t rec_header;
+static uint32_t rec_slot_base;
+static uint32_t rec_offset = 0;     // 槽内下一块的位置，0表示还没有写会话头
+static uint32_t rec_erased = 0;     // 槽内已擦除到的位置
+
+static void recorder_put(session_rec_t *rec)
+{
+    if (!rec_running) {
+        return;
+    }
+    uint8_t out[16 + SESSION_REC_MAX_SIZE];    // 前面可能有一条GAP记录
+    bool notify = false;
+
+    // 在临界区内取时间：各任务的记录按时间顺序写入
+    portENTER_CRITICAL(&rec_lock);
+    rec->time_us = (uint64_t)(esp_timer_get_time() - rec_start_us);
+    size_t n = 0;
+    if (rec_dropped) {
+        session_rec_t gap = {.type = SESSION_REC_GAP, .time_us = rec->time_us, .gap = rec_dropped};
+        n = session_rec_encode(&gap, rec_last_us, out);
+    }
+    n += session_rec_encode(rec, n ? rec->time_us : rec_last_us, &out[n]);
+
+    if (rec_len[rec_active] + n > REC_CHUNK_SIZE) {
+        if (rec_pending >= 0) {
+            rec_dropped++;
+            portEXIT_CRITICAL(&rec_lock);
+            return;
+        }
+        rec_pending = rec_active;
+        rec_active ^= 1;
+        rec_len[rec_active] = 0;
+        notify = true;
+    }
+    memcpy(&rec_buf[rec_active][rec_len[rec_active]], out, n);
+    rec_len[rec_active] += n;
+    rec_last_us = rec->time_us;
+    rec_dropped = 0;
+    portEXIT_CRITICAL(&rec_lock);
+
+    if (notify) {
+        xTaskNotifyGive(rec_task_handle);
+    }
+}
+
+void recorder_encoder(int32_t count)
+{
+    session_rec_t rec = {.type = SESSION_REC_ENCODER, .encoder = count};
+    recorder_put(&rec);
+}
+
+void recorder_switches(char left, float right)
+{
+    session_rec_t rec = {.type = SESSION_REC_SWITCH, .sw = {left, (uint8_t)(right * 10.0f + 0.5f)}};
+    recorder_put(&rec);
+}
+
+void recorder_button(session_button_t id, bool level)
+{
+    session_rec_t rec = {.type = SESSION_REC_BUTTON, .button = {id, level}};
+    recorder_put(&rec);
+}
+
+void recorder_uart_rx(const uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        session_rec_t rec = {.type = SESSION_REC_UART_RX};
+        rec.rx.data = data;
+        rec.rx.len = len < SESSION_RX_MAX ? len : SESSION_RX_MAX;
+        recorder_put(&rec);
+        data += rec.rx.len;
+        len -= rec.rx.len;
+    }
+}
+
+// 追加一块：按需逐扇区擦除，数据先写、块头最后写，中途断电时这一块无效
+// 擦写期间cache关闭，只有IRAM中的中断（急停、功能键）能响应，所以recorder_put不能在中断中调用
+static esp_err_t recorder_write_chunk(const uint8_t *data, uint16_t len)
+{
+    esp_err_t err;
+    if (rec_offset == 0) {
+        // 第一块之前才擦除并写会话头：开机后没有输入时上一次的会话不受影响
+        err = esp_partition_erase_range(rec_part, rec_slot_base, rec_part->erase_size);
+        if (err == ESP_OK) {
+            err = esp_partition_write(rec_part, rec_slot_base, &rec_header, sizeof(rec_header));
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+        rec_erased = rec_part->erase_size;
+        rec_offset = sizeof(rec_header);
+    }
+
+    uint32_t size = rec_chunk_size(len);
+    if (rec_offset + size > rec_slot_size) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    while (rec_erased < rec_offset + size) {
+        err = esp_partition_erase_range(rec_part, rec_slot_base + rec_erased, rec_part->erase_size);
+        if (err != ESP_OK) {
+            return err;
+        }
+        rec_erased += rec_part->erase_size;
+    }
+    session_chunk_t chunk = {.len = len, .reserved = 0, .crc32 = esp_rom_crc32_le(0, data, len)};
+    err = esp_partition_write(rec_part, rec_slot_base + rec_offset + sizeof(chunk), data, len);
+    if (err == ESP_OK) {
+        err = esp_partition_write(rec_part, rec_slot_base + rec_offset, &chunk, sizeof(chunk));
+    }
+    if (err == ESP_OK) {
+        rec_offset += size;
+    }
+    return err;
+}
+
+static void recorder_task(void *arg)
+{
+    while (1) {
+        // 缓冲区满时被唤醒；否则定时把未满的缓冲区也写入，断电时最多丢失这段时间的记录
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_PENDANT_RECORDER_FLUSH_MS)) == 0) {
+            portENTER_CRITICAL(&rec_lock);
+            if (rec_pending < 0 && rec_len[rec_active] > 0) {
+                rec_pending = rec_active;
+                rec_active ^= 1;
+                rec_len[rec_active] = 0;
+            }
+            portEXIT_CRITICAL(&rec_lock);
+        }
+        if (rec_pending < 0) {
+            continue;
+        }
+
+        int idx = rec_pending;
+        esp_err_t err = recorder_write_chunk(rec_buf[idx], rec_len[idx]);
+        portENTER_CRITICAL(&rec_lock);
+        rec_pending = -1;
+        if (err != ESP_OK) {
+            rec_running = false;
+        }
+        portEXIT_CRITICAL(&rec_lock);
+
+        if (err == ESP_ERR_INVALID_SIZE) {
+            ESP_LOGW(TAG_REC, "会话%" PRIu32 "已写满分区的一半，停止记录", rec_header.seq);
+        } else if (err != ESP_OK) {
+            ESP_LOGE(TAG_REC, "写入会话失败: %s", esp_err_to_name(err));
+        }
+        if (!rec_running) {
+            vTaskDelete(NULL);
+        }
+    }
+}
+
+static void recorder_start(void)
+{
+    // 新会话写入另一个槽：上一次的会话（例如机床上记录的）在重启一次后仍然保留
+    session_header_t h[2];
+    bool valid[2] = {rec_read_header(0, &h[0]), rec_read_header(1, &h[1])};
+    int slot = !valid[0] ? 0 : !valid[1] ? 1 : (h[0].seq <= h[1].seq ? 0 : 1);
+    uint32_t seq = 0;
+    for (int i = 0; i < 2; i++) {
+        if (valid[i] && h[i].seq > seq) {
+            seq = h[i].seq;
+        }
+    }
+
+    const uint8_t *sha = esp_app_get_description()->app_elf_sha256;
+    rec_header = (session_header_t){.magic = SESSION_MAGIC, .seq = seq + 1};
+    memcpy(&rec_header.build_id, sha, sizeof(rec_header.build_id));
+    rec_slot_base = slot * rec_slot_size;
+    rec_start_us = esp_timer_get_time();
+    rec_running = true;
+    rec_task_handle = xTaskCreateStatic(recorder_task, "recorder", REC_TASK_STACK, NULL, REC_TASK_PRIO,
+                                        rec_task_stack, &rec_task_tcb);
+    ESP_LOGI(TAG_REC, "记录会话%" PRIu32 "到槽%d（%" PRIu32 " KB）", rec_header.seq, slot, rec_slot_size / 1024);
+}
+
+#else
+// ==================== 回放 ====================
+static const recorder_replay_ops_t *replay_ops;
+static esp_timer_handle_t replay_timer;
+
+static void replay_timer_cb(void *arg)
+{
+    xTaskNotifyGive(rec_task_handle);
+}
+
+// tick只有10ms，用esp_timer唤醒，按微秒精度回放
+static void replay_wait_until(int64_t t)
+{
+    int64_t d = t - esp_timer_get_time();
+    if (d > 0) {
+        esp_timer_start_once(replay_timer, d);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+static void replay_task(void *arg)
+{
+    session_header_t h[2];
+    bool valid[2] = {rec_read_header(0, &h[0]), rec_read_header(1, &h[1])};
+    if (!valid[0] && !valid[1]) {
+        ESP_LOGW(TAG_REC, "没有可回放的会话");
+        vTaskDelete(NULL);
+    }
+    int slot = !valid[1] ? 0 : !valid[0] ? 1 : (h[0].seq > h[1].seq ? 0 : 1);
+    ESP_LOGI(TAG_REC, "回放会话%" PRIu32 "（槽%d，固件%08" PRIx32 "）", h[slot].seq, slot, h[slot].build_id);
+
+    uint32_t base = slot * rec_slot_size;
+    uint32_t off = sizeof(session_header_t);
+    uint8_t *buf = rec_buf[0];
+    uint64_t prev_us = 0;
+    uint32_t cnt = 0, gaps = 0;
+    int64_t late_max = 0, late_sum = 0;
+    bool corrupt = false;
+    int64_t start = esp_timer_get_time();
+
+    while (!corrupt && off + sizeof(session_chunk_t) <= rec_slot_size) {
+        session_chunk_t chunk;
+        if (esp_partition_read(rec_part, base + off, &chunk, sizeof(chunk)) != ESP_OK ||
+            chunk.len == 0xFFFF || chunk.len > REC_CHUNK_SIZE || off + rec_chunk_size(chunk.len) > rec_slot_size ||
+            esp_partition_read(rec_part, base + off + sizeof(chunk), buf, chunk.len) != ESP_OK ||
+            esp_rom_crc32_le(0, buf, chunk.len) != chunk.crc32) {
+            break;  // 会话结束（擦除状态或断电时未写完的块）
+        }
+        const uint8_t *p = buf;
+        const uint8_t *end = buf + chunk.len;
+        while (p < end) {
+            session_rec_t rec;
+            if (!session_rec_decode(&p, end, prev_us, &rec)) {
+                corrupt = true;
+                break;
+            }
+            prev_us = rec.time_us;
+            replay_wait_until(start + (int64_t)rec.time_us);
+            int64_t late = esp_timer_get_time() - (start + (int64_t)rec.time_us);
+            late_sum += late;
+            if (late > late_max) {
+                late_max = late;
+            }
+            cnt++;
+
+            switch (rec.type) {
+                case SESSION_REC_ENCODER:
+                    replay_ops->encoder(rec.encoder);
+                    break;
+                case SESSION_REC_SWITCH:
+                    replay_ops->switches(rec.sw.left, rec.sw.right_x10 / 10.0f);
+                    break;
+                case SESSION_REC_BUTTON:
+                    replay_ops->button((session_button_t)rec.button.id, rec.button.level != 0);
+                    break;
+                case SESSION_REC_UART_RX:
+                    replay_ops->uart_rx(rec.rx.data, rec.rx.len);
+                    break;
+                case SESSION_REC_GAP:
+                    gaps += rec.gap;
+                    break;
+            }
+        }
+        off += rec_chunk_size(chunk.len);
+    }
+
+    ESP_LOGI(TAG_REC, "回放结束：%" PRIu32 "条记录，%" PRIu32 " ms，延迟平均%" PRId32 " us、最大%" PRId32 " us%s",
+             cnt, (uint32_t)(prev_us / 1000), (int32_t)(cnt ? late_sum / cnt : 0), (int32_t)late_max,
+             corrupt ? "，记录损坏" : "");
+    if (gaps) {
+        ESP_LOGW(TAG_REC, "记录时丢弃了%" PRIu32 "条，回放与原会话不完全相同", gaps);
+    }
+    vTaskDelete(NULL);
+}
+#endif
+
+void Recorder_Init(const recorder_replay_ops_t *ops)
+{
+    rec_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                        CONFIG_PENDANT_RECORDER_PARTITION_LABEL);
+    if (rec_part == NULL) {
+        ESP_LOGW(TAG_REC, "没有会话分区 %s", CONFIG_PENDANT_RECORDER_PARTITION_LABEL);
+        return;
+    }
+    rec_slot_size = rec_part->size / 2 / rec_part->erase_size * rec_part->erase_size;
+
+#if CONFIG_PENDANT_RECORDER_RECORD
+    recorder_start();
+#else
+    replay_ops = ops;
+    const esp_timer_create_args_t timer_args = {.callback = replay_timer_cb, .name = "replay"};
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &replay_timer));
+    rec_task_handle = xTaskCreateStatic(replay_task, "replay", REC_TASK_STACK, NULL, REPLAY_TASK_PRIO,
+                                        rec_task_stack, &rec_task_tcb);
+#endif
+}
+
+#if CONFIG_PENDANT_RECORDER_REPLAY
+// 回放模式下不记录
+void recorder_encoder(int32_t count) {}
+void recorder_switches(char left, float right) {}
+void recorder_button(session_button_t id, bool level) {}
+void recorder_uart_rx(const uint8_t *data, size_t len) {}
+#endif
+
+#endif  // CONFIG_PENDANT_RECORDER
@@ -0,0 +1,37 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "Session_Log.h"
+
+// 会话记录：记录手轮增量、拨档、按键与GRBL串口收到的原始字节（带时间戳，格式见Session_Log.h），
+// 先写入RAM双缓冲，由低优先级任务追加到session分区；回放模式开机后按原来的时间把记录的输入重新送入
+// 点动、解析与界面，用于在桌面上复现机床上的工作负载（tools/session_dump.py导出分区内容）
+
+// 回放时由main.c提供的输入注入函数，在回放任务中调用
+typedef struct {
+    void (*encoder)(int32_t count);                     // 手轮增量，累加到下一次编码器轮询
+    void (*switches)(char left, float right);           // 拨档稳定值
+    void (*button)(session_button_t id, bool level);    // 按键电平变化（0为按下）
+    void (*uart_rx)(const uint8_t *data, size_t len);   // GRBL串口收到的数据
+} recorder_replay_ops_t;
+
+#if CONFIG_PENDANT_RECORDER
+// 记录模式：开始新会话（应用任务创建之前调用，ops为NULL）
+// 回放模式：界面与全部任务就绪后调用，按时间回放最新的会话
+void Recorder_Init(const recorder_replay_ops_t *ops);
+
+// 记录输入，只能在任务中调用（不在IRAM中）；回放模式下不记录
+void recorder_encoder(int32_t count);
+void recorder_switches(char left, float right);
+void recorder_button(session_button_t id, bool level);
+void recorder_uart_rx(const uint8_t *data, size_t len);
+#else
+static inline void recorder_encoder(int32_t count) {}
+static inline void recorder_switches(char left, float right) {}
+static inline void recorder_button(session_button_t id, bool level) {}
+static inline void recorder_uart_rx(const uint8_t *data, size_t len) {}
+#endif
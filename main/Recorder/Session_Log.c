@@ -0,0 +1,136 @@
+#include "Session_Log.h"
+#include <string.h>
+
+// ==================== varint ====================
+static size_t put_varint(uint8_t *out, uint64_t v)
+{
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool get_varint(const uint8_t **in, const uint8_t *end, uint64_t *v)
+{
+    const uint8_t *p = *in;
+    uint64_t r = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) {
+            return false;
+        }
+        uint8_t b = *p++;
+        r |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            *in = p;
+            *v = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 小的负数也编码为短的varint
+static uint32_t zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v)
+{
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// ==================== 编码/解码 ====================
+size_t session_rec_encode(const session_rec_t *rec, uint64_t prev_us, uint8_t *out)
+{
+    if (rec->time_us < prev_us) {
+        return 0;
+    }
+    size_t n = 0;
+    out[n++] = (uint8_t)rec->type;
+    n += put_varint(&out[n], rec->time_us - prev_us);
+    switch (rec->type) {
+        case SESSION_REC_ENCODER:
+            n += put_varint(&out[n], zigzag(rec->encoder));
+            break;
+        case SESSION_REC_SWITCH:
+            out[n++] = (uint8_t)rec->sw.left;
+            out[n++] = rec->sw.right_x10;
+            break;
+        case SESSION_REC_BUTTON:
+            out[n++] = rec->button.id;
+            out[n++] = rec->button.level;
+            break;
+        case SESSION_REC_UART_RX:
+            if (rec->rx.len == 0 || rec->rx.len > SESSION_RX_MAX) {
+                return 0;
+            }
+            n += put_varint(&out[n], rec->rx.len);
+            memcpy(&out[n], rec->rx.data, rec->rx.len);
+            n += rec->rx.len;
+            break;
+        case SESSION_REC_GAP:
+            n += put_varint(&out[n], rec->gap);
+            break;
+        default:
+            return 0;
+    }
+    return n;
+}
+
+bool session_rec_decode(const uint8_t **in, const uint8_t *end, uint64_t prev_us, session_rec_t *rec)
+{
+    const uint8_t *p = *in;
+    uint64_t dt, v;
+    if (p >= end) {
+        return false;
+    }
+    rec->type = (session_rec_type_t)*p++;
+    if (!get_varint(&p, end, &dt)) {
+        return false;
+    }
+    rec->time_us = prev_us + dt;
+    switch (rec->type) {
+        case SESSION_REC_ENCODER:
+            if (!get_varint(&p, end, &v) || v > UINT32_MAX) {
+                return false;
+            }
+            rec->encoder = unzigzag((uint32_t)v);
+            break;
+        case SESSION_REC_SWITCH:
+        case SESSION_REC_BUTTON:
+            if (end - p < 2) {
+                return false;
+            }
+            if (rec->type == SESSION_REC_SWITCH) {
+                rec->sw.left = (char)p[0];
+                rec->sw.right_x10 = p[1];
+            } else {
+                rec->button.id = p[0];
+                rec->button.level = p[1];
+            }
+            p += 2;
+            break;
+        case SESSION_REC_UART_RX:
+            if (!get_varint(&p, end, &v) || v == 0 || v > SESSION_RX_MAX || (uint64_t)(end - p) < v) {
+                return false;
+            }
+            rec->rx.data = p;
+            rec->rx.len = (uint16_t)v;
+            p += v;
+            break;
+        case SESSION_REC_GAP:
+            if (!get_varint(&p, end, &v) || v > UINT32_MAX) {
+                return false;
+            }
+            rec->gap = (uint32_t)v;
+            break;
+        default:
+            return false;
+    }
+    *in = p;
+    return true;
+}
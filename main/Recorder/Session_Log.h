@@ -0,0 +1,74 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// 会话记录的二进制格式（与ESP-IDF无关，主机端测试与回放共用；tools/session_dump.py解析同一格式）
+//
+// 分区分为两个槽，新会话写入序号较小或无效的槽，上一次会话在重启一次后仍然保留：
+//   槽 = session_header_t + 若干块，块 = session_chunk_t + len字节记录，下一块4字节对齐
+//   块头为擦除状态（len=0xFFFF）或CRC错误时会话结束
+// 记录 = u8类型 + 距上一条记录的微秒数（varint） + 内容：
+//   ENCODER  手轮增量（zigzag varint）
+//   SWITCH   拨档稳定值：u8左档字符（0为OFF档），u8右档倍率×10
+//   BUTTON   按键电平：u8按键，u8电平（0为按下）
+//   UART_RX  GRBL串口收到的原始字节：varint长度 + 数据
+//   GAP      缓冲区满时丢弃的记录数（varint），之后的回放不再确定
+
+#define SESSION_MAGIC       0x31534553  // "SES1"
+#define SESSION_CHUNK_ALIGN 4
+#define SESSION_RX_MAX      128         // 一条UART_RX记录最多的字节数
+#define SESSION_REC_MAX_SIZE    (1 + 10 + 2 + SESSION_RX_MAX)
+
+typedef struct {
+    uint32_t magic;         // SESSION_MAGIC
+    uint32_t seq;           // 会话序号，每次开始记录加1
+    uint32_t build_id;      // 固件ELF的SHA256前4字节
+    uint32_t reserved;
+} session_header_t;
+
+typedef struct {
+    uint16_t len;           // 记录的字节数
+    uint16_t reserved;
+    uint32_t crc32;         // 记录的CRC32（esp_rom_crc32_le(0, ...)，与zlib相同）
+} session_chunk_t;
+
+typedef enum {
+    SESSION_REC_ENCODER = 1,
+    SESSION_REC_SWITCH,
+    SESSION_REC_BUTTON,
+    SESSION_REC_UART_RX,
+    SESSION_REC_GAP,
+} session_rec_type_t;
+
+typedef enum {
+    SESSION_BTN_FUNC = 0,   // 功能键
+    SESSION_BTN_ESTOP,      // 急停
+} session_button_t;
+
+typedef struct {
+    session_rec_type_t type;
+    uint64_t time_us;       // 距会话开始的时间
+    union {
+        int32_t encoder;
+        struct {
+            char left;
+            uint8_t right_x10;
+        } sw;
+        struct {
+            uint8_t id;     // session_button_t
+            uint8_t level;
+        } button;
+        struct {
+            const uint8_t *data;    // 解码时指向输入数据
+            uint16_t len;
+        } rx;
+        uint32_t gap;
+    };
+} session_rec_t;
+
+// 把rec编码到out（至少SESSION_REC_MAX_SIZE字节），时间相对prev_us，返回字节数；rec无效时返回0
+size_t session_rec_encode(const session_rec_t *rec, uint64_t prev_us, uint8_t *out);
+
+// 从*in解码一条记录（不超过end），时间为prev_us加上记录的间隔；成功时*in移到下一条
+bool session_rec_decode(const uint8_t **in, const uint8_t *end, uint64_t prev_us, session_rec_t *rec);
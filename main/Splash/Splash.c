@@ -0,0 +1,239 @@
+#include "Splash.h"
+
+#if CONFIG_PENDANT_SPLASH
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_heap_caps.h"
+#include "esp_app_desc.h"
+#include "ST7789.h"
+#include "Splash_Frame.h"
+
+_Static_assert(sizeof(lv_color_t) == sizeof(uint16_t), "the splash frame is RGB565 as flushed by LVGL");
+
+static const char *TAG_SPLASH = "SPLASH";
+
+#define SPLASH_STRIP_PX     (EXAMPLE_LCD_H_RES * SPLASH_STRIP_LINES)
+
+static const esp_partition_t *splash_part = NULL;
+static const uint16_t *splash_data = NULL;      // 映射后的编码流，没有可显示的画面时为NULL
+static uint32_t splash_data_words;
+static esp_partition_mmap_handle_t splash_mmap_handle;
+
+// 刷屏时空闲的DMA缓冲区个数，由刷屏完成中断归还
+static volatile bool splash_streaming = false;
+static SemaphoreHandle_t splash_buf_sem = NULL;
+static StaticSemaphore_t splash_buf_sem_buf;
+
+// 固件ELF的SHA256前4字节：界面布局随固件改变，旧固件保存的画面不再显示
+static uint32_t splash_build_id(void)
+{
+    uint32_t id;
+    memcpy(&id, esp_app_get_description()->app_elf_sha256, sizeof(id));
+    return id;
+}
+
+static const esp_partition_t *splash_find_partition(void)
+{
+    if (splash_part == NULL) {
+        splash_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                               CONFIG_PENDANT_SPLASH_PARTITION_LABEL);
+    }
+    return splash_part;
+}
+
+bool Splash_Init(void)
+{
+    const esp_partition_t *part = splash_find_partition();
+    if (part == NULL) {
+        ESP_LOGW(TAG_SPLASH, "没有启动画面分区 %s", CONFIG_PENDANT_SPLASH_PARTITION_LABEL);
+        return false;
+    }
+
+    splash_header_t hdr;
+    if (esp_partition_read(part, 0, &hdr, sizeof(hdr)) != ESP_OK) {
+        return false;
+    }
+    if (hdr.magic != SPLASH_MAGIC || hdr.w != EXAMPLE_LCD_H_RES || hdr.h != EXAMPLE_LCD_V_RES ||
+        hdr.size == 0 || hdr.size % 2 != 0 || hdr.size > part->size - sizeof(hdr)) {
+        ESP_LOGI(TAG_SPLASH, "没有保存的启动画面");
+        return false;
+    }
+    if (hdr.build_id != splash_build_id()) {
+        ESP_LOGI(TAG_SPLASH, "启动画面由其他固件保存，不显示");
+        return false;
+    }
+
+    const void *ptr;
+    esp_err_t err = esp_partition_mmap(part, 0, sizeof(hdr) + hdr.size, ESP_PARTITION_MMAP_DATA, &ptr, &splash_mmap_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG_SPLASH, "映射启动画面分区失败: %s", esp_err_to_name(err));
+        return false;
+    }
+    const uint8_t *data = (const uint8_t *)ptr + sizeof(hdr);
+    uint32_t crc = esp_rom_crc32_le(0, data, hdr.size);
+    if (crc != hdr.crc32) {
+        ESP_LOGE(TAG_SPLASH, "启动画面CRC错误（%08" PRIx32 "，应为%08" PRIx32 "）", crc, hdr.crc32);
+        esp_partition_munmap(splash_mmap_handle);
+        return false;
+    }
+    splash_data = (const uint16_t *)data;
+    splash_data_words = hdr.size / 2;
+    return true;
+}
+
+void Splash_Show(void)
+{
+    if (splash_data == NULL) {
+        return;
+    }
+
+    // 两个条带缓冲区轮流解码与DMA发送，解码下一条带时上一条带在SPI上传输
+    uint16_t *bufs[2];
+    bufs[0] = heap_caps_malloc(SPLASH_STRIP_PX * sizeof(uint16_t), MALLOC_CAP_DMA);
+    bufs[1] = heap_caps_malloc(SPLASH_STRIP_PX * sizeof(uint16_t), MALLOC_CAP_DMA);
+    bool ok = bufs[0] != NULL && bufs[1] != NULL;
+    if (ok) {
+        splash_buf_sem = xSemaphoreCreateCountingStatic(2, 2, &splash_buf_sem_buf);
+        splash_streaming = true;
+
+        const uint16_t *p = splash_data;
+        const uint16_t *end = splash_data + splash_data_words;
+        int i = 0;
+        for (int y = 0; y < EXAMPLE_LCD_V_RES; y += SPLASH_STRIP_LINES, i ^= 1) {
+            int lines = LV_MIN(SPLASH_STRIP_LINES, EXAMPLE_LCD_V_RES - y);
+            xSemaphoreTake(splash_buf_sem, portMAX_DELAY);     // 刷屏按顺序完成，拿到的就是bufs[i]
+            if (!splash_rle_decode(&p, end, bufs[i], EXAMPLE_LCD_H_RES * lines)) {
+                xSemaphoreGive(splash_buf_sem);
+                ok = false;
+                break;
+            }
+            esp_lcd_panel_draw_bitmap(panel_handle, Offset_X, y + Offset_Y,
+                                      Offset_X + EXAMPLE_LCD_H_RES, y + lines + Offset_Y, bufs[i]);
+        }
+        // 等待全部传输完成后才能释放缓冲区并交给LVGL
+        xSemaphoreTake(splash_buf_sem, portMAX_DELAY);
+        xSemaphoreTake(splash_buf_sem, portMAX_DELAY);
+        splash_streaming = false;
+    }
+    heap_caps_free(bufs[0]);
+    heap_caps_free(bufs[1]);
+    esp_partition_munmap(splash_mmap_handle);
+    splash_data = NULL;
+
+    if (ok) {
+        BK_Light(CONFIG_PENDANT_BACKLIGHT_LEVEL);
+    } else {
+        // 面板上是不完整的画面，背光保持关闭，等LVGL的第一帧
+        ESP_LOGE(TAG_SPLASH, "启动画面数据损坏或内存不足");
+    }
+}
+
+bool splash_flush_done(bool *need_yield)
+{
+    if (!splash_streaming) {
+        return false;
+    }
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(splash_buf_sem, &woken);
+    *need_yield = (woken == pdTRUE);
+    return true;
+}
+
+// 逐条带渲染并编码整个屏幕：计算长度与CRC，write为true时同时写入分区
+static esp_err_t splash_encode_frame(const esp_partition_t *part, lv_color_t *px, uint16_t *out, bool write,
+                                     uint32_t *size, uint32_t *crc)
+{
+    lv_obj_t *scr = lv_scr_act();
+    *size = 0;
+    *crc = 0;
+    for (int y = 0; y < EXAMPLE_LCD_V_RES; y += SPLASH_STRIP_LINES) {
+        lv_area_t area = {0, y, EXAMPLE_LCD_H_RES - 1, LV_MIN(y + SPLASH_STRIP_LINES, EXAMPLE_LCD_V_RES) - 1};
+        if (!splash_frame_render(scr, &area, px)) {
+            return ESP_ERR_NO_MEM;
+        }
+        uint32_t bytes = splash_rle_encode((const uint16_t *)px, lv_area_get_size(&area), out) * sizeof(uint16_t);
+        if (*size + bytes > part->size - sizeof(splash_header_t)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        *crc = esp_rom_crc32_le(*crc, (const uint8_t *)out, bytes);
+        if (write) {
+            esp_err_t err = esp_partition_write(part, sizeof(splash_header_t) + *size, out, bytes);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+        *size += bytes;
+    }
+    return ESP_OK;
+}
+
+esp_err_t splash_save(void)
+{
+    const esp_partition_t *part = splash_find_partition();
+    if (part == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    lv_color_t *px = malloc(SPLASH_STRIP_PX * sizeof(lv_color_t));
+    uint16_t *out = malloc(SPLASH_RLE_MAX_WORDS(SPLASH_STRIP_PX) * sizeof(uint16_t));
+    if (px == NULL || out == NULL) {
+        free(px);
+        free(out);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // 暗屏时不运行lv_timer_handler，先完成界面修改后挂起的布局
+    lv_obj_update_layout(lv_scr_act());
+
+    // 第一遍只计算长度与CRC：与已保存的画面相同时不擦写flash
+    splash_header_t hdr = {
+        .w = EXAMPLE_LCD_H_RES,
+        .h = EXAMPLE_LCD_V_RES,
+        .build_id = splash_build_id(),
+    };
+    splash_header_t old;
+    esp_err_t err = splash_encode_frame(part, px, out, false, &hdr.size, &hdr.crc32);
+    if (err == ESP_OK) {
+        err = esp_partition_read(part, 0, &old, sizeof(old));
+    }
+    if (err == ESP_OK && old.magic == SPLASH_MAGIC && old.w == hdr.w && old.h == hdr.h && old.size == hdr.size &&
+        old.crc32 == hdr.crc32 && old.build_id == hdr.build_id) {
+        free(px);
+        free(out);
+        return ESP_OK;
+    }
+
+    // 第二遍写入编码流，头（magic）最后写：中途断电时分区保持无效
+    if (err == ESP_OK) {
+        uint32_t erase_size = (sizeof(hdr) + hdr.size + part->erase_size - 1) / part->erase_size * part->erase_size;
+        err = esp_partition_erase_range(part, 0, erase_size);
+    }
+    uint32_t size = 0;
+    uint32_t crc = 0;
+    if (err == ESP_OK) {
+        err = splash_encode_frame(part, px, out, true, &size, &crc);
+    }
+    if (err == ESP_OK && (size != hdr.size || crc != hdr.crc32)) {
+        err = ESP_ERR_INVALID_STATE;    // 两遍之间界面被修改，下次熄屏时再保存
+    }
+    if (err == ESP_OK) {
+        hdr.magic = SPLASH_MAGIC;
+        err = esp_partition_write(part, 0, &hdr, sizeof(hdr));
+    }
+    free(px);
+    free(out);
+
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG_SPLASH, "保存启动画面：%" PRIu32 "字节", hdr.size);
+    } else {
+        ESP_LOGW(TAG_SPLASH, "保存启动画面失败: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+#endif  // CONFIG_PENDANT_SPLASH
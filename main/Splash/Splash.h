@@ -0,0 +1,18 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// 启动画面：背光熄灭时把当前界面（最后的DRO布局与数值）行程编码保存到splash分区，
+// 下次上电面板初始化后、LVGL初始化之前直接用DMA把它刷到面板并打开背光，LVGL的第一帧再覆盖它
+bool Splash_Init(void);     // 映射并校验保存的画面，有可显示的画面时返回true（此时应先完成LCD_Init_Finish）
+void Splash_Show(void);     // 把画面刷到面板，刷完后打开背光；须在LVGL开始刷屏之前调用
+
+// 背光熄灭后在UI任务中调用：界面与上次保存的不同时重新保存（同一画面不重复擦写flash）
+esp_err_t splash_save(void);
+
+// 面板IO的刷屏完成回调中首先调用：是启动画面的传输时返回true，此时不是LVGL的刷屏
+bool splash_flush_done(bool *need_yield);
@@ -0,0 +1,129 @@
+#include "Splash_Frame.h"
+#include <string.h>
+
+uint32_t splash_rle_encode(const uint16_t *px, uint32_t px_cnt, uint16_t *out)
+{
+    uint16_t *o = out;
+    uint32_t i = 0;
+    uint32_t lit_start = 0;     // 尚未输出的原样像素从这里开始
+
+    while (i < px_cnt) {
+        // 从i开始的相同像素个数
+        uint32_t run = 1;
+        while (i + run < px_cnt && px[i + run] == px[i] && run < SPLASH_RLE_CNT_MAX) {
+            run++;
+        }
+        if (run < SPLASH_RLE_RUN_MIN && i + run < px_cnt) {
+            i += run;
+            continue;
+        }
+        if (run < SPLASH_RLE_RUN_MIN) {
+            i += run;       // 最后几个像素并入原样段
+            run = 0;
+        }
+
+        // 先输出积累的原样像素
+        while (lit_start < i) {
+            uint32_t n = i - lit_start;
+            if (n > SPLASH_RLE_CNT_MAX) {
+                n = SPLASH_RLE_CNT_MAX;
+            }
+            *o++ = n - 1;
+            memcpy(o, &px[lit_start], n * sizeof(uint16_t));
+            o += n;
+            lit_start += n;
+        }
+        if (run) {
+            *o++ = SPLASH_RLE_RUN | (run - 1);
+            *o++ = px[i];
+            i += run;
+            lit_start = i;
+        }
+    }
+    return o - out;
+}
+
+bool splash_rle_decode(const uint16_t **in, const uint16_t *end, uint16_t *px, uint32_t px_cnt)
+{
+    const uint16_t *p = *in;
+    while (px_cnt) {
+        if (p >= end) {
+            return false;
+        }
+        uint16_t t = *p++;
+        uint32_t n = (t & (SPLASH_RLE_RUN - 1)) + 1;
+        if (n > px_cnt) {
+            return false;
+        }
+        if (t & SPLASH_RLE_RUN) {
+            if (p >= end) {
+                return false;
+            }
+            uint16_t c = *p++;
+            // 成对写入：大片底色是主要部分
+            uint32_t k = 0;
+            if (((uintptr_t)px & 3) == 0) {
+                uint32_t c2 = c | ((uint32_t)c << 16);
+                for (; k + 1 < n; k += 2) {
+                    *(uint32_t *)&px[k] = c2;
+                }
+            }
+            for (; k < n; k++) {
+                px[k] = c;
+            }
+        } else {
+            if ((uint32_t)(end - p) < n) {
+                return false;
+            }
+            memcpy(px, p, n * sizeof(uint16_t));
+            p += n;
+        }
+        px += n;
+        px_cnt -= n;
+    }
+    *in = p;
+    return true;
+}
+
+bool splash_frame_render(lv_obj_t *scr, const lv_area_t *area, lv_color_t *buf)
+{
+    // 与lv_snapshot相同：用一个假显示把对象树画进buf，真实显示的缓冲区与刷屏状态不受影响
+    lv_disp_t *disp = lv_obj_get_disp(scr);
+    lv_disp_drv_t driver;
+    lv_disp_drv_init(&driver);
+    driver.hor_res = disp->driver->hor_res;
+    driver.ver_res = disp->driver->ver_res;
+    driver.antialiasing = disp->driver->antialiasing;
+
+    lv_disp_t fake_disp;
+    lv_memset_00(&fake_disp, sizeof(fake_disp));
+    fake_disp.driver = &driver;
+
+    lv_draw_ctx_t *draw_ctx = lv_mem_alloc(disp->driver->draw_ctx_size);
+    if (draw_ctx == NULL) {
+        return false;
+    }
+    disp->driver->draw_ctx_init(&driver, draw_ctx);
+    driver.draw_ctx = draw_ctx;
+    lv_area_t clip = *area;
+    lv_area_t buf_area = *area;
+    draw_ctx->clip_area = &clip;
+    draw_ctx->buf_area = &buf_area;
+    draw_ctx->buf = buf;
+
+    lv_disp_t *refr_ori = _lv_refr_get_disp_refreshing();
+    _lv_refr_set_disp_refreshing(&fake_disp);
+
+    // 屏幕按LVGL刷新时的顺序画：当前屏幕、顶层、系统层
+    lv_obj_t *layers[] = {scr, lv_disp_get_layer_top(disp), lv_disp_get_layer_sys(disp)};
+    for (uint32_t i = 0; i < sizeof(layers) / sizeof(layers[0]); i++) {
+        if (i == 0 || !lv_obj_has_flag(layers[i], LV_OBJ_FLAG_HIDDEN)) {
+            lv_obj_redraw(draw_ctx, layers[i]);
+        }
+    }
+
+    _lv_refr_set_disp_refreshing(refr_ori);
+    disp->driver->draw_ctx_deinit(&driver, draw_ctx);
+    lv_mem_free(draw_ctx);
+    return true;
+}
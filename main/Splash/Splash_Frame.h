@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+// 启动画面帧格式（splash分区，小端）：splash_header_t + RGB565行程编码流
+// 编码流是16位字，像素按LVGL刷屏缓冲区的字节序原样存放，解码后直接交给esp_lcd_panel_draw_bitmap：
+//   1nnnnnnn nnnnnnnn + 1个像素：n+1个相同像素
+//   0nnnnnnn nnnnnnnn + n+1个像素：原样像素
+// 每SPLASH_STRIP_LINES行为一个条带，条带单独编码（记号不跨条带），解码一个条带正好填满一个DMA缓冲区
+
+#define SPLASH_MAGIC            0x314C5053  // "SPL1"
+#define SPLASH_STRIP_LINES      16
+
+#define SPLASH_RLE_RUN          0x8000
+#define SPLASH_RLE_CNT_MAX      0x8000
+#define SPLASH_RLE_RUN_MIN      3           // 至少3个相同像素才单独编为一段（2个时与原样段一样长）
+#define SPLASH_RLE_MAX_WORDS(px_cnt)    ((px_cnt) * 2)  // 最坏情况的编码长度（字）
+
+typedef struct {
+    uint32_t magic;         // 最后写入，写到一半断电时分区无效
+    uint16_t w;
+    uint16_t h;
+    uint32_t size;          // 编码流的字节数
+    uint32_t crc32;         // 编码流的CRC32（与zlib相同）
+    uint32_t build_id;      // 保存该帧的固件（界面布局改变后不再显示旧画面）
+} splash_header_t;
+
+_Static_assert(sizeof(splash_header_t) == 20, "splash_header_t layout");
+
+// 编码px_cnt个像素，返回写入out的字数（out至少SPLASH_RLE_MAX_WORDS(px_cnt)字）
+uint32_t splash_rle_encode(const uint16_t *px, uint32_t px_cnt, uint16_t *out);
+
+// 从*in解码正好px_cnt个像素，*in前进到下一个条带；数据越过end或记号跨条带时返回false
+bool splash_rle_decode(const uint16_t **in, const uint16_t *end, uint16_t *px, uint32_t px_cnt);
+
+// 把scr在area内的部分离屏渲染到buf（area大小），像素与LVGL刷屏时相同；
+// 不经过显示驱动的flush_cb，须在LVGL任务中调用。内存不足时返回false
+bool splash_frame_render(lv_obj_t *scr, const lv_area_t *area, lv_color_t *buf);
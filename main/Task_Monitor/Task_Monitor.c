@@ -0,0 +1,264 @@
+#include "Task_Monitor.h"
+
+#if CONFIG_TASK_MONITOR
+#include <string.h>
+#include <inttypes.h>
+#include "lvgl.h"
+#include "freertos/semphr.h"
+#include "esp_freertos_hooks.h"
+#include "Debug_Log.h"
+
+static const char *TAG_TM = "TASK_MON";
+
+static const char *tm_task_names[TM_TASK_MAX] = {
+    "estop", "encoder", "switch", "uart_rx", "ui"
+};
+
+// tick钩子记录的最近一次节拍时间，用于把唤醒节拍换算成微秒
+static portMUX_TYPE tm_tick_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile TickType_t tm_last_tick = 0;
+static volatile int64_t tm_last_tick_us = 0;
+
+static volatile uint32_t tm_worst_latency_us[TM_TASK_MAX];
+
+// 采样快照（静态分配，避免在监视任务中申请内存）
+static TaskStatus_t tm_status_buf[TM_MAX_TASKS];
+static configRUN_TIME_COUNTER_TYPE tm_prev_runtime[TM_MAX_TASKS];
+static UBaseType_t tm_prev_number[TM_MAX_TASKS];
+static int tm_prev_count = 0;
+static configRUN_TIME_COUNTER_TYPE tm_prev_total = 0;
+
+static tm_task_stats_t tm_stats[TM_MAX_TASKS];
+static int tm_stats_count = 0;
+static portMUX_TYPE tm_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// LVGL刷新统计与堆快照：监视任务置位请求，UI任务在lv_timer_handler之后采样
+#define TM_LVGL_TAG_MAX  24
+static volatile bool tm_lvgl_sample_req = false;
+static lv_refr_stat_t tm_lvgl_refr;
+static lv_mem_monitor_t tm_lvgl_mon;
+#if LV_MEM_ACCOUNTING
+static lv_mem_tag_stat_t tm_lvgl_tags[TM_LVGL_TAG_MAX];
+static uint32_t tm_lvgl_tag_count = 0;
+static uint32_t tm_lvgl_used = 0;
+static uint32_t tm_lvgl_peak = 0;
+#endif
+
+// 打印用的缓冲区较大，放在静态区；监视任务与控制台命令m都会打印，用互斥量串行化
+static SemaphoreHandle_t tm_print_mutex = NULL;
+static StaticSemaphore_t tm_print_mutex_buf;
+
+#define TM_TASK_STACK_SIZE  3072
+static StaticTask_t tm_task_tcb;
+static StackType_t tm_task_stack[TM_TASK_STACK_SIZE];
+
+// ==================== tick钩子 ====================
+static void IRAM_ATTR task_monitor_tick_hook(void)
+{
+    portENTER_CRITICAL_ISR(&tm_tick_lock);
+    tm_last_tick = xTaskGetTickCountFromISR();
+    tm_last_tick_us = esp_timer_get_time();
+    portEXIT_CRITICAL_ISR(&tm_tick_lock);
+}
+
+// ==================== 调度延迟记录 ====================
+void task_monitor_record_latency(tm_task_id_t id, uint32_t latency_us)
+{
+    if (id >= TM_TASK_MAX) {
+        return;
+    }
+    if (latency_us > tm_worst_latency_us[id]) {
+        tm_worst_latency_us[id] = latency_us;
+    }
+}
+
+uint32_t task_monitor_get_worst_latency(tm_task_id_t id)
+{
+    return (id < TM_TASK_MAX) ? tm_worst_latency_us[id] : 0;
+}
+
+void task_monitor_delay(tm_task_id_t id, TickType_t ticks)
+{
+    TickType_t due = xTaskGetTickCount() + ticks;
+    vTaskDelay(ticks);
+
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&tm_tick_lock);
+    TickType_t tick = tm_last_tick;
+    int64_t tick_us = tm_last_tick_us;
+    portEXIT_CRITICAL(&tm_tick_lock);
+
+    // 唤醒节拍之后经过的时间 = 最近节拍之后的时间 + 迟到的整节拍数
+    int64_t latency = (now_us - tick_us) + (int64_t)(TickType_t)(tick - due) * portTICK_PERIOD_MS * 1000;
+    if (tick_us != 0 && latency >= 0) {
+        task_monitor_record_latency(id, (uint32_t)latency);
+    }
+}
+
+// ==================== 采样 ====================
+static void task_monitor_sample(void)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    int count = (int)uxTaskGetSystemState(tm_status_buf, TM_MAX_TASKS, &total);
+    configRUN_TIME_COUNTER_TYPE total_delta = total - tm_prev_total;
+
+    portENTER_CRITICAL(&tm_stats_lock);
+    for (int i = 0; i < count; i++) {
+        TaskStatus_t *st = &tm_status_buf[i];
+        configRUN_TIME_COUNTER_TYPE prev = st->ulRunTimeCounter;
+        for (int j = 0; j < tm_prev_count; j++) {
+            if (tm_prev_number[j] == st->xTaskNumber) {
+                prev = tm_prev_runtime[j];
+                break;
+            }
+        }
+        tm_task_stats_t *out = &tm_stats[i];
+        strlcpy(out->name, st->pcTaskName, sizeof(out->name));
+        out->priority = st->uxCurrentPriority;
+        out->stack_free_bytes = st->usStackHighWaterMark;  // ESP-IDF中栈单位为字节
+        out->cpu_permille = total_delta ? (uint32_t)(((uint64_t)(st->ulRunTimeCounter - prev) * 1000) / total_delta) : 0;
+    }
+    tm_stats_count = count;
+    portEXIT_CRITICAL(&tm_stats_lock);
+
+    for (int i = 0; i < count; i++) {
+        tm_prev_number[i] = tm_status_buf[i].xTaskNumber;
+        tm_prev_runtime[i] = tm_status_buf[i].ulRunTimeCounter;
+    }
+    tm_prev_count = count;
+    tm_prev_total = total;
+
+    tm_lvgl_sample_req = true;
+}
+
+void task_monitor_sample_lvgl(void)
+{
+    if (!tm_lvgl_sample_req) {
+        return;
+    }
+    tm_lvgl_sample_req = false;
+
+    // 读取LVGL状态与遍历TLSF堆在锁外进行，只在拷贝结果时进入临界区
+    lv_refr_stat_t refr;
+    lv_refr_get_stat(&refr);
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+#if LV_MEM_ACCOUNTING
+    static lv_mem_tag_stat_t tags[TM_LVGL_TAG_MAX];
+    uint32_t tag_count = lv_mem_get_tag_stat(tags, TM_LVGL_TAG_MAX);
+    uint32_t used, peak;
+    lv_mem_get_used_size(&used, &peak);
+#endif
+
+    portENTER_CRITICAL(&tm_stats_lock);
+    tm_lvgl_refr = refr;
+    tm_lvgl_mon = mon;
+#if LV_MEM_ACCOUNTING
+    memcpy(tm_lvgl_tags, tags, tag_count * sizeof(lv_mem_tag_stat_t));
+    tm_lvgl_tag_count = tag_count;
+    tm_lvgl_used = used;
+    tm_lvgl_peak = peak;
+#endif
+    portEXIT_CRITICAL(&tm_stats_lock);
+}
+
+int task_monitor_get_stats(tm_task_stats_t *out, int max_count)
+{
+    portENTER_CRITICAL(&tm_stats_lock);
+    int count = (tm_stats_count < max_count) ? tm_stats_count : max_count;
+    memcpy(out, tm_stats, count * sizeof(tm_task_stats_t));
+    portEXIT_CRITICAL(&tm_stats_lock);
+    return count;
+}
+
+void task_monitor_print(void)
+{
+    xSemaphoreTake(tm_print_mutex, portMAX_DELAY);
+
+    static tm_task_stats_t snapshot[TM_MAX_TASKS];
+    int count = task_monitor_get_stats(snapshot, TM_MAX_TASKS);
+
+    printf("%-16s %4s %6s %10s\n", "task", "prio", "cpu%", "stack_free");
+    for (int i = 0; i < count; i++) {
+        printf("%-16s %4u %3" PRIu32 ".%" PRIu32 " %10" PRIu32 "\n", snapshot[i].name, (unsigned)snapshot[i].priority,
+               snapshot[i].cpu_permille / 10, snapshot[i].cpu_permille % 10,
+               snapshot[i].stack_free_bytes);
+    }
+    printf("%-16s %12s\n", "task", "worst_lat_us");
+    for (int i = 0; i < TM_TASK_MAX; i++) {
+        printf("%-16s %12" PRIu32 "\n", tm_task_names[i], tm_worst_latency_us[i]);
+    }
+
+    // LVGL刷新统计（自启动以来）与LVGL堆，都是UI任务中采样的快照
+    static lv_refr_stat_t refr;
+    static lv_mem_monitor_t mon;
+#if LV_MEM_ACCOUNTING
+    static lv_mem_tag_stat_t tags[TM_LVGL_TAG_MAX];
+    uint32_t tag_count, used, peak;
+#endif
+    portENTER_CRITICAL(&tm_stats_lock);
+    refr = tm_lvgl_refr;
+    mon = tm_lvgl_mon;
+#if LV_MEM_ACCOUNTING
+    tag_count = tm_lvgl_tag_count;
+    memcpy(tags, tm_lvgl_tags, tag_count * sizeof(lv_mem_tag_stat_t));
+    used = tm_lvgl_used;
+    peak = tm_lvgl_peak;
+#endif
+    portEXIT_CRITICAL(&tm_stats_lock);
+
+    uint32_t frames = refr.frame_cnt ? refr.frame_cnt : 1;
+    printf("%-16s %8s %8s %8s %8s\n", "lvgl_refr", "inv", "areas", "flushes", "px");
+    printf("%-16s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n", "avg/frame", refr.sum.inv_cnt / frames,
+           refr.sum.area_cnt / frames, refr.sum.flush_cnt / frames, refr.sum.px_cnt / frames);
+    printf("%-16s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n", "max/frame", refr.max.inv_cnt,
+           refr.max.area_cnt, refr.max.flush_cnt, refr.max.px_cnt);
+    printf("%-16s %8" PRIu32 "\n", "frames", refr.frame_cnt);
+
+    printf("%-16s %8s %8s %8s %8s\n", "lvgl_mem", "used", "max_used", "biggest", "frag%");
+    printf("%-16s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8u\n", "heap", mon.total_size - mon.free_size,
+           mon.max_used, mon.free_biggest_size, (unsigned)mon.frag_pct);
+#if LV_MEM_ACCOUNTING
+    // 按标签（对象类、timer、缓存等）统计的请求字节数，不含分配器开销
+    printf("%-16s %8s %8s %8s %8s\n", "lvgl_mem_tag", "cnt", "bytes", "peak", "allocs");
+    for (uint32_t i = 0; i < tag_count; i++) {
+        printf("%-16s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n", tags[i].name, tags[i].cnt,
+               tags[i].size, tags[i].peak_size, tags[i].alloc_cnt);
+    }
+    printf("%-16s %8s %8" PRIu32 " %8" PRIu32 "\n", "total", "", used, peak);
+#endif
+
+    xSemaphoreGive(tm_print_mutex);
+}
+
+// ==================== 监视任务 ====================
+static void task_monitor_task(void *arg)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+#if CONFIG_TASK_MONITOR_REPORT_PERIOD_MS > 0
+    TickType_t last_report = last_wake;
+#endif
+    while (1) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CONFIG_TASK_MONITOR_SAMPLE_PERIOD_MS));
+        task_monitor_sample();
+#if CONFIG_TASK_MONITOR_REPORT_PERIOD_MS > 0
+        if ((xTaskGetTickCount() - last_report) >= pdMS_TO_TICKS(CONFIG_TASK_MONITOR_REPORT_PERIOD_MS)) {
+            last_report = xTaskGetTickCount();
+            task_monitor_print();
+        }
+#endif
+    }
+}
+
+void Task_Monitor_Init(void)
+{
+    ESP_LOGI(TAG_TM, "Install task monitor, press m on the console to print");
+    tm_print_mutex = xSemaphoreCreateMutexStatic(&tm_print_mutex_buf);
+    ESP_ERROR_CHECK(esp_register_freertos_tick_hook(task_monitor_tick_hook));
+    task_monitor_sample();  // 建立第一次基准快照
+    xTaskCreateStatic(task_monitor_task, "task_monitor", TM_TASK_STACK_SIZE, NULL,
+                      CONFIG_TASK_MONITOR_TASK_PRIORITY, tm_task_stack, &tm_task_tcb);
+    debug_console_register('m', "print task, LVGL refresh and heap statistics", task_monitor_print);
+}
+
+#endif  // CONFIG_TASK_MONITOR
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// 被监视的应用任务（用于统计调度延迟）
+typedef enum {
+    TM_TASK_ESTOP = 0,      // 急停任务
+    TM_TASK_ENCODER,        // 编码器点动任务
+    TM_TASK_SWITCH,         // 拨档任务
+    TM_TASK_UART_RX,        // 串口接收任务
+    TM_TASK_UI,             // UI主循环任务
+    TM_TASK_MAX
+} tm_task_id_t;
+
+#define TM_MAX_TASKS  24    // 快照最多记录的任务数
+
+// 单个任务的统计结果
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    UBaseType_t priority;
+    uint32_t stack_free_bytes;      // 栈高水位（剩余最少字节数）
+    uint32_t cpu_permille;          // 上一采样周期的CPU占用（千分比）
+} tm_task_stats_t;
+
+#if CONFIG_TASK_MONITOR
+void Task_Monitor_Init(void);      // 创建采样任务、注册tick钩子与控制台命令m，需在应用任务创建后调用
+
+// 替代vTaskDelay：延时ticks个节拍，并记录唤醒时的调度延迟
+void task_monitor_delay(tm_task_id_t id, TickType_t ticks);
+// 直接记录一次调度延迟（例如从中断到任务运行）
+void task_monitor_record_latency(tm_task_id_t id, uint32_t latency_us);
+// 读取某任务的最坏调度延迟（微秒）
+uint32_t task_monitor_get_worst_latency(tm_task_id_t id);
+
+// 读取上一次采样的任务统计，返回任务数
+int task_monitor_get_stats(tm_task_stats_t *out, int max_count);
+// 把上一次采样结果打印到调试控制台（可在任意任务中调用，多个调用者依次打印）
+void task_monitor_print(void);
+// 在UI任务中调用（LVGL非线程安全）：监视任务请求采样后，记录一次LVGL刷新统计与堆快照
+void task_monitor_sample_lvgl(void);
+#else
+// 关闭任务监视时的空实现，调用处不需要条件编译
+static inline void Task_Monitor_Init(void) { }
+static inline void task_monitor_delay(tm_task_id_t id, TickType_t ticks) { vTaskDelay(ticks); }
+static inline void task_monitor_record_latency(tm_task_id_t id, uint32_t latency_us) { }
+static inline uint32_t task_monitor_get_worst_latency(tm_task_id_t id) { return 0; }
+static inline int task_monitor_get_stats(tm_task_stats_t *out, int max_count) { return 0; }
+static inline void task_monitor_print(void) { }
+static inline void task_monitor_sample_lvgl(void) { }
+#endif
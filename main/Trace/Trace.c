@@ -0,0 +1,171 @@
+#include "Trace.h"
+
+#if CONFIG_PENDANT_TRACE
+#include <inttypes.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include "esp_pm.h"
+#include "esp_private/esp_clk.h"
+#include "Debug_Log.h"
+
+static const char *TAG_TRACE = "TRACE";
+
+#define TRACE_LEN   CONFIG_PENDANT_TRACE_EVENTS
+_Static_assert((TRACE_LEN & (TRACE_LEN - 1)) == 0, "CONFIG_PENDANT_TRACE_EVENTS must be a power of two");
+
+typedef struct {
+    uint32_t cycles;        // CPU周期计数器（32位，160MHz时约27秒回绕一次，主机端展开）
+    uint8_t id;             // trace_event_t
+    char ph;                // TRACE_PH_*
+    uint16_t reserved;
+    int32_t arg;
+} trace_rec_t;
+
+static const char *trace_cat_names[TRACE_CAT_MAX] = {
+    "encoder", "switch", "uart_rx", "uart_tx", "parser", "lvgl", "render", "flush", "input", "trace"
+};
+
+static const struct {
+    trace_event_t id;
+    const char *name;
+} trace_event_names[] = {
+    {TRACE_EVT_ENCODER_POLL, "encoder_poll"},
+    {TRACE_EVT_SWITCH_AXIS, "switch_axis"},
+    {TRACE_EVT_SWITCH_MULTIPLIER, "switch_multiplier"},
+    {TRACE_EVT_UART_RX, "uart_rx"},
+    {TRACE_EVT_UART_TX_JOG, "uart_tx_jog"},
+    {TRACE_EVT_UART_TX_CMD, "uart_tx_cmd"},
+    {TRACE_EVT_PARSE_FRAME, "parse_frame"},
+    {TRACE_EVT_LV_TIMER, "lv_timer_handler"},
+    {TRACE_EVT_RENDER, "render"},
+    {TRACE_EVT_FLUSH, "flush"},
+    {TRACE_EVT_ESTOP_ISR, "estop_isr"},
+    {TRACE_EVT_FUNC_BTN_ISR, "func_btn_isr"},
+    {TRACE_EVT_LONG_PRESS, "long_press"},
+    {TRACE_EVT_STALL, "stall"},
+};
+
+// 环形缓冲区（静态分配），写满后覆盖最旧的记录
+static trace_rec_t trace_ring[TRACE_LEN];
+static uint32_t trace_head = 0;                 // 写入的总条数
+static volatile bool trace_running = false;
+static uint32_t trace_open[TRACE_ID_MAX];       // 各区间开始的周期数，0表示未开始
+static uint32_t trace_stall_cycles;
+static uint32_t trace_stalls = 0;
+static portMUX_TYPE trace_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t trace_pm_lock = NULL;
+#endif
+
+// ==================== 写入 ====================
+void IRAM_ATTR trace_record(trace_event_t id, char ph, int32_t arg)
+{
+    if (!trace_running) {
+        return;
+    }
+    uint32_t now = esp_cpu_get_cycle_count();
+    uint32_t stall = 0;
+
+    portENTER_CRITICAL_SAFE(&trace_lock);
+    trace_rec_t *rec = &trace_ring[trace_head++ & (TRACE_LEN - 1)];
+    rec->cycles = now;
+    rec->id = id;
+    rec->ph = ph;
+    rec->arg = arg;
+    if (ph == TRACE_PH_BEGIN) {
+        trace_open[id] = now | 1;   // 0保留为“未开始”
+    } else if (ph == TRACE_PH_END && trace_open[id] != 0) {
+        // 在中断中结束的区间（刷屏DMA）不占用CPU，不算停顿
+        if (now - trace_open[id] >= trace_stall_cycles && !xPortInIsrContext()) {
+            stall = now - trace_open[id];
+            rec = &trace_ring[trace_head++ & (TRACE_LEN - 1)];
+            rec->cycles = now;
+            rec->id = TRACE_EVT_STALL;
+            rec->ph = TRACE_PH_INSTANT;
+            rec->arg = id;
+            trace_stalls++;
+#if CONFIG_PENDANT_TRACE_STOP_ON_STALL
+            trace_running = false;  // 保留停顿之前的记录，导出后重新开始
+#endif
+        }
+        trace_open[id] = 0;
+    }
+    portEXIT_CRITICAL_SAFE(&trace_lock);
+
+    if (stall) {
+        debug_log(DLOG_EVT_STALL, id, (int32_t)(stall / (esp_clk_cpu_freq() / 1000000)));
+    }
+}
+
+// ==================== 导出 ====================
+static const char *trace_event_name(uint8_t id)
+{
+    for (size_t i = 0; i < sizeof(trace_event_names) / sizeof(trace_event_names[0]); i++) {
+        if (trace_event_names[i].id == id) {
+            return trace_event_names[i].name;
+        }
+    }
+    return "?";
+}
+
+void trace_dump(void)
+{
+    portENTER_CRITICAL(&trace_lock);
+    trace_running = false;
+    portEXIT_CRITICAL(&trace_lock);
+
+    // 行格式见tools/trace_to_chrome.py，与ESP_LOG输出混在一起时按#T前缀识别
+    uint32_t cnt = trace_head < TRACE_LEN ? trace_head : TRACE_LEN;
+    printf("#TRACE %" PRIu32 " %" PRIu32 " %" PRIu32 "\n", (uint32_t)esp_clk_cpu_freq(), cnt, trace_stalls);
+    for (int i = 0; i < TRACE_CAT_MAX; i++) {
+        printf("#TC %d %s\n", i, trace_cat_names[i]);
+    }
+    for (size_t i = 0; i < sizeof(trace_event_names) / sizeof(trace_event_names[0]); i++) {
+        printf("#TN %d %s\n", trace_event_names[i].id, trace_event_names[i].name);
+    }
+    for (uint32_t i = trace_head - cnt; i != trace_head; i++) {
+        const trace_rec_t *rec = &trace_ring[i & (TRACE_LEN - 1)];
+        printf("#T %" PRIu32 " %c %u %" PRId32 "\n", rec->cycles, rec->ph, rec->id, rec->arg);
+    }
+    printf("#TRACE_END\n");
+    fflush(stdout);
+
+    portENTER_CRITICAL(&trace_lock);
+    trace_head = 0;
+    trace_stalls = 0;
+    memset(trace_open, 0, sizeof(trace_open));
+    trace_running = true;
+    portEXIT_CRITICAL(&trace_lock);
+}
+
+// 控制台命令c：清空并重新开始记录
+static void trace_clear(void)
+{
+    portENTER_CRITICAL(&trace_lock);
+    trace_head = 0;
+    trace_stalls = 0;
+    memset(trace_open, 0, sizeof(trace_open));
+    trace_running = true;
+    portEXIT_CRITICAL(&trace_lock);
+    ESP_LOGI(TAG_TRACE, "cleared");
+}
+
+void Trace_Init(void)
+{
+#if CONFIG_PM_ENABLE
+    // 周期计数器随CPU频率变化，追踪期间固定在最高频率（同时不进入light-sleep）
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "trace", &trace_pm_lock));
+    esp_pm_lock_acquire(trace_pm_lock);
+#endif
+    trace_stall_cycles = (uint32_t)((uint64_t)CONFIG_PENDANT_TRACE_STALL_MS * esp_clk_cpu_freq() / 1000);
+    trace_running = true;
+    debug_console_register('t', "dump the event trace", trace_dump);
+    debug_console_register('c', "clear the event trace", trace_clear);
+    ESP_LOGI(TAG_TRACE, "%d events, stall > %d ms, press t on the console to dump",
+             TRACE_LEN, CONFIG_PENDANT_TRACE_STALL_MS);
+}
+
+#endif  // CONFIG_PENDANT_TRACE
@@ -0,0 +1,71 @@
+#pragma once
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+// 轻量事件追踪：CPU周期计数器时间戳，写入固定大小的RAM环形缓冲区（覆盖最旧的记录），可在中断中调用。
+// 在调试控制台按 t 导出，tools/trace_to_chrome.py 把导出内容转换为Chrome/Perfetto的trace JSON。
+// 任务中结束的区间超过CONFIG_PENDANT_TRACE_STALL_MS时记为停顿（调试日志stall事件）
+
+// 分类：CONFIG_PENDANT_TRACE_CATEGORIES的位，关闭的分类在编译时去掉
+typedef enum {
+    TRACE_CAT_ENCODER = 0,  // 手轮轮询
+    TRACE_CAT_SWITCH,       // 拨档
+    TRACE_CAT_UART_RX,      // GRBL串口接收
+    TRACE_CAT_UART_TX,      // GRBL串口发送
+    TRACE_CAT_PARSER,       // 状态帧解析
+    TRACE_CAT_LVGL,         // lv_timer_handler
+    TRACE_CAT_RENDER,       // LVGL渲染一帧
+    TRACE_CAT_FLUSH,        // SPI DMA刷屏
+    TRACE_CAT_INPUT,        // 急停、功能键
+    TRACE_CAT_TRACE,        // 追踪本身（停顿标记），总是打开
+    TRACE_CAT_MAX
+} trace_cat_t;
+
+#define TRACE_ID(cat, n)    (((cat) << 4) | (n))    // 每个分类最多16个事件
+#define TRACE_ID_CAT(id)    ((id) >> 4)
+#define TRACE_ID_MAX        TRACE_ID(TRACE_CAT_MAX, 0)
+
+// 事件编号（导出时附带名称表，主机端不需要同步修改）
+typedef enum {
+    TRACE_EVT_ENCODER_POLL      = TRACE_ID(TRACE_CAT_ENCODER, 0),   // 区间：处理一次手轮增量    arg=脉冲数
+    TRACE_EVT_SWITCH_AXIS       = TRACE_ID(TRACE_CAT_SWITCH, 0),    // 瞬时：切换轴              arg=轴字符(0为OFF档)
+    TRACE_EVT_SWITCH_MULTIPLIER = TRACE_ID(TRACE_CAT_SWITCH, 1),    // 瞬时：倍率调整            arg=倍率×10
+    TRACE_EVT_UART_RX           = TRACE_ID(TRACE_CAT_UART_RX, 0),   // 瞬时：读到数据            arg=字节数
+    TRACE_EVT_UART_TX_JOG       = TRACE_ID(TRACE_CAT_UART_TX, 0),   // 区间：写入$J点动指令      arg=字节数
+    TRACE_EVT_UART_TX_CMD       = TRACE_ID(TRACE_CAT_UART_TX, 1),   // 瞬时：写入其他指令        arg=字节数
+    TRACE_EVT_PARSE_FRAME       = TRACE_ID(TRACE_CAT_PARSER, 0),    // 区间：解析<...>状态帧     结束arg=1成功/0失败
+    TRACE_EVT_LV_TIMER          = TRACE_ID(TRACE_CAT_LVGL, 0),      // 区间：lv_timer_handler
+    TRACE_EVT_RENDER            = TRACE_ID(TRACE_CAT_RENDER, 0),    // 区间：渲染一帧（含等待刷屏） 结束arg=像素数
+    TRACE_EVT_FLUSH             = TRACE_ID(TRACE_CAT_FLUSH, 0),     // 区间：一块的DMA传输（在中断中结束） arg=像素数
+    TRACE_EVT_ESTOP_ISR         = TRACE_ID(TRACE_CAT_INPUT, 0),     // 瞬时：急停中断            arg=引脚电平
+    TRACE_EVT_FUNC_BTN_ISR      = TRACE_ID(TRACE_CAT_INPUT, 1),     // 瞬时：功能键中断
+    TRACE_EVT_LONG_PRESS        = TRACE_ID(TRACE_CAT_INPUT, 2),     // 区间：长按检测（阻塞UI任务） 结束arg=1长按
+    TRACE_EVT_STALL             = TRACE_ID(TRACE_CAT_TRACE, 0),     // 瞬时：前一个区间是停顿    arg=该区间的事件编号
+} trace_event_t;
+
+// 记录类型，与Chrome trace的ph相同
+#define TRACE_PH_BEGIN      'B'
+#define TRACE_PH_END        'E'
+#define TRACE_PH_INSTANT    'i'
+
+#if CONFIG_PENDANT_TRACE
+#define TRACE_CATEGORIES    (CONFIG_PENDANT_TRACE_CATEGORIES | (1U << TRACE_CAT_TRACE))
+#define TRACE_ON(id)        ((TRACE_CATEGORIES >> TRACE_ID_CAT(id)) & 1U)
+#define TRACE_BEGIN(id, arg)    do { if (TRACE_ON(id)) trace_record((id), TRACE_PH_BEGIN, (arg)); } while (0)
+#define TRACE_END(id, arg)      do { if (TRACE_ON(id)) trace_record((id), TRACE_PH_END, (arg)); } while (0)
+#define TRACE_INSTANT(id, arg)  do { if (TRACE_ON(id)) trace_record((id), TRACE_PH_INSTANT, (arg)); } while (0)
+
+void Trace_Init(void);      // 在Debug_Log_Init之后调用：锁定CPU频率并注册控制台命令t、c
+
+// 写入一条记录，可在任务和中断中调用；用上面的宏，关闭的分类不产生代码
+void trace_record(trace_event_t id, char ph, int32_t arg);
+
+void trace_dump(void);      // 把环形缓冲区打印到控制台，然后清空并重新开始记录
+#else
+#define TRACE_BEGIN(id, arg)    do { } while (0)
+#define TRACE_END(id, arg)      do { } while (0)
+#define TRACE_INSTANT(id, arg)  do { } while (0)
+#endif
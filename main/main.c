@@ -1,16 +1,32 @@
 #include "ST7789.h"
 #include "LVGL_UI/LVGL_Example.h"
+#include "Task_Monitor.h"
+#include "Debug_Log.h"
+#include "LP_Inputs.h"
+#include "Power_Manager.h"
+#include "Boot_Timeline.h"
+#include "Asset_Bundle.h"
+#include "Splash.h"
+#include "Trace.h"
+#include "Perf_HUD.h"
+#include "Recorder.h"
 
 #include <stdio.h>  
 #include <stdlib.h>  
 #include "freertos/FreeRTOS.h"   // FreeRTOS实时操作系统核心库
 #include "freertos/task.h"    // FreeRTOS任务管理
 #include "driver/gpio.h"         // ESP32 GPIO驱动程序
+#include "hal/gpio_ll.h"         // 中断中读取引脚电平
 #include "driver/pcnt.h"        // ESP32脉冲计数器驱动程序
 #include "esp_log.h"
 #include <math.h>
 #include "driver/uart.h"         // UART 驱动
 #include <string.h>       // 字符串处理函数
+#include "esp_system.h"       // 复位原因
+#include "esp_sleep.h"        // 串口唤醒
+#if CONFIG_PENDANT_RECORDER_REPLAY
+#include "freertos/stream_buffer.h"  // 回放的串口数据
+#endif
 
 #define ENCODER_A GPIO_NUM_1  //A相接开发板1
 #define ENCODER_B GPIO_NUM_0  //B相接开发板2，地是3，电压是4
@@ -21,7 +37,7 @@
 #define RIGHT_SW1 GPIO_NUM_9  //0.1倍（开发板1，拨档14）
 #define RIGHT_SW2 GPIO_NUM_18  //1倍（开发板2，拨档16）
 #define RIGHT_SW3 GPIO_NUM_19  //5倍（开发板3，拨档17）
-#define UART_PORT_NUM UART_NUM_0
+#define UART_PORT_NUM UART_NUM_1  // GRBL专用串口，UART0/USB-Serial-JTAG留给调试控制台
 #define UART_TX_PIN GPIO_NUM_16  // TX接开发板1
 #define UART_RX_PIN GPIO_NUM_17  // RX接开发板2
 #define UART_BAUD_RATE 115200
@@ -30,6 +46,21 @@
 #define FUNC_BTN_PIN GPIO_NUM_20  // 功能按键
 #define FUNC_BTN_DEBOUNCE_MS 500 // 功能键防抖 500ms
 
+// ==================== 任务优先级规划 ====================
+// 急停 > 点动(编码器/拨档) > 串口接收 > UI，数值越大优先级越高
+#define ESTOP_TASK_PRIO      10   // 急停任务
+#define ENCODER_TASK_PRIO    8    // 编码器点动任务
+#define SWITCH_TASK_PRIO     7    // 拨档任务
+#define UART_RX_TASK_PRIO    6    // 串口接收任务
+#define UI_TASK_PRIO         3    // UI主循环任务（LVGL渲染）
+
+// 任务栈大小（字节），实际余量可通过 Task_Monitor 查看
+#define ESTOP_TASK_STACK     2048
+#define ENCODER_TASK_STACK   4096
+#define SWITCH_TASK_STACK    2048
+#define UART_RX_TASK_STACK   4096
+#define UI_TASK_STACK        4096
+
 // 全局变量声明
 static const char *TAG = "ENCODER";
 static pcnt_unit_t pcnt_unit = PCNT_UNIT_0;  // 使用PCNT单元0
@@ -38,6 +69,7 @@ static void IRAM_ATTR estop_isr_handler(void* arg);
 static void IRAM_ATTR func_btn_isr_handler(void* arg);    
 static volatile uint32_t last_estop_tick = 0;  // 急停防抖时间戳
 static volatile uint32_t last_func_btn_tick = 0;  // 功能按键防抖时间戳
+static volatile int64_t estop_isr_time_us = 0;  // 急停中断时间，用于统计急停任务延迟
 static volatile float axis_counts[4] = {0, 0, 0, 0};  // X, Y, Z, A轴累计位移
 static volatile float axis_last_report[4] = {0, 0, 0, 0};  // 上次报告的位移
 volatile int current_axis = 0;   // 0:X, 1:Y, 2:Z, 3:A
@@ -53,9 +85,110 @@ static int coordinate_buffer_index = 0;  // 当前缓冲区索引
 static volatile bool coordinate_updated = false;  // 坐标更新标志
 static float received_mechanical_coords[4] = {0, 0, 0, 0}; // X, Y, Z, A
 static float received_workpiece_coords[4] = {0, 0, 0, 0};  // X, Y, Z, A
+static float last_mechanical_coords[4] = {0, 0, 0, 0};     // 上一帧机械坐标，用于判断机床是否在动
+static QueueHandle_t uart_event_queue = NULL;  // UART驱动事件（统计串口错误）
+
+// 静态分配的任务控制块与任务栈
+static TaskHandle_t estop_task_handle = NULL;
+static StaticTask_t estop_task_tcb;
+static StackType_t estop_task_stack[ESTOP_TASK_STACK];
+static StaticTask_t encoder_task_tcb;
+static StackType_t encoder_task_stack[ENCODER_TASK_STACK];
+static StaticTask_t switch_task_tcb;
+static StackType_t switch_task_stack[SWITCH_TASK_STACK];
+static StaticTask_t uart_rx_task_tcb;
+static StackType_t uart_rx_task_stack[UART_RX_TASK_STACK];
+static StaticTask_t ui_task_tcb;
+static StackType_t ui_task_stack[UI_TASK_STACK];
+
+// ==================== 输入源与GRBL发送 ====================
+// 回放会话时输入来自记录（Recorder），不读取GPIO/PCNT/串口，发往GRBL的数据丢弃
+#if CONFIG_PENDANT_RECORDER_REPLAY
+static portMUX_TYPE replay_lock = portMUX_INITIALIZER_UNLOCKED;
+static int32_t replay_encoder_count = 0;  // 回放的手轮增量，编码器任务轮询时取走
+static volatile char replay_left = 0;
+static volatile float replay_right = 1.0f;
+static volatile int replay_func_level = 1;
+static volatile int replay_estop_level = 1;
+static StreamBufferHandle_t replay_rx_stream = NULL;
+
+static void replay_encoder(int32_t count) {
+    portENTER_CRITICAL(&replay_lock);
+    replay_encoder_count += count;
+    portEXIT_CRITICAL(&replay_lock);
+}
+
+static void replay_switches(char left, float right) {
+    replay_left = left;
+    replay_right = right;
+}
+
+// 代替GPIO中断：功能键按下时置位标志，急停电平变化时通知急停任务
+static void replay_button(session_button_t id, bool level) {
+    if (id == SESSION_BTN_FUNC) {
+        replay_func_level = level;
+        if (!level) {
+            func_btn_pressed = true;
+            power_manager_notify_activity();
+        }
+    } else if (id == SESSION_BTN_ESTOP) {
+        replay_estop_level = level;
+        if (!level) {
+            estop_triggered = true;
+        }
+        estop_isr_time_us = esp_timer_get_time();
+        xTaskNotifyGive(estop_task_handle);
+    }
+}
+
+static void replay_uart_rx(const uint8_t *data, size_t len) {
+    xStreamBufferSend(replay_rx_stream, data, len, pdMS_TO_TICKS(100));
+}
+
+static const recorder_replay_ops_t replay_ops = {
+    .encoder = replay_encoder,
+    .switches = replay_switches,
+    .button = replay_button,
+    .uart_rx = replay_uart_rx,
+};
+#endif
+
+static int func_btn_level(void) {
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    return replay_func_level;
+#else
+    return gpio_get_level(FUNC_BTN_PIN);
+#endif
+}
+
+static int estop_level(void) {
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    return replay_estop_level;
+#else
+    return gpio_get_level(ESTOP_PIN);
+#endif
+}
+
+static void grbl_write(const char *data, size_t len) {
+#if !CONFIG_PENDANT_RECORDER_REPLAY
+    uart_write_bytes(UART_PORT_NUM, data, len);
+#endif
+}
+
+static int grbl_read(uint8_t *buf, size_t len, TickType_t wait) {
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    return (int)xStreamBufferReceive(replay_rx_stream, buf, len, wait);
+#else
+    return uart_read_bytes(UART_PORT_NUM, buf, len, wait);
+#endif
+}
 
 // ==================== 编码器初始化 ====================
 static void encoder_init(void) {
+#if CONFIG_PENDANT_LP_CORE_INPUTS
+    // 手轮与左拨档交给LP核采集，不再使用PCNT
+    LP_Inputs_Init();
+#else
     pcnt_config_t pcnt_config = {
 .pulse_gpio_num = ENCODER_A,  // 脉冲输入引脚
         .ctrl_gpio_num = ENCODER_B,   // 方向控制引脚
@@ -75,6 +208,7 @@ static void encoder_init(void) {
     pcnt_counter_pause(pcnt_unit);
     pcnt_counter_clear(pcnt_unit);
     pcnt_counter_resume(pcnt_unit);
+#endif
 }
 
 // ==================== UART 初始化 ====================
@@ -86,10 +220,15 @@ static void uart_init(void) {
         .stop_bits = UART_STOP_BITS_1,
         .flow_ctrl = UART_HW_FLOWCTRL_DISABLE
     };
-    uart_driver_install(UART_PORT_NUM, 1024, 0, 0, NULL, 0);
+    uart_driver_install(UART_PORT_NUM, 1024, 0, 16, &uart_event_queue, 0);
     uart_param_config(UART_PORT_NUM, &uart_config);
     uart_set_pin(UART_PORT_NUM, UART_TX_PIN, UART_RX_PIN,
                  UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+#if CONFIG_PM_ENABLE
+    // light-sleep期间RX线上的边沿唤醒CPU（唤醒字符本身会丢失，GRBL状态帧会重发）
+    uart_set_wakeup_threshold(UART_PORT_NUM, 3);
+    esp_sleep_enable_uart_wakeup(UART_PORT_NUM);
+#endif
 }
 
 // ==================== UART 接收配置 ====================
@@ -146,9 +285,17 @@ static void uart_receive_task(void *arg) {
     
     while (1) {
         // 读取UART数据
-        length = uart_read_bytes(UART_PORT_NUM, data, sizeof(data) - 1, 20 / portTICK_PERIOD_MS);
+        length = grbl_read(data, sizeof(data) - 1, power_manager_poll_period(pdMS_TO_TICKS(20)));
+
+        // 驱动的数据事件不需要处理，只统计FIFO溢出、缓冲区满与帧错误
+        uart_event_t event;
+        while (uart_event_queue != NULL && xQueueReceive(uart_event_queue, &event, 0) == pdTRUE) {
+            perf_hud_uart_event(event.type);
+        }
         
         if (length > 0) {
+            TRACE_INSTANT(TRACE_EVT_UART_RX, length);
+            recorder_uart_rx(data, length);
             data[length] = '\0'; // 添加字符串结束符
             
             // 处理接收到的每个字符
@@ -164,8 +311,20 @@ static void uart_receive_task(void *arg) {
                     coordinate_buffer[coordinate_buffer_index] = '\0'; // 确保字符串结束
                     
                     // 解析坐标帧
-                    if (parse_coordinate_frame(coordinate_buffer)) {
+                    TRACE_BEGIN(TRACE_EVT_PARSE_FRAME, 0);
+                    bool parsed = parse_coordinate_frame(coordinate_buffer);
+                    TRACE_END(TRACE_EVT_PARSE_FRAME, parsed);
+                    if (parsed) {
+                        // 上位机会持续查询状态，只有坐标变化（机床在动）才算活动
+                        if (memcmp(received_mechanical_coords, last_mechanical_coords, sizeof(last_mechanical_coords)) != 0) {
+                            memcpy(last_mechanical_coords, received_mechanical_coords, sizeof(last_mechanical_coords));
+                            power_manager_notify_activity();
+                        }
                         coordinate_updated = true;
+                        perf_hud_status_frame();
+                        debug_log(DLOG_EVT_COORD_FRAME, 1, 0);
+                    } else {
+                        debug_log(DLOG_EVT_COORD_FRAME, 0, 0);
                     }
                     
                     coordinate_buffer_index = 0; // 重置缓冲区索引
@@ -174,10 +333,14 @@ static void uart_receive_task(void *arg) {
                 else if (coordinate_buffer_index > 0 && coordinate_buffer_index < COORDINATE_BUFFER_SIZE - 1) {
                     coordinate_buffer[coordinate_buffer_index++] = data[i];
                 }
+                // 状态帧之外：指令的ok/error应答
+                else if (coordinate_buffer_index == 0) {
+                    perf_hud_rx_char(data[i]);
+                }
             }
         }
         
-        vTaskDelay(pdMS_TO_TICKS(10));
+        task_monitor_delay(TM_TASK_UART_RX, pdMS_TO_TICKS(10));
     }
 }
 
@@ -207,45 +370,75 @@ static void estop_init(void) {
     };
     gpio_config(&io_conf);
 
-    // 安装GPIO中断服务
-    gpio_install_isr_service(0);
+    // 安装GPIO中断服务：放在IRAM中，写flash（暗屏保存启动画面、会话记录）关闭cache期间急停中断照常响应
+    // 因此所有注册的处理函数及其调用的代码都必须在IRAM中
+    gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
     // 注册中断处理函数
     gpio_isr_handler_add(ESTOP_PIN, estop_isr_handler, NULL);
 }
 
 // ==================== 急停中断服务函数 ====================
 static void IRAM_ATTR estop_isr_handler(void* arg) {
+    power_manager_gpio_wake_isr(ESTOP_PIN);
     uint32_t now_tick = xTaskGetTickCountFromISR();
     if ((now_tick - last_estop_tick) < pdMS_TO_TICKS(ESTOP_DEBOUNCE_MS)) {
         return;  // 在防抖时间内，忽略
     }
     last_estop_tick = now_tick;
+    int level = gpio_ll_get_level(&GPIO, ESTOP_PIN);  // gpio_get_level不在IRAM中
+    TRACE_INSTANT(TRACE_EVT_ESTOP_ISR, level);
 
-    int level = gpio_get_level(ESTOP_PIN);
-
-    if (level == 0) {  
-        // 按钮按下（假设低电平有效）
+    // 按下时立即置位，阻止后续点动指令；串口发送交给最高优先级的急停任务
+    if (level == 0) {
         estop_triggered = true;
-        const char stop_cmd = 0x18;  // GRBL 急停指令
-        uart_write_bytes(UART_PORT_NUM, &stop_cmd, 1);
-        //ESP_EARLY_LOGW(TAG, "急停触发，发送0x18");
-    } else {  
-        // 按钮松开
-        estop_triggered = false;
-        const char *unlock_cmd = "$X\n";  // GRBL 解锁指令
-        uart_write_bytes(UART_PORT_NUM, unlock_cmd, strlen(unlock_cmd));
-        //ESP_EARLY_LOGI(TAG, "急停解除，发送$X");
+    }
+    estop_isr_time_us = esp_timer_get_time();
+
+    BaseType_t higher_prio_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(estop_task_handle, &higher_prio_woken);
+    portYIELD_FROM_ISR(higher_prio_woken);
+}
+
+// ==================== 急停任务 ====================
+static void estop_task(void *arg) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        task_monitor_record_latency(TM_TASK_ESTOP, (uint32_t)(esp_timer_get_time() - estop_isr_time_us));
+        power_manager_notify_activity();
+
+        int level = estop_level();
+        recorder_button(SESSION_BTN_ESTOP, level);
+
+        if (level == 0) {  
+            // 按钮按下（假设低电平有效）
+            estop_triggered = true;
+            const char stop_cmd = 0x18;  // GRBL 急停指令
+            grbl_write(&stop_cmd, 1);
+            TRACE_INSTANT(TRACE_EVT_UART_TX_CMD, 1);
+            perf_hud_link_reset();
+            debug_log(DLOG_EVT_ESTOP, 1, 0);
+        } else {  
+            // 按钮松开
+            estop_triggered = false;
+            const char *unlock_cmd = "$X\n";  // GRBL 解锁指令
+            grbl_write(unlock_cmd, strlen(unlock_cmd));
+            TRACE_INSTANT(TRACE_EVT_UART_TX_CMD, strlen(unlock_cmd));
+            perf_hud_tx_line(false);
+            debug_log(DLOG_EVT_ESTOP, 0, 0);
+        }
     }
 }
 
 // ==================== 功能按键中断回调 ====================
 static void IRAM_ATTR func_btn_isr_handler(void* arg) {
+    power_manager_gpio_wake_isr(FUNC_BTN_PIN);
     // 中断级防抖
     uint32_t now_tick = xTaskGetTickCountFromISR();
     if ((now_tick - last_func_btn_tick) < pdMS_TO_TICKS(FUNC_BTN_DEBOUNCE_MS)) {
         return;
     }
     last_func_btn_tick = now_tick;
+    TRACE_INSTANT(TRACE_EVT_FUNC_BTN_ISR, 0);
     // 设置功能按键按下标志，供LVGL界面处理
     func_btn_pressed = true;
 }
@@ -254,7 +447,7 @@ static void IRAM_ATTR func_btn_isr_handler(void* arg) {
 static bool is_func_btn_long_pressed(void) {
     // 检测功能按键是否长按2秒
     uint32_t press_start_time = xTaskGetTickCount();
-    while (gpio_get_level(FUNC_BTN_PIN) == 0) {  // 按键被按下
+    while (func_btn_level() == 0) {  // 按键被按下
         vTaskDelay(pdMS_TO_TICKS(50));  // 每50ms检查一次
         if ((xTaskGetTickCount() - press_start_time) >= pdMS_TO_TICKS(2000)) {  // 长按2秒
             return true;
@@ -283,8 +476,11 @@ static void send_command_frame(float scaled_steps, int axis_index) {
     snprintf(cmd, sizeof(cmd), "$J=G21G91X%.2fY%.2fZ%.2fA%.2fF%.1f\n",
              x, y, z, A,feedrate);
 
-    uart_write_bytes(UART_PORT_NUM, cmd, strlen(cmd));
-    //ESP_LOGI(TAG, "发送指令: %s", cmd);
+    TRACE_BEGIN(TRACE_EVT_UART_TX_JOG, strlen(cmd));
+    grbl_write(cmd, strlen(cmd));
+    TRACE_END(TRACE_EVT_UART_TX_JOG, 0);
+    perf_hud_tx_line(true);
+    debug_log(DLOG_EVT_JOG, axis_index, (int32_t)lroundf(scaled_steps * 1000.0f));
 }
 
 // ==================== 发送中点指令帧 ====================
@@ -308,8 +504,10 @@ static void send_midpoint_command_frame(float midpoint, int axis_index) {
     // 生成指令帧，格式为"G10 L2 P1 [轴][中点]"
     snprintf(cmd, sizeof(cmd), "G10 L2 P1 %c%.3f\n", axis_char, midpoint);
     
-    uart_write_bytes(UART_PORT_NUM, cmd, strlen(cmd));
-    //ESP_LOGI(TAG, "发送中点指令: %s", cmd);
+    grbl_write(cmd, strlen(cmd));
+    TRACE_INSTANT(TRACE_EVT_UART_TX_CMD, strlen(cmd));
+    perf_hud_tx_line(false);
+    debug_log(DLOG_EVT_MIDPOINT, axis_index, (int32_t)lroundf(midpoint * 1000.0f));
 }
 
 
@@ -322,10 +520,12 @@ static void switch_init(void) {
         .pull_down_en = 0  // 禁用下拉
     };
 
-    // 左拨档
+#if !CONFIG_PENDANT_LP_CORE_INPUTS
+    // 左拨档（启用LP核时由LP核采集）
     io_conf.pin_bit_mask = (1ULL << LEFT_SW1) | (1ULL << LEFT_SW2) |
                            (1ULL << LEFT_SW3) | (1ULL << LEFT_SW4);
     gpio_config(&io_conf);
+#endif
 
     // 右拨档
     io_conf.pin_bit_mask = (1ULL << RIGHT_SW1) | (1ULL << RIGHT_SW2) |
@@ -335,18 +535,28 @@ static void switch_init(void) {
 
 // ==================== 拨档读取（原始值） ====================
 static char read_left_switch_raw(void) {
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    return replay_left;
+#elif CONFIG_PENDANT_LP_CORE_INPUTS
+    return lp_inputs_get_left_switch();  // LP核已防抖
+#else
     if (gpio_get_level(LEFT_SW1) == 0) return 'X';
     if (gpio_get_level(LEFT_SW2) == 0) return 'Y';
     if (gpio_get_level(LEFT_SW3) == 0) return 'Z';
     if (gpio_get_level(LEFT_SW4) == 0) return 'A';
     return 0;  //无开关按下
+#endif
 }
 
 static float read_right_switch_raw(void) {
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    return replay_right;
+#else
     if (gpio_get_level(RIGHT_SW1) == 0) return 0.1f;
     if (gpio_get_level(RIGHT_SW2) == 0) return 1.0f;
     if (gpio_get_level(RIGHT_SW3) == 0) return 5.0f;
     return 0.0f;
+#endif
 }
 
 // ==================== 防抖函数宏 ====================
@@ -377,14 +587,27 @@ DEFINE_SWITCH_STABLE(float)
 // ==================== 编码器轮询任务 ====================
 //每20ms检测一次，有位移就输出，没有位移就不输出
 static void encoder_poll_task(void *arg) {
-    int16_t raw_count = 0;
-    const char axis_names[4] = {'X', 'Y', 'Z', 'A'};
     while (1) {
         // 获取当前脉冲计数值
+#if CONFIG_PENDANT_RECORDER_REPLAY
+        portENTER_CRITICAL(&replay_lock);
+        int32_t raw_count = replay_encoder_count;
+        replay_encoder_count = 0;
+        portEXIT_CRITICAL(&replay_lock);
+#elif CONFIG_PENDANT_LP_CORE_INPUTS
+        int32_t raw_count = lp_inputs_take_encoder_count();  // LP核累计的增量
+#else
+        int16_t raw_count = 0;
         pcnt_get_counter_value(pcnt_unit, &raw_count);
+#endif
         
+        // 点动期间保持PM锁，停转一段时间后释放
+        power_manager_jog(raw_count != 0);
+
         // 如果有脉冲，处理并输出增量
         if (raw_count != 0) {
+            TRACE_BEGIN(TRACE_EVT_ENCODER_POLL, raw_count);
+            recorder_encoder(raw_count);
             // // 除以2.0f是因为每个完整周期有2个脉冲（A相和B相）
             float scaled_steps = (raw_count / 2.0f) * right_multiplier;
             
@@ -393,19 +616,19 @@ static void encoder_poll_task(void *arg) {
             
             // 只有当不是OFF档位时才发送指令
             if (read_left_switch_raw() != 0) {
-                // 输出增量信息
-                //ESP_LOGI(TAG, "轴: %c, 倍率: ×%.1f, 增量: %.2f", 
-                        // axis_names[current_axis], right_multiplier, scaled_steps);
-                // 发送指令帧
+                // 发送指令帧（增量信息由 send_command_frame 记录到调试日志）
                 send_command_frame(scaled_steps, current_axis);
                 axis_last_report[current_axis] = axis_counts[current_axis];
             }
+#if !CONFIG_PENDANT_LP_CORE_INPUTS && !CONFIG_PENDANT_RECORDER_REPLAY
             // 清除计数器
             pcnt_counter_clear(pcnt_unit);
+#endif
+            TRACE_END(TRACE_EVT_ENCODER_POLL, 0);
         }
         
-        // 等待20ms进行下一次检测
-        vTaskDelay(pdMS_TO_TICKS(20));
+        // 等待20ms进行下一次检测（暗屏时放慢，让CPU进入light-sleep）
+        task_monitor_delay(TM_TASK_ENCODER, power_manager_poll_period(pdMS_TO_TICKS(20)));
     }
 }
 
@@ -413,11 +636,31 @@ static void encoder_poll_task(void *arg) {
 static void switch_task(void *arg) {
     char left_pos = 0;
     float right_pos = 1.0f;
+#if CONFIG_PENDANT_RECORDER_RECORD
+    int func_level = 1;
+#endif
     while (1) {
+#if CONFIG_PENDANT_RECORDER_RECORD
+        // 功能键按下在主循环处理时记录，松开在这里记录（回放长按判断需要）
+        int level = gpio_get_level(FUNC_BTN_PIN);
+        if (level != func_level) {
+            func_level = level;
+            if (level) {
+                recorder_button(SESSION_BTN_FUNC, 1);
+            }
+        }
+#endif
+        // 暗屏时先做一次原始读取，没有变化就跳过10ms间隔的防抖采样，让CPU尽量睡眠
+        if (power_manager_is_dark() && read_left_switch_raw() == left_pos && read_right_switch_raw() == right_pos) {
+            task_monitor_delay(TM_TASK_SWITCH, power_manager_poll_period(pdMS_TO_TICKS(20)));
+            continue;
+        }
         char new_left = read_switch_stable_char(read_left_switch_raw, left_pos);
         float new_right = read_switch_stable_float(read_right_switch_raw, right_pos);
 
         if (new_left != left_pos || new_right != right_pos) {
+            power_manager_notify_activity();
+            recorder_switches(new_left, new_right);
             if (new_left != left_pos) {
                 left_pos = new_left;
                 if (new_left != 0) {
@@ -429,26 +672,35 @@ static void switch_task(void *arg) {
                     }
                     // 请求更新轴标签（不直接调用UI函数）
                     request_axis_labels_update();
-                    //ESP_LOGI(TAG, "切换到轴: %c", new_left);
+                    TRACE_INSTANT(TRACE_EVT_SWITCH_AXIS, new_left);
+                    debug_log(DLOG_EVT_AXIS, new_left, 0);
                 } else {
                     // OFF档位，不需要做特殊处理，只需要更新UI
                     request_axis_labels_update();
-                    //ESP_LOGI(TAG, "切换到OFF档位");
+                    TRACE_INSTANT(TRACE_EVT_SWITCH_AXIS, 0);
+                    debug_log(DLOG_EVT_AXIS, 0, 0);
                 }
             }
             if (new_right != right_pos && new_right != 0.0f) {
                 right_pos = new_right;
                 right_multiplier = right_pos;
-                //ESP_LOGI(TAG, "倍率调整: ×%.1f", right_pos);
+                TRACE_INSTANT(TRACE_EVT_SWITCH_MULTIPLIER, lroundf(right_pos * 10.0f));
+                debug_log(DLOG_EVT_MULTIPLIER, (int32_t)lroundf(right_pos * 10.0f), 0);
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(20));
+        task_monitor_delay(TM_TASK_SWITCH, power_manager_poll_period(pdMS_TO_TICKS(20)));
     }
 }
 
 // ==================== 功能按钮任务 ====================
 static void main_loop_task(void *arg) {
+#if CONFIG_PENDANT_SPLASH
+    bool splash_saved = false;  // 本次暗屏已保存过启动画面
+#endif
     while (1) {
+        // 无操作超时渐灭背光，有活动时唤醒
+        power_manager_update();
+
         // 检查并更新轴标签（如果需要）
         check_and_update_axis_labels();
         
@@ -474,9 +726,20 @@ static void main_loop_task(void *arg) {
         // 处理功能按键事件
         if (func_btn_pressed) {
             func_btn_pressed = false;  // 清除按键标志
+            power_manager_notify_activity();
+            recorder_button(SESSION_BTN_FUNC, 0);  // 记录代码不在IRAM中，不能在中断中调用
             
-            // 检测长按
-            if (is_func_btn_long_pressed()) {
+            // 检测长按（阻塞UI任务直到松开或满2秒）
+            TRACE_BEGIN(TRACE_EVT_LONG_PRESS, 0);
+            bool long_pressed = is_func_btn_long_pressed();
+            TRACE_END(TRACE_EVT_LONG_PRESS, long_pressed);
+#if CONFIG_PENDANT_PERF_HUD
+            if (long_pressed && read_left_switch_raw() == 0) {
+                // 轴选择在OFF档（不点动）时长按：切换诊断条，不做分中
+                perf_hud_toggle();
+            } else
+#endif
+            if (long_pressed) {
                 // 更新分中值输入框
                 update_centering_values();
                 
@@ -518,49 +781,125 @@ static void main_loop_task(void *arg) {
                 ui_update_on_state_change();
                 
                 // 输出调试信息
-                switch (func_btn_current_state) {
-                case FUNC_BTN_STATE_CENTERING1:
-                       // ESP_LOGI(TAG, "功能按键: 切换到分中值1轴");
-                        break;
-                    case FUNC_BTN_STATE_CENTERING2:
-                        //ESP_LOGI(TAG, "功能按键: 切换到分中值2轴");
-                        break;
-                    case FUNC_BTN_STATE_OK:
-                       // ESP_LOGI(TAG, "功能按键: 切换到OK键");
-                        break;
-                }
+                debug_log(DLOG_EVT_FUNC_BTN, func_btn_current_state, 0);
             }
         }
         
-        vTaskDelay(pdMS_TO_TICKS(10));
+        if (power_manager_is_dark()) {
+#if CONFIG_PENDANT_SPLASH
+            // 背光刚熄灭：保存当前界面，下次上电时作为启动画面
+            // 与上次保存的画面相同时不写flash；写入期间急停中断在IRAM中照常响应
+            if (!splash_saved) {
+                splash_saved = true;
+                splash_save();
+            }
+#endif
+            // 暗屏：不渲染，等待唤醒事件（界面的修改在唤醒后的第一帧一起刷新）
+            power_manager_idle_wait();
+            continue;
+        }
+#if CONFIG_PENDANT_SPLASH
+        splash_saved = false;
+#endif
+
+        task_monitor_delay(TM_TASK_UI, pdMS_TO_TICKS(10));
+        power_manager_render_begin();
+        TRACE_BEGIN(TRACE_EVT_LV_TIMER, 0);
         lv_timer_handler();
+        TRACE_END(TRACE_EVT_LV_TIMER, 0);
+        power_manager_render_end();
+        task_monitor_sample_lvgl();
+
+        // 第一帧完整刷到面板后才打开背光，上电时不显示未初始化的显存
+        if (!boot_timeline_reached(BOOT_PHASE_FIRST_FRAME) && lvgl_flush_idle()) {
+            BK_Light(CONFIG_PENDANT_BACKLIGHT_LEVEL);
+            boot_timeline_mark(BOOT_PHASE_FIRST_FRAME);
+            boot_timeline_report();
+        }
     }
 }
 void app_main(void)
 {
+    Boot_Timeline_Init();  //启动时间线（复位到app_main的时间）
+    Debug_Log_Init();  //调试日志（USB-Serial-JTAG）
+#if CONFIG_PENDANT_TRACE
+    Trace_Init();  //事件追踪（控制台按t导出）
+#endif
+#if CONFIG_PENDANT_RECORDER_RECORD
+    Recorder_Init(NULL);  //会话记录（输入与GRBL串口写入session分区）
+#endif
+    debug_log(DLOG_EVT_BOOT, esp_reset_reason(), 0);
     ESP_LOGI(TAG, "初始化旋转编码器 + 拨档开关");
 
-    // 初始化编码器相关功能
+    // ==================== 先让串口、点动与急停工作 ====================
     uart_init();
     uart_receive_config();  
     encoder_init();  //编码器初始化
     switch_init();  //拨档初始化
+
+    // 急停任务需在注册急停中断之前创建
+    estop_task_handle = xTaskCreateStatic(estop_task, "estop_task", ESTOP_TASK_STACK, NULL,
+                                          ESTOP_TASK_PRIO, estop_task_stack, &estop_task_tcb);
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    // 回放：急停与功能键由回放任务驱动，不注册GPIO中断
+    replay_rx_stream = xStreamBufferCreate(1024, 1);
+#else
     estop_init();  //急停初始化
     func_btn_init();  //功能按键初始化
-
-    // 创建编码器任务
-    xTaskCreate(encoder_poll_task, "encoder_poll_task", 4096, NULL, 5, NULL);  // 编码器轮询任务
-    xTaskCreate(switch_task, "switch_task", 2048, NULL, 5, NULL);  // 拨档任务
-    xTaskCreate(uart_receive_task, "uart_receive_task", 4096, NULL, 4, NULL);    //串口接收任务
-
-    LCD_Init();  //LCD屏幕初始化
-    BK_Light(50);  //设置背光亮度，范围0-100
+#endif
+
+    // 暗屏light-sleep时的GPIO唤醒源（手轮与左拨档在启用LP核时由LP核唤醒）
+    power_manager_add_wake_gpio(ESTOP_PIN, GPIO_INTR_ANYEDGE);
+    power_manager_add_wake_gpio(FUNC_BTN_PIN, GPIO_INTR_NEGEDGE);
+    power_manager_add_wake_gpio(RIGHT_SW1, GPIO_INTR_DISABLE);
+    power_manager_add_wake_gpio(RIGHT_SW2, GPIO_INTR_DISABLE);
+    power_manager_add_wake_gpio(RIGHT_SW3, GPIO_INTR_DISABLE);
+#if !CONFIG_PENDANT_LP_CORE_INPUTS
+    power_manager_add_wake_gpio(ENCODER_A, GPIO_INTR_DISABLE);  // PCNT在light-sleep中不计数，用A相电平变化唤醒
+    power_manager_add_wake_gpio(LEFT_SW1, GPIO_INTR_DISABLE);
+    power_manager_add_wake_gpio(LEFT_SW2, GPIO_INTR_DISABLE);
+    power_manager_add_wake_gpio(LEFT_SW3, GPIO_INTR_DISABLE);
+    power_manager_add_wake_gpio(LEFT_SW4, GPIO_INTR_DISABLE);
+#endif
+
+    // 创建编码器任务（优先级高于app_main，创建后立即完成第一次轮询）
+    xTaskCreateStatic(encoder_poll_task, "encoder_poll", ENCODER_TASK_STACK, NULL,
+                      ENCODER_TASK_PRIO, encoder_task_stack, &encoder_task_tcb);  // 编码器轮询任务
+    xTaskCreateStatic(switch_task, "switch_task", SWITCH_TASK_STACK, NULL,
+                      SWITCH_TASK_PRIO, switch_task_stack, &switch_task_tcb);  // 拨档任务
+    xTaskCreateStatic(uart_receive_task, "uart_rx_task", UART_RX_TASK_STACK, NULL,
+                      UART_RX_TASK_PRIO, uart_rx_task_stack, &uart_rx_task_tcb);    //串口接收任务
+    boot_timeline_mark(BOOT_PHASE_JOG_READY);
+
+    // ==================== 显示：面板退出睡眠的等待与界面创建重叠 ====================
+    LCD_Init_Start();  //面板复位并发送SLPOUT，背光保持关闭
+    boot_timeline_mark(BOOT_PHASE_PANEL_AWAKE);
+#if CONFIG_PENDANT_SPLASH
+    // 有上次保存的画面时先完成面板初始化并显示它，界面创建与第一帧在亮屏之后进行
+    if (Splash_Init()) {
+        LCD_Init_Finish();
+        boot_timeline_mark(BOOT_PHASE_PANEL_READY);
+        Splash_Show();
+        boot_timeline_mark(BOOT_PHASE_SPLASH);
+    }
+#endif
     LVGL_Init();  //LVGL初始化
+    Asset_Bundle_Init();  //映射资源分区（字体、图片直接从flash读取）
     coordinate_display_init();  //坐标显示初始化
+    boot_timeline_mark(BOOT_PHASE_UI_CREATED);
+    if (!boot_timeline_reached(BOOT_PHASE_PANEL_READY)) {
+        LCD_Init_Finish();  //等待SLPOUT剩余时间后发送初始化序列并打开显示
+        boot_timeline_mark(BOOT_PHASE_PANEL_READY);
+    }
+    Power_Manager_Init();  //电源管理（DFS、自动light-sleep、背光渐灭）
 
-    lv_obj_add_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);  // 隐藏性能监视器标签（FPS和CPU显示）
+    // 创建功能按钮任务（第一帧刷完后打开背光并打印启动时间线）
+    xTaskCreateStatic(main_loop_task, "main_loop_task", UI_TASK_STACK, NULL,
+                      UI_TASK_PRIO, ui_task_stack, &ui_task_tcb);
 
-    // 创建功能按钮任务
-    xTaskCreate(main_loop_task, "main_loop_task", 4096, NULL, 5, NULL);
+    Task_Monitor_Init();  //任务监视（CPU占用、栈余量、调度延迟）
+#if CONFIG_PENDANT_RECORDER_REPLAY
+    Recorder_Init(&replay_ops);  //全部任务就绪后按记录的时间回放上一次会话
+#endif
 }
 
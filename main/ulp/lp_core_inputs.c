@@ -0,0 +1,96 @@
+/*
+ * LP核程序：手轮正交解码 + 左拨档（轴选择）防抖
+ * 运行在ESP32-C6低功耗RISC-V核上，结果放在LP内存中供HP核读取，
+ * 仅在有意义的事件（手轮转动、拨档变化）且HP核请求唤醒时才唤醒HP核。
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include "ulp_lp_core.h"
+#include "ulp_lp_core_utils.h"
+#include "ulp_lp_core_gpio.h"
+
+#define ENC_A       LP_IO_NUM_1     // 编码器A相（GPIO1）
+#define ENC_B       LP_IO_NUM_0     // 编码器B相（GPIO0）
+#define LEFT_SW1    LP_IO_NUM_4     // X
+#define LEFT_SW2    LP_IO_NUM_5     // Y
+#define LEFT_SW3    LP_IO_NUM_3     // Z
+#define LEFT_SW4    LP_IO_NUM_2     // A
+
+#define SAMPLE_PERIOD_US    50      // 正交采样周期
+#define SWITCH_PERIOD       200     // 拨档采样间隔（采样周期数，200×50us=10ms）
+#define SWITCH_STABLE       3       // 连续相同次数达到3次才认为稳定
+
+// ==================== 与HP核共享的变量 ====================
+volatile int32_t enc_count = 0;         // 累计计数（与PCNT配置相同：A相双边沿，B相决定方向）
+volatile uint32_t left_sw = 0;          // 稳定的拨档值：'X'/'Y'/'Z'/'A'，0为OFF
+volatile uint32_t wake_request = 0;     // HP核进入睡眠前置1，LP核唤醒后清0
+volatile uint32_t wake_threshold = 2;   // 唤醒HP核所需的计数变化
+volatile int32_t wake_base_count = 0;   // HP核睡眠时的计数基准
+volatile uint32_t wake_events = 0;      // bit0:手轮 bit1:拨档
+
+static uint32_t read_left_switch(void)
+{
+    if (ulp_lp_core_gpio_get_level(LEFT_SW1) == 0) return 'X';
+    if (ulp_lp_core_gpio_get_level(LEFT_SW2) == 0) return 'Y';
+    if (ulp_lp_core_gpio_get_level(LEFT_SW3) == 0) return 'Z';
+    if (ulp_lp_core_gpio_get_level(LEFT_SW4) == 0) return 'A';
+    return 0;
+}
+
+static void wake_main_processor(uint32_t event)
+{
+    wake_events |= event;
+    if (wake_request) {
+        wake_request = 0;
+        ulp_lp_core_wakeup_main_processor();
+    }
+}
+
+int main(void)
+{
+    int last_a = ulp_lp_core_gpio_get_level(ENC_A);
+    uint32_t sw_candidate = read_left_switch();
+    uint32_t sw_same = 0;
+    uint32_t sw_tick = 0;
+    left_sw = sw_candidate;
+
+    while (1) {
+        // 正交解码：A相上升沿在B低时+1、B高时-1，下降沿相反
+        int a = ulp_lp_core_gpio_get_level(ENC_A);
+        if (a != last_a) {
+            int b = ulp_lp_core_gpio_get_level(ENC_B);
+            enc_count += (a ^ b) ? 1 : -1;
+            last_a = a;
+
+            int32_t moved = enc_count - wake_base_count;
+            if (moved < 0) {
+                moved = -moved;
+            }
+            if ((uint32_t)moved >= wake_threshold) {
+                wake_main_processor(1);
+            }
+        }
+
+        // 拨档防抖
+        if (++sw_tick >= SWITCH_PERIOD) {
+            sw_tick = 0;
+            uint32_t sw = read_left_switch();
+            if (sw == sw_candidate) {
+                if (sw_same < SWITCH_STABLE) {
+                    sw_same++;
+                }
+            } else {
+                sw_candidate = sw;
+                sw_same = 1;
+            }
+            if (sw_same >= SWITCH_STABLE && sw_candidate != left_sw) {
+                left_sw = sw_candidate;
+                wake_main_processor(2);
+            }
+        }
+
+        ulp_lp_core_delay_us(SAMPLE_PERIOD_US);
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Decode binary debug-log records (CONFIG_DEBUG_LOG_FORMAT_BINARY).
+
+Reads the raw USB-Serial-JTAG capture from a file or a serial port and prints
+one line per record. Text output from ESP_LOG that is interleaved with the
+records is skipped while resynchronising on the 0xA5 0x5A header.
+
+    python tools/dlog_decode.py capture.bin
+    python tools/dlog_decode.py /dev/ttyACM0
+"""
+
+import argparse
+import struct
+import sys
+
+# Must match dlog_event_t in main/Debug_Log/Debug_Log.h
+EVENT_NAMES = [
+    'dropped', 'boot', 'jog', 'axis', 'multiplier', 'estop', 'func_btn',
+    'midpoint', 'coord_frame', 'power', 'boot_phase', 'stall',
+]
+
+SYNC = b'\xa5\x5a'
+RECORD = struct.Struct('<2sBBIii')
+
+
+def decode(stream):
+    buf = b''
+    last_seq = None
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if getattr(stream, 'is_open', False):
+                continue  # serial port read timeout, keep waiting
+            break
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                buf = buf[-1:]
+                break
+            if len(buf) - start < RECORD.size:
+                buf = buf[start:]
+                break
+            _, event, seq, time_us, a0, a1 = RECORD.unpack_from(buf, start)
+            buf = buf[start + RECORD.size:]
+            name = EVENT_NAMES[event] if event < len(EVENT_NAMES) else 'evt%d' % event
+            if event != 0 and last_seq is not None and seq != (last_seq + 1) & 0xFF:
+                print('# sequence gap: %d -> %d' % (last_seq, seq))
+            if event != 0:
+                last_seq = seq
+            yield time_us, name, a0, a1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('source', help='capture file or serial port')
+    args = parser.parse_args()
+
+    if args.source.startswith('/dev/') or args.source.upper().startswith('COM'):
+        import serial
+        stream = serial.Serial(args.source, timeout=1)
+    else:
+        stream = open(args.source, 'rb')
+
+    try:
+        for time_us, name, a0, a1 in decode(stream):
+            print('%10d %-11s %d %d' % (time_us, name, a0, a1))
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""Pack UI fonts and images into an asset bundle for the assets partition.
+
+The manifest (JSON) names the font spec of gen_font_subset.py and the images:
+
+    {
+      "font_spec": "ui_fonts.json",
+      "images": [ { "name": "logo", "file": "logo.bin" } ]
+    }
+
+Every font of the spec marked "bundle": true is subset exactly as
+gen_font_subset.py does it and stored as raw lv_font_fmt_txt arrays. Images
+are LVGL binary images (the image converter's .bin output: a 4 byte
+lv_img_header_t and the pixel data). Paths are relative to the manifest.
+
+The firmware maps the partition with esp_partition_mmap and hands LVGL
+pointers right into flash (main/Asset_Bundle), so nothing is copied to RAM
+but the small font descriptors. The layout, all little endian and every
+blob 4 byte aligned (main/Asset_Bundle/Asset_Bundle_Format.h):
+
+    header   magic "ASB1", version, entry count, total size, CRC32 of the rest
+    entries  name[16], type (1 font, 2 image), offset, size
+    blobs    font: asset_font_header_t, then the glyph descriptors, cmaps,
+                   unicode lists, kerning and bitmaps it points to
+             image: the .bin file as is
+
+Offsets in a font blob are relative to the blob.
+
+    python tools/gen_asset_bundle.py main/LVGL_UI/ui_assets.json \\
+        components/lvgl__lvgl/src/font build/ui_assets.bin --max-size 0x84000
+
+main/CMakeLists.txt runs this at build time and flashes the result to the
+assets partition with `idf.py flash`.
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import zlib
+
+from gen_font_subset import FontError, RLE_FORMAT, build_cmaps, build_fonts, write_depfile
+
+MAGIC = 0x31425341      # "ASB1"
+VERSION = 1
+NAME_LEN = 16
+TYPE_FONT = 1
+TYPE_IMAGE = 2
+
+HEADER = struct.Struct('<IHHII')
+ENTRY = struct.Struct(f'<{NAME_LEN}sB3xII')
+FONT_HEADER = struct.Struct('<HhbbBBBBHHHIIII')
+GLYPH_DSC = struct.Struct('<IBBbb')
+CMAP = struct.Struct('<IIIHHHBx')
+KERN_CLASSES = struct.Struct('<IIIBB2x')
+KERN_PAIRS = struct.Struct('<IIIB3x')
+
+# lv_font_fmt_txt_cmap_type_t
+CMAP_FORMAT0_TINY = 2
+CMAP_SPARSE_TINY = 3
+
+RLE_BITMAP_FORMAT = 3
+
+SUBPX = {'LV_FONT_SUBPX_NONE': 0, 'LV_FONT_SUBPX_HOR': 1, 'LV_FONT_SUBPX_VER': 2, 'LV_FONT_SUBPX_BOTH': 3}
+
+
+class AssetError(Exception):
+    pass
+
+
+def align4(buf):
+    buf.extend(b'\0' * (-len(buf) % 4))
+
+
+class Blob:
+    """A blob whose header is patched with the offsets of the sections added later"""
+
+    def __init__(self, header_size):
+        self.data = bytearray(header_size)
+
+    def add(self, data):
+        align4(self.data)
+        ofs = len(self.data)
+        self.data.extend(data)
+        return ofs
+
+
+def pack_font(f):
+    font, glyphs, kern = f['font'], f['glyphs'], f['kern']
+    blob = Blob(FONT_HEADER.size)
+
+    bitmap = bytearray()
+    dsc = bytearray(GLYPH_DSC.pack(0, 0, 0, 0, 0))   # id = 0 reserved
+    for g in glyphs:
+        if len(bitmap) >= 1 << 20 or g['adv_w'] >= 1 << 12:
+            raise AssetError(f'{f["name"]}: glyph too large for lv_font_fmt_txt_glyph_dsc_t')
+        dsc += GLYPH_DSC.pack(len(bitmap) | g['adv_w'] << 20, g['box_w'], g['box_h'], g['ofs_x'], g['ofs_y'])
+        bitmap += bytes(g['bitmap'])
+    glyph_dsc_ofs = blob.add(dsc)
+
+    cmaps = build_cmaps(f['cps'])
+    lists = [blob.add(struct.pack(f'<{len(c["list"])}H', *c['list'])) if c['list'] is not None else 0
+             for c in cmaps]
+    cmap_data = bytearray()
+    for c, list_ofs in zip(cmaps, lists):
+        ctype = CMAP_FORMAT0_TINY if c['list'] is None else CMAP_SPARSE_TINY
+        list_len = 0 if c['list'] is None else len(c['list'])
+        cmap_data += CMAP.pack(c['start'], list_ofs, 0, c['length'], c['gid'], list_len, ctype)
+    cmaps_ofs = blob.add(cmap_data)
+
+    kern_classes = 0
+    kern_ofs = 0
+    if kern is not None and 'pairs' in kern:
+        ids_size = 0 if len(glyphs) < 256 else 1
+        ids = [v for l, r, _ in kern['pairs'] for v in (l, r)]
+        ids_ofs = blob.add(struct.pack(f'<{len(ids)}{"B" if ids_size == 0 else "H"}', *ids))
+        values_ofs = blob.add(struct.pack(f'<{len(kern["pairs"])}b', *(v for _, _, v in kern['pairs'])))
+        kern_ofs = blob.add(KERN_PAIRS.pack(ids_ofs, values_ofs, len(kern['pairs']), ids_size))
+    elif kern is not None:
+        kern_classes = 1
+        values_ofs = blob.add(struct.pack(f'<{len(kern["values"])}b', *kern['values']))
+        left_ofs = blob.add(bytes(kern['left']))
+        right_ofs = blob.add(bytes(kern['right']))
+        kern_ofs = blob.add(KERN_CLASSES.pack(values_ofs, left_ofs, right_ofs, kern['left_cnt'], kern['right_cnt']))
+
+    bitmap_ofs = blob.add(bitmap or b'\0')
+    bitmap_format = RLE_BITMAP_FORMAT if font['bitmap_format'] == RLE_FORMAT else int(font['bitmap_format'])
+    blob.data[:FONT_HEADER.size] = FONT_HEADER.pack(
+        font['line_height'], font['base_line'], font['underline_position'], font['underline_thickness'],
+        SUBPX.get(font['subpx'], font['subpx']), font['bpp'], bitmap_format, kern_classes, font['kern_scale'], len(cmaps),
+        len(glyphs) + 1, bitmap_ofs, glyph_dsc_ofs, cmaps_ofs, kern_ofs)
+    return bytes(blob.data)
+
+
+def pack_image(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < 4:
+        raise AssetError(f'{path}: not an LVGL binary image')
+    header = struct.unpack_from('<I', data)[0]
+    cf, w, h = header & 0x1F, (header >> 10) & 0x7FF, (header >> 21) & 0x7FF
+    if cf == 0 or w == 0 or h == 0:
+        raise AssetError(f'{path}: not an LVGL binary image (cf {cf}, {w}x{h})')
+    return data
+
+
+def pack_bundle(assets):
+    out = bytearray(HEADER.size + ENTRY.size * len(assets))
+    entries = bytearray()
+    for name, asset_type, data in assets:
+        align4(out)
+        entries += ENTRY.pack(name.encode(), asset_type, len(out), len(data))
+        out += data
+    out[HEADER.size:HEADER.size + len(entries)] = entries
+    out[:HEADER.size] = HEADER.pack(MAGIC, VERSION, len(assets), len(out), zlib.crc32(out[HEADER.size:]))
+    return bytes(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('manifest', help='asset bundle description')
+    ap.add_argument('fontdir', help='directory of the source fonts')
+    ap.add_argument('output', help='bundle image to write')
+    ap.add_argument('--max-size', type=lambda v: int(v, 0), help='size of the partition')
+    ap.add_argument('--depfile', help='write the input files as make dependencies of the bundle')
+    args = ap.parse_args()
+
+    manifest_dir = os.path.dirname(os.path.abspath(args.manifest))
+    deps = [os.path.abspath(args.manifest)]
+    assets = []
+    try:
+        with open(args.manifest, encoding='utf-8') as f:
+            manifest = json.load(f)
+        if 'font_spec' in manifest:
+            fonts, font_deps = build_fonts(os.path.join(manifest_dir, manifest['font_spec']), args.fontdir)
+            deps += font_deps
+            assets += [(f['name'], TYPE_FONT, pack_font(f)) for f in fonts if f['bundle']]
+        for img in manifest.get('images', []):
+            path = os.path.join(manifest_dir, img['file'])
+            deps.append(os.path.abspath(path))
+            assets.append((img['name'], TYPE_IMAGE, pack_image(path)))
+
+        names = [name for name, _, _ in assets]
+        for name in names:
+            if not name or len(name.encode()) >= NAME_LEN or names.count(name) > 1:
+                raise AssetError(f'bad or duplicate asset name {name!r} (at most {NAME_LEN - 1} bytes)')
+        bundle = pack_bundle(assets)
+        if args.max_size is not None and len(bundle) > args.max_size:
+            raise AssetError(f'bundle is {len(bundle)} bytes, the partition only {args.max_size}')
+    except (FontError, AssetError, KeyError, ValueError, OSError) as e:
+        sys.exit(f'{args.manifest}: {e}')
+
+    try:
+        with open(args.output, 'rb') as f:
+            unchanged = f.read() == bundle
+    except OSError:
+        unchanged = False
+    if not unchanged:
+        os.makedirs(os.path.dirname(args.output) or '.', exist_ok=True)
+        with open(args.output, 'wb') as f:
+            f.write(bundle)
+    if args.depfile:
+        write_depfile(args.depfile, args.output, deps)
+
+    for name, asset_type, data in assets:
+        print(f'{name:<{NAME_LEN}} {"font" if asset_type == TYPE_FONT else "image":<6} {len(data):7} B')
+    print(f'{os.path.basename(args.output)}: {len(bundle)} B'
+          + (f' of {args.max_size} B' if args.max_size is not None else ''))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,677 @@
+#!/usr/bin/env python3
+"""Cut LVGL fonts down to the characters the UI actually uses.
+
+The spec (JSON) lists the UI sources to scan and the fonts to produce:
+
+    {
+      "scan":  ["coordinate_screen.json", "LVGL_Example.c"],
+      "chars": "0123456789.-",
+      "fonts": [ { "name": "pendant_font_12", "source": "lv_font_montserrat_12", "chars": "" },
+                 { "name": "dro_font_48", "source": "lv_font_montserrat_48", "charset": "0123456789.-",
+                   "format": "rle" } ]
+    }
+
+"scan" paths are relative to the spec. From JSON files every "text" value is
+taken, from C files every string and character literal except #include lines,
+ESP_LOGx/printf arguments and log tags; printf conversions are dropped, so the
+characters printed at runtime (numbers mostly) go into "chars". A font's own
+"chars" are added for that font only.
+
+"charset" instead of "chars" gives a font exactly these characters, e.g. the
+digits of a large readout. "format": "rle" stores the glyphs run-length
+encoded with 8 shades (LV_FONT_FMT_TXT_RLE), which LVGL decodes right into
+the mask while drawing; large glyphs shrink to a fraction of their 4 bpp size.
+
+"bundle": true marks a font that the firmware loads from the asset partition
+(tools/gen_asset_bundle.py) instead of linking it. Its .c is still written for
+the host tests.
+
+"source" is an lv_font_conv generated font (lv_font_fmt_txt format) in the
+font directory given on the command line. Glyphs, bitmaps and kerning are
+copied unchanged, so the subset renders exactly like the original. The glyphs
+are renumbered in code point order and the cmaps are rebuilt from the result:
+long runs of consecutive code points become FORMAT0_TINY ranges (no table at
+all), everything between them SPARSE_TINY lists. The ranges don't overlap,
+so LVGL's linear cmap scan stops at the first range that can hold a letter.
+
+    python tools/gen_font_subset.py main/LVGL_UI/ui_fonts.json \\
+        components/lvgl__lvgl/src/font build/main
+
+writes <name>.c for each font and <spec name>.h with the declarations.
+main/CMakeLists.txt runs this at build time; --depfile lets the build rerun
+it when a scanned file changes.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# A FORMAT0_TINY cmap costs about as much as 10 entries of a sparse list
+RUN_MIN = 10
+
+RLE_FORMAT = 'LV_FONT_FMT_TXT_RLE'
+
+# Relative code points of a sparse list are uint16_t
+SPARSE_SPAN_MAX = 0xFFFF
+
+IDENT = re.compile(r'^[a-z_][a-z0-9_]*$')
+
+PRINTF_CONV = re.compile(r'%[-+ #0]*(?:\d+|\*)?(?:\.(?:\d+|\*))?(?:hh|h|ll|l|L|z|j|t)?[diouxXeEfFgGaAcspn]')
+
+# Calls whose string arguments are never shown on the display
+LOG_CALL = re.compile(r'\b(?:ESP_LOG[A-Z]*|ESP_DRAM_LOG[A-Z]*|printf|puts)\s*\(')
+
+# ESP_LOG tags: static const char *TAG = "UI";
+LOG_TAG = re.compile(r'\bTAG\w*\s*=\s*"(?:[^"\\\n]|\\.)*"')
+
+C_LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"|\'((?:[^\'\\\n]|\\.)+)\'')
+
+C_ESCAPES = {'n': '\n', 't': '\t', 'r': '\r', '0': '\0', '\\': '\\', '"': '"', "'": "'",
+             'a': '\a', 'b': '\b', 'f': '\f', 'v': '\v', '?': '?'}
+
+
+class FontError(Exception):
+    pass
+
+
+# ==================== 扫描界面源文件 ====================
+
+def c_unescape(text):
+    out = []
+    i = 0
+    while i < len(text):
+        ch = text[i]
+        if ch != '\\':
+            out.append(ch)
+            i += 1
+            continue
+        nxt = text[i + 1]
+        m = re.match(r'x([0-9a-fA-F]+)|u([0-9a-fA-F]{4})|U([0-9a-fA-F]{8})|([0-7]{1,3})', text[i + 1:])
+        if m and nxt in 'xuU01234567':
+            num = m.group(1) or m.group(2) or m.group(3)
+            out.append(chr(int(num, 16)) if num else chr(int(m.group(4), 8)))
+            i += 1 + len(m.group(0))
+        else:
+            out.append(C_ESCAPES.get(nxt, nxt))
+            i += 2
+    return ''.join(out)
+
+
+def strip_c_comments(src):
+    # Literals are matched too so that "//" inside a string survives
+    def repl(m):
+        return m.group(0) if m.group(0)[0] in '"\'' else ' '
+    return re.sub(r'"(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\'|//[^\n]*|/\*.*?\*/', repl, src, flags=re.S)
+
+
+def strip_calls(src, pattern):
+    out = []
+    pos = 0
+    for m in pattern.finditer(src):
+        if m.start() < pos:
+            continue
+        out.append(src[pos:m.start()])
+        depth = 1
+        i = m.end()
+        while i < len(src) and depth:
+            lit = C_LITERAL.match(src, i)
+            if lit:
+                i = lit.end()
+                continue
+            depth += {'(': 1, ')': -1}.get(src[i], 0)
+            i += 1
+        pos = i
+    out.append(src[pos:])
+    return ''.join(out)
+
+
+def scan_c(path):
+    with open(path, encoding='utf-8') as f:
+        src = f.read()
+    src = strip_c_comments(src)
+    src = re.sub(r'^\s*#\s*include[^\n]*', '', src, flags=re.M)
+    src = strip_calls(src, LOG_CALL)
+    src = LOG_TAG.sub('', src)
+    chars = set()
+    for m in C_LITERAL.finditer(src):
+        text = c_unescape(m.group(1) if m.group(1) is not None else m.group(2))
+        if m.group(1) is not None:
+            text = PRINTF_CONV.sub('', text).replace('%%', '%')
+        chars.update(text)
+    return chars
+
+
+def scan_json(path):
+    with open(path, encoding='utf-8') as f:
+        desc = json.load(f)
+    chars = set()
+
+    def walk(node):
+        if isinstance(node, dict):
+            for key, value in node.items():
+                if key == 'text' and isinstance(value, str):
+                    chars.update(value)
+                else:
+                    walk(value)
+        elif isinstance(node, list):
+            for value in node:
+                walk(value)
+
+    walk(desc)
+    return chars
+
+
+def scan(path):
+    if path.endswith('.json'):
+        return scan_json(path)
+    if path.endswith(('.c', '.h')):
+        return scan_c(path)
+    raise FontError(f'{path}: don\'t know how to scan this file')
+
+
+# ==================== 解析lv_font_conv生成的字体 ====================
+
+def c_array(src, name, path):
+    m = re.search(r'\b' + name + r'\[\]\s*=\s*\{(.*?)\};', src, re.S)
+    if not m:
+        raise FontError(f'{path}: no {name}[]')
+    body = re.sub(r'/\*.*?\*/', '', m.group(1), flags=re.S)
+    return [int(v, 0) for v in re.findall(r'-?(?:0x[0-9a-fA-F]+|\d+)', body)]
+
+
+def c_field(src, name, path, struct=None):
+    if struct:
+        m = re.search(struct + r'\s*=\s*\{(.*?)\};', src, re.S)
+        if not m:
+            raise FontError(f'{path}: no {struct}')
+        src = m.group(1)
+    m = re.search(r'\.' + name + r'\s*=\s*(&?[-\w]+)', src)
+    if not m:
+        raise FontError(f'{path}: no .{name}')
+    value = m.group(1)
+    return int(value, 0) if re.fullmatch(r'-?(0x[0-9a-fA-F]+|\d+)', value) else value
+
+
+def load_font(path):
+    with open(path, encoding='utf-8') as f:
+        src = f.read()
+
+    font = {'path': path}
+    header = re.match(r'/\*+\s*\n((?:\s*\*[^\n]*\n)*?)\s*\*+/', src)
+    font['header'] = [l.strip().lstrip('*').strip() for l in header.group(1).splitlines()] if header else []
+
+    bitmap = c_array(src, 'glyph_bitmap', path)
+    font['bitmap'] = bitmap
+
+    dsc = re.findall(r'\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), '
+                     r'\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}', src)
+    if not dsc:
+        raise FontError(f'{path}: no glyph_dsc[]')
+    glyphs = [dict(zip(('bitmap_index', 'adv_w', 'box_w', 'box_h', 'ofs_x', 'ofs_y'), map(int, d))) for d in dsc]
+
+    # A glyph's bitmap reaches to the next bitmap (works for compressed fonts too)
+    starts = sorted({g['bitmap_index'] for g in glyphs} | {len(bitmap)})
+    end_of = dict(zip(starts, starts[1:]))
+    for g in glyphs:
+        empty = g['box_w'] == 0 or g['box_h'] == 0
+        g['bitmap'] = [] if empty else bitmap[g['bitmap_index']:end_of[g['bitmap_index']]]
+    font['glyphs'] = glyphs
+
+    # Unicode -> glyph id
+    cmap = {}
+    cmaps = re.findall(r'\.range_start = (\d+), \.range_length = (\d+), \.glyph_id_start = (\d+),\s*'
+                       r'\.unicode_list = (\w+), \.glyph_id_ofs_list = (\w+), \.list_length = (\d+), '
+                       r'\.type = LV_FONT_FMT_TXT_CMAP_(\w+)', src)
+    if not cmaps:
+        raise FontError(f'{path}: no cmaps[]')
+    for start, length, gid_start, ulist, olist, list_len, ctype in cmaps:
+        start, length, gid_start = int(start), int(length), int(gid_start)
+        if ctype == 'FORMAT0_TINY':
+            for rcp in range(length):
+                cmap[start + rcp] = gid_start + rcp
+        elif ctype == 'FORMAT0_FULL':
+            ofs = c_array(src, olist, path)
+            for rcp in range(length):
+                if ofs[rcp] or rcp == 0:
+                    cmap[start + rcp] = gid_start + ofs[rcp]
+        elif ctype in ('SPARSE_TINY', 'SPARSE_FULL'):
+            rcps = c_array(src, ulist, path)
+            ofs = c_array(src, olist, path) if ctype == 'SPARSE_FULL' else range(len(rcps))
+            for rcp, o in zip(rcps, ofs):
+                cmap[start + rcp] = gid_start + o
+        else:
+            raise FontError(f'{path}: unknown cmap type {ctype}')
+    font['cmap'] = cmap
+
+    for name in ('kern_scale', 'bpp', 'kern_classes', 'bitmap_format'):
+        font[name] = c_field(src, name, path, r'font_dsc')
+    for name in ('line_height', 'base_line', 'subpx', 'underline_position', 'underline_thickness'):
+        font[name] = c_field(src, name, path, r'const lv_font_t \w+')
+
+    kern_dsc = c_field(src, 'kern_dsc', path, r'font_dsc')
+    font['kern'] = None
+    if kern_dsc == 'NULL':
+        pass
+    elif font['kern_classes']:
+        font['kern'] = {
+            'left': c_array(src, 'kern_left_class_mapping', path),
+            'right': c_array(src, 'kern_right_class_mapping', path),
+            'values': c_array(src, 'kern_class_values', path),
+            'left_cnt': c_field(src, 'left_class_cnt', path, r'kern_classes'),
+            'right_cnt': c_field(src, 'right_class_cnt', path, r'kern_classes'),
+        }
+    else:
+        ids = c_array(src, 'kern_pair_glyph_ids', path)
+        values = c_array(src, 'kern_pair_values', path)
+        font['kern'] = {'pairs': {(ids[2 * i], ids[2 * i + 1]): v for i, v in enumerate(values)}}
+    return font
+
+
+# ==================== 生成子集字体 ====================
+
+def subset(font, cps):
+    """Glyphs of `cps` in code point order, with kerning remapped to the new ids"""
+    cps = sorted(cp for cp in cps if cp in font['cmap'])
+    old_ids = [font['cmap'][cp] for cp in cps]
+    new_id = {old: i + 1 for i, old in enumerate(old_ids)}
+
+    kern = font['kern']
+    if kern is None:
+        new_kern = None
+    elif 'pairs' in kern:
+        pairs = sorted((new_id[l], new_id[r], v) for (l, r), v in kern['pairs'].items()
+                       if l in new_id and r in new_id)
+        new_kern = {'pairs': pairs} if pairs else None
+    else:
+        # Keep only the classes of the remaining glyphs. Classes that kern the same way are merged
+        # and classes without any kerning dropped, so the value table shrinks with the glyph set
+        def value(l, r):
+            return kern['values'][(l - 1) * kern['right_cnt'] + (r - 1)] if l and r else 0
+        left_old = sorted({kern['left'][g] for g in old_ids} - {0})
+        right_old = sorted({kern['right'][g] for g in old_ids} - {0})
+
+        def merge(classes, key):
+            ids, keys = {}, []
+            for c in classes:
+                k = key(c)
+                if any(k):
+                    if k not in keys:
+                        keys.append(k)
+                    ids[c] = keys.index(k) + 1
+            return ids, keys
+        left_new, rows = merge(left_old, lambda l: tuple(value(l, r) for r in right_old))
+        right_new, cols = merge(right_old, lambda r: tuple(row[right_old.index(r)] for row in rows))
+        pairs = [(new_id[l], new_id[r], value(kern['left'][l], kern['right'][r]))
+                 for l in old_ids for r in old_ids]
+        pairs = [p for p in pairs if p[2]]
+
+        class_size = 2 * (len(old_ids) + 1) + len(rows) * len(cols)
+        pair_size = (2 if len(old_ids) < 256 else 4) * len(pairs) + len(pairs)
+        if not pairs:
+            new_kern = None
+        elif pair_size < class_size:
+            new_kern = {'pairs': sorted(pairs)}
+        else:
+            new_kern = {
+                'left': [0] + [left_new.get(kern['left'][g], 0) for g in old_ids],
+                'right': [0] + [right_new.get(kern['right'][g], 0) for g in old_ids],
+                'values': [col[i] for i in range(len(rows)) for col in cols],
+                'left_cnt': len(rows),
+                'right_cnt': len(cols),
+            }
+
+    return cps, [font['glyphs'][g] for g in old_ids], new_kern
+
+
+def build_cmaps(cps):
+    """Split the sorted code points into non-overlapping FORMAT0_TINY runs and SPARSE_TINY lists"""
+    runs = []
+    for i, cp in enumerate(cps):
+        if runs and cp == runs[-1][1] + 1:
+            runs[-1][1] = cp
+        else:
+            runs.append([cp, cp, i + 1])
+
+    cmaps = []
+    sparse = None
+    for first, last, gid in runs:
+        if last - first + 1 >= RUN_MIN:
+            sparse = None
+            cmaps.append({'start': first, 'length': last - first + 1, 'gid': gid, 'list': None})
+            continue
+        if sparse is None or last - sparse['start'] > SPARSE_SPAN_MAX:
+            sparse = {'start': first, 'gid': gid, 'list': []}
+            cmaps.append(sparse)
+        sparse['list'].extend(cp - sparse['start'] for cp in range(first, last + 1))
+        sparse['length'] = last - sparse['start'] + 1
+
+    # A list of consecutive code points is a range
+    for c in cmaps:
+        if c['list'] is not None and len(c['list']) == c['length']:
+            c['list'] = None
+    return cmaps
+
+
+def rle_encode(g, bpp):
+    """Encode a plain glyph bitmap as LV_FONT_FMT_TXT_RLE (see lv_font_fmt_txt.h)"""
+    px_cnt = g['box_w'] * g['box_h']
+    vmax = (1 << bpp) - 1
+    levels = []
+    for i in range(px_cnt):
+        bit = i * bpp
+        v = (g['bitmap'][bit >> 3] >> (8 - bpp - (bit & 7))) & vmax
+        levels.append((v * 14 + vmax) // (2 * vmax))   # round(v * 7 / vmax)
+
+    out = []
+    i = 0
+    while i < px_cnt:
+        v = levels[i]
+        run = 1
+        while i + run < px_cnt and levels[i + run] == v:
+            run += 1
+        if run == 1 and i + 1 < px_cnt:
+            out.append(0x80 | v << 3 | levels[i + 1])
+            i += 2
+        elif v in (0, 7):
+            n = min(run, 64)
+            out.append((0x00 if v == 0 else 0x40) | (n - 1))
+            i += n
+        else:
+            n = min(run, 8)
+            out.append(0xC0 | v << 3 | (n - 1))
+            i += n
+    return out
+
+
+def c_list(values, per_line=8, fmt=str):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt(v) for v in values[i:i + per_line]))
+    return ',\n'.join(lines)
+
+
+def char_comment(cp):
+    ch = chr(cp)
+    return {'"': '\\"', '\\': '\\\\'}.get(ch, ch)
+
+
+def generate(font, name, cps, glyphs, kern, spec_name):
+    src_name = os.path.basename(font['path'])
+    cmaps = build_cmaps(cps)
+    out = []
+    out.append('/*******************************************************************************')
+    for line in font['header']:
+        if line.startswith('Size:'):
+            out.append(f' * {line}')
+        elif line.startswith('Bpp:'):
+            out.append(' * Bpp: 3, run-length encoded' if font['bitmap_format'] == RLE_FORMAT else f' * {line}')
+    out.append(f' * Subset of {src_name}: {len(cps)} of {len(font["cmap"])} glyphs')
+    out.append(f' * Generated by tools/gen_font_subset.py from {spec_name}, do not edit')
+    out.append(' ******************************************************************************/')
+    out.append('')
+    out.append('#include "lvgl.h"')
+    out.append('')
+    out.append('/*-----------------')
+    out.append(' *    BITMAPS')
+    out.append(' *----------------*/')
+    out.append('')
+    out.append('/*Store the image of the glyphs*/')
+    out.append('static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {')
+    bitmap_index = []
+    size = 0
+    lines = []
+    for cp, g in zip(cps, glyphs):
+        bitmap_index.append(size)
+        size += len(g['bitmap'])
+        if lines:
+            lines.append('')
+        lines.append(f'    /* U+{cp:04X} "{char_comment(cp)}" */')
+        if g['bitmap']:
+            lines.append(c_list(g['bitmap'], fmt=lambda v: f'0x{v:x}') + ',')
+    if size == 0:
+        lines.append('    0x0,')
+    # No comma after the last byte
+    last = max(i for i, l in enumerate(lines) if l.endswith(','))
+    lines[last] = lines[last][:-1]
+    out.extend(lines)
+    out.append('};')
+    out.append('')
+    out.append('')
+    out.append('/*---------------------')
+    out.append(' *  GLYPH DESCRIPTION')
+    out.append(' *--------------------*/')
+    out.append('')
+    out.append('static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {')
+    dsc = ['    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */']
+    for idx, g in zip(bitmap_index, glyphs):
+        dsc.append(f'    {{.bitmap_index = {idx}, .adv_w = {g["adv_w"]}, .box_w = {g["box_w"]}, .box_h = {g["box_h"]}, '
+                   f'.ofs_x = {g["ofs_x"]}, .ofs_y = {g["ofs_y"]}}}')
+    out.append(',\n'.join(dsc))
+    out.append('};')
+    out.append('')
+    out.append('/*---------------------')
+    out.append(' *  CHARACTER MAPPING')
+    out.append(' *--------------------*/')
+    out.append('')
+    for i, c in enumerate(cmaps):
+        if c['list'] is not None:
+            out.append(f'static const uint16_t unicode_list_{i}[] = {{')
+            out.append(c_list(c['list'], fmt=lambda v: f'0x{v:x}'))
+            out.append('};')
+            out.append('')
+    out.append('/*Collect the unicode lists and glyph_id offsets*/')
+    out.append('static const lv_font_fmt_txt_cmap_t cmaps[] = {')
+    entries = []
+    for i, c in enumerate(cmaps):
+        if c['list'] is None:
+            ulist, list_len, ctype = 'NULL', 0, 'FORMAT0_TINY'
+        else:
+            ulist, list_len, ctype = f'unicode_list_{i}', len(c['list']), 'SPARSE_TINY'
+        entries.append('    {\n'
+                       f'        .range_start = {c["start"]}, .range_length = {c["length"]}, .glyph_id_start = {c["gid"]},\n'
+                       f'        .unicode_list = {ulist}, .glyph_id_ofs_list = NULL, .list_length = {list_len}, '
+                       f'.type = LV_FONT_FMT_TXT_CMAP_{ctype}\n'
+                       '    }')
+    out.append(',\n'.join(entries))
+    out.append('};')
+    out.append('')
+    out.append('/*-----------------')
+    out.append(' *    KERNING')
+    out.append(' *----------------*/')
+    out.append('')
+    if kern is None:
+        kern_dsc, kern_classes = 'NULL', 0
+    elif 'pairs' in kern:
+        kern_dsc, kern_classes = '&kern_pairs', 0
+        ids_size = 0 if len(glyphs) < 256 else 1
+        ids_type = 'uint8_t' if ids_size == 0 else 'uint16_t'
+        out.append('/*Pair left and right glyphs for kerning*/')
+        out.append(f'static const {ids_type} kern_pair_glyph_ids[] = {{')
+        out.append(c_list([v for l, r, _ in kern['pairs'] for v in (l, r)]))
+        out.append('};')
+        out.append('')
+        out.append('/* Kerning between the respective left and right glyphs')
+        out.append(' * 4.4 format which needs to scaled with `kern_scale`*/')
+        out.append('static const int8_t kern_pair_values[] = {')
+        out.append(c_list([v for _, _, v in kern['pairs']]))
+        out.append('};')
+        out.append('')
+        out.append('/*Collect the kern pair\'s data in one place*/')
+        out.append('static const lv_font_fmt_txt_kern_pair_t kern_pairs = {')
+        out.append('    .glyph_ids = kern_pair_glyph_ids,')
+        out.append('    .values = kern_pair_values,')
+        out.append(f'    .pair_cnt = {len(kern["pairs"])},')
+        out.append(f'    .glyph_ids_size = {ids_size}')
+        out.append('};')
+        out.append('')
+    else:
+        kern_dsc, kern_classes = '&kern_classes', 1
+        out.append('/*Map glyph_ids to kern left classes*/')
+        out.append('static const uint8_t kern_left_class_mapping[] = {')
+        out.append(c_list(kern['left']))
+        out.append('};')
+        out.append('')
+        out.append('/*Map glyph_ids to kern right classes*/')
+        out.append('static const uint8_t kern_right_class_mapping[] = {')
+        out.append(c_list(kern['right']))
+        out.append('};')
+        out.append('')
+        out.append('/*Kern values between classes*/')
+        out.append('static const int8_t kern_class_values[] = {')
+        out.append(c_list(kern['values']))
+        out.append('};')
+        out.append('')
+        out.append('/*Collect the kern class\' data in one place*/')
+        out.append('static const lv_font_fmt_txt_kern_classes_t kern_classes = {')
+        out.append('    .class_pair_values   = kern_class_values,')
+        out.append('    .left_class_mapping  = kern_left_class_mapping,')
+        out.append('    .right_class_mapping = kern_right_class_mapping,')
+        out.append(f'    .left_class_cnt      = {kern["left_cnt"]},')
+        out.append(f'    .right_class_cnt     = {kern["right_cnt"]},')
+        out.append('};')
+        out.append('')
+    out.append('/*--------------------')
+    out.append(' *  ALL CUSTOM DATA')
+    out.append(' *--------------------*/')
+    out.append('')
+    out.append('/*Store all the custom data of the font*/')
+    out.append('static lv_font_fmt_txt_glyph_cache_t cache;')
+    out.append('static const lv_font_fmt_txt_dsc_t font_dsc = {')
+    out.append('    .glyph_bitmap = glyph_bitmap,')
+    out.append('    .glyph_dsc = glyph_dsc,')
+    out.append('    .cmaps = cmaps,')
+    out.append(f'    .kern_dsc = {kern_dsc},')
+    out.append(f'    .kern_scale = {font["kern_scale"]},')
+    out.append(f'    .cmap_num = {len(cmaps)},')
+    out.append(f'    .bpp = {font["bpp"]},')
+    out.append(f'    .kern_classes = {kern_classes},')
+    out.append(f'    .bitmap_format = {font["bitmap_format"]},')
+    out.append('    .cache = &cache')
+    out.append('};')
+    out.append('')
+    out.append('/*-----------------')
+    out.append(' *  PUBLIC FONT')
+    out.append(' *----------------*/')
+    out.append('')
+    out.append('/*Initialize a public general font descriptor*/')
+    out.append(f'const lv_font_t {name} = {{')
+    out.append('    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph\'s data*/')
+    out.append('    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph\'s bitmap*/')
+    out.append(f'    .line_height = {font["line_height"]},          /*The maximum line height required by the font*/')
+    out.append(f'    .base_line = {font["base_line"]},             /*Baseline measured from the bottom of the line*/')
+    out.append(f'    .subpx = {font["subpx"]},')
+    out.append(f'    .underline_position = {font["underline_position"]},')
+    out.append(f'    .underline_thickness = {font["underline_thickness"]},')
+    out.append('    .dsc = &font_dsc           /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */')
+    out.append('};')
+    out.append('')
+    return '\n'.join(out)
+
+
+def generate_header(fonts, spec_name):
+    h = []
+    h.append(f'// 由tools/gen_font_subset.py根据{spec_name}生成，请勿手动修改')
+    h.append('#pragma once')
+    h.append('#include "lvgl.h"')
+    h.append('')
+    for f in fonts:
+        if not f['bundle']:
+            h.append(f'LV_FONT_DECLARE({f["name"]})')
+    bundled = [f['name'] for f in fonts if f['bundle']]
+    if bundled:
+        h.append('')
+        h.append('// 以下字体打包在资源分区中，固件用asset_bundle_get_font("<名称>")获取；.c只供主机测试编译')
+        for name in bundled:
+            h.append(f'LV_FONT_DECLARE({name})')
+    h.append('')
+    return '\n'.join(h)
+
+
+def write(path, text):
+    # Unchanged outputs keep their timestamp so dependent objects aren't rebuilt
+    try:
+        with open(path, encoding='utf-8') as f:
+            if f.read() == text:
+                return
+    except OSError:
+        pass
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write(text)
+
+
+def build_fonts(spec_path, fontdir):
+    """Subset every font of the spec. Returns the fonts and the files they depend on"""
+    spec_dir = os.path.dirname(os.path.abspath(spec_path))
+    spec_name = os.path.basename(spec_path)
+    deps = [os.path.abspath(spec_path)]
+    with open(spec_path, encoding='utf-8') as f:
+        spec = json.load(f)
+    used = set(spec.get('chars', ''))
+    for rel in spec.get('scan', []):
+        path = os.path.join(spec_dir, rel)
+        deps.append(path)
+        used |= scan(path)
+
+    fonts = []
+    for entry in spec['fonts']:
+        name, source = entry['name'], entry['source']
+        if not IDENT.match(name) or any(f['name'] == name for f in fonts):
+            raise FontError(f'bad or duplicate font name {name!r}')
+        path = os.path.join(fontdir, source + '.c')
+        deps.append(os.path.abspath(path))
+        font = load_font(path)
+        chars = set(entry['charset']) if 'charset' in entry else used
+        chars = {ord(ch) for ch in chars | set(entry.get('chars', '')) if ord(ch) >= 0x20}
+        missing = sorted(cp for cp in chars if cp not in font['cmap'])
+        if missing:
+            print(f'{spec_name}: warning: {source} has no glyph for ' +
+                  ' '.join(f'U+{cp:04X} "{chr(cp)}"' for cp in missing), file=sys.stderr)
+        cps, glyphs, kern = subset(font, chars)
+        fmt = entry.get('format', 'plain')
+        if fmt == 'rle':
+            if font['bitmap_format'] != 0 or font['bpp'] not in (1, 2, 4, 8):
+                raise FontError(f'{source}: only plain 1, 2, 4 or 8 bpp fonts can be run-length encoded')
+            glyphs = [dict(g, bitmap=rle_encode(g, font['bpp'])) for g in glyphs]
+            font = dict(font, bpp=3, bitmap_format=RLE_FORMAT)
+        elif fmt != 'plain':
+            raise FontError(f'{name}: unknown format {fmt!r}')
+        fonts.append({'name': name, 'font': font, 'cps': cps, 'glyphs': glyphs, 'kern': kern,
+                      'bundle': bool(entry.get('bundle', False))})
+    return fonts, deps
+
+
+def write_depfile(path, target, deps):
+    write(path, target.replace(' ', '\\ ') + ': ' +
+          ' \\\n  '.join(d.replace(' ', '\\ ') for d in deps) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('spec', help='font subset description')
+    ap.add_argument('fontdir', help='directory of the source fonts')
+    ap.add_argument('outdir', help='directory for the generated .c/.h')
+    ap.add_argument('--depfile', help='write the scanned files as make dependencies of the header')
+    args = ap.parse_args()
+
+    spec_name = os.path.basename(args.spec)
+    header_name = os.path.splitext(spec_name)[0] + '.h'
+    outputs = {}
+    try:
+        fonts, deps = build_fonts(args.spec, args.fontdir)
+        for f in fonts:
+            outputs[f['name'] + '.c'] = generate(f['font'], f['name'], f['cps'], f['glyphs'], f['kern'], spec_name)
+        outputs[header_name] = generate_header(fonts, spec_name)
+    except (FontError, KeyError, ValueError, OSError) as e:
+        sys.exit(f'{args.spec}: {e}')
+
+    os.makedirs(args.outdir, exist_ok=True)
+    for fname, text in outputs.items():
+        write(os.path.join(args.outdir, fname), text)
+    if args.depfile:
+        write_depfile(args.depfile, os.path.join(args.outdir, header_name), deps)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,371 @@
+#!/usr/bin/env python3
+"""Compile a declarative screen description (JSON) into LVGL C code.
+
+The screen is a single root object with every widget as a direct child at an
+absolute position, so LVGL has no flex containers to lay out at runtime. Styles
+are emitted as LV_STYLE_CONST_INIT tables that live in flash and are shared by
+every object that references them; "extends" lets styles share common values
+in the JSON. A reference of the form "name:checked" adds
+the style for that state only, so switching a highlight is lv_obj_add_state /
+lv_obj_clear_state instead of swapping styles.
+
+Fonts listed in "bundle_fonts" are not linked into the firmware; they live in
+the asset bundle (tools/gen_asset_bundle.py). The styles using them start with
+LV_FONT_DEFAULT in a RAM copy of their table, and <name>_create() replaces it
+with what its load_font callback returns for the font's name.
+
+    python tools/gen_screen.py main/LVGL_UI/coordinate_screen.json build/main
+
+writes <name>.c and <name>.h into the output directory. main/CMakeLists.txt
+runs this at build time whenever the JSON or this script changes.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+NODE_TYPES = {
+    'obj': ('NODE_OBJ', 'lv_obj_create'),
+    'label': ('NODE_LABEL', 'lv_label_create'),
+    'textarea': ('NODE_TEXTAREA', 'lv_textarea_create'),
+    'btn': ('NODE_BTN', 'lv_btn_create'),
+}
+
+# Node flags understood by the generated create loop
+FLAGS = {
+    'one_line': 'NODE_FLAG_ONE_LINE',      # lv_textarea_set_one_line
+    'long_clip': 'NODE_FLAG_LONG_CLIP',    # lv_label_set_long_mode(LV_LABEL_LONG_CLIP)
+    'center': 'NODE_FLAG_CENTER',          # lv_obj_center instead of x/y
+    'no_scroll': 'NODE_FLAG_NO_SCROLL',    # clear LV_OBJ_FLAG_SCROLLABLE
+    'no_theme': 'NODE_FLAG_NO_THEME',      # drop the theme's default-state main styles (incl. transitions)
+    'hidden': 'NODE_FLAG_HIDDEN',          # LV_OBJ_FLAG_HIDDEN, shown at runtime
+}
+
+MAX_STYLES = 4
+
+# Style references are "name" or "name:state"; the state picks the selector the
+# style is added with, so e.g. a highlight is a state bit flip at runtime
+STATES = {
+    'checked': 'LV_STATE_CHECKED',
+    'focused': 'LV_STATE_FOCUSED',
+    'pressed': 'LV_STATE_PRESSED',
+    'disabled': 'LV_STATE_DISABLED',
+}
+
+# Shorthands expanded to the underlying LVGL properties
+SHORTHANDS = {
+    'pad_all': ('pad_top', 'pad_bottom', 'pad_left', 'pad_right'),
+    'pad_hor': ('pad_left', 'pad_right'),
+    'pad_ver': ('pad_top', 'pad_bottom'),
+    'size': ('width', 'height'),
+}
+
+IDENT = re.compile(r'^[a-z_][a-z0-9_]*$')
+
+
+class ScreenError(Exception):
+    pass
+
+
+def style_value(prop, value, bundle_fonts=()):
+    if prop.endswith('_color'):
+        m = re.fullmatch(r'0x([0-9a-fA-F]{6})', str(value))
+        if not m:
+            raise ScreenError(f'{prop}: colour must be "0xRRGGBB", got {value!r}')
+        rgb = int(m.group(1), 16)
+        return 'LV_COLOR_MAKE(0x%02X, 0x%02X, 0x%02X)' % (rgb >> 16, (rgb >> 8) & 0xFF, rgb & 0xFF)
+    if value is None:
+        return 'NULL'  # pointer properties such as transition
+    if prop == 'text_font':
+        if not IDENT.match(str(value)):
+            raise ScreenError(f'text_font: bad font name {value!r}')
+        if value in bundle_fonts:
+            return 'LV_FONT_DEFAULT'  # replaced by <name>_create()
+        return f'&{value}'
+    if isinstance(value, bool) or not isinstance(value, (int, str)):
+        raise ScreenError(f'{prop}: unsupported value {value!r}')
+    if isinstance(value, str) and not re.fullmatch(r'LV_[A-Z0-9_]+', value):
+        raise ScreenError(f'{prop}: enum values must be LV_* constants, got {value!r}')
+    return str(value)
+
+
+def expand_style(name, styles, bundle_fonts=(), chain=()):
+    """Resolve a style to an ordered {property: C value} dict.
+
+    "extends" names one or more base styles whose properties are copied first
+    and may be overridden, so shared values are written once in the JSON but
+    every object still needs only one style table at runtime.
+    """
+    if name in chain:
+        raise ScreenError(f'style {name}: circular "extends"')
+    if name not in styles:
+        raise ScreenError(f'unknown style {name!r}')
+    props = dict(styles[name])
+    bases = props.pop('extends', [])
+    out = {}
+    for base in [bases] if isinstance(bases, str) else bases:
+        out.update(expand_style(base, styles, bundle_fonts, chain + (name,)))
+    own = set()
+    for prop, value in props.items():
+        for p in SHORTHANDS.get(prop, (prop,)):
+            if not IDENT.match(p):
+                raise ScreenError(f'style {name}: bad property {p!r}')
+            if p in own:
+                raise ScreenError(f'style {name}: property {p} set twice')
+            own.add(p)
+            out.pop(p, None)
+            out[p] = style_value(p, value, bundle_fonts)
+    return out
+
+
+def style_ref(ref):
+    sname, _, state = ref.partition(':')
+    if state and state not in STATES:
+        raise ScreenError(f'unknown state {state!r} in style reference {ref!r}')
+    return sname, STATES.get(state, '0')
+
+
+def c_string(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+def load(path):
+    with open(path, encoding='utf-8') as f:
+        desc = json.load(f)
+
+    name = desc.get('name', '')
+    if not IDENT.match(name):
+        raise ScreenError(f'bad screen name {name!r}')
+
+    styles = desc.get('styles', {})
+    for sname in styles:
+        if not IDENT.match(sname):
+            raise ScreenError(f'bad style name {sname!r}')
+    for font in desc.get('bundle_fonts', []):
+        if not IDENT.match(font):
+            raise ScreenError(f'bundle_fonts: bad font name {font!r}')
+
+    root = desc['root']
+    root_w, root_h = root['w'], root['h']
+
+    ids = ['root']
+    nodes = []
+    for obj in desc['objects']:
+        oid = obj.get('id', '')
+        if not IDENT.match(oid) or oid in ids:
+            raise ScreenError(f'bad or duplicate object id {oid!r}')
+        if obj.get('type') not in NODE_TYPES:
+            raise ScreenError(f'{oid}: unknown type {obj.get("type")!r}')
+        parent = obj.get('parent', 'root')
+        if parent not in ids:
+            raise ScreenError(f'{oid}: parent {parent!r} must be declared before it')
+        for ref in obj.get('styles', []):
+            if style_ref(ref)[0] not in styles:
+                raise ScreenError(f'{oid}: unknown style {ref!r}')
+        if len(obj.get('styles', [])) > MAX_STYLES:
+            raise ScreenError(f'{oid}: at most {MAX_STYLES} styles per object')
+        for fl in obj.get('flags', []):
+            if fl not in FLAGS:
+                raise ScreenError(f'{oid}: unknown flag {fl!r}')
+        x, y = obj.get('x', 0), obj.get('y', 0)
+        if parent == 'root' and 'center' not in obj.get('flags', []):
+            if not (0 <= x < root_w and 0 <= y < root_h):
+                raise ScreenError(f'{oid}: position ({x},{y}) outside the root')
+        ids.append(oid)
+        nodes.append(dict(obj, parent=parent))
+
+    return desc, name, styles, ids, nodes
+
+
+def generate(desc, name, styles, ids, nodes, src_name):
+    upper = name.upper()
+    enum_names = [f'{upper}_{i.upper()}' for i in ids]
+    style_syms = {s: f'{name}_style_{s}' for s in styles}
+    root = desc['root']
+    # Only referenced styles are emitted; pure "extends" bases cost no flash
+    used = []
+    for ref in root.get('styles', []) + [r for n in nodes for r in n.get('styles', [])]:
+        sname = style_ref(ref)[0]
+        if sname not in used:
+            used.append(sname)
+
+    # Fonts outside LVGL (e.g. the subsets from gen_font_subset.py) need a declaration;
+    # bundle fonts are looked up by name instead, in the style's text_font property
+    bundle_fonts = desc.get('bundle_fonts', [])
+    fonts = []
+    font_slots = []
+    for s in used:
+        font = expand_style(s, styles).get('text_font', 'NULL').lstrip('&')
+        if font in bundle_fonts:
+            index = list(expand_style(s, styles, bundle_fonts)).index('text_font')
+            font_slots.append((font, s, index))
+        elif font != 'NULL' and not font.startswith('lv_font_') and font not in fonts:
+            fonts.append(font)
+    patched = {s for _, s, _ in font_slots}
+
+    h = []
+    h.append(f'// 由tools/gen_screen.py根据{src_name}生成，请勿手动修改')
+    h.append('#pragma once')
+    h.append('#include "lvgl.h"')
+    h.append('')
+    for f in fonts:
+        h.append(f'LV_FONT_DECLARE({f})')
+    if fonts:
+        h.append('')
+    h.append('typedef enum {')
+    for e in enum_names:
+        h.append(f'    {e},')
+    h.append(f'    {upper}_OBJ_MAX')
+    h.append(f'}} {name}_obj_t;')
+    h.append('')
+    for s in used:
+        h.append(f'extern const lv_style_t {style_syms[s]};')
+    h.append('')
+    h.append(f'// 在parent下创建界面，objs按{name}_obj_t返回全部对象；')
+    h.append('// 资源包中的字体由load_font按名称获取（例如asset_bundle_get_font），为NULL或返回NULL时使用LV_FONT_DEFAULT')
+    h.append(f'lv_obj_t *{name}_create(lv_obj_t *parent, lv_obj_t *objs[{upper}_OBJ_MAX],')
+    h.append(f'{" " * len(f"lv_obj_t *{name}_create(")}const lv_font_t *(*load_font)(const char *name));')
+    h.append('')
+
+    c = []
+    c.append(f'// 由tools/gen_screen.py根据{src_name}生成，请勿手动修改')
+    c.append(f'#include "{name}.h"')
+    c.append('')
+    c.append('// ==================== styles ====================')
+    for s in used:
+        # Tables with a bundle font are in RAM so that create() can set the font
+        qual = '' if s in patched else 'const '
+        c.append(f'static {qual}lv_style_const_prop_t {s}_props[] = {{')
+        for p, v in expand_style(s, styles, bundle_fonts).items():
+            c.append(f'    LV_STYLE_CONST_{p.upper()}({v}),')
+        c.append('};')
+        c.append(f'LV_STYLE_CONST_INIT({style_syms[s]}, {s}_props);')
+        c.append('')
+
+    c.append('// ==================== objects ====================')
+    c.append('typedef enum { ' + ', '.join(t for t, _ in NODE_TYPES.values()) + ' } node_type_t;')
+    c.append('')
+    for i, fl in enumerate(FLAGS.values()):
+        c.append(f'#define {fl:<24} 0x{1 << i:02X}')
+    c.append('')
+    c.append('typedef struct {')
+    c.append('    uint8_t type;')
+    c.append('    uint8_t parent;')
+    c.append('    uint8_t flags;')
+    c.append('    lv_coord_t x, y, w, h;             // w/h为0时使用样式或内容尺寸')
+    c.append('    struct {')
+    c.append('        const lv_style_t *style;')
+    c.append('        lv_style_selector_t selector;')
+    c.append(f'    }} styles[{MAX_STYLES}];')
+    c.append('    const char *text;')
+    c.append('} screen_node_t;')
+    c.append('')
+    if font_slots:
+        c.append('// 资源包中的字体：create时按名称获取后写入样式表的text_font')
+        c.append('static const struct {')
+        c.append('    const char *name;')
+        c.append('    lv_style_const_prop_t *prop;')
+        c.append(f'}} {name}_bundle_fonts[] = {{')
+        for font, s, index in font_slots:
+            c.append(f'    {{ {c_string(font)}, &{s}_props[{index}] }},')
+        c.append('};')
+        c.append('')
+    c.append(f'static const screen_node_t {name}_nodes[] = {{')
+    for i, n in enumerate(nodes):
+        flags = ' | '.join(FLAGS[f] for f in n.get('flags', [])) or '0'
+        st = []
+        for ref in n.get('styles', []):
+            sname, sel = style_ref(ref)
+            st.append(f'{{ &{style_syms[sname]}, {sel} }}')
+        text = c_string(n['text']) if 'text' in n else 'NULL'
+        c.append(f'    [{enum_names[i + 1]} - 1] = {{ {NODE_TYPES[n["type"]][0]}, '
+                 f'{enum_names[ids.index(n["parent"])]}, {flags}, '
+                 f'{n.get("x", 0)}, {n.get("y", 0)}, {n.get("w", 0)}, {n.get("h", 0)}, '
+                 f'{{ {", ".join(st) or "{ NULL, 0 }"} }}, {text} }},')
+    c.append('};')
+    c.append('')
+
+    root_styles = root.get('styles', [])
+    c.append(f'lv_obj_t *{name}_create(lv_obj_t *parent, lv_obj_t *objs[{upper}_OBJ_MAX],')
+    c.append(f'{" " * len(f"lv_obj_t *{name}_create(")}const lv_font_t *(*load_font)(const char *name))')
+    c.append('{')
+    if font_slots:
+        c.append(f'    for (uint32_t i = 0; i < sizeof({name}_bundle_fonts) / sizeof({name}_bundle_fonts[0]); i++) {{')
+        c.append(f'        const lv_font_t *font = load_font ? load_font({name}_bundle_fonts[i].name) : NULL;')
+        c.append(f'        {name}_bundle_fonts[i].prop->value.ptr = font ? font : LV_FONT_DEFAULT;')
+        c.append('    }')
+    else:
+        c.append('    LV_UNUSED(load_font);')
+    c.append('    lv_obj_t *root = lv_obj_create(parent);')
+    c.append('    lv_obj_clear_flag(root, LV_OBJ_FLAG_SCROLLABLE);')
+    c.append('    // 旋转前的尺寸超出父对象，设为浮动对象，不计入父对象的滚动范围')
+    c.append('    lv_obj_add_flag(root, LV_OBJ_FLAG_FLOATING);')
+    c.append(f'    lv_obj_set_size(root, {root["w"]}, {root["h"]});')
+    for ref in root_styles:
+        sname, sel = style_ref(ref)
+        c.append(f'    lv_obj_add_style(root, (lv_style_t *)&{style_syms[sname]}, {sel});')
+    c.append('    lv_obj_center(root);')
+    c.append(f'    objs[{enum_names[0]}] = root;')
+    c.append('')
+    c.append(f'    for (uint32_t i = 0; i < sizeof({name}_nodes) / sizeof({name}_nodes[0]); i++) {{')
+    c.append(f'        const screen_node_t *n = &{name}_nodes[i];')
+    c.append('        lv_obj_t *p = objs[n->parent];')
+    c.append('        lv_obj_t *o;')
+    c.append('        switch (n->type) {')
+    for t, fn in NODE_TYPES.values():
+        c.append(f'            case {t}: o = {fn}(p); break;')
+    c.append('            default: o = lv_obj_create(p); break;')
+    c.append('        }')
+    c.append('        if (n->flags & NODE_FLAG_NO_SCROLL) lv_obj_clear_flag(o, LV_OBJ_FLAG_SCROLLABLE);')
+    c.append('        if (n->flags & NODE_FLAG_HIDDEN) lv_obj_add_flag(o, LV_OBJ_FLAG_HIDDEN);')
+    c.append('        // 去掉主题的默认状态样式，外观完全由常量样式给出，切换状态时也不会启动主题的过渡动画')
+    c.append('        if (n->flags & NODE_FLAG_NO_THEME) lv_obj_remove_style(o, NULL, LV_PART_MAIN | LV_STATE_DEFAULT);')
+    c.append(f'        for (int s = 0; s < {MAX_STYLES} && n->styles[s].style; s++) {{')
+    c.append('            lv_obj_add_style(o, (lv_style_t *)n->styles[s].style, n->styles[s].selector);')
+    c.append('        }')
+    c.append('        if (n->w) lv_obj_set_width(o, n->w);')
+    c.append('        if (n->h) lv_obj_set_height(o, n->h);')
+    c.append('        if (n->flags & NODE_FLAG_CENTER) lv_obj_center(o);')
+    c.append('        else lv_obj_set_pos(o, n->x, n->y);')
+    c.append('        if (n->type == NODE_LABEL) {')
+    c.append('            if (n->flags & NODE_FLAG_LONG_CLIP) lv_label_set_long_mode(o, LV_LABEL_LONG_CLIP);')
+    c.append('            // 常量文本不占LVGL堆，之后lv_label_set_text时再分配')
+    c.append('            if (n->text) lv_label_set_text_static(o, n->text);')
+    c.append('        } else if (n->type == NODE_TEXTAREA) {')
+    c.append('            if (n->flags & NODE_FLAG_ONE_LINE) lv_textarea_set_one_line(o, true);')
+    c.append('            if (n->text) lv_textarea_set_text(o, n->text);')
+    c.append('        }')
+    c.append('        objs[i + 1] = o;')
+    c.append('    }')
+    c.append('    return root;')
+    c.append('}')
+    c.append('')
+    return '\n'.join(h), '\n'.join(c)
+
+
+def write(path, text):
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write(text)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('json', help='screen description')
+    ap.add_argument('outdir', help='directory for the generated .c/.h')
+    args = ap.parse_args()
+
+    try:
+        desc, name, styles, ids, nodes = load(args.json)
+        header, source = generate(desc, name, styles, ids, nodes, os.path.basename(args.json))
+    except (ScreenError, KeyError, ValueError) as e:
+        sys.exit(f'{args.json}: {e}')
+
+    os.makedirs(args.outdir, exist_ok=True)
+    write(os.path.join(args.outdir, f'{name}.h'), header)
+    write(os.path.join(args.outdir, f'{name}.c'), source)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,719 @@
+#!/usr/bin/env python3
+"""Emulate a GRBL 1.1 controller on a pseudo-terminal.
+
+Attach it to the GRBL UART of the host simulation (host/, --uart-link), or
+let it create a PTY of its own for any other sender:
+
+    build-sim/pendant_sim --uart-link /tmp/grbl &
+    python tools/grbl_sim.py /tmp/grbl
+    python tools/grbl_sim.py --link /tmp/grbl-pty     # PTY for a sender
+
+What is modelled, after grbl 1.1h:
+
+- The 128 byte serial RX ring (127 bytes usable, Bf reports 128 when empty).
+  Bytes arriving when it is full are dropped, as grbl does. Senders keep it
+  from overflowing by counting characters: every line is answered with
+  exactly one ok or error:N once it has been executed, and a motion line is
+  executed when it fits into the planner.
+- Realtime bytes, taken out of the stream on arrival: ? status report,
+  ~ cycle start, ! feed hold (cancels a jog), 0x18 soft reset (ALARM:3 when
+  it interrupts motion), 0x85 jog cancel, 0x90-0x9D feed, rapid and spindle
+  overrides.
+- $J= jogging and G0/G1 moves through a 16 block planner (15 usable) with
+  per axis rates ($110-$113) and accelerations ($120-$123), junction
+  deviation ($11) and a look-ahead pass that plans every block to end at
+  standstill. Feed holds and jog cancels decelerate along the planned path.
+  Jogs ignore the feed override, as in grbl.
+- Status reports <State|MPos|Bf|FS|WCO|Ov> with grbl's WCO/Ov refresh
+  counters, on ? and, with --report-ms, periodically as if a sender were
+  polling. The pendant parses both MPos and WPos with four axes, so by
+  default both are reported for XYZA (--position grbl follows $10 instead).
+- $$, $#, $G, $I, $X, $N=value, G10 L2/L20, G20/G21, G90/G91, G53, G54.
+
+The emulator writes to the PTY at once and leaves the baud rate to the other
+end (the host simulation paces both directions); --baud only sets the wire
+model used to timestamp when each report has been delivered.
+
+GrblSim is also used by tools/jog_bench.py, which reads its statistics.
+"""
+
+import argparse
+import math
+import os
+import select
+import signal
+import sys
+import time
+import tty
+from collections import deque
+
+VERSION = '1.1h'
+RX_BUFFER_SIZE = 128
+BLOCK_BUFFER_SIZE = 16
+LINE_BUFFER_SIZE = 80
+
+REPORT_WCO_REFRESH_BUSY_COUNT = 30
+REPORT_WCO_REFRESH_IDLE_COUNT = 10
+REPORT_OVR_REFRESH_BUSY_COUNT = 20
+REPORT_OVR_REFRESH_IDLE_COUNT = 10
+
+CMD_RESET = 0x18
+CMD_STATUS_REPORT = ord('?')
+CMD_CYCLE_START = ord('~')
+CMD_FEED_HOLD = ord('!')
+CMD_JOG_CANCEL = 0x85
+CMD_FEED_OVR_RESET = 0x90
+CMD_RAPID_OVR_RESET = 0x95
+CMD_SPINDLE_OVR_RESET = 0x99
+
+STATUS_EXPECTED_COMMAND_LETTER = 1
+STATUS_BAD_NUMBER_FORMAT = 2
+STATUS_INVALID_STATEMENT = 3
+STATUS_NEGATIVE_VALUE = 4
+STATUS_SETTING_DISABLED = 5
+STATUS_IDLE_ERROR = 8
+STATUS_SYSTEM_GC_LOCK = 9
+STATUS_OVERFLOW = 11
+STATUS_INVALID_JOG_COMMAND = 16
+STATUS_GCODE_UNSUPPORTED_COMMAND = 20
+STATUS_GCODE_MODAL_GROUP_VIOLATION = 21
+STATUS_GCODE_UNDEFINED_FEED_RATE = 22
+STATUS_GCODE_NO_AXIS_WORDS = 26
+
+ALARM_ABORT_CYCLE = 3
+
+AXES = 'XYZA'
+MM_PER_INCH = 25.4
+
+# Defaults closer to a small router than to grbl's defaults.h
+DEFAULT_SETTINGS = {
+    10: 1,                                          # status report mask
+    11: 0.010,                                      # junction deviation, mm
+    12: 0.002,                                      # arc tolerance, mm
+    110: 5000.0, 111: 5000.0, 112: 2000.0, 113: 5000.0,    # max rate, mm/min
+    120: 300.0, 121: 300.0, 122: 150.0, 123: 300.0,        # acceleration, mm/s^2
+    130: 500.0, 131: 500.0, 132: 100.0, 133: 360.0,        # max travel, mm
+}
+
+STATE_IDLE, STATE_RUN, STATE_HOLD, STATE_JOG, STATE_ALARM = 'Idle', 'Run', 'Hold', 'Jog', 'Alarm'
+
+
+class Block:
+    """A straight move in the planner, distances in mm and speeds in mm/s"""
+
+    def __init__(self, start, target, nominal, accel, jog, rapid):
+        self.start = start
+        self.target = target
+        delta = [t - s for s, t in zip(start, target)]
+        self.length = math.sqrt(sum(d * d for d in delta))
+        self.unit = [d / self.length for d in delta]
+        self.nominal = nominal
+        self.accel = accel
+        self.jog = jog
+        self.rapid = rapid
+        self.max_entry = 0.0
+        self.entry = 0.0
+        self.done = 0.0
+
+    def position(self):
+        return [s + u * self.done for s, u in zip(self.start, self.unit)]
+
+
+class GrblSim:
+    """The controller. Feed it received bytes and call update() often"""
+
+    def __init__(self, axes=4, settings=None, report_ms=0, position='both', baud=115200):
+        self.axes = axes
+        self.settings = dict(DEFAULT_SETTINGS)
+        self.settings.update(settings or {})
+        self.report_period = report_ms / 1000.0
+        self.position_mode = position
+        self.char_time = 10.0 / baud
+        self.out = bytearray()
+        self.tx_done = 0.0
+        self.now = time.monotonic()
+        self.mpos = [0.0] * axes
+        self.wco = [0.0] * axes
+        self.stats = {
+            'rx_bytes': 0, 'rx_dropped': 0, 'rx_high_water': 0, 'planner_high_water': 0,
+            'lines': 0, 'jogs': 0, 'oks': 0, 'errors': {}, 'realtime': {}, 'traveled': 0.0,
+        }
+        self.reports = []       # (sample time, delivery time, mpos) of every status report
+        self.on_state = None    # callback(state, now) on state changes
+        self._hard_reset()
+        self._send('\r\nGrbl %s [\'$\' for help]\r\n' % VERSION)
+
+    # ==================== Reset ====================
+    def _hard_reset(self):
+        self.rx = deque()
+        self.line = bytearray()
+        self.line_overflow = False
+        self.comment = None         # '(' or ';' while skipping a comment
+        self.waiting = None         # motion line waiting for planner space
+        self.blocks = deque()
+        self.v = 0.0
+        self.hold = False
+        self.jog_cancel = False
+        self.state = STATE_IDLE
+        self.modal = {'units': 21, 'distance': 90, 'motion': 0, 'feed': 0.0}
+        self.plan_pos = list(self.mpos)
+        self.feed_ovr = self.rapid_ovr = self.spindle_ovr = 100
+        self.wco_counter = 0
+        self.ovr_counter = 0
+        self.next_report = self.now + self.report_period if self.report_period else None
+
+    def _soft_reset(self):
+        moving = bool(self.blocks) and self.state in (STATE_RUN, STATE_JOG, STATE_HOLD) and self.v > 0
+        alarm = self.state == STATE_ALARM or moving
+        if moving:
+            self._send('ALARM:%d\r\n' % ALARM_ABORT_CYCLE)
+        self._hard_reset()
+        self._send('\r\nGrbl %s [\'$\' for help]\r\n' % VERSION)
+        if alarm:
+            self._set_state(STATE_ALARM)
+            self._send("[MSG:'$H'|'$X' to unlock]\r\n")
+
+    def _set_state(self, state):
+        if state != self.state:
+            self.state = state
+            if self.on_state:
+                self.on_state(state, self.now)
+
+    # ==================== Serial ====================
+    def receive(self, data, now):
+        """Bytes from the sender: realtime commands act at once, the rest goes to the RX ring"""
+        self._advance(now)
+        self.stats['rx_bytes'] += len(data)
+        for b in data:
+            if b == CMD_STATUS_REPORT:
+                self._count_realtime('?')
+                self._status_report()
+            elif b == CMD_CYCLE_START:
+                self._count_realtime('~')
+                self._cycle_start()
+            elif b == CMD_FEED_HOLD:
+                self._count_realtime('!')
+                self._feed_hold()
+            elif b == CMD_RESET:
+                self._count_realtime('reset')
+                self._soft_reset()
+            elif b == CMD_JOG_CANCEL:
+                self._count_realtime('jog_cancel')
+                if self.state == STATE_JOG:
+                    self._feed_hold()
+            elif b >= 0x80:
+                self._count_realtime('0x%02X' % b)
+                self._override(b)
+            elif len(self.rx) < RX_BUFFER_SIZE - 1:
+                self.rx.append(b)
+                self.stats['rx_high_water'] = max(self.stats['rx_high_water'], len(self.rx))
+            else:
+                self.stats['rx_dropped'] += 1
+
+    def _count_realtime(self, name):
+        self.stats['realtime'][name] = self.stats['realtime'].get(name, 0) + 1
+
+    def _send(self, text):
+        data = text.encode('ascii')
+        self.out += data
+        self.tx_done = max(self.now, self.tx_done) + len(data) * self.char_time
+        return self.tx_done
+
+    def _ok(self):
+        self.stats['oks'] += 1
+        self._send('ok\r\n')
+
+    def _error(self, code):
+        self.stats['errors'][code] = self.stats['errors'].get(code, 0) + 1
+        self._send('error:%d\r\n' % code)
+
+    # ==================== Realtime commands ====================
+    def _feed_hold(self):
+        if self.state in (STATE_RUN, STATE_JOG) and not self.hold:
+            self.hold = True
+            self.jog_cancel = self.state == STATE_JOG
+            if self.state == STATE_RUN:
+                self._set_state(STATE_HOLD)
+
+    def _cycle_start(self):
+        if self.state == STATE_HOLD and self.v == 0:
+            self.hold = False
+            self._set_state(STATE_RUN if self.blocks else STATE_IDLE)
+
+    def _override(self, b):
+        def clamp(v, lo, hi):
+            return max(lo, min(hi, v))
+        if CMD_FEED_OVR_RESET <= b <= CMD_FEED_OVR_RESET + 4:
+            step = {0: None, 1: 10, 2: -10, 3: 1, 4: -1}[b - CMD_FEED_OVR_RESET]
+            self.feed_ovr = 100 if step is None else clamp(self.feed_ovr + step, 10, 200)
+        elif CMD_RAPID_OVR_RESET <= b <= CMD_RAPID_OVR_RESET + 2:
+            self.rapid_ovr = (100, 50, 25)[b - CMD_RAPID_OVR_RESET]
+        elif CMD_SPINDLE_OVR_RESET <= b <= CMD_SPINDLE_OVR_RESET + 4:
+            step = {0: None, 1: 10, 2: -10, 3: 1, 4: -1}[b - CMD_SPINDLE_OVR_RESET]
+            self.spindle_ovr = 100 if step is None else clamp(self.spindle_ovr + step, 10, 200)
+        else:
+            return
+        self.ovr_counter = 0    # report the new values with the next status
+
+    # ==================== Status report ====================
+    def _status_report(self):
+        state = self.state
+        if state == STATE_HOLD:
+            state = 'Hold:1' if self.v > 0 else 'Hold:0'
+        mpos = self.mpos
+        wpos = [m - w for m, w in zip(mpos, self.wco)]
+        fmt = lambda p: ','.join('%.3f' % v for v in p)
+        mask = int(self.settings[10])
+        fields = [state]
+        if self.position_mode == 'both':
+            fields += ['MPos:' + fmt(mpos), 'WPos:' + fmt(wpos)]
+        elif self.position_mode == 'wpos' or (self.position_mode == 'grbl' and not mask & 1):
+            fields.append('WPos:' + fmt(wpos))
+        else:
+            fields.append('MPos:' + fmt(mpos))
+        if self.position_mode != 'grbl' or mask & 2:
+            fields.append('Bf:%d,%d' % (BLOCK_BUFFER_SIZE - 1 - len(self.blocks),
+                                        RX_BUFFER_SIZE - len(self.rx)))
+        fields.append('FS:%d,0' % round(self.v * 60))
+        busy = self.state in (STATE_RUN, STATE_HOLD, STATE_JOG)
+        if self.wco_counter > 0:
+            self.wco_counter -= 1
+        else:
+            self.wco_counter = (REPORT_WCO_REFRESH_BUSY_COUNT if busy else REPORT_WCO_REFRESH_IDLE_COUNT) - 1
+            fields.append('WCO:' + fmt(self.wco))
+        if self.ovr_counter > 0:
+            self.ovr_counter -= 1
+        else:
+            self.ovr_counter = (REPORT_OVR_REFRESH_BUSY_COUNT if busy else REPORT_OVR_REFRESH_IDLE_COUNT) - 1
+            if self.wco_counter == 0:
+                self.wco_counter = 1
+            fields.append('Ov:%d,%d,%d' % (self.feed_ovr, self.rapid_ovr, self.spindle_ovr))
+        done = self._send('<%s>\r\n' % '|'.join(fields))
+        self.reports.append((self.now, done, list(mpos)))
+
+    # ==================== Protocol ====================
+    def update(self, now):
+        """Run the motion up to now, execute buffered lines and send due reports"""
+        self._advance(now)
+        self._protocol()
+        if self.next_report is not None and now >= self.next_report:
+            self._status_report()
+            self.next_report = max(self.next_report + self.report_period, now)
+
+    def _advance(self, now):
+        dt = now - self.now
+        self.now = now
+        if dt > 0:
+            self._move(dt)
+
+    def _protocol(self):
+        while True:
+            if self.waiting is not None:
+                if not self._plan(*self.waiting):
+                    return
+                self.waiting = None
+                self._ok()
+            if not self.rx:
+                return
+            c = self.rx.popleft()
+            if c in (ord('\n'), ord('\r')):
+                line = self.line.decode('ascii', 'replace')
+                overflow = self.line_overflow
+                self.line = bytearray()
+                self.line_overflow = False
+                self.comment = None
+                if overflow:
+                    self._error(STATUS_OVERFLOW)
+                else:
+                    self._execute(line)
+            elif self.comment:
+                if self.comment == '(' and c == ord(')'):
+                    self.comment = None
+            elif c <= ord(' ') or c == 0x7F:
+                pass                            # whitespace and control characters
+            elif c in (ord('('), ord(';')):
+                self.comment = chr(c)
+            elif len(self.line) >= LINE_BUFFER_SIZE - 1:
+                self.line_overflow = True
+            else:
+                self.line.append(ord(chr(c).upper()))
+
+    def _execute(self, line):
+        self.stats['lines'] += 1
+        if not line:
+            self._ok()
+        elif line[0] == '$':
+            self._system_command(line)
+        elif self.state in (STATE_ALARM, STATE_JOG):
+            self._error(STATUS_SYSTEM_GC_LOCK)
+        else:
+            self._gcode(line, jog=False)
+
+    def _system_command(self, line):
+        if line.startswith('$J='):
+            if self.state == STATE_ALARM:
+                self._error(STATUS_SYSTEM_GC_LOCK)
+            elif self.state not in (STATE_IDLE, STATE_JOG):
+                self._error(STATUS_IDLE_ERROR)
+            else:
+                self.stats['jogs'] += 1
+                self._gcode(line[3:], jog=True)
+            return
+        if line == '$':
+            self._send('[HLP:$$ $# $G $I $N $x=val $Nx=line $J=line $SLP $C $X $H ~ ! ? ctrl-x]\r\n')
+        elif line == '$$':
+            for key in sorted(self.settings):
+                value = self.settings[key]
+                self._send('$%d=%s\r\n' % (key, ('%d' % value) if key == 10 else ('%.3f' % value)))
+        elif line == '$#':
+            fmt = lambda p: ','.join('%.3f' % v for v in p)
+            self._send('[G54:%s]\r\n[TLO:0.000]\r\n' % fmt(self.wco))
+        elif line == '$G':
+            self._send('[GC:G%d G54 G17 G%d G%d G94 M5 M9 T0 F%g S0]\r\n' % (
+                self.modal['motion'], self.modal['units'], self.modal['distance'], self.modal['feed']))
+        elif line == '$I':
+            self._send('[VER:%s.20190825:]\r\n[OPT:V,%d,%d]\r\n' % (VERSION, BLOCK_BUFFER_SIZE - 1, RX_BUFFER_SIZE))
+        elif line == '$X':
+            if self.state == STATE_ALARM:
+                self._send('[MSG:Caution: Unlocked]\r\n')
+                self._set_state(STATE_IDLE)
+        elif line == '$H':
+            self._error(STATUS_SETTING_DISABLED)
+            return
+        elif line[1:2].isdigit() and '=' in line:
+            key, _, value = line[1:].partition('=')
+            try:
+                key, value = int(key), float(value)
+            except ValueError:
+                self._error(STATUS_BAD_NUMBER_FORMAT)
+                return
+            if key not in self.settings:
+                self._error(STATUS_INVALID_STATEMENT)
+                return
+            if value < 0:
+                self._error(STATUS_NEGATIVE_VALUE)
+                return
+            self.settings[key] = value
+        else:
+            self._error(STATUS_INVALID_STATEMENT)
+            return
+        self._ok()
+
+    @staticmethod
+    def _words(line):
+        """Split a block into (letter, value) pairs, or return a status code"""
+        words = []
+        i = 0
+        while i < len(line):
+            letter = line[i]
+            if not letter.isalpha():
+                return STATUS_EXPECTED_COMMAND_LETTER
+            j = i + 1
+            while j < len(line) and (line[j].isdigit() or line[j] in '.-+'):
+                j += 1
+            try:
+                words.append((letter, float(line[i + 1:j])))
+            except ValueError:
+                return STATUS_BAD_NUMBER_FORMAT
+            i = j
+        return words
+
+    def _gcode(self, line, jog):
+        words = self._words(line)
+        if isinstance(words, int):
+            self._error(words)
+            return
+        modal = dict(self.modal)
+        if jog:
+            modal['distance'] = 90          # jog blocks start from G90, modal state is not kept
+        target_words = {}
+        feed = None
+        machine = False
+        g10 = None
+        params = {}
+        for letter, value in words:
+            if letter == 'G':
+                g = int(value) if value == int(value) else value
+                if g in (0, 1) and not jog:
+                    modal['motion'] = g
+                elif g in (20, 21):
+                    modal['units'] = g
+                elif g in (90, 91):
+                    modal['distance'] = g
+                elif g == 53:
+                    machine = True
+                elif g == 54 and not jog:
+                    pass
+                elif g == 10 and not jog:
+                    g10 = True
+                else:
+                    self._error(STATUS_INVALID_JOG_COMMAND if jog else STATUS_GCODE_UNSUPPORTED_COMMAND)
+                    return
+            elif letter in AXES[:self.axes]:
+                if letter in target_words:
+                    self._error(STATUS_GCODE_MODAL_GROUP_VIOLATION)
+                    return
+                target_words[letter] = value
+            elif letter == 'F':
+                feed = value
+            elif letter == 'N':
+                pass
+            elif letter in 'LP' and not jog:
+                params[letter] = value
+            else:
+                self._error(STATUS_INVALID_JOG_COMMAND if jog else STATUS_GCODE_UNSUPPORTED_COMMAND)
+                return
+        scale = MM_PER_INCH if modal['units'] == 20 else 1.0
+        if feed is not None:
+            if feed < 0:
+                self._error(STATUS_NEGATIVE_VALUE)
+                return
+            feed *= scale
+            if not jog:
+                modal['feed'] = feed
+
+        if g10:
+            if params.get('L') not in (2, 20) or params.get('P', 1) not in (0, 1):
+                self._error(STATUS_GCODE_UNSUPPORTED_COMMAND)
+                return
+            if not target_words:
+                self._error(STATUS_GCODE_NO_AXIS_WORDS)
+                return
+            for letter, value in target_words.items():
+                i = AXES.index(letter)
+                # L2 sets the G54 offset, L20 sets it so that the current position reads value
+                self.wco[i] = value * scale if params['L'] == 2 else self.plan_pos[i] - value * scale
+            self.wco_counter = 0
+            self.modal = modal
+            self._ok()
+            return
+
+        if jog:
+            if feed is None:
+                self._error(STATUS_GCODE_UNDEFINED_FEED_RATE)
+                return
+            if not target_words:
+                self._error(STATUS_GCODE_NO_AXIS_WORDS)
+                return
+        elif target_words and modal['motion'] == 1 and modal['feed'] <= 0:
+            self._error(STATUS_GCODE_UNDEFINED_FEED_RATE)
+            return
+        if not jog:
+            self.modal = modal
+
+        target = list(self.plan_pos)
+        for letter, value in target_words.items():
+            i = AXES.index(letter)
+            value *= scale
+            if modal['distance'] == 91:
+                target[i] += value
+            else:
+                target[i] = value + (0.0 if machine else self.wco[i])
+        if target == self.plan_pos:
+            self._ok()
+            return
+        rapid = not jog and modal['motion'] == 0
+        motion = (target, feed if jog else modal['feed'], jog, rapid)
+        if self._plan(*motion):
+            self._ok()
+        else:
+            self.waiting = motion
+
+    # ==================== Planner ====================
+    def _plan(self, target, feed, jog, rapid):
+        """Append a block, or return False while the planner is full"""
+        if len(self.blocks) >= BLOCK_BUFFER_SIZE - 1 or (self.hold and self.jog_cancel):
+            return False
+        block = Block(list(self.plan_pos), target, 0.0, 0.0, jog, rapid)
+        max_rate = float('inf')
+        accel = float('inf')
+        for i, u in enumerate(block.unit):
+            if abs(u) > 1e-9:
+                max_rate = min(max_rate, self.settings[110 + i] / 60.0 / abs(u))
+                accel = min(accel, self.settings[120 + i] / abs(u))
+        block.accel = accel
+        if rapid:
+            block.nominal = max_rate
+        else:
+            block.nominal = min(feed / 60.0, max_rate)
+        if self.blocks:
+            prev = self.blocks[-1]
+            cos_theta = -sum(a * b for a, b in zip(prev.unit, block.unit))
+            if cos_theta > 0.999999:
+                v_junction = 0.0                # reversal
+            elif cos_theta < -0.999999:
+                v_junction = float('inf')       # straight on
+            else:
+                sin_half = math.sqrt(0.5 * (1.0 - cos_theta))
+                v_junction = math.sqrt(min(prev.accel, accel) * self.settings[11] * sin_half / (1.0 - sin_half))
+            block.max_entry = min(v_junction, block.nominal, prev.nominal)
+        self.blocks.append(block)
+        self.plan_pos = list(target)
+        self.stats['planner_high_water'] = max(self.stats['planner_high_water'], len(self.blocks))
+        self._recalculate()
+        if self.state == STATE_IDLE:
+            self._set_state(STATE_JOG if jog else STATE_RUN)
+        return True
+
+    def _recalculate(self):
+        """Reverse pass: every block may only enter as fast as it can still stop by the end"""
+        next_entry = 0.0
+        for block in reversed(list(self.blocks)[1:]):
+            block.entry = min(block.max_entry, math.sqrt(next_entry ** 2 + 2 * block.accel * block.length))
+            next_entry = block.entry
+
+    def _nominal(self, block):
+        if block.jog:
+            return block.nominal
+        if block.rapid:
+            return block.nominal * self.rapid_ovr / 100.0
+        return block.nominal * self.feed_ovr / 100.0
+
+    def _move(self, dt):
+        while dt > 1e-9 and self.blocks:
+            block = self.blocks[0]
+            remaining = block.length - block.done
+            if self.hold:
+                v_new = max(self.v - block.accel * dt, 0.0)
+            else:
+                exit_v = self.blocks[1].entry if len(self.blocks) > 1 else 0.0
+                v_limit = min(self._nominal(block), math.sqrt(exit_v ** 2 + 2 * block.accel * remaining))
+                if self.v <= v_limit:
+                    v_new = min(self.v + block.accel * dt, v_limit)
+                else:
+                    v_new = max(self.v - block.accel * dt, v_limit)
+            ds = (self.v + v_new) / 2 * dt
+            if ds >= remaining and remaining > 0 or remaining <= 1e-9:
+                used = dt * remaining / ds if ds > 0 else 0.0
+                self.v += (v_new - self.v) * (used / dt)
+                self.stats['traveled'] += remaining
+                self.mpos = list(block.target)
+                self.blocks.popleft()
+                dt -= used
+                if self.blocks:
+                    self._recalculate()
+                else:
+                    self.v = 0.0
+                continue
+            block.done += ds
+            self.stats['traveled'] += ds
+            self.v = v_new
+            self.mpos = block.position()
+            dt = 0
+            if self.hold and self.v == 0.0:
+                break
+
+        if self.hold and self.v == 0.0:
+            if self.jog_cancel:
+                # Jog cancel: stop, then drop the rest of the jog from the planner
+                self.blocks.clear()
+                self.plan_pos = list(self.mpos)
+                self.hold = self.jog_cancel = False
+                if self.waiting is not None and self.waiting[2]:
+                    self.waiting = None
+                    self._ok()
+                self._set_state(STATE_IDLE)
+            elif not self.blocks:
+                self.hold = False
+                self._set_state(STATE_IDLE)
+        elif not self.blocks and self.waiting is None and self.state in (STATE_RUN, STATE_JOG):
+            self.v = 0.0
+            self._set_state(STATE_IDLE)
+
+
+# ==================== PTY ====================
+def open_port(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+    tty.setraw(fd)
+    return fd
+
+
+def open_pty(link):
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    os.set_blocking(master, False)
+    name = os.ttyname(slave)
+    if link:
+        if os.path.islink(link):
+            os.unlink(link)
+        os.symlink(name, link)
+    print('grbl_sim: listening on %s%s' % (name, ' -> ' + link if link else ''), file=sys.stderr)
+    return master, slave
+
+
+def serve(grbl, fd, stop=None, period=0.001):
+    """Move bytes between the port and the emulator until the other end closes or stop is set"""
+    while stop is None or not stop.is_set():
+        wfds = [fd] if grbl.out else []
+        readable, writable, _ = select.select([fd], wfds, [], period)
+        if readable:
+            try:
+                data = os.read(fd, 512)
+            except BlockingIOError:
+                data = None
+            except OSError:
+                return                          # EIO: the other end of the PTY was closed
+            if data == b'':
+                return
+            if data:
+                grbl.receive(data, time.monotonic())
+        grbl.update(time.monotonic())
+        if grbl.out:
+            try:
+                n = os.write(fd, grbl.out)
+                del grbl.out[:n]
+            except BlockingIOError:
+                pass
+            except OSError:
+                return
+
+
+def parse_settings(values):
+    settings = {}
+    for item in values:
+        key, _, value = item.lstrip('$').partition('=')
+        settings[int(key)] = float(value)
+    return settings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('port', nargs='?', help='serial device or PTY to attach to (default: create a PTY)')
+    parser.add_argument('--link', help='symlink to the created PTY')
+    parser.add_argument('--axes', type=int, choices=(3, 4), default=4, help='axes reported (default: 4, XYZA)')
+    parser.add_argument('--position', choices=('both', 'mpos', 'wpos', 'grbl'), default='both',
+                        help='position fields of the status report (grbl: as selected by $10)')
+    parser.add_argument('--report-ms', type=float, default=200,
+                        help='send a status report every N ms as a polling sender would (0: only on ?)')
+    parser.add_argument('--baud', type=int, default=115200, help='baud rate of the delivery time model')
+    parser.add_argument('--set', action='append', default=[], metavar='N=VALUE',
+                        help='override a $ setting, e.g. --set 110=3000 (repeatable)')
+    parser.add_argument('-v', '--verbose', action='store_true', help='log state changes and statistics')
+    args = parser.parse_args()
+
+    if args.port:
+        fd = open_port(args.port)
+    else:
+        fd, _slave = open_pty(args.link)
+    grbl = GrblSim(axes=args.axes, settings=parse_settings(args.set), report_ms=args.report_ms,
+                   position=args.position, baud=args.baud)
+    t0 = time.monotonic()
+    if args.verbose:
+        grbl.on_state = lambda state, now: print('%9.3f  %s  MPos:%s' % (
+            now - t0, state, ','.join('%.3f' % v for v in grbl.mpos)), file=sys.stderr)
+    signal.signal(signal.SIGTERM, lambda *_: sys.exit(0))
+    try:
+        serve(grbl, fd)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if args.link and not args.port and os.path.islink(args.link):
+            os.unlink(args.link)
+        if args.verbose:
+            print(grbl.stats, file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""Benchmark the jog pipeline: virtual handwheel -> pendant -> emulated GRBL.
+
+Runs the host simulation of the firmware (host/) once per wheel speed. A
+generated script selects the axis and multiplier and spins the wheel at a
+constant rate. The GRBL UART of the simulation is attached to
+grbl_sim.GrblSim, which plans and executes the $J commands:
+
+    cmake -S host -B build-sim && cmake --build build-sim -j
+    python tools/jog_bench.py build-sim/pendant_sim
+    python tools/jog_bench.py build-sim/pendant_sim --rate 10,25,50 --mult 5 --json bench.json
+
+Reported per run:
+
+    commands   $J lines grbl executed of those the pendant sent, per second
+               of wheel turning, and the bytes received. The pendant
+               streams without counting characters, so RX bytes grbl
+               dropped and error replies are listed too.
+    stop       time and distance the machine kept moving after the last
+               wheel click (wheel stop to motion stop).
+    lost       distance the wheel commanded (1 mm per click times the
+               multiplier) minus the distance moved.
+    latency    wheel count to the end of its $J on the wire, from the
+               simulation's own report.
+    staleness  age of the newest status report the pendant has received,
+               sampled every millisecond from the first click to motion
+               stop (percentiles).
+
+Runs are only comparable on the same machine; the simulation runs with
+real-time priorities when started as root (see host/CMakeLists.txt).
+"""
+
+import argparse
+import bisect
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import grbl_sim  # noqa: E402
+
+AXES = 'XYZA'
+BOOT_MS = 1000          # until the pendant's tasks are running
+SWITCH_MS = 300         # switch debounce (5 samples of 10 ms) with margin
+MM_PER_CLICK = 1.0      # main.c: 2 counts per click, times the multiplier
+PHASE_SWEEP_MS = 0.37   # added to the click period so clicks sweep the 20 ms encoder poll
+
+LATENCY_RE = re.compile(r'jog latency .*?(\d+) samples: p50 ([\d.]+) ms, p90 ([\d.]+) ms, '
+                        r'p99 ([\d.]+) ms, max ([\d.]+) ms')
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return float('nan')
+    return sorted_values[min(len(sorted_values) - 1, int(len(sorted_values) * p / 100))]
+
+
+def write_script(path, axis, mult, clicks, wheel_ms, settle_ms):
+    with open(path, 'w', encoding='ascii') as f:
+        f.write(f'wait {BOOT_MS}\n'
+                f'axis {axis}\n'
+                f'mult {mult:g}\n'
+                f'wait {SWITCH_MS}\n'
+                f'echo bench:wheel-start\n'
+                # the last click alone, so that wheel-stop is marked right after it
+                f'wheel {clicks - 1} {wheel_ms * (clicks - 1) / clicks:.1f}\n'
+                f'wheel 1\n'
+                f'echo bench:wheel-stop\n'
+                f'wait {settle_ms}\n'
+                f'echo bench:end\n'
+                f'quit\n')
+
+
+def run_once(args, rate):
+    clicks = max(1, round(rate * args.seconds))
+    wheel_ms = clicks * (1000.0 / rate + PHASE_SWEEP_MS)
+    axis_index = AXES.index(args.axis)
+    with tempfile.TemporaryDirectory(prefix='jog_bench') as tmp:
+        link = os.path.join(tmp, 'grbl')
+        script = os.path.join(tmp, 'bench.sim')
+        write_script(script, args.axis, args.mult, clicks, wheel_ms, args.settle_ms)
+        cmd = [os.path.abspath(args.sim), '--script', script, '--uart-link', link] + args.sim_arg
+        proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, cwd=tmp)
+
+        grbl = grbl_sim.GrblSim(axes=4, report_ms=args.report_ms,
+                                settings=grbl_sim.parse_settings(args.set))
+        marks = {}
+        output = []
+        states = []
+        grbl.on_state = lambda state, now: states.append((now, state))
+
+        def read_output():
+            for line in proc.stdout:
+                now = time.monotonic()
+                output.append(line)
+                if line.startswith('sim: bench:'):
+                    marks[line.strip()[len('sim: bench:'):]] = (now, grbl.stats['traveled'], list(grbl.mpos))
+        reader = threading.Thread(target=read_output, daemon=True)
+        reader.start()
+
+        deadline = time.monotonic() + 10
+        while not os.path.exists(link):
+            if proc.poll() is not None or time.monotonic() > deadline:
+                proc.kill()
+                reader.join()
+                sys.exit('jog_bench: the simulation did not open its UART:\n' + ''.join(output))
+            time.sleep(0.005)
+        fd = grbl_sim.open_port(link)
+        stop = threading.Event()
+        server = threading.Thread(target=grbl_sim.serve, args=(grbl, fd, stop), daemon=True)
+        server.start()
+        try:
+            proc.wait(timeout=(BOOT_MS + SWITCH_MS + wheel_ms + args.settle_ms) / 1000.0 + 30)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+            sys.exit('jog_bench: the simulation did not finish')
+        stop.set()
+        server.join()
+        reader.join()
+        os.close(fd)
+
+    if proc.returncode != 0 or not all(k in marks for k in ('wheel-start', 'wheel-stop', 'end')):
+        sys.exit('jog_bench: the simulation failed:\n' + ''.join(output[-20:]))
+    t_start, _, pos_start = marks['wheel-start']
+    t_stop, traveled_stop, _ = marks['wheel-stop']
+    t_end = marks['end'][0]
+    stats = grbl.stats
+    turning = t_stop - t_start
+
+    # Motion stop: the last transition to Idle, if the machine is idle by the end
+    idle = [t for t, s in states if s == grbl_sim.STATE_IDLE and t >= t_start]
+    stopped = grbl.state == grbl_sim.STATE_IDLE and idle
+    t_motion_stop = idle[-1] if stopped else t_end
+
+    # Staleness: age of the newest delivered report, every ms while moving
+    reports = [(d, s) for s, d, _ in grbl.reports]
+    delivered = [d for d, _ in reports]
+    ages = []
+    t = t_start
+    while t <= t_motion_stop:
+        i = bisect.bisect_right(delivered, t) - 1
+        if i >= 0:
+            ages.append((t - reports[i][1]) * 1000.0)
+        t += 0.001
+    ages.sort()
+
+    latency = None
+    for line in output:
+        m = LATENCY_RE.search(line)
+        if m:
+            latency = {'samples': int(m.group(1)), 'p50': float(m.group(2)), 'p90': float(m.group(3)),
+                       'p99': float(m.group(4)), 'max': float(m.group(5))}
+
+    commanded = clicks * MM_PER_CLICK * args.mult
+    moved = grbl.mpos[axis_index] - pos_start[axis_index]
+    return {
+        'rate': rate, 'clicks': clicks, 'mult': args.mult, 'axis': args.axis,
+        'jogs': stats['jogs'], 'jogs_per_s': stats['jogs'] / turning if turning > 0 else 0.0,
+        'rx_bytes_per_s': stats['rx_bytes'] / turning if turning > 0 else 0.0,
+        'rx_dropped': stats['rx_dropped'], 'rx_high_water': stats['rx_high_water'],
+        'planner_high_water': stats['planner_high_water'], 'errors': stats['errors'],
+        'stopped': bool(stopped), 'stop_ms': (t_motion_stop - t_stop) * 1000.0,
+        'stop_mm': stats['traveled'] - traveled_stop,
+        'commanded_mm': commanded, 'moved_mm': moved, 'lost_mm': commanded - moved,
+        'latency_ms': latency,
+        'staleness_ms': {'p50': percentile(ages, 50), 'p90': percentile(ages, 90),
+                         'p99': percentile(ages, 99), 'max': ages[-1] if ages else float('nan')},
+    }
+
+
+def print_run(r):
+    errors = ', '.join(f'error:{k} x{v}' for k, v in sorted(r['errors'].items())) or 'no errors'
+    print(f"wheel {r['rate']:g} clicks/s, {r['clicks']} clicks x{r['mult']:g} on {r['axis']}")
+    lat = r['latency_ms']
+    sent = f" of {lat['samples']} sent" if lat else ''
+    print(f"  commands   {r['jogs']} $J executed{sent}, {r['jogs_per_s']:.1f}/s, {r['rx_bytes_per_s']:.0f} B/s; "
+          f"RX dropped {r['rx_dropped']} B (high water {r['rx_high_water']}/127), "
+          f"planner high water {r['planner_high_water']}/15, {errors}")
+    still = '' if r['stopped'] else ' (still moving at the end, raise --settle-ms)'
+    print(f"  stop       {r['stop_ms']:.0f} ms, {r['stop_mm']:.3f} mm after the last click{still}")
+    print(f"  lost       {r['lost_mm']:.3f} mm of {r['commanded_mm']:.3f} mm commanded")
+    if lat:
+        print(f"  latency    p50 {lat['p50']:.2f}  p90 {lat['p90']:.2f}  p99 {lat['p99']:.2f}  "
+              f"max {lat['max']:.2f} ms ({lat['samples']} samples)")
+    st = r['staleness_ms']
+    print(f"  staleness  p50 {st['p50']:.1f}  p90 {st['p90']:.1f}  p99 {st['p99']:.1f}  max {st['max']:.1f} ms")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('sim', help='pendant_sim built from host/')
+    parser.add_argument('--rate', default='5,20,50', help='wheel speeds in clicks/s, comma separated')
+    parser.add_argument('--seconds', type=float, default=2.0, help='how long the wheel turns')
+    parser.add_argument('--mult', type=float, choices=(0.1, 1, 5), default=1, help='right switch position')
+    parser.add_argument('--axis', choices=tuple(AXES), default='X', help='left switch position')
+    parser.add_argument('--settle-ms', type=int, default=8000,
+                        help='time left for the machine to stop after the wheel')
+    parser.add_argument('--report-ms', type=float, default=200,
+                        help='status report period (a sender polling ?)')
+    parser.add_argument('--set', action='append', default=[], metavar='N=VALUE',
+                        help='grbl $ setting, e.g. --set 110=3000 (repeatable)')
+    parser.add_argument('--sim-arg', action='append', default=[], help='extra argument for pendant_sim')
+    parser.add_argument('--json', metavar='FILE', help='also write the results as JSON')
+    args = parser.parse_args()
+
+    results = []
+    for rate in (float(r) for r in args.rate.split(',')):
+        result = run_once(args, rate)
+        print_run(result)
+        results.append(result)
+    if args.json:
+        with open(args.json, 'w', encoding='utf-8') as f:
+            json.dump(results, f, indent=1)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
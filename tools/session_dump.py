@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Decode an input/serial session recorded by CONFIG_PENDANT_RECORDER.
+
+Read the session partition back from the pendant and decode the newest
+session (or --slot) to text or JSON:
+
+    parttool.py -p /dev/ttyACM0 read_partition --partition-name session --output session.bin
+    python tools/session_dump.py session.bin
+    python tools/session_dump.py session.bin --json session.json
+
+The format is described in main/Recorder/Session_Log.h: the partition holds
+two slots, each a 16 byte header (magic "SES1", seq, build id) followed by
+CRC32-checked chunks of records. A record is a type byte, the microseconds
+since the previous record (LEB128) and a payload.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import zlib
+
+SESSION_MAGIC = 0x31534553
+CHUNK_ALIGN = 4
+ERASE_SIZE = 4096
+RX_MAX = 128
+
+REC_ENCODER, REC_SWITCH, REC_BUTTON, REC_UART_RX, REC_GAP = range(1, 6)
+BUTTONS = {0: 'func', 1: 'estop'}
+
+
+class SessionError(Exception):
+    pass
+
+
+def _varint(data, pos):
+    value = shift = 0
+    while True:
+        if pos >= len(data) or shift >= 64:
+            raise SessionError('truncated varint')
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, pos
+
+
+def decode_records(data, prev_us=0):
+    """Yield (time_us, type name, value) for every record of one chunk"""
+    pos = 0
+    while pos < len(data):
+        kind = data[pos]
+        dt, pos = _varint(data, pos + 1)
+        prev_us += dt
+        if kind == REC_ENCODER:
+            v, pos = _varint(data, pos)
+            yield prev_us, 'encoder', (v >> 1) ^ -(v & 1)
+        elif kind in (REC_SWITCH, REC_BUTTON):
+            if pos + 2 > len(data):
+                raise SessionError('truncated record')
+            a, b = data[pos], data[pos + 1]
+            pos += 2
+            if kind == REC_SWITCH:
+                yield prev_us, 'switch', {'left': chr(a) if a else 'OFF', 'right': b / 10}
+            else:
+                yield prev_us, 'button', {'id': BUTTONS.get(a, str(a)), 'level': b}
+        elif kind == REC_UART_RX:
+            n, pos = _varint(data, pos)
+            if n == 0 or n > RX_MAX or pos + n > len(data):
+                raise SessionError('bad UART_RX length')
+            yield prev_us, 'uart_rx', bytes(data[pos:pos + n])
+            pos += n
+        elif kind == REC_GAP:
+            v, pos = _varint(data, pos)
+            yield prev_us, 'gap', v
+        else:
+            raise SessionError(f'unknown record type {kind}')
+
+
+def slot_size(part_size):
+    return part_size // 2 // ERASE_SIZE * ERASE_SIZE
+
+
+def read_header(image, slot):
+    base = slot * slot_size(len(image))
+    magic, seq, build_id, _ = struct.unpack_from('<4I', image, base)
+    return (seq, build_id) if magic == SESSION_MAGIC else None
+
+
+def read_session(image, slot):
+    """Return (seq, build id, records, end reason) of one slot"""
+    size = slot_size(len(image))
+    header = read_header(image, slot)
+    if header is None:
+        raise SessionError(f'slot {slot} holds no session')
+    base = slot * size
+    off = 16
+    prev_us = 0
+    records = []
+    end = 'slot full'
+    while off + 8 <= size:
+        length, _, crc = struct.unpack_from('<HHI', image, base + off)
+        if length == 0xFFFF:
+            end = 'end of session'
+            break
+        data = image[base + off + 8:base + off + 8 + length]
+        if off + 8 + length > size or zlib.crc32(data) != crc:
+            end = f'bad chunk at {off:#x} (power cut while writing)'
+            break
+        try:
+            for rec in decode_records(data, prev_us):
+                records.append(rec)
+                prev_us = rec[0]
+        except SessionError as e:
+            end = f'corrupt chunk at {off:#x}: {e}'
+            break
+        off += (8 + length + CHUNK_ALIGN - 1) & ~(CHUNK_ALIGN - 1)
+    return header[0], header[1], records, end
+
+
+def newest_slot(image):
+    headers = [read_header(image, s) for s in (0, 1)]
+    valid = [s for s in (0, 1) if headers[s] is not None]
+    if not valid:
+        raise SessionError('no session in the image')
+    return max(valid, key=lambda s: headers[s][0])
+
+
+def format_record(time_us, kind, value):
+    if kind == 'uart_rx':
+        value = value.decode('ascii', 'backslashreplace').replace('\r', '\\r').replace('\n', '\\n')
+    elif kind == 'switch':
+        value = f"{value['left']} x{value['right']:g}"
+    elif kind == 'button':
+        value = f"{value['id']} {'up' if value['level'] else 'down'}"
+    return f'{time_us / 1e6:12.6f}  {kind:8} {value}'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('image', help='session partition read with parttool.py')
+    parser.add_argument('--slot', type=int, choices=(0, 1), help='slot to decode (default: newest session)')
+    parser.add_argument('--json', metavar='FILE', help='write the records as JSON instead of text')
+    args = parser.parse_args()
+
+    with open(args.image, 'rb') as f:
+        image = f.read()
+    try:
+        if len(image) < 2 * ERASE_SIZE:
+            raise SessionError(f'image is only {len(image)} bytes')
+        for s in (0, 1):
+            h = read_header(image, s)
+            print(f'slot {s}: ' + (f'session {h[0]}, build {h[1]:08x}' if h else 'empty'), file=sys.stderr)
+        slot = newest_slot(image) if args.slot is None else args.slot
+        seq, build_id, records, end = read_session(image, slot)
+    except SessionError as e:
+        sys.exit(f'{args.image}: {e}')
+
+    duration = records[-1][0] / 1e6 if records else 0
+    print(f'session {seq} (slot {slot}): {len(records)} records, {duration:.1f} s, {end}', file=sys.stderr)
+    if args.json:
+        out = [{'t_us': t, 'type': k, 'value': v.decode('latin-1') if isinstance(v, bytes) else v}
+               for t, k, v in records]
+        with open(args.json, 'w', encoding='utf-8') as f:
+            json.dump({'seq': seq, 'build_id': f'{build_id:08x}', 'records': out}, f, indent=1)
+    else:
+        for rec in records:
+            print(format_record(*rec))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
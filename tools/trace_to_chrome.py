@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Convert an event trace dump (CONFIG_PENDANT_TRACE) to Chrome trace JSON.
+
+Press t on the debug console to dump the trace ring, capture the console
+output to a file (or read the serial port directly) and open the result in
+chrome://tracing or https://ui.perfetto.dev. ESP_LOG lines around the dump
+are ignored. The dump (main/Trace/Trace.c) is self-describing:
+
+    #TRACE <cpu_hz> <events> <stalls>
+    #TC <category> <name>
+    #TN <event id> <name>
+    #T <cycles> <B|E|i> <event id> <arg>
+    #TRACE_END
+
+Every category is a track. Timestamps are the 32 bit CPU cycle counter,
+unwrapped here, so two consecutive events must be less than one wrap apart
+(about 27 s at 160 MHz). Stalls (spans longer than
+CONFIG_PENDANT_TRACE_STALL_MS) are global instant events named after the
+stalled span and its duration.
+
+    python tools/trace_to_chrome.py capture.log trace.json
+    python tools/trace_to_chrome.py /dev/ttyACM0 trace.json
+"""
+
+import argparse
+import json
+import sys
+
+
+class TraceError(Exception):
+    pass
+
+
+def read_dumps(lines):
+    """Yield every complete dump as (cpu_hz, categories, names, records)"""
+    dump = None
+    for line in lines:
+        line = line.strip()
+        if not line.startswith('#T'):
+            continue
+        parts = line.split()
+        tag = parts[0]
+        if tag == '#TRACE':
+            dump = {'hz': int(parts[1]), 'cats': {}, 'names': {}, 'recs': []}
+        elif dump is None:
+            continue
+        elif tag == '#TC':
+            dump['cats'][int(parts[1])] = parts[2]
+        elif tag == '#TN':
+            dump['names'][int(parts[1])] = parts[2]
+        elif tag == '#T':
+            dump['recs'].append((int(parts[1]), parts[2], int(parts[3]), int(parts[4])))
+        elif tag == '#TRACE_END':
+            yield dump['hz'], dump['cats'], dump['names'], dump['recs']
+            dump = None
+
+
+def convert(hz, cats, names, recs):
+    events = [{'ph': 'M', 'name': 'process_name', 'pid': 1, 'args': {'name': 'pendant'}}]
+    for cat, name in sorted(cats.items()):
+        events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': cat, 'args': {'name': name}})
+        events.append({'ph': 'M', 'name': 'thread_sort_index', 'pid': 1, 'tid': cat, 'args': {'sort_index': cat}})
+
+    open_spans = {}     # event id -> begin timestamp, to drop ends whose begin was overwritten
+    wrap = 0
+    prev = None
+    start = None
+    stalls = []
+    for cycles, ph, evt, arg in recs:
+        if prev is not None and cycles < prev:
+            wrap += 1 << 32
+        prev = cycles
+        t = cycles + wrap
+        if start is None:
+            start = t
+        ts = (t - start) * 1e6 / hz
+        name = names.get(evt, f'evt{evt}')
+        e = {'name': name, 'cat': cats.get(evt >> 4, str(evt >> 4)), 'ph': ph, 'ts': ts, 'pid': 1, 'tid': evt >> 4}
+        if ph == 'B':
+            open_spans[evt] = ts
+            e['args'] = {'arg': arg}
+        elif ph == 'E':
+            if evt not in open_spans:
+                continue
+            open_spans.pop(evt)
+            e['args'] = {'arg': arg}
+        elif name == 'stall':
+            span = names.get(arg, f'evt{arg}')
+            # the stall follows the end of the stalled span, find its begin
+            begin = next((x['ts'] for x in reversed(events) if x.get('name') == span and x['ph'] == 'B'), None)
+            dur_ms = (ts - begin) / 1000 if begin is not None else None
+            e['name'] = f'stall: {span}' + (f' {dur_ms:.1f} ms' if dur_ms is not None else '')
+            e['s'] = 'g'
+            stalls.append(e['name'])
+        else:
+            e['s'] = 't'
+            e['args'] = {'arg': arg}
+        events.append(e)
+    return {'traceEvents': events, 'displayTimeUnit': 'ms'}, stalls
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('source', help='captured console output or serial port')
+    parser.add_argument('output', help='Chrome trace JSON to write')
+    parser.add_argument('--index', type=int, default=-1, help='dump to convert if there are several (default: last)')
+    args = parser.parse_args()
+
+    if args.source.startswith('/dev/') or args.source.upper().startswith('COM'):
+        import serial
+        port = serial.Serial(args.source, timeout=None)
+        lines = (raw.decode('utf-8', 'replace') for raw in iter(port.readline, b''))
+        print('waiting for a dump, press t on the console', file=sys.stderr)
+        dumps = [next(read_dumps(lines))]
+    else:
+        with open(args.source, encoding='utf-8', errors='replace') as f:
+            dumps = list(read_dumps(f))
+
+    try:
+        if not dumps:
+            raise TraceError('no complete trace dump (#TRACE ... #TRACE_END) found')
+        try:
+            hz, cats, names, recs = dumps[args.index]
+        except IndexError:
+            raise TraceError(f'there are only {len(dumps)} dumps')
+        if hz <= 0:
+            raise TraceError(f'bad CPU frequency {hz}')
+        trace, stalls = convert(hz, cats, names, recs)
+    except TraceError as e:
+        sys.exit(f'{args.source}: {e}')
+
+    with open(args.output, 'w', encoding='utf-8') as f:
+        json.dump(trace, f)
+    print(f'{args.output}: {len(recs)} events at {hz / 1e6:g} MHz')
+    for s in stalls:
+        print(f'  {s}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())